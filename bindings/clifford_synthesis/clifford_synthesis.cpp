@@ -124,6 +124,26 @@ PYBIND11_MODULE(MQT_QMAP_MODULE_NAME, m, py::mod_gil_not_used()) {
           "with more gates than necessary. This option enables "
           "an additional run of the synthesizer to minimize the "
           "overall number of gates. Defaults to `false`.")
+      .def_readwrite(
+          "portfolio", &cs::Configuration::portfolio,
+          "Race several solver configurations (with and without symmetry "
+          "breaking, MaxSAT and binary search, and each entry of "
+          "`portfolio_solver_parameters`) in parallel and return the result "
+          "of the first one to finish. Defaults to `false`.")
+      .def_readwrite("portfolio_solver_parameters",
+                     &cs::Configuration::portfolioSolverParameters,
+                     "Additional solver parameter sets to race in the "
+                     "portfolio mode as list[dict[str, bool | int | float | "
+                     "str]]. Defaults to an empty list.")
+      .def_readwrite(
+          "greedy", &cs::Configuration::greedy,
+          "Synthesize the circuit with a polynomial-time greedy algorithm "
+          "instead of a SAT solver. The resulting circuit is not optimal with "
+          "respect to any metric, but is obtained quickly even for hundreds "
+          "of qubits. Defaults to `false`.")
+      .def_readwrite("greedy_upper_bound", &cs::Configuration::greedyUpperBound,
+                     "Use a greedily synthesized circuit as the initial upper "
+                     "bound for the SAT-based synthesis. Defaults to `false`.")
       .def_readwrite("heuristic", &cs::Configuration::heuristic,
                      "Use heuristic to synthesize the circuit. "
                      "This method synthesizes shallow intermediate circuits "
@@ -135,6 +155,21 @@ PYBIND11_MODULE(MQT_QMAP_MODULE_NAME, m, py::mod_gil_not_used()) {
           "n_threads_heuristic", &cs::Configuration::nThreadsHeuristic,
           "Maximum number of threads used for the heuristic optimizer. "
           "Defaults to the number of available threads on the system.")
+      .def_readwrite(
+          "iterative_heuristic", &cs::Configuration::iterativeHeuristic,
+          "Repeat the heuristic with shifted subcircuit boundaries so that "
+          "the seams between subcircuits get optimized as well. After the "
+          "first pass for every offset, only windows that changed in the "
+          "previous pass are resynthesized. Defaults to `false`.")
+      .def_readwrite("heuristic_max_passes",
+                     &cs::Configuration::heuristicMaxPasses,
+                     "Maximum number of passes of the iterative heuristic. "
+                     "Defaults to `0`, which runs until convergence.")
+      .def_readwrite("heuristic_time_limit",
+                     &cs::Configuration::heuristicTimeLimit,
+                     "Time budget in seconds for the iterative heuristic. No "
+                     "further pass is started once it is exceeded. Defaults "
+                     "to `0`, which means no limit.")
       .def("json", &cs::Configuration::json,
            "Returns a JSON-style dictionary of all the information present in "
            "the :class:`.Configuration`")
@@ -38,12 +38,32 @@ PYBIND11_MODULE(MQT_QMAP_MODULE_NAME, m, py::mod_gil_not_used()) {
            "min_entangling_y"_a, "max_entangling_y"_a)
       .def("solve", &na::NASolver::solve, "ops"_a, "num_qubits"_a,
            "num_stages"_a, "num_transfers"_a, "mind_ops_order"_a,
-           "shield_idle_qubits"_a);
+           "shield_idle_qubits"_a, "break_symmetries"_a = false,
+           py::call_guard<py::gil_scoped_release>())
+      .def("solve_optimal", &na::NASolver::solveOptimal, "ops"_a,
+           "num_qubits"_a, "max_num_stages"_a, "mind_ops_order"_a = false,
+           "shield_idle_qubits"_a = true, "break_symmetries"_a = false,
+           py::call_guard<py::gil_scoped_release>())
+      .def("solve_parallel", &na::NASolver::solveParallel, "ops"_a,
+           "num_qubits"_a, "max_num_stages"_a, "mind_ops_order"_a = false,
+           "shield_idle_qubits"_a = true, "break_symmetries"_a = false,
+           "num_threads"_a = 0,
+           py::call_guard<py::gil_scoped_release>());
 
   py::class_<na::NASolver::Result>(m, "NAStatePreparationSolver.Result")
       .def(py::init<>())
       .def("json",
-           [](const na::NASolver::Result& result) { return result.json(); });
+           [](const na::NASolver::Result& result) { return result.json(); })
+      .def("binary",
+           [](const na::NASolver::Result& result) {
+             return py::bytes(result.binary());
+           })
+      .def_static(
+          "from_binary",
+          [](const py::bytes& data) {
+            return na::NASolver::Result::fromBinary(std::string(data));
+          },
+          "data"_a);
 
   m.def(
       "generate_code",
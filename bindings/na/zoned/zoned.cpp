@@ -11,33 +11,121 @@
 #include "ir/QuantumComputation.hpp"
 #include "na/zoned/Architecture.hpp"
 #include "na/zoned/Compiler.hpp"
+#include "na/zoned/Profiling.hpp"
 #include "na/zoned/code_generator/CodeGenerator.hpp"
+#include "na/zoned/code_generator/CodeWriter.hpp"
 #include "na/zoned/layout_synthesizer/PlaceAndRouteSynthesizer.hpp"
 #include "na/zoned/layout_synthesizer/placer/AStarPlacer.hpp"
 #include "na/zoned/layout_synthesizer/placer/VertexMatchingPlacer.hpp"
 
 #include <cstddef>
+#include <fstream>
+#include <ios>
 // The header <nlohmann/json.hpp> is used, but clang-tidy confuses it with the
 // wrong forward header <nlohmann/json_fwd.hpp>
 // NOLINTNEXTLINE(misc-include-cleaner)
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <pybind11/attr.h>
 #include <pybind11/cast.h>
 #include <pybind11/detail/common.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 // NOLINTNEXTLINE(misc-include-cleaner)
 #include <pybind11_json/pybind11_json.hpp>
 #include <spdlog/common.h>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace py = pybind11;
 using namespace pybind11::literals;
 
+namespace {
+/// Compile the quantum computation and return the code in the .naviz format
+template <class Compiler>
+auto compileToString(Compiler& compiler, const qc::QuantumComputation& qc)
+    -> std::string {
+  std::ostringstream os;
+  na::zoned::TextCodeWriter writer(os);
+  compiler.compile(qc, writer);
+  return os.str();
+}
+/// Compile the quantum computation and write the code directly to a file
+template <class Compiler>
+auto compileToFile(Compiler& compiler, const qc::QuantumComputation& qc,
+                   const std::string& filename, const bool binary) -> void {
+  std::ofstream os(filename, binary ? std::ios::out | std::ios::binary
+                                    : std::ios::out);
+  if (!os) {
+    throw std::runtime_error("Could not open file " + filename + ".");
+  }
+  if (binary) {
+    na::zoned::BinaryCodeWriter writer(os);
+    compiler.compile(qc, writer);
+  } else {
+    na::zoned::TextCodeWriter writer(os);
+    compiler.compile(qc, writer);
+  }
+}
+/**
+ * Compile the quantum computations in parallel without holding the GIL and
+ * return the code in the .naviz format together with the statistics
+ */
+template <class Compiler>
+auto compileBatch(const Compiler& compiler,
+                  const std::vector<qc::QuantumComputation>& circuits,
+                  const size_t nThreads)
+    -> std::vector<std::pair<std::string, nlohmann::json>> {
+  std::vector<std::pair<std::string, nlohmann::json>> results;
+  results.reserve(circuits.size());
+  {
+    const py::gil_scoped_release release;
+    for (const auto& [code, statistics] :
+         compiler.compileBatch(circuits, nThreads)) {
+      results.emplace_back(code.toString(), statistics);
+    }
+  }
+  return results;
+}
+/// Parse the fallback of the A* placer from its name in the Python API
+auto parseFallback(const std::string& fallback)
+    -> na::zoned::AStarPlacer::Fallback {
+  if (fallback == "none") {
+    return na::zoned::AStarPlacer::Fallback::None;
+  }
+  if (fallback == "beam_search") {
+    return na::zoned::AStarPlacer::Fallback::BeamSearch;
+  }
+  if (fallback == "weighted_a_star") {
+    return na::zoned::AStarPlacer::Fallback::WeightedAStar;
+  }
+  throw std::invalid_argument("Invalid fallback \"" + fallback +
+                              "\", possible values are \"none\", "
+                              "\"beam_search\", and \"weighted_a_star\".");
+}
+} // namespace
+
 PYBIND11_MODULE(MQT_QMAP_MODULE_NAME, m, py::mod_gil_not_used()) {
+  // whether the statistics contain the fine-grained profiling counters
+  m.attr("PROFILING") = na::zoned::PROFILING;
+
   py::class_<na::zoned::Architecture> architecture(
       m, "ZonedNeutralAtomArchitecture");
-  architecture.def_static("from_json_file",
-                          &na::zoned::Architecture::fromJSONFile, "filename"_a);
+  architecture.def_static(
+      "from_json_file",
+      [](const std::string& filename,
+         const std::optional<std::string>& lookupTablesFile)
+          -> na::zoned::Architecture {
+        if (lookupTablesFile.has_value()) {
+          return na::zoned::Architecture::fromJSONFile(filename,
+                                                       *lookupTablesFile);
+        }
+        return na::zoned::Architecture::fromJSONFile(filename);
+      },
+      "filename"_a, "lookup_tables_file"_a = std::nullopt);
   architecture.def_static("from_json_string",
                           &na::zoned::Architecture::fromJSONString, "json"_a);
   architecture.def(
@@ -57,14 +145,17 @@ PYBIND11_MODULE(MQT_QMAP_MODULE_NAME, m, py::mod_gil_not_used()) {
       py::init([](const na::zoned::Architecture& arch,
                   const std::string& logLevel, const bool useWindow,
                   const size_t windowSize, const bool dynamicPlacement,
-                  const size_t parkingOffset, const bool warnUnsupportedGates)
+                  const size_t parkingOffset, const bool warnUnsupportedGates,
+                  const bool pipelining, const bool denseMatching)
                    -> na::zoned::RoutingAgnosticCompiler {
         na::zoned::RoutingAgnosticCompiler::Config config;
         config.logLevel = spdlog::level::from_str(logLevel);
-        config.layoutSynthesizerConfig.placerConfig = {.useWindow = useWindow,
-                                                       .windowSize = windowSize,
-                                                       .dynamicPlacement =
-                                                           dynamicPlacement};
+        config.pipelining = pipelining;
+        config.layoutSynthesizerConfig.placerConfig = {
+            .useWindow = useWindow,
+            .windowSize = windowSize,
+            .dynamicPlacement = dynamicPlacement,
+            .denseMatching = denseMatching};
         config.codeGeneratorConfig = {.parkingOffset = parkingOffset,
                                       .warnUnsupportedGates =
                                           warnUnsupportedGates};
@@ -72,7 +163,8 @@ PYBIND11_MODULE(MQT_QMAP_MODULE_NAME, m, py::mod_gil_not_used()) {
       }),
       py::keep_alive<1, 2>(), "arch"_a, "log_level"_a = "WARN",
       "use_window"_a = true, "window_size"_a = 10, "dynamic_placement"_a = true,
-      "parking_offset"_a = 1, "warn_unsupported_gates"_a = true);
+      "parking_offset"_a = 1, "warn_unsupported_gates"_a = true,
+      "pipelining"_a = false, "dense_matching"_a = false);
   routingAgnosticCompiler.def_static(
       "from_json_string",
       [](const na::zoned::Architecture& arch,
@@ -87,9 +179,26 @@ PYBIND11_MODULE(MQT_QMAP_MODULE_NAME, m, py::mod_gil_not_used()) {
       "compile",
       [](na::zoned::RoutingAgnosticCompiler& self,
          const qc::QuantumComputation& qc) -> std::string {
-        return self.compile(qc).toString();
+        return compileToString(self, qc);
       },
       "qc"_a);
+  routingAgnosticCompiler.def(
+      "compile_to_file",
+      [](na::zoned::RoutingAgnosticCompiler& self,
+         const qc::QuantumComputation& qc, const std::string& filename,
+         const bool binary) -> void {
+        compileToFile(self, qc, filename, binary);
+      },
+      "qc"_a, "filename"_a, "binary"_a = false);
+  routingAgnosticCompiler.def(
+      "compile_batch",
+      [](const na::zoned::RoutingAgnosticCompiler& self,
+         const std::vector<qc::QuantumComputation>& circuits,
+         const size_t nThreads)
+          -> std::vector<std::pair<std::string, nlohmann::json>> {
+        return compileBatch(self, circuits, nThreads);
+      },
+      "circuits"_a, "n_threads"_a = 0);
   routingAgnosticCompiler.def(
       "stats",
       [](const na::zoned::RoutingAgnosticCompiler& self) -> nlohmann::json {
@@ -105,10 +214,14 @@ PYBIND11_MODULE(MQT_QMAP_MODULE_NAME, m, py::mod_gil_not_used()) {
                   const double windowShare, const float deepeningFactor,
                   const float deepeningValue, const float lookaheadFactor,
                   const float reuseLevel, const size_t maxNodes,
-                  const size_t parkingOffset, const bool warnUnsupportedGates)
+                  const size_t parkingOffset, const bool warnUnsupportedGates,
+                  const bool pipelining, const std::string& fallback,
+                  const size_t beamWidth, const float fallbackWeight,
+                  const size_t portfolioSize)
                    -> na::zoned::RoutingAwareCompiler {
         na::zoned::RoutingAwareCompiler::Config config;
         config.logLevel = spdlog::level::from_str(logLevel);
+        config.pipelining = pipelining;
         config.layoutSynthesizerConfig.placerConfig = {
             .useWindow = useWindow,
             .windowMinWidth = windowMinWidth,
@@ -118,7 +231,11 @@ PYBIND11_MODULE(MQT_QMAP_MODULE_NAME, m, py::mod_gil_not_used()) {
             .deepeningValue = deepeningValue,
             .lookaheadFactor = lookaheadFactor,
             .reuseLevel = reuseLevel,
-            .maxNodes = maxNodes};
+            .maxNodes = maxNodes,
+            .fallback = parseFallback(fallback),
+            .beamWidth = beamWidth,
+            .fallbackWeight = fallbackWeight,
+            .portfolioSize = portfolioSize};
         config.codeGeneratorConfig = {.parkingOffset = parkingOffset,
                                       .warnUnsupportedGates =
                                           warnUnsupportedGates};
@@ -129,7 +246,9 @@ PYBIND11_MODULE(MQT_QMAP_MODULE_NAME, m, py::mod_gil_not_used()) {
       "window_share"_a = 0.6, "deepening_factor"_a = 0.8,
       "deepening_value"_a = 0.2, "lookahead_factor"_a = 0.2,
       "reuse_level"_a = 5.0, "max_nodes"_a = 50000000, "parking_offset"_a = 1,
-      "warn_unsupported_gates"_a = true);
+      "warn_unsupported_gates"_a = true, "pipelining"_a = false,
+      "fallback"_a = "none", "beam_width"_a = 1000, "fallback_weight"_a = 2.0,
+      "portfolio_size"_a = 1);
   routingAwareCompiler.def_static(
       "from_json_string",
       [](const na::zoned::Architecture& arch,
@@ -144,9 +263,26 @@ PYBIND11_MODULE(MQT_QMAP_MODULE_NAME, m, py::mod_gil_not_used()) {
       "compile",
       [](na::zoned::RoutingAwareCompiler& self,
          const qc::QuantumComputation& qc) -> std::string {
-        return self.compile(qc).toString();
+        return compileToString(self, qc);
       },
       "qc"_a);
+  routingAwareCompiler.def(
+      "compile_to_file",
+      [](na::zoned::RoutingAwareCompiler& self,
+         const qc::QuantumComputation& qc, const std::string& filename,
+         const bool binary) -> void {
+        compileToFile(self, qc, filename, binary);
+      },
+      "qc"_a, "filename"_a, "binary"_a = false);
+  routingAwareCompiler.def(
+      "compile_batch",
+      [](const na::zoned::RoutingAwareCompiler& self,
+         const std::vector<qc::QuantumComputation>& circuits,
+         const size_t nThreads)
+          -> std::vector<std::pair<std::string, nlohmann::json>> {
+        return compileBatch(self, circuits, nThreads);
+      },
+      "circuits"_a, "n_threads"_a = 0);
   routingAwareCompiler.def(
       "stats",
       [](const na::zoned::RoutingAwareCompiler& self) -> nlohmann::json {
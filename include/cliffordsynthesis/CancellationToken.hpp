@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2023 - 2025 Chair for Design Automation, TUM
+ * Copyright (c) 2025 Munich Quantum Software Company GmbH
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "logicblocks/LogicBlock.hpp"
+
+#include <mutex>
+#include <unordered_set>
+
+namespace cs {
+
+/**
+ * @brief Allows to cancel synthesis runs from another thread.
+ * @details Solver instances register themselves while they are solving. Upon
+ * cancellation, all registered solvers are interrupted and no further solver
+ * may register.
+ */
+class CancellationToken {
+public:
+  void cancel() {
+    const std::scoped_lock lock(mutex);
+    cancelled = true;
+    for (auto* const lb : activeBlocks) {
+      lb->interrupt();
+    }
+  }
+
+  [[nodiscard]] bool isCancelled() {
+    const std::scoped_lock lock(mutex);
+    return cancelled;
+  }
+
+  /// @returns false if the token has already been cancelled
+  [[nodiscard]] bool registerBlock(logicbase::LogicBlock* lb) {
+    const std::scoped_lock lock(mutex);
+    if (cancelled) {
+      return false;
+    }
+    activeBlocks.emplace(lb);
+    return true;
+  }
+
+  void unregisterBlock(logicbase::LogicBlock* lb) {
+    const std::scoped_lock lock(mutex);
+    activeBlocks.erase(lb);
+  }
+
+  /**
+   * @brief Registers a logic block for the lifetime of this object.
+   * @details The block is unregistered on destruction, also if solving throws.
+   */
+  class ScopedRegistration {
+  public:
+    ScopedRegistration(CancellationToken* token, logicbase::LogicBlock* lb)
+        : token(token), lb(lb),
+          registered(token == nullptr || token->registerBlock(lb)) {}
+    ScopedRegistration(const ScopedRegistration&) = delete;
+    ScopedRegistration(ScopedRegistration&&) = delete;
+    ScopedRegistration& operator=(const ScopedRegistration&) = delete;
+    ScopedRegistration& operator=(ScopedRegistration&&) = delete;
+    ~ScopedRegistration() {
+      if (token != nullptr && registered) {
+        token->unregisterBlock(lb);
+      }
+    }
+
+    /// @returns false if the token has already been cancelled
+    [[nodiscard]] bool isRegistered() const { return registered; }
+
+  private:
+    CancellationToken* token;
+    logicbase::LogicBlock* lb;
+    bool registered;
+  };
+
+protected:
+  std::mutex mutex;
+  bool cancelled = false;
+  std::unordered_set<logicbase::LogicBlock*> activeBlocks;
+};
+
+} // namespace cs
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include "cliffordsynthesis/CancellationToken.hpp"
 #include "cliffordsynthesis/Configuration.hpp"
 #include "cliffordsynthesis/Results.hpp"
 #include "cliffordsynthesis/Tableau.hpp"
@@ -22,6 +23,7 @@
 #include <memory>
 #include <plog/Log.h>
 #include <utility>
+#include <vector>
 
 namespace cs {
 
@@ -72,6 +74,11 @@ protected:
   std::shared_ptr<qc::QuantumComputation> resultCircuit;
   Tableau resultTableau;
   std::size_t solverCalls{};
+  std::shared_ptr<CancellationToken> cancellation;
+
+  [[nodiscard]] bool isCancelled() const {
+    return cancellation && cancellation->isCancelled();
+  }
 
   static bool requiresMultiGateEncoding(const TargetMetric metric) {
     return metric == TargetMetric::Depth;
@@ -88,7 +95,12 @@ protected:
                             std::size_t upper);
   void depthOptimalSynthesis(EncoderConfig config, std::size_t lower,
                              std::size_t upper);
+  void portfolioSynthesis();
   void depthHeuristicSynthesis();
+  std::pair<std::shared_ptr<qc::QuantumComputation>, std::vector<bool>>
+  runHeuristicPass(const std::shared_ptr<qc::QuantumComputation>& circuit,
+                   std::size_t offset, const std::vector<bool>& changedOps,
+                   const Configuration& config, bool acceptAll) const;
   void twoQubitGateOptimalSynthesis(EncoderConfig config, std::size_t lower,
                                     std::size_t upper);
 
@@ -102,7 +114,7 @@ protected:
     PLOG_INFO << "Running binary search in range [" << lowerBound << ", "
               << upperBound << ")";
 
-    while (lowerBound != upperBound) {
+    while (lowerBound != upperBound && !isCancelled()) {
       value = (lowerBound + upperBound) / 2;
       PLOG_INFO << "Trying value " << value << " in range [" << lowerBound
                 << ", " << upperBound << ")";
@@ -128,7 +140,7 @@ protected:
     if (upperBound == 0U) {
       upperBound = std::numeric_limits<std::size_t>::max();
     }
-    for (value = lowerBound; value < upperBound; ++value) {
+    for (value = lowerBound; value < upperBound && !isCancelled(); ++value) {
       PLOG_INFO << "Trying value " << value << " in range [" << lowerBound
                 << ", " << upperBound << ")";
       const auto r = callSolver(config);
@@ -21,6 +21,7 @@
 #include <thread>
 #include <unordered_map>
 #include <variant>
+#include <vector>
 
 namespace cs {
 
@@ -52,10 +53,26 @@ struct Configuration {
   double gateLimitFactor = 1.1;
   bool minimizeGatesAfterTwoQubitGateOptimization = false;
 
+  // Settings for the portfolio solver
+  bool portfolio = false;
+  std::vector<SolverParameterMap> portfolioSolverParameters;
+
+  // Settings for the greedy solver
+  bool greedy = false;
+  bool greedyUpperBound = false;
+
   // Settings for the heuristic solver
   bool heuristic = false;
   std::size_t splitSize = 5U;
   std::size_t nThreadsHeuristic = std::thread::hardware_concurrency();
+  /// Repeat the heuristic with shifted window offsets so that seams between
+  /// subcircuits are optimized as well
+  bool iterativeHeuristic = false;
+  /// Maximum number of passes of the iterative heuristic (0 = until
+  /// convergence)
+  std::size_t heuristicMaxPasses = 0U;
+  /// Time budget for the iterative heuristic in seconds (0 = no limit)
+  double heuristicTimeLimit = 0.0;
 
   [[nodiscard]] nlohmann::basic_json<> json() const {
     nlohmann::basic_json j;
@@ -72,9 +89,15 @@ struct Configuration {
     j["gate_limit_factor"] = gateLimitFactor;
     j["minimize_gates_after_two_qubit_gate_optimization"] =
         minimizeGatesAfterTwoQubitGateOptimization;
+    j["portfolio"] = portfolio;
+    j["greedy"] = greedy;
+    j["greedy_upper_bound"] = greedyUpperBound;
     j["heuristic"] = heuristic;
     j["split_size"] = splitSize;
     j["n_threads_heuristic"] = nThreadsHeuristic;
+    j["iterative_heuristic"] = iterativeHeuristic;
+    j["heuristic_max_passes"] = heuristicMaxPasses;
+    j["heuristic_time_limit"] = heuristicTimeLimit;
     if (!solverParameters.empty()) {
       nlohmann::basic_json solverParametersJson;
       for (const auto& entry : solverParameters) {
@@ -86,6 +109,21 @@ struct Configuration {
       }
       j["solver_parameters"] = solverParametersJson;
     }
+    if (!portfolioSolverParameters.empty()) {
+      nlohmann::basic_json portfolioJson = nlohmann::basic_json<>::array();
+      for (const auto& parameters : portfolioSolverParameters) {
+        nlohmann::basic_json parametersJson = nlohmann::basic_json<>::object();
+        for (const auto& entry : parameters) {
+          std::visit(
+              [&parametersJson, &entry](const auto& v) {
+                parametersJson[entry.first] = v;
+              },
+              entry.second);
+        }
+        portfolioJson.emplace_back(parametersJson);
+      }
+      j["portfolio_solver_parameters"] = portfolioJson;
+    }
     return j;
   }
 
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2023 - 2025 Chair for Design Automation, TUM
+ * Copyright (c) 2025 Munich Quantum Software Company GmbH
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "cliffordsynthesis/Results.hpp"
+#include "cliffordsynthesis/Tableau.hpp"
+#include "ir/operations/OpType.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace cs {
+
+/**
+ * @brief A polynomial-time Clifford synthesizer that does not rely on a SAT
+ * solver.
+ * @details Both the initial and the target tableau are reduced to the
+ * identity tableau by symplectic Gaussian elimination. In every step, the
+ * qubit whose (de)stabilizer rows are cheapest to eliminate, i.e., have the
+ * smallest support on the remaining qubits, is chosen next. The circuit
+ * reducing the initial tableau followed by the inverse of the circuit reducing
+ * the target tableau maps the initial tableau to the target tableau. Adjacent
+ * gates that cancel each other are removed afterward.
+ *
+ * The resulting circuits are not optimal with respect to any metric, but they
+ * are obtained within milliseconds even for hundreds of qubits. Hence, they
+ * serve well as an upper bound for the SAT-based synthesis.
+ */
+class GreedySynthesizer {
+public:
+  GreedySynthesizer(const Tableau& initial, const Tableau& target)
+      : initialTableau(&initial), targetTableau(&target) {}
+
+  /**
+   * @brief Synthesizes a circuit mapping the initial to the target tableau.
+   * @details If only one of the tableaus contains destabilizers, only the
+   * stabilizers are considered.
+   * @throws std::invalid_argument if one of the tableaus does not describe a
+   * valid (de)stabilizer state.
+   */
+  [[nodiscard]] Results run() const;
+
+protected:
+  struct Gate {
+    qc::OpType type = qc::OpType::None;
+    std::size_t target{};
+    std::optional<std::size_t> control = std::nullopt;
+  };
+  using GateList = std::vector<Gate>;
+
+  const Tableau* initialTableau;
+  const Tableau* targetTableau;
+
+  /// Returns the gates that reduce the given tableau to the identity tableau.
+  static GateList reduce(Tableau tableau, bool useDestabilizers);
+  static void reduceStabilizers(Tableau& tableau, GateList& gates);
+  static void reduceStabilizersAndDestabilizers(Tableau& tableau,
+                                                GateList& gates);
+
+  static void apply(Tableau& tableau, const Gate& gate);
+  static void applyAndRecord(Tableau& tableau, const Gate& gate,
+                             GateList& gates);
+
+  [[nodiscard]] static Gate invert(const Gate& gate);
+  [[nodiscard]] static bool cancels(const Gate& lhs, const Gate& rhs);
+  /// Removes pairs of adjacent gates that cancel each other.
+  [[nodiscard]] static GateList cancelGates(const GateList& gates,
+                                            std::size_t nQubits);
+};
+
+} // namespace cs
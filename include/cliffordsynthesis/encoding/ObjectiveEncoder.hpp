@@ -30,16 +30,8 @@ public:
                    std::shared_ptr<logicbase::LogicBlock> logicBlock)
       : N(nQubits), T(timestepLimit), gvars(vars), lb(std::move(logicBlock)) {}
 
-  template <class Op>
-  void limitGateCount(const std::size_t maxGateCount, Op op,
-                      const bool includeSingleQubitGates = true) const {
-    PLOG_DEBUG << "Limiting gate count to at most " << maxGateCount
-               << (includeSingleQubitGates ? "" : " two-qubit") << " gate(s)";
-
-    const auto cost = collectGateCount(includeSingleQubitGates);
-    lb->assertFormula(
-        op(cost, logicbase::LogicTerm(static_cast<int>(maxGateCount))));
-  }
+  void limitGateCount(std::size_t maxGateCount,
+                      bool includeSingleQubitGates = true) const;
 
   void optimizeMetric(TargetMetric targetMetric) const;
 
@@ -62,28 +54,30 @@ protected:
   [[nodiscard]] logicbase::LogicTerm
   collectGateCount(bool includeSingleQubitGates = true) const;
 
-  template <class Op>
-  void collectSingleQubitGateTerms(std::size_t pos, logicbase::LogicTerm& terms,
-                                   Op op) const {
-    const auto& singleQubitGates = gvars->gS[pos];
-    for (std::size_t q = 0U; q < N; ++q) {
-      for (const auto gate : GateEncoder::SINGLE_QUBIT_GATES) {
-        if (gate == qc::OpType::None) {
-          continue;
+  [[nodiscard]] logicbase::LogicVector
+  collectGateVariables(bool includeSingleQubitGates = true) const;
+
+  // calls visit for the variables of all gates at timestep pos, i.e., all
+  // single-qubit gates except the identity and all two-qubit gates
+  template <class Visitor>
+  void forEachGateVariable(std::size_t pos, bool includeSingleQubitGates,
+                           Visitor visit) const {
+    if (includeSingleQubitGates) {
+      const auto& singleQubitGates = gvars->gS[pos];
+      for (std::size_t q = 0U; q < N; ++q) {
+        for (const auto gate : GateEncoder::SINGLE_QUBIT_GATES) {
+          if (gate == qc::OpType::None) {
+            continue;
+          }
+          visit(singleQubitGates[GateEncoder::gateToIndex(gate)][q]);
         }
-        terms = op(terms, singleQubitGates[GateEncoder::gateToIndex(gate)][q]);
       }
     }
-  }
-
-  template <class Op>
-  void collectTwoQubitGateTerms(std::size_t pos, logicbase::LogicTerm& terms,
-                                Op op) const {
     const auto& twoQubitGates = gvars->gC[pos];
     for (std::size_t ctrl = 0U; ctrl < N; ++ctrl) {
       for (std::size_t trgt = 0U; trgt < ctrl; ++trgt) {
-        terms = op(terms, twoQubitGates[ctrl][trgt]);
-        terms = op(terms, twoQubitGates[trgt][ctrl]);
+        visit(twoQubitGates[ctrl][trgt]);
+        visit(twoQubitGates[trgt][ctrl]);
       }
     }
   }
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include "cliffordsynthesis/CancellationToken.hpp"
 #include "cliffordsynthesis/Configuration.hpp"
 #include "cliffordsynthesis/Results.hpp"
 #include "cliffordsynthesis/Tableau.hpp"
@@ -63,6 +64,9 @@ public:
     std::optional<std::size_t> twoQubitGateLimit = std::nullopt;
 
     SolverParameterMap solverParameters;
+
+    // an optional token to cancel the solver from another thread
+    std::shared_ptr<CancellationToken> cancellation{};
   };
 
   SATEncoder() = default;
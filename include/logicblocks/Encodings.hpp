@@ -66,6 +66,29 @@ LogicTerm naiveAtLeastOne(const std::vector<LogicTerm>& clauseVars);
 LogicTerm atMostOneBiMander(const std::vector<LogicTerm>& vars,
                             LogicBlock* logic);
 
+// The following functions emit their constraints as CNF clauses directly
+// into the given logic block (see LogicBlock::addClause) instead of returning
+// a formula. Literals are Boolean variables or their negations.
+
+void addAtLeastOne(const std::vector<LogicTerm>& literals, LogicBlock* logic);
+
+void addNaiveAtMostOne(const std::vector<LogicTerm>& literals,
+                       LogicBlock* logic);
+
+void addAtMostOneCmdr(const std::vector<NestedVar>& subords,
+                      const LogicTerm& cmdrVar, LogicBlock* logic);
+
+void addExactlyOneCmdr(const std::vector<NestedVar>& subords,
+                       const LogicTerm& cmdrVar, LogicBlock* logic);
+
+void addAtMostOneBiMander(const std::vector<LogicTerm>& literals,
+                          LogicBlock* logic);
+
+// Sequential counter encoding (Sinz, 2005) of sum(literals) <= k using
+// O(n * k) auxiliary variables and clauses.
+void addAtMostK(const std::vector<LogicTerm>& literals, std::size_t k,
+                LogicBlock* logic);
+
 std::vector<NestedVar> groupVars(const std::vector<LogicTerm>& vars,
                                  std::size_t maxSize);
 std::vector<NestedVar> groupVarsAux(const std::vector<NestedVar>& vars,
@@ -275,6 +275,7 @@ inline CType getResultCType(OpType op) {
 }
 
 class LogicTerm;
+class TermTable;
 
 using LogicVector = std::vector<LogicTerm>;
 using LogicMatrix = std::vector<LogicVector>;
@@ -286,6 +287,8 @@ public:
   virtual ~Logic() = default;
   virtual uint64_t getNextId() = 0;
   virtual uint64_t getId() = 0;
+  // The table used for hash-consing the compound terms of this logic, if any.
+  virtual TermTable* getTermTable() { return nullptr; }
 };
 
 } // namespace logicbase
@@ -13,6 +13,7 @@
 #include "Logic.hpp"
 #include "LogicTerm.hpp"
 
+#include <atomic>
 #include <cstdint>
 #include <set>
 #include <string>
@@ -29,16 +30,26 @@ protected:
   bool convertWhenAssert;
   virtual void internalReset() = 0;
   uint64_t gid = 0U;
+  TermTable termTable;
+  // Set by interrupt() and cleared by reset(). The solvers only react to an
+  // interrupt while they are running, hence, solve() checks this flag right
+  // before the solver is started.
+  std::atomic<bool> interrupted = false;
 
 public:
   explicit LogicBlock(bool convert = false) : convertWhenAssert(convert) {}
 
   uint64_t getNextId() override { return gid++; };
   uint64_t getId() override { return gid; };
+  TermTable* getTermTable() override { return &termTable; }
 
   Model* getModel() { return model; }
 
   virtual void assertFormula(const LogicTerm& a);
+  // Add the disjunction of the given literals, i.e., Boolean variables or
+  // their negations, as a clause. Backends may pass the clause to the solver
+  // directly instead of building and clausifying a formula.
+  virtual void addClause(const LogicVector& literals);
 
   LogicTerm makeVariable(const std::string& name, CType type = CType::BOOL,
                          uint16_t bvSize = 32U);
@@ -46,6 +57,10 @@ public:
   virtual void produceInstance() = 0;
   virtual Result solve() = 0;
   virtual void reset();
+  // Abort a running call to solve() from another thread. The interrupted call
+  // returns Result::NDEF. The interrupt is sticky, i.e., a call to solve()
+  // that has not started the solver yet returns Result::NDEF as well.
+  virtual void interrupt() { interrupted = true; }
 
   virtual std::string dumpInternalSolver() { return ""; }
 };
@@ -16,7 +16,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <initializer_list>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace logicbase {
@@ -33,7 +35,8 @@ private:
   double fValue = 0.;
   uint64_t bvValue = 0U;
   uint16_t bvSize = 0;
-  std::vector<LogicTerm> nodes;
+  // children are immutable and shared between all copies of a term
+  std::shared_ptr<const std::vector<LogicTerm>> nodes;
   CType cType = CType::BOOL;
 
   // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
@@ -133,7 +136,7 @@ public:
   [[nodiscard]] bool isConst() const;
 
   [[nodiscard]] uint64_t getID() const { return id; }
-  [[nodiscard]] const std::vector<LogicTerm>& getNodes() const { return nodes; }
+  [[nodiscard]] const std::vector<LogicTerm>& getNodes() const;
   [[nodiscard]] OpType getOpType() const { return opType; }
   [[nodiscard]] CType getCType() const { return cType; }
   [[nodiscard]] const std::string& getName() const { return name; }
@@ -199,4 +202,37 @@ struct TermDepthComparator {
   bool operator()(const LogicTerm& t1, const LogicTerm& t2) const;
 };
 
+/**
+ * @brief Hash-consing table for compound terms.
+ * @details Structurally equal compound terms created within the same logic
+ * share their id and their children. Thus, formulas form a DAG instead of a
+ * tree, copying a term never copies its subterms, and every distinct subterm
+ * is converted only once by the solver backends. The interned children live
+ * as long as the table, i.e., until the owning logic block is reset.
+ */
+class TermTable {
+public:
+  struct Entry {
+    uint64_t id = 0;
+    std::shared_ptr<const std::vector<LogicTerm>> nodes;
+  };
+
+  /**
+   * @brief Returns the id and the shared children of the term (op, type, n).
+   * @details Terms with children from another logic cannot be identified by
+   * the ids of their children and are, hence, never interned.
+   */
+  Entry intern(OpType op, CType type, const std::vector<LogicTerm>& n,
+               Logic* logic);
+
+  [[nodiscard]] std::size_t size() const { return table.size(); }
+  void clear() { table.clear(); }
+
+protected:
+  struct KeyHash {
+    std::size_t operator()(const std::vector<uint64_t>& key) const;
+  };
+  std::unordered_map<std::vector<uint64_t>, Entry, KeyHash> table;
+};
+
 } // namespace logicbase
@@ -14,9 +14,13 @@
 #include "LogicBlock.hpp"
 #include "LogicTerm.hpp"
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <sstream>
 #include <string>
@@ -33,8 +37,20 @@ class Z3Base {
 protected:
   std::unordered_map<uint64_t, std::vector<std::pair<bool, z3::expr>>>
       variables;
-  std::unordered_map<LogicTerm, std::vector<std::pair<bool, z3::expr>>,
-                     TermHash, TermHash>
+  // Term ids are only unique within the logic that created the term. Terms
+  // created without a logic take their id from a global counter instead.
+  struct CacheKeyHash {
+    std::size_t
+    operator()(const std::pair<const Logic*, uint64_t>& key) const {
+      const auto seed = std::hash<const Logic*>{}(key.first);
+      return seed ^ (std::hash<uint64_t>{}(key.second) +
+                     0x9e3779b97f4a7c15ULL + (seed << 6U) + (seed >> 2U));
+    }
+  };
+  // converted compound terms indexed by their logic, their id, and the target
+  // type
+  std::unordered_map<std::pair<const Logic*, uint64_t>,
+                     std::array<std::optional<z3::expr>, 4>, CacheKeyHash>
       cache;
   std::shared_ptr<z3::context> ctx;
 
@@ -69,6 +85,7 @@ public:
                            CType toType);
 
   z3::expr convertConstant(const LogicTerm& a, CType toType);
+  z3::expr convertClause(const LogicVector& literals);
 };
 
 class Z3LogicBlock : public LogicBlock, public Z3Base {
@@ -86,8 +103,13 @@ public:
     cache.clear();
   }
   void assertFormula(const LogicTerm& a) override;
+  void addClause(const LogicVector& literals) override;
   void produceInstance() override;
   Result solve() override;
+  void interrupt() override {
+    LogicBlock::interrupt();
+    ctx->interrupt();
+  }
   std::string dumpInternalSolver() override {
     std::stringstream ss;
     ss << (*solver);
@@ -117,8 +139,13 @@ public:
     cache.clear();
   }
   void assertFormula(const LogicTerm& a) override;
+  void addClause(const LogicVector& literals) override;
   void produceInstance() override;
   Result solve() override;
+  void interrupt() override {
+    LogicBlockOptimizer::interrupt();
+    ctx->interrupt();
+  }
 
   bool makeMinimize() override;
   bool makeMaximize() override;
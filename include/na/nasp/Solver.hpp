@@ -13,12 +13,16 @@
 #include "ir/Definitions.hpp"
 #include "ir/QuantumComputation.hpp"
 
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <nlohmann/json_fwd.hpp>
 #include <optional>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <z3++.h>
@@ -26,6 +30,50 @@
 namespace na {
 using namespace z3;
 
+/**
+ * @brief Interrupts the Z3 contexts of cancelled jobs that run concurrently.
+ * @details Z3 clears a pending interrupt of a context when a check starts and
+ * then runs the check to completion. Hence, a single interrupt is lost if the
+ * job is cancelled right before its check starts. Instead, a background thread
+ * repeats the interrupt of a cancelled job every millisecond until the job
+ * acknowledges it by unregistering its context.
+ */
+class ContextInterrupter {
+  std::mutex mutex_;
+  /// Wakes up the background thread
+  std::condition_variable wakeup_;
+  /// The registered context of every job or nullptr if there is none
+  std::vector<context*> contexts_;
+  /// Whether every job is cancelled
+  std::vector<bool> cancelled_;
+  /// Whether the background thread shall stop
+  bool finished_ = false;
+  std::thread thread_;
+
+public:
+  /// Creates an interrupter for @p nJobs jobs and starts its thread.
+  explicit ContextInterrupter(size_t nJobs);
+  ContextInterrupter(const ContextInterrupter&) = delete;
+  ContextInterrupter(ContextInterrupter&&) = delete;
+  auto operator=(const ContextInterrupter&) -> ContextInterrupter& = delete;
+  auto operator=(ContextInterrupter&&) -> ContextInterrupter& = delete;
+  /// Stops the thread. All contexts must be unregistered before.
+  ~ContextInterrupter();
+  /**
+   * Registers the context of job @p job such that it is interrupted when the
+   * job is cancelled. The context must be unregistered before it is destroyed.
+   * @returns false and does not register the context if the job is already
+   * cancelled
+   */
+  auto registerContext(size_t job, context& ctx) -> bool;
+  /// Unregisters the context of job @p job, which acknowledges a cancellation.
+  auto unregisterContext(size_t job) -> void;
+  /// Cancels job @p job and interrupts its context until it is unregistered.
+  auto cancel(size_t job) -> void;
+  /// @returns true if job @p job is cancelled
+  [[nodiscard]] auto isCancelled(size_t job) -> bool;
+};
+
 class NASolver {
 private:
   /// Z3 context used throughout the solver instance
@@ -254,6 +302,20 @@ private:
   std::vector<Stage> stages;
   std::vector<expr> transfers;
   std::vector<expr> gates;
+  /// the number of gates that must be executed before each gate
+  std::vector<uint16_t> gateDepths;
+  /// the number of gates that must be executed after each gate
+  std::vector<uint16_t> gateHeights;
+  /// the minimal number of Rydberg stages required to execute all gates
+  uint16_t minNumRydbergStages = 0;
+
+  /// Returns the bit width of the variables holding the index of a stage
+  [[nodiscard]] auto getStageBits() const -> uint32_t;
+
+  /// Returns the constraint @code stage < t @endcode for a variable holding
+  /// the index of a stage, where @p t may be out of the range of the variable
+  [[nodiscard]] auto getBeforeStageConstraint(const expr& stage,
+                                              int32_t t) const -> expr;
 
   /// Initializes the variables for all stages and all qubits
   auto initVariables() -> void;
@@ -325,6 +387,38 @@ private:
       const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
       bool mindOpsOrder, bool shieldIdleAtoms) -> std::vector<expr>;
 
+  /**
+   * @brief Creates the variables @code gate_i@endcode for every gate in @p ops
+   * and derives the bounds of the stages the gates can be executed in.
+   * @details If @p mindOpsOrder is true, the depth and the height of every
+   * gate are derived from the order of the gates. In any case, the minimal
+   * number of Rydberg stages is derived.
+   */
+  auto initGates(const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
+                 bool mindOpsOrder) -> void;
+
+  /**
+   * @brief Returns the constraints on the relative order of the gates.
+   * @details If @p mindOpsOrder is true, every gate is executed after the
+   * previous gates acting on the same qubits. Otherwise, gates sharing a qubit
+   * are executed in different stages.
+   */
+  [[nodiscard]] auto getGateOrderConstraints(
+      const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
+      bool mindOpsOrder) const -> std::vector<expr>;
+
+  /// Returns constraints ensuring that all gates are executed before stage t
+  /// and that at least @ref minNumRydbergStages of those stages are Rydberg
+  /// stages
+  [[nodiscard]] auto getGatesBeforeStageConstraints(uint16_t t) const
+      -> std::vector<expr>;
+
+  /// Returns the constraints of getCircuitExecutionConstraints that refer to
+  /// stage t
+  [[nodiscard]] auto getStageExecutionConstraints(
+      const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops, uint16_t t,
+      bool shieldIdleAtoms) const -> std::vector<expr>;
+
   /// Returns a constraint expressing that this stage is a Rydberg stage, that
   /// is if
   /// @code numTransfers_{t-1} = numTransfers_t @endcode
@@ -339,6 +433,33 @@ private:
   [[nodiscard]] auto getValidStageConstraints(uint16_t t) const
       -> std::vector<expr>;
 
+  /**
+   * @brief Returns constraints that exclude solutions which are symmetric to
+   * other solutions within the first t stages.
+   * @details The constraints are satisfied by at least one solution of every
+   * class of symmetric solutions, i.e., they do not change the satisfiability:
+   * - Qubits that can be exchanged without changing the operations are
+   * ordered lexicographically by their location in the first stage.
+   * - The smallest x-coordinate of all atoms in all stages is 0 because all
+   * constraints on x-coordinates are invariant under translation.
+   * - The AOD columns (rows) used in any stage with a positive index are
+   * indexed without gaps, i.e., if column c + 1 is used, column c is used as
+   * well. The index 0 is excluded because it also determines whether SLM atoms
+   * are loaded.
+   */
+  [[nodiscard]] auto getSymmetryBreakingConstraints(
+      const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
+      bool mindOpsOrder, uint16_t t) const -> std::vector<expr>;
+
+  /**
+   * @brief Checks the input of the solver.
+   * @throws illegal_argument if there is no storage zone and shieldIdleQubits
+   * is true, or if the operations reference a qubit not less than
+   * @p newNumQubits
+   */
+  auto checkInput(const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
+                  uint16_t newNumQubits, bool shieldIdleQubits) const -> void;
+
 public:
   /**
    * @brief Construct a new NASolver object with the given parameters that
@@ -445,9 +566,51 @@ public:
 
     [[nodiscard]] auto json() const -> nlohmann::json;
 
+    /**
+     * @brief Returns a compact binary representation of the result.
+     * @details The representation starts with the magic bytes `NASP` and a
+     * version byte followed by the satisfiability flag, the attributes
+     * required by the CodeGenerator, and all stages. All integers are encoded
+     * as LEB128 variable-length integers, signed ones after zigzag encoding.
+     * In contrast to the JSON representation, the attributes and the stage of
+     * every gate are preserved.
+     */
+    [[nodiscard]] auto binary() const -> std::string;
+
+    /**
+     * @brief Reads a result from its binary representation.
+     * @see binary
+     * @throws invalid_argument if @\p data is not a valid binary representation
+     * of a result
+     */
+    [[nodiscard]] static auto fromBinary(const std::string& data) -> Result;
+
     [[nodiscard]] auto operator==(const Result& other) const -> bool;
   };
 
+private:
+  /// Extracts the result for the first @p nStages stages from the model
+  [[nodiscard]] auto
+  extractResult(const model& model,
+                const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
+                uint16_t nStages) const -> Result;
+
+  /**
+   * @brief Same as solve but returns no result if @p isCancelled returns true
+   * right before or after the check.
+   * @details This complements interrupting the context since Z3 clears a
+   * pending interrupt when the check starts. If @p isCancelled is empty, a
+   * result is always returned.
+   */
+  [[nodiscard]] auto solveUnlessCancelled(
+      const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
+      uint16_t newNumQubits, uint16_t newNumStages,
+      std::optional<uint16_t> newNumTransfers, bool mindOpsOrder,
+      bool shieldIdleQubits, bool breakSymmetries,
+      const std::function<bool()>& isCancelled) -> std::optional<Result>;
+
+public:
+
   /**
    * @brief The core function of the solver that solves one instance of the
    * problem.
@@ -470,14 +633,89 @@ public:
    * not involved in an operation are shielded from the Rydberg beam, i.e.,
    * moved to one storage zone. If there is no storage zone and this parameter
    * is true, the solver will return an exception.
+   * @param breakSymmetries if true, the solver adds constraints that exclude
+   * solutions that are symmetric to other solutions, see
+   * getSymmetryBreakingConstraints. This does not change whether a solution
+   * exists but may speed up proving that none exists.
    * @throws illegal_argument if there is no storage zone and shieldIdleQubits
    * is true
+   * @throws runtime_error if the Z3 context was interrupted while solving
    */
   [[nodiscard]] auto
   solve(const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
         uint16_t newNumQubits, uint16_t newNumStages,
         std::optional<uint16_t> newNumTransfers = std::nullopt,
-        bool mindOpsOrder = false, bool shieldIdleQubits = true) -> Result;
+        bool mindOpsOrder = false, bool shieldIdleQubits = true,
+        bool breakSymmetries = false) -> Result;
+
+  /**
+   * @brief Finds a solution with the minimal number of stages and, among
+   * those, the minimal number of transfer stages.
+   * @details Instead of solving one instance per number of stages, all
+   * variables are created once for @p maxNumStages and the stages are added
+   * one after the other to the same Z3 solver. The requirement that all gates
+   * are executed within the first k stages as well as the exact number of
+   * transfer stages are only passed as assumptions. Hence, no constraint is
+   * encoded twice and the solver reuses what it has learned for smaller
+   * numbers of stages.
+   * @param ops a list of entangling operations represented as a list of qubit
+   * pairs
+   * @param newNumQubits the overall number of qubits in the quantum circuit
+   * @param maxNumStages the maximal number of stages that is tried
+   * @param mindOpsOrder if true, the solver schedules the operations in the
+   * order they are given in the list
+   * @param shieldIdleQubits if true, the solver ensures that qubits that are
+   * not involved in an operation are shielded from the Rydberg beam
+   * @param breakSymmetries if true, symmetric solutions are excluded, see
+   * solve
+   * @return the result for the minimal number of stages, or an unsatisfiable
+   * result if no solution with at most @p maxNumStages stages exists
+   * @throws illegal_argument if @p maxNumStages is zero, or if there is no
+   * storage zone and shieldIdleQubits is true
+   */
+  [[nodiscard]] auto
+  solveOptimal(const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
+               uint16_t newNumQubits, uint16_t maxNumStages,
+               bool mindOpsOrder = false, bool shieldIdleQubits = true,
+               bool breakSymmetries = false) -> Result;
+
+  /**
+   * @brief Finds a solution with the minimal number of stages and, among
+   * those, the minimal number of transfer stages by solving independent
+   * instances concurrently.
+   * @details Every instance, i.e., every combination of a number of stages and
+   * a number of transfer stages, is solved with solve by its own NASolver with
+   * its own Z3 context because the context is not thread-safe and is shared by
+   * all copies of a solver. Additionally, for every number of stages, the
+   * instance with a variable number of transfer stages is solved. The instances
+   * are started in the order of increasing number of stages and transfer
+   * stages. As soon as an instance is solved, all instances that became
+   * redundant are skipped or interrupted if they are already running, i.e.,
+   * all instances with more stages or transfer stages than a satisfiable
+   * instance and all instances with a number of stages for which the instance
+   * with a variable number of transfer stages is unsatisfiable.
+   * @param ops a list of entangling operations represented as a list of qubit
+   * pairs
+   * @param newNumQubits the overall number of qubits in the quantum circuit
+   * @param maxNumStages the maximal number of stages that is tried
+   * @param mindOpsOrder if true, the solver schedules the operations in the
+   * order they are given in the list
+   * @param shieldIdleQubits if true, the solver ensures that qubits that are
+   * not involved in an operation are shielded from the Rydberg beam
+   * @param breakSymmetries if true, symmetric solutions are excluded, see
+   * solve
+   * @param numThreads the number of instances solved concurrently, if zero,
+   * the number of hardware threads is used
+   * @return the result for the minimal number of stages, or an unsatisfiable
+   * result if no solution with at most @p maxNumStages stages exists
+   * @throws illegal_argument if @p maxNumStages is zero, or if there is no
+   * storage zone and shieldIdleQubits is true
+   */
+  [[nodiscard]] auto
+  solveParallel(const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
+                uint16_t newNumQubits, uint16_t maxNumStages,
+                bool mindOpsOrder = false, bool shieldIdleQubits = true,
+                bool breakSymmetries = false, size_t numThreads = 0) -> Result;
 
   /**
    * @brief Get the list of entangling operations that the solver takes as
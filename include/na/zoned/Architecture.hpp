@@ -13,7 +13,9 @@
 #include "ir/Definitions.hpp"
 
 #include <array>
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <functional>
@@ -29,6 +31,12 @@
 #include <vector>
 
 namespace na::zoned {
+/**
+ * A compact identifier of a site that is unique among all sites of an
+ * architecture, see @ref Architecture::getSiteId.
+ */
+using SiteId = std::uint32_t;
+
 /// A 2D-Array of AOD traps
 struct AOD {
   std::size_t id = 0;
@@ -58,6 +66,8 @@ struct SLM {
   const std::array<SLM, 2>* entanglementZone_ = nullptr;
   /// Only used for printing.
   std::optional<std::size_t> entanglementId_ = std::nullopt;
+  /// The site id of the site in the first row and column of the SLM.
+  SiteId firstSiteId_ = 0;
   /// Creates an SLM with default values.
   SLM() = default;
   /// Creates an SLM array from a JSON specification.
@@ -195,16 +205,24 @@ struct Architecture {
 
 private:
   /**
-   * A map from an entanglement site to its nearest storage site. The nearest
-   * @see storageToNearestEntanglementSite
+   * All SLMs sorted by the id of their first site. Together with the total
+   * number of sites, this allows mapping a site id back to its site.
    */
-  SLMMap<std::vector<std::vector<Site>>> entanglementToNearestStorageSite;
+  std::vector<const SLM*> slmsBySiteId_;
+  /// The total number of sites in all SLMs
+  SiteId nSites_ = 0;
+  /// The number of sites in storage SLMs, they have the smallest site ids
+  SiteId nStorageSites_ = 0;
+  /// The exact location of every site indexed by its site id
+  std::vector<std::pair<std::size_t, std::size_t>> siteLocations_;
   /**
-   * A map from a pair of storage sites to their common nearest entanglement
-   * @see entanglementToNearestStorageSite
+   * The nearest storage site of every entanglement site. The entry for the
+   * entanglement site with id i is stored at index i - nStorageSites_.
+   * @note The nearest entanglement site of a pair of storage sites is not
+   * stored as there are quadratically many pairs, see
+   * @ref nearestEntanglementSiteId.
    */
-  SLMMap<std::vector<std::vector<SLMMap<std::vector<std::vector<Site>>>>>>
-      storageToNearestEntanglementSite;
+  std::vector<SiteId> nearestStorageSiteIds_;
 
 public:
   /**
@@ -236,6 +254,32 @@ public:
    */
   [[nodiscard]] static auto fromJSON(const nlohmann::json& json)
       -> Architecture;
+  /**
+   * @brief Creates an Architecture from a JSON file and reuses the lookup
+   * tables stored in another file.
+   * @details If the file with the lookup tables does not exist or belongs to
+   * a different architecture, the lookup tables are computed and written to
+   * the file such that subsequent loads skip the precomputation.
+   * @param filename the name of the JSON file
+   * @param lookupTablesPath the path of the file with the lookup tables, see
+   * @ref exportLookupTables
+   * @throws std::invalid_argument if the file with the lookup tables is
+   * corrupted, see @ref importLookupTables
+   */
+  [[nodiscard]] static auto
+  fromJSONFile(const std::string& filename,
+               const std::filesystem::path& lookupTablesPath) -> Architecture {
+    return fromJSON(nlohmann::json::parse(std::ifstream(filename)),
+                    lookupTablesPath);
+  }
+  /**
+   * Creates an Architecture from a JSON object and reuses the lookup tables
+   * stored in a file.
+   * @see fromJSONFile(const std::string&, const std::filesystem::path&)
+   */
+  [[nodiscard]] static auto
+  fromJSON(const nlohmann::json& json,
+           const std::filesystem::path& lookupTablesPath) -> Architecture;
   /// Creates an empty Architecture.
   Architecture() = default;
   // Explicitly delete copy constructor and copy assignment operator because the
@@ -278,6 +322,26 @@ public:
   auto exportNAVizMachine(const std::string& filename) const -> void {
     exportNAVizMachine(std::filesystem::path(filename));
   }
+  /**
+   * @brief Export the precomputed lookup tables of the architecture.
+   * @details The tables are written as a fixed-size header followed by flat
+   * arrays of 32-bit site ids in native byte order. The format contains no
+   * pointers and is aligned, i.e., it can be read with a single read or
+   * mapped into memory as is. The header contains a fingerprint of the
+   * geometry of the architecture that is checked when the tables are
+   * imported.
+   * @param os the output stream to write the lookup tables to
+   */
+  auto exportLookupTables(std::ostream& os) const -> void;
+  /**
+   * Import lookup tables previously written by @ref exportLookupTables.
+   * @param is the input stream to read the lookup tables from
+   * @return false if the stream does not contain valid lookup tables for this
+   * architecture, in this case the current lookup tables are left unchanged
+   * @throws std::invalid_argument if the header matches this architecture but
+   * the tables contain site ids out of range, i.e., the stream is corrupted
+   */
+  auto importLookupTables(std::istream& is) -> bool;
   /**
    * Check if the given position is a valid SLM position, i.e., whether the
    * given row and column are within the range of the SLM.
@@ -295,18 +359,32 @@ public:
   auto distance(const SLM& idx1, std::size_t r1, std::size_t c1,
                 const SLM& idx2, std::size_t r2, std::size_t c2) const
       -> double;
+  /// Compute the distance between two sites given by their site ids
+  [[nodiscard]] auto distance(SiteId site1, SiteId site2) const -> double;
   /// Return the nearest storage site for an entanglement site
   auto nearestStorageSite(const SLM& slm, std::size_t r, std::size_t c) const
-      -> const
-      std::tuple<std::reference_wrapper<const SLM>, std::size_t, std::size_t>&;
+      -> Site;
+  /// @see nearestStorageSite(const SLM&, std::size_t, std::size_t)
+  [[nodiscard]] auto nearestStorageSiteId(const SiteId site) const -> SiteId {
+    assert(site >= nStorageSites_ && site < nSites_);
+    return nearestStorageSiteIds_[site - nStorageSites_];
+  }
   /**
    * Return the nearest entanglement site for two qubit in the storage zone
    * based on the position of two qubits
    */
   auto nearestEntanglementSite(const SLM& idx1, std::size_t r1, std::size_t c1,
                                const SLM& idx2, std::size_t r2,
-                               std::size_t c2) const -> const
-      std::tuple<std::reference_wrapper<const SLM>, std::size_t, std::size_t>&;
+                               std::size_t c2) const -> Site;
+  /**
+   * @brief Return the nearest entanglement site for two storage sites.
+   * @details In contrast to the nearest storage site, the result is computed
+   * on demand in time linear in the number of entanglement SLMs, which avoids
+   * precomputing a table over all pairs of storage sites.
+   * @see nearestEntanglementSite
+   */
+  [[nodiscard]] auto nearestEntanglementSiteId(SiteId site1,
+                                               SiteId site2) const -> SiteId;
   /**
    * Return the maximum/sum of the distance to move two qubits to one rydberg
    * site. If the two qubits are in the same row, i.e., can be picked up
@@ -317,19 +395,77 @@ public:
                                        std::size_t c1, const SLM& slm2,
                                        std::size_t r2, std::size_t c2) const
       -> double;
+  /// @returns the total number of sites in all SLMs of the architecture
+  [[nodiscard]] auto getNumberOfSites() const -> SiteId { return nSites_; }
+  /**
+   * @returns the number of storage sites, i.e., the storage sites have the ids
+   * from 0 up to but excluding this number
+   */
+  [[nodiscard]] auto getNumberOfStorageSites() const -> SiteId {
+    return nStorageSites_;
+  }
+  /**
+   * @brief Returns the unique id of the given site.
+   * @details The sites of every SLM are numbered consecutively row by row
+   * starting from the first site id of the SLM. Storage SLMs come first,
+   * followed by the entanglement SLMs.
+   */
+  [[nodiscard]] auto getSiteId(const SLM& slm, const std::size_t r,
+                               const std::size_t c) const -> SiteId {
+    return slm.firstSiteId_ + static_cast<SiteId>((r * slm.nCols) + c);
+  }
+  /// @see getSiteId(const SLM&, std::size_t, std::size_t)
+  [[nodiscard]] auto getSiteId(const Site& site) const -> SiteId {
+    const auto& [slm, r, c] = site;
+    return getSiteId(slm, r, c);
+  }
+  /// @returns the site with the given id, see @ref getSiteId
+  [[nodiscard]] auto getSite(SiteId id) const -> Site;
+  /// @returns the exact location of the site with the given id
+  [[nodiscard]] auto getSiteLocation(const SiteId id) const
+      -> const std::pair<std::size_t, std::size_t>& {
+    assert(id < nSites_);
+    return siteLocations_[id];
+  }
   /// Returns the other site of a pair of entanglement sites
   auto otherEntanglementSite(const SLM& slm, std::size_t r, std::size_t c) const
       -> std::tuple<std::reference_wrapper<const SLM>, std::size_t,
                     std::size_t>;
 
 private:
+  /**
+   * Creates an Architecture from a JSON object without any preprocessing.
+   * @param json the JSON specification
+   */
+  [[nodiscard]] static auto parseJSON(const nlohmann::json& json)
+      -> Architecture;
   /// Initialize the logger if it is not already initialized.
   static auto initializeLog() -> void;
   /**
-   * Compute the site region for entanglement zone and the nearest entanglement
-   * site for each storage site.
+   * Assign the site ids and compute the nearest storage site for each
+   * entanglement site.
    */
   auto preprocessing() -> void;
+  /**
+   * Assign the first site id to every SLM such that every site has a unique
+   * id, see @ref getSiteId, and compute the location of every site.
+   * @note this function is meant to be used in @ref preprocessing.
+   */
+  auto assignSiteIds() -> void;
+  /**
+   * Compute the nearest storage site for each entanglement site.
+   * @note this function is meant to be used in @ref preprocessing.
+   */
+  auto computeLookupTables() -> void;
+  /// @returns a fingerprint of the geometry of all SLMs
+  [[nodiscard]] auto getGeometryFingerprint() const -> std::uint64_t;
+  /**
+   * @returns the row and column of the site in @p slm that is nearest to the
+   * location (@p x, @p y)
+   */
+  [[nodiscard]] static auto nearestSiteInSLM(const SLM& slm, std::size_t x,
+                                             std::size_t y)
+      -> std::pair<std::size_t, std::size_t>;
   /**
    * In the loop, we will calculate a lower bound of the distance
    * between the entanglement site and a storage SLM. Any site in the
@@ -349,7 +485,7 @@ private:
    * minimalDistance. Among all storage SLMs, we will find the one
    * that has the minimum distance to the entanglement site, the @c
    * minimumDistance.
-   * @note those functions are meant to be used in @ref preprocessing.
+   * @note this function is used by @ref nearestEntanglementSiteId.
    */
   [[nodiscard]] auto findNearestEntanglementSLM(size_t x, size_t y,
                                                 size_t otherX,
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2023 - 2025 Chair for Design Automation, TUM
+ * Copyright (c) 2025 Munich Quantum Software Company GmbH
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace na::zoned {
+/**
+ * @brief A blocking first-in-first-out queue with a fixed capacity that
+ * connects two stages of the pipelined compiler running on different threads.
+ * @details The producer blocks in @ref push while the queue is full and the
+ * consumer blocks in @ref pop while the queue is empty. After the queue is
+ * closed, @ref push discards all items and @ref pop returns the remaining
+ * items followed by `std::nullopt`.
+ * @tparam T is the type of the items
+ */
+template <class T> class BoundedQueue {
+  std::deque<T> items_;
+  size_t capacity_;
+  bool closed_ = false;
+  std::mutex mutex_;
+  std::condition_variable notFull_;
+  std::condition_variable notEmpty_;
+
+public:
+  /// Create a queue that holds at most @p capacity items
+  explicit BoundedQueue(const size_t capacity) : capacity_(capacity) {
+    assert(capacity > 0);
+  }
+
+  /**
+   * @brief Appends an item to the queue and blocks while the queue is full.
+   * @return false if the queue was closed and the item was discarded
+   */
+  auto push(T item) -> bool {
+    std::unique_lock lock(mutex_);
+    notFull_.wait(lock,
+                  [this] { return closed_ || items_.size() < capacity_; });
+    if (closed_) {
+      return false;
+    }
+    items_.emplace_back(std::move(item));
+    lock.unlock();
+    notEmpty_.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Removes the first item from the queue and blocks while the queue is
+   * empty.
+   * @return the first item or `std::nullopt` if the queue is closed and empty
+   */
+  [[nodiscard]] auto pop() -> std::optional<T> {
+    std::unique_lock lock(mutex_);
+    notEmpty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+    if (items_.empty()) {
+      return std::nullopt;
+    }
+    std::optional<T> item(std::move(items_.front()));
+    items_.pop_front();
+    lock.unlock();
+    notFull_.notify_one();
+    return item;
+  }
+
+  /**
+   * @brief Closes the queue, i.e., no further items are accepted and all
+   * blocked threads are woken up.
+   * @details The producer closes the queue after the last item, the consumer
+   * closes it to signal the producer that it stopped consuming.
+   */
+  auto close() -> void {
+    {
+      const std::lock_guard lock(mutex_);
+      closed_ = true;
+    }
+    notFull_.notify_all();
+    notEmpty_.notify_all();
+  }
+};
+} // namespace na::zoned
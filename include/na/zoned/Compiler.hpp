@@ -11,7 +11,9 @@
 #pragma once
 
 #include "Architecture.hpp"
+#include "BoundedQueue.hpp"
 #include "code_generator/CodeGenerator.hpp"
+#include "code_generator/CodeWriter.hpp"
 #include "ir/QuantumComputation.hpp"
 #include "ir/operations/Operation.hpp"
 #include "layout_synthesizer/PlaceAndRouteSynthesizer.hpp"
@@ -22,13 +24,26 @@
 #include "reuse_analyzer/VertexMatchingReuseAnalyzer.hpp"
 #include "scheduler/ASAPScheduler.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cstddef>
+#include <exception>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
+#include <span>
+#include <spdlog/logger.h>
 #include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace na::zoned {
 #define SELF (*static_cast<ConcreteType*>(this))
@@ -65,12 +80,28 @@ public:
     typename LayoutSynthesizer::Config layoutSynthesizerConfig{};
     /// Configuration for the code generator
     typename CodeGenerator::Config codeGeneratorConfig{};
-    /// Log level for the compiler
+    /**
+     * @brief Log level for the compiler
+     * @details The level only applies to the logger owned by the compiler.
+     * The global log level of spdlog is not modified.
+     */
     spdlog::level::level_enum logLevel = spdlog::level::info;
+    /**
+     * @brief If true, the layout synthesis and the code generation run as a
+     * pipeline.
+     * @details The placer runs on the calling thread while the routing and
+     * the code generation of already placed layers run on two worker threads.
+     * The result is the same as without pipelining.
+     */
+    bool pipelining = false;
+    /// The maximum number of items buffered between two stages of the pipeline
+    size_t pipelineQueueCapacity = 4;
     NLOHMANN_DEFINE_TYPE_INTRUSIVE_WITH_DEFAULT(Config, schedulerConfig,
                                                 reuseAnalyzerConfig,
                                                 layoutSynthesizerConfig,
-                                                codeGeneratorConfig, logLevel);
+                                                codeGeneratorConfig, logLevel,
+                                                pipelining,
+                                                pipelineQueueCapacity);
   };
   /**
    * Collection of statistics collected during the compilation process for the
@@ -81,8 +112,16 @@ public:
     int64_t reuseAnalysisTime; ///< Time taken for reuse analysis in us
     /// Statistics collected during layout synthesis.
     typename LayoutSynthesizer::Statistics layoutSynthesizerStatistics;
-    int64_t layoutSynthesisTime; ///< Time taken for layout synthesis in us
-    int64_t codeGenerationTime;  ///< Time taken for code generation in us
+    /**
+     * Time taken for layout synthesis in us. When pipelining, this includes
+     * the code generation that overlaps with the layout synthesis.
+     */
+    int64_t layoutSynthesisTime;
+    /**
+     * Time taken for code generation in us. When pipelining, this is only the
+     * time after the layout synthesis finished.
+     */
+    int64_t codeGenerationTime;
     int64_t totalTime;           ///< Total time taken for the compilation in us
     NLOHMANN_DEFINE_TYPE_INTRUSIVE_ONLY_SERIALIZE(Statistics, schedulingTime,
                                                   reuseAnalysisTime,
@@ -92,10 +131,28 @@ public:
                                                   totalTime);
   };
 
+  /// The result of compiling one quantum computation of a batch
+  struct BatchResult {
+    /// The compiled neutral atom computation
+    NAComputation code;
+    /// The statistics collected while compiling the quantum computation
+    Statistics statistics;
+  };
+
 private:
   std::reference_wrapper<const Architecture> architecture_;
-  nlohmann::json config_;
+  Config config_;
   Statistics statistics_;
+  /**
+   * The logger of the compiler. It writes to the sinks of the default logger
+   * but has its own log level such that several compilers with different log
+   * levels can be used at the same time.
+   */
+  std::shared_ptr<spdlog::logger> logger_;
+  /// Whether the layout synthesis and the code generation run as a pipeline
+  bool pipelining_;
+  /// The capacity of the queues between the stages of the pipeline
+  size_t pipelineQueueCapacity_;
 
   /**
    * Construct a Compiler instance with the given architecture and
@@ -109,8 +166,15 @@ private:
         ReuseAnalyzer(architecture, config.reuseAnalyzerConfig),
         LayoutSynthesizer(architecture, config.layoutSynthesizerConfig),
         CodeGenerator(architecture, config.codeGeneratorConfig),
-        architecture_(architecture), config_(config) {
-    spdlog::set_level(config.logLevel);
+        architecture_(architecture), config_(config),
+        logger_(std::make_shared<spdlog::logger>(
+            "mqt-qmap-zoned", spdlog::default_logger()->sinks().begin(),
+            spdlog::default_logger()->sinks().end())),
+        pipelining_(config.pipelining),
+        pipelineQueueCapacity_(
+            std::max<size_t>(1, config.pipelineQueueCapacity)) {
+    logger_->set_level(config.logLevel);
+    LayoutSynthesizer::setLogger(logger_);
   }
 
   /**
@@ -132,30 +196,126 @@ public:
    */
   [[nodiscard]] auto compile(const qc::QuantumComputation& qComp)
       -> NAComputation {
-    SPDLOG_INFO("*** MQT QMAP Zoned Neutral Atom Compiler ***");
+    NAComputation code;
+    NAComputationWriter writer(code);
+    compile(qComp, code, writer);
+    assert(code.validate().first);
+    return code;
+  }
+  /**
+   * @brief Compile a quantum computation and pass the resulting code to
+   * @p writer while it is generated.
+   * @details In contrast to the function above, the operations of the neutral
+   * atom computation are not kept in memory. In particular, with pipelining
+   * enabled, every layer is written as soon as it is routed.
+   * @param qComp is the quantum computation to compile.
+   * @param writer receives the compiled code.
+   */
+  auto compile(const qc::QuantumComputation& qComp, CodeWriter& writer)
+      -> void {
+    // the header only holds the zones and atoms the operations refer to
+    NAComputation header;
+    compile(qComp, header, writer);
+  }
+  /**
+   * @brief Compile several quantum computations in parallel.
+   * @details Every worker thread constructs its own compiler with the
+   * architecture and the configuration of this compiler, i.e., the jobs do not
+   * share any mutable state. The architecture including its precomputed lookup
+   * tables is shared by all workers and only read. In contrast to @ref
+   * compile, this function does not modify this compiler and, hence, may be
+   * called concurrently from several threads.
+   * @param circuits are the quantum computations to compile
+   * @param nThreads is the maximum number of worker threads, 0 means the
+   * number of hardware threads
+   * @return the code and the statistics of every quantum computation in the
+   * same order as the quantum computations
+   * @throws the first exception thrown while compiling any of the quantum
+   * computations, the remaining jobs are not started anymore
+   */
+  [[nodiscard]] auto
+  compileBatch(const std::span<const qc::QuantumComputation> circuits,
+               size_t nThreads = 0) const -> std::vector<BatchResult> {
+    std::vector<BatchResult> results(circuits.size());
+    if (nThreads == 0) {
+      nThreads = std::thread::hardware_concurrency();
+    }
+    nThreads = std::clamp<size_t>(nThreads, 1,
+                                  std::max<size_t>(1, circuits.size()));
+    std::atomic<size_t> nextJob = 0;
+    std::atomic<bool> failed = false;
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    const auto work = [this, &circuits, &results, &nextJob, &failed, &error,
+                       &errorMutex]() {
+      try {
+        ConcreteType compiler(architecture_.get(), config_);
+        for (auto job = nextJob++; job < circuits.size() && !failed;
+             job = nextJob++) {
+          results[job].code = compiler.compile(circuits[job]);
+          results[job].statistics = compiler.getStatistics();
+        }
+      } catch (...) {
+        const std::lock_guard lock(errorMutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        failed = true;
+      }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(nThreads - 1);
+    for (size_t i = 1; i < nThreads; ++i) {
+      workers.emplace_back(work);
+    }
+    // the calling thread is the last worker
+    work();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    return results;
+  }
+  /// @return the statistics collected during the compilation process.
+  [[nodiscard]] auto getStatistics() const -> const Statistics& {
+    return statistics_;
+  }
+
+private:
+  /**
+   * Compile a quantum computation, create the zones and the atoms in @p code,
+   * and pass the resulting code to @p writer.
+   */
+  auto compile(const qc::QuantumComputation& qComp, NAComputation& code,
+               CodeWriter& writer) -> void {
+    SPDLOG_LOGGER_INFO(logger_, "*** MQT QMAP Zoned Neutral Atom Compiler ***");
 #if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
-    if (spdlog::should_log(spdlog::level::debug)) {
-      SPDLOG_DEBUG("Used compiler settings:");
-      std::string jsonStr =
-          config_.dump(2); // Pretty-print with 2-space indentation
+    if (logger_->should_log(spdlog::level::debug)) {
+      SPDLOG_LOGGER_DEBUG(logger_, "Used compiler settings:");
+      // Pretty-print with 2-space indentation
+      std::string jsonStr = nlohmann::json(config_).dump(2);
       std::istringstream iss(jsonStr);
       std::string line;
       while (std::getline(iss, line)) {
-        SPDLOG_DEBUG(line);
+        SPDLOG_LOGGER_DEBUG(logger_, line);
       }
-      SPDLOG_DEBUG("Number of qubits: {}", qComp.getNqubits());
+      SPDLOG_LOGGER_DEBUG(logger_, "Number of qubits: {}", qComp.getNqubits());
       const auto nTwoQubitGates = static_cast<size_t>(
           std::count_if(qComp.cbegin(), qComp.cend(),
                         [](const std::unique_ptr<qc::Operation>& op) {
                           return op->getNqubits() == 2;
                         }));
-      SPDLOG_DEBUG("Number of two-qubit gates: {}", nTwoQubitGates);
+      SPDLOG_LOGGER_DEBUG(logger_, "Number of two-qubit gates: {}",
+                          nTwoQubitGates);
       const auto nSingleQubitGates = static_cast<size_t>(
           std::count_if(qComp.cbegin(), qComp.cend(),
                         [](const std::unique_ptr<qc::Operation>& op) {
                           return op->getNqubits() == 1;
                         }));
-      SPDLOG_DEBUG("Number of single-qubit gates: {}", nSingleQubitGates);
+      SPDLOG_LOGGER_DEBUG(logger_, "Number of single-qubit gates: {}",
+                          nSingleQubitGates);
     }
 #endif // SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
 
@@ -168,26 +328,32 @@ public:
     const auto& schedulingEnd = std::chrono::system_clock::now();
     const auto& reuseQubits = SELF.analyzeReuse(twoQubitGateLayers);
     const auto& reuseAnalysisEnd = std::chrono::system_clock::now();
-    const auto& [placement, routing] = LayoutSynthesizer::synthesize(
-        qComp.getNqubits(), twoQubitGateLayers, reuseQubits);
-    const auto& layoutSynthesisEnd = std::chrono::system_clock::now();
-    NAComputation code =
-        SELF.generate(singleQubitGateLayers, placement, routing);
+    std::chrono::system_clock::time_point layoutSynthesisEnd;
+    if (pipelining_) {
+      synthesizeAndGenerate(qComp.getNqubits(), singleQubitGateLayers,
+                            twoQubitGateLayers, reuseQubits, code, writer,
+                            layoutSynthesisEnd);
+    } else {
+      const auto& [placement, routing] = LayoutSynthesizer::synthesize(
+          qComp.getNqubits(), twoQubitGateLayers, reuseQubits);
+      layoutSynthesisEnd = std::chrono::system_clock::now();
+      SELF.generate(singleQubitGateLayers, placement, routing, code, writer);
+    }
     const auto& codeGenerationEnd = std::chrono::system_clock::now();
-    assert(code.validate().first);
 
     statistics_.schedulingTime =
         std::chrono::duration_cast<std::chrono::microseconds>(schedulingEnd -
                                                               schedulingStart)
             .count();
-    SPDLOG_INFO("Time for scheduling: {}us", statistics_.schedulingTime);
+    SPDLOG_LOGGER_INFO(logger_, "Time for scheduling: {}us",
+                       statistics_.schedulingTime);
 #if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
-    SPDLOG_DEBUG("Number of single-qubit gate layers: {}",
-                 singleQubitGateLayers.size());
-    SPDLOG_DEBUG("Number of two-qubit gate layers: {}",
-                 twoQubitGateLayers.size());
+    SPDLOG_LOGGER_DEBUG(logger_, "Number of single-qubit gate layers: {}",
+                        singleQubitGateLayers.size());
+    SPDLOG_LOGGER_DEBUG(logger_, "Number of two-qubit gate layers: {}",
+                        twoQubitGateLayers.size());
     if (!twoQubitGateLayers.empty() &&
-        spdlog::should_log(spdlog::level::debug)) {
+        logger_->should_log(spdlog::level::debug)) {
       const auto& [min, sum, max] = std::accumulate(
           twoQubitGateLayers.cbegin(), twoQubitGateLayers.cend(),
           std::array<size_t, 3>{std::numeric_limits<size_t>::max(), 0UL, 0UL},
@@ -198,7 +364,8 @@ public:
           });
       const auto avg = static_cast<double>(sum) /
                        static_cast<double>(twoQubitGateLayers.size());
-      SPDLOG_DEBUG(
+      SPDLOG_LOGGER_DEBUG(
+          logger_,
           "Number of two-qubit gates per layer: min: {}, avg: {}, max: {}", min,
           avg, max);
     }
@@ -207,31 +374,113 @@ public:
         std::chrono::duration_cast<std::chrono::microseconds>(reuseAnalysisEnd -
                                                               schedulingEnd)
             .count();
-    SPDLOG_INFO("Time for reuse analysis: {}us", statistics_.reuseAnalysisTime);
+    SPDLOG_LOGGER_INFO(logger_, "Time for reuse analysis: {}us",
+                       statistics_.reuseAnalysisTime);
     statistics_.layoutSynthesisTime =
         std::chrono::duration_cast<std::chrono::microseconds>(
             layoutSynthesisEnd - reuseAnalysisEnd)
             .count();
     statistics_.layoutSynthesizerStatistics =
         SELF.getLayoutSynthesisStatistics();
-    SPDLOG_INFO("Time for layout synthesis: {}us",
-                statistics_.layoutSynthesisTime);
+    SPDLOG_LOGGER_INFO(logger_, "Time for layout synthesis: {}us",
+                       statistics_.layoutSynthesisTime);
     statistics_.codeGenerationTime =
         std::chrono::duration_cast<std::chrono::microseconds>(
             codeGenerationEnd - layoutSynthesisEnd)
             .count();
-    SPDLOG_INFO("Time for code generation: {}us",
-                statistics_.codeGenerationTime);
+    SPDLOG_LOGGER_INFO(logger_, "Time for code generation: {}us",
+                       statistics_.codeGenerationTime);
     statistics_.totalTime =
         std::chrono::duration_cast<std::chrono::microseconds>(
             codeGenerationEnd - schedulingStart)
             .count();
-    SPDLOG_INFO("Total time: {}us", statistics_.totalTime);
-    return code;
+    SPDLOG_LOGGER_INFO(logger_, "Total time: {}us", statistics_.totalTime);
   }
-  /// @return the statistics collected during the compilation process.
-  [[nodiscard]] auto getStatistics() const -> const Statistics& {
-    return statistics_;
+  /**
+   * @brief Runs the layout synthesis and the code generation as a pipeline.
+   * @details The layout synthesizer places the layers on the calling thread
+   * and routes them on a worker thread. Every routed transition is passed via
+   * a bounded queue to a second worker thread that writes the corresponding
+   * operations as soon as both transitions of a two-qubit gate layer are
+   * known.
+   * @param nQubits is the number of qubits
+   * @param singleQubitGateLayers are the single-qubit gate layers
+   * @param twoQubitGateLayers are the two-qubit gate layers
+   * @param reuseQubits are the qubits reused between the two-qubit gate layers
+   * @param code receives the zones and the atoms
+   * @param writer receives the generated code
+   * @param layoutSynthesisEnd is set to the time when the layout synthesis
+   * finished
+   */
+  auto synthesizeAndGenerate(
+      const size_t nQubits,
+      const std::vector<SingleQubitGateLayer>& singleQubitGateLayers,
+      const std::vector<TwoQubitGateLayer>& twoQubitGateLayers,
+      const std::vector<std::unordered_set<qc::Qubit>>& reuseQubits,
+      NAComputation& code, CodeWriter& writer,
+      std::chrono::system_clock::time_point& layoutSynthesisEnd) -> void {
+    // a transition consists of the routing and the placement reached by it
+    BoundedQueue<std::pair<Routing, Placement>> transitions(
+        pipelineQueueCapacity_);
+    std::exception_ptr codeGenerationError;
+    std::thread generator([this, &transitions, &code, &writer,
+                           &codeGenerationError, &singleQubitGateLayers]() {
+      try {
+        if (auto initial = transitions.pop();
+            initial.has_value() && !singleQubitGateLayers.empty()) {
+          const auto& context =
+              SELF.initializeCode(initial->second, code, writer);
+          SELF.appendSingleQubitGateLayer(
+              context, singleQubitGateLayers.front(), writer);
+          auto current = std::move(initial->second);
+          for (size_t layer = 1; layer < singleQubitGateLayers.size();
+               ++layer) {
+            auto execution = transitions.pop();
+            auto target = transitions.pop();
+            if (!execution.has_value() || !target.has_value()) {
+              // the layout synthesis stopped early
+              break;
+            }
+            SELF.appendTwoQubitGateLayer(context, current, execution->first,
+                                         execution->second, target->first,
+                                         target->second, writer);
+            SELF.appendSingleQubitGateLayer(
+                context, singleQubitGateLayers[layer], writer);
+            current = std::move(target->second);
+          }
+        } else if (initial.has_value()) {
+          std::ignore = SELF.initializeCode(initial->second, code, writer);
+        }
+      } catch (...) {
+        codeGenerationError = std::current_exception();
+      }
+      // signals the layout synthesis to stop in case the code generation
+      // stopped early
+      transitions.close();
+    });
+    try {
+      std::ignore = LayoutSynthesizer::synthesize(
+          nQubits, twoQubitGateLayers, reuseQubits, pipelineQueueCapacity_,
+          [&transitions](const Routing& routing, const Placement& placement) {
+            if (!transitions.push({routing, placement})) {
+              throw std::runtime_error(
+                  "Code generation stopped before all layers were generated.");
+            }
+          });
+    } catch (...) {
+      transitions.close();
+      generator.join();
+      if (codeGenerationError) {
+        std::rethrow_exception(codeGenerationError);
+      }
+      throw;
+    }
+    layoutSynthesisEnd = std::chrono::system_clock::now();
+    transitions.close();
+    generator.join();
+    if (codeGenerationError) {
+      std::rethrow_exception(codeGenerationError);
+    }
   }
 };
 
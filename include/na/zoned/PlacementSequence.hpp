@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2023 - 2025 Chair for Design Automation, TUM
+ * Copyright (c) 2025 Munich Quantum Software Company GmbH
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "ir/Definitions.hpp"
+#include "na/zoned/Architecture.hpp"
+#include "na/zoned/Types.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace na::zoned {
+/**
+ * @brief A compact representation of a sequence of placements.
+ * @details Instead of storing every placement in full, i.e., one @ref Site of
+ * 24 bytes per atom, only the atoms that change their site w.r.t. the previous
+ * placement are stored together with their new site encoded as 32-bit
+ * @ref SiteId. Since most atoms stay at their site between two consecutive
+ * placements, this reduces the memory consumption considerably. To allow for
+ * random access, every k-th placement is additionally stored in full as site
+ * ids, where k is the checkpoint interval passed to the constructor. A full
+ * placement is only materialized on demand.
+ * @par
+ * Consumers that process the placements in order, e.g., the router and the
+ * code generator, keep one materialized placement and update it with
+ * @ref applyMoves, which only takes time linear in the number of moved atoms.
+ */
+class PlacementSequence {
+public:
+  /// An atom that changes its site between two consecutive placements
+  struct Move {
+    qc::Qubit atom; ///< The atom that is moved
+    SiteId site;    ///< The site of the atom in the later placement
+    [[nodiscard]] auto operator==(const Move& other) const -> bool = default;
+  };
+
+private:
+  /// The architecture the site ids refer to
+  std::reference_wrapper<const Architecture> architecture_;
+  /// The distance between two placements that are stored in full
+  size_t checkpointInterval_;
+  /// The number of placements in the sequence
+  size_t size_ = 0;
+  /// Every checkpointInterval_-th placement stored in full
+  std::vector<std::vector<SiteId>> checkpoints_;
+  /**
+   * The moves of all placements. The moves leading to the i-th placement are
+   * stored in the range from `moveOffsets_[i - 1]` to `moveOffsets_[i]`.
+   */
+  std::vector<Move> moves_;
+  /// The offsets of the moves of every placement in @ref moves_
+  std::vector<size_t> moveOffsets_;
+  /// The last placement kept in full such that appending is cheap
+  std::vector<SiteId> back_;
+
+public:
+  /**
+   * Create an empty sequence of placements.
+   * @param architecture is the architecture the placements refer to
+   * @param checkpointInterval is the distance between two placements that are
+   * stored in full, it trades memory for the time of random access
+   */
+  explicit PlacementSequence(const Architecture& architecture,
+                             size_t checkpointInterval = 64);
+
+  /// Create a sequence from the given placements
+  PlacementSequence(const Architecture& architecture,
+                    const std::vector<Placement>& placements,
+                    size_t checkpointInterval = 64);
+
+  /**
+   * Append a placement to the sequence.
+   * @details Only the atoms whose site differs from the previous placement
+   * are stored.
+   * @param placement is the placement to append, it must contain the same
+   * number of atoms as the previous placements
+   */
+  auto append(const Placement& placement) -> void;
+
+  /// @returns the number of placements in the sequence
+  [[nodiscard]] auto size() const -> size_t { return size_; }
+
+  /// @returns true if the sequence does not contain any placement
+  [[nodiscard]] auto empty() const -> bool { return size_ == 0; }
+
+  /// @returns the number of atoms in every placement
+  [[nodiscard]] auto getNumberOfAtoms() const -> size_t {
+    return back_.size();
+  }
+
+  /**
+   * @returns the atoms that changed their site between the placements @p i - 1
+   * and @p i together with their new site. For the first placement, no moves
+   * are returned.
+   */
+  [[nodiscard]] auto getMoves(size_t i) const -> std::span<const Move>;
+
+  /**
+   * @brief Updates @p placement from the placement @p i - 1 to the placement
+   * @p i of this sequence.
+   * @details This takes time linear in the number of moved atoms.
+   */
+  auto applyMoves(size_t i, Placement& placement) const -> void;
+
+  /// @returns the site ids of all atoms in the placement @p i
+  [[nodiscard]] auto getSiteIds(size_t i) const -> std::vector<SiteId>;
+
+  /// @returns the placement @p i materialized in full
+  [[nodiscard]] auto getPlacement(size_t i) const -> Placement;
+
+  /// @returns the first placement materialized in full
+  [[nodiscard]] auto front() const -> Placement { return getPlacement(0); }
+
+  /// @returns the last placement materialized in full
+  [[nodiscard]] auto back() const -> Placement;
+
+  /// @returns all placements materialized in full
+  [[nodiscard]] auto toVector() const -> std::vector<Placement>;
+
+  /// @returns the memory occupied by the sequence in bytes
+  [[nodiscard]] auto getMemory() const -> size_t;
+};
+} // namespace na::zoned
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2023 - 2025 Chair for Design Automation, TUM
+ * Copyright (c) 2025 Munich Quantum Software Company GmbH
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace na::zoned {
+/**
+ * @brief Whether the fine-grained profiling counters of the zoned neutral atom
+ * compiler are collected.
+ * @details The counters are enabled by the CMake option
+ * `MQT_QMAP_ZONED_PROFILING`. All code collecting them is guarded by
+ * `if constexpr (PROFILING)` such that it is removed entirely when the option
+ * is disabled. The corresponding entries in the statistics are then empty.
+ */
+#ifdef MQT_QMAP_ZONED_PROFILING
+constexpr bool PROFILING = true;
+#else
+constexpr bool PROFILING = false;
+#endif
+
+/**
+ * @brief Adds the time elapsed between its construction and its destruction
+ * in microseconds to a counter.
+ * @details If profiling is disabled, the timer does nothing.
+ */
+class ProfilingTimer {
+  /// The counter the elapsed time is added to
+  int64_t* counter_;
+  /// The time when the timer was constructed
+  std::chrono::steady_clock::time_point start_;
+
+public:
+  /// Creates a timer that adds the elapsed time to @p counter
+  explicit ProfilingTimer(int64_t& counter) : counter_(&counter) {
+    if constexpr (PROFILING) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+  ProfilingTimer(const ProfilingTimer&) = delete;
+  ProfilingTimer(ProfilingTimer&&) = delete;
+  auto operator=(const ProfilingTimer&) -> ProfilingTimer& = delete;
+  auto operator=(ProfilingTimer&&) -> ProfilingTimer& = delete;
+  ~ProfilingTimer() {
+    if constexpr (PROFILING) {
+      *counter_ += std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::steady_clock::now() - start_)
+                       .count();
+    }
+  }
+};
+} // namespace na::zoned
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2023 - 2025 Chair for Design Automation, TUM
+ * Copyright (c) 2025 Munich Quantum Software Company GmbH
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "na/zoned/Architecture.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace na::zoned {
+/**
+ * @brief A spatial index over a consecutive range of sites of an architecture,
+ * e.g., all storage sites, that supports nearest neighbor queries.
+ * @details The bounding box of the sites is divided into a uniform grid of
+ * square cells such that every cell contains about one site. Every cell keeps
+ * the sites of the index that lie within it. Sites are inserted and removed
+ * in constant time, which allows keeping, e.g., the set of free sites up to
+ * date while atoms move. A query only visits the cells around the query
+ * location and, hence, takes time independent of the size of the zone as
+ * long as the sites in the index are not too sparse.
+ */
+class SiteIndex {
+  /// The architecture the site ids refer to
+  std::reference_wrapper<const Architecture> architecture_;
+  /// The first site id covered by the index
+  SiteId firstSite_;
+  /// The site id after the last site covered by the index
+  SiteId lastSite_;
+  /// The minimal x- and y-coordinate of all covered sites
+  std::size_t minX_ = 0;
+  std::size_t minY_ = 0;
+  /// The side length of a cell
+  std::size_t cellSize_ = 1;
+  /// The number of cells in x- and y-direction
+  std::size_t nCellsX_ = 1;
+  std::size_t nCellsY_ = 1;
+  /// The sites contained in every cell stored row by row
+  std::vector<std::vector<SiteId>> cells_;
+  /// The cell of every covered site
+  std::vector<std::uint32_t> cellOfSite_;
+  /**
+   * The position of every covered site in its cell or @ref absent_ if the site
+   * is not contained in the index
+   */
+  std::vector<std::uint32_t> positionInCell_;
+  /// The number of sites contained in the index
+  std::size_t size_ = 0;
+
+  constexpr static auto absent_ = static_cast<std::uint32_t>(-1);
+
+public:
+  /**
+   * Create an empty index that covers the sites with ids from @p firstSite up
+   * to but excluding @p lastSite.
+   */
+  SiteIndex(const Architecture& architecture, SiteId firstSite,
+            SiteId lastSite);
+
+  /**
+   * Inserts a site into the index.
+   * @returns false if the site was already contained
+   */
+  auto insert(SiteId site) -> bool;
+
+  /**
+   * Removes a site from the index.
+   * @returns false if the site was not contained
+   */
+  auto erase(SiteId site) -> bool;
+
+  /// Inserts all covered sites into the index
+  auto fill() -> void;
+
+  /// @returns true if the site is covered by and contained in the index
+  [[nodiscard]] auto contains(SiteId site) const -> bool;
+
+  /// @returns true if the site id lies in the range covered by the index
+  [[nodiscard]] auto covers(const SiteId site) const -> bool {
+    return site >= firstSite_ && site < lastSite_;
+  }
+
+  /// @returns the number of sites contained in the index
+  [[nodiscard]] auto size() const -> std::size_t { return size_; }
+
+  /// @returns true if the index does not contain any site
+  [[nodiscard]] auto empty() const -> bool { return size_ == 0; }
+
+  /**
+   * @returns the @p k sites of the index closest to the location (@p x, @p y)
+   * in increasing order of their distance, ties are broken by the site id. If
+   * the index contains fewer sites, all of them are returned.
+   */
+  [[nodiscard]] auto nearest(std::size_t x, std::size_t y, std::size_t k) const
+      -> std::vector<SiteId>;
+
+  /**
+   * @returns all sites of the index whose distance to the location (@p x,
+   * @p y) is at most @p radius in increasing order of their distance, ties are
+   * broken by the site id
+   */
+  [[nodiscard]] auto withinRadius(std::size_t x, std::size_t y,
+                                  double radius) const -> std::vector<SiteId>;
+
+private:
+  /// @returns the cell in x-direction of the given x-coordinate
+  [[nodiscard]] auto cellX(std::size_t x) const -> std::size_t;
+  /// @returns the cell in y-direction of the given y-coordinate
+  [[nodiscard]] auto cellY(std::size_t y) const -> std::size_t;
+  /// @returns the distance of a site to the location (@p x, @p y)
+  [[nodiscard]] auto distance(SiteId site, std::size_t x, std::size_t y) const
+      -> double;
+};
+} // namespace na::zoned
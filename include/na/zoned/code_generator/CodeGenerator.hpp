@@ -14,9 +14,12 @@
 #include "na/entities/Atom.hpp"
 #include "na/entities/Zone.hpp"
 #include "na/zoned/Architecture.hpp"
+#include "na/zoned/PlacementSequence.hpp"
 #include "na/zoned/Types.hpp"
+#include "na/zoned/code_generator/CodeWriter.hpp"
 
 #include <cstddef>
+#include <functional>
 #include <vector>
 
 namespace na::zoned {
@@ -73,12 +76,106 @@ public:
            const std::vector<Placement>& placement,
            const std::vector<Routing>& routing) const -> NAComputation;
 
+  /**
+   * Same as the function above but for a delta-encoded sequence of placements.
+   * @details Every placement is materialized only when its layer is generated
+   * by applying the moves to the previous placement.
+   */
+  [[nodiscard]] auto
+  generate(const std::vector<SingleQubitGateLayer>& singleQubitGateLayers,
+           const PlacementSequence& placement,
+           const std::vector<Routing>& routing) const -> NAComputation;
+
+  /**
+   * @brief Same as the function above but instead of building a neutral atom
+   * computation, the code is passed to @p writer while it is generated.
+   * @details Only the zones and the atoms are kept in memory, every operation
+   * is passed to the writer as soon as it is generated and not stored
+   * afterward.
+   */
+  auto generate(const std::vector<SingleQubitGateLayer>& singleQubitGateLayers,
+                const std::vector<Placement>& placement,
+                const std::vector<Routing>& routing, CodeWriter& writer) const
+      -> void;
+
+  /// Same as the function above but for a delta-encoded sequence of placements
+  auto generate(const std::vector<SingleQubitGateLayer>& singleQubitGateLayers,
+                const PlacementSequence& placement,
+                const std::vector<Routing>& routing, CodeWriter& writer) const
+      -> void;
+
+  /**
+   * Same as the function above but the zones and the atoms are created in
+   * @p code. Together with a NAComputationWriter appending to @p code, this
+   * yields the same computation as the first overload.
+   */
+  auto generate(const std::vector<SingleQubitGateLayer>& singleQubitGateLayers,
+                const std::vector<Placement>& placement,
+                const std::vector<Routing>& routing, NAComputation& code,
+                CodeWriter& writer) const -> void;
+
+  /// Same as the function above but for a delta-encoded sequence of placements
+  auto generate(const std::vector<SingleQubitGateLayer>& singleQubitGateLayers,
+                const PlacementSequence& placement,
+                const std::vector<Routing>& routing, NAComputation& code,
+                CodeWriter& writer) const -> void;
+
+  /**
+   * The zones and atoms created at the beginning of the code generation that
+   * all further operations refer to.
+   */
+  struct Context {
+    /// The atoms in the order of the qubits they represent
+    std::vector<std::reference_wrapper<const Atom>> atoms;
+    /// The zones in which the rydberg beam acts
+    std::vector<std::reference_wrapper<const Zone>> rydbergZones;
+    /// The zone spanning all storage zones used for global gates
+    const Zone* globalZone = nullptr;
+  };
+
+  /**
+   * @brief Creates the zones and the atoms at their initial locations and
+   * writes them as the header of the code.
+   * @details Together with @ref appendSingleQubitGateLayer and
+   * @ref appendTwoQubitGateLayer, this allows generating the code layer by
+   * layer as soon as the placement and routing of a layer are known. Calling
+   * these functions in the order of the layers yields the same code as
+   * @ref generate.
+   * @param initialPlacement is the initial placement of the atoms
+   * @param code is the neutral atom computation the zones and atoms are added
+   * to
+   * @param writer receives the header of the code
+   * @return the context required for appending the layers
+   */
+  [[nodiscard]] auto initializeCode(const Placement& initialPlacement,
+                                    NAComputation& code,
+                                    CodeWriter& writer) const -> Context;
+
+  /// Write all single-qubit gates of a layer
+  auto appendSingleQubitGateLayer(const Context& context,
+                                  const SingleQubitGateLayer& singleQubitGates,
+                                  CodeWriter& writer) const -> void;
+
+  /**
+   * @brief Write all operations to execute one layer of two-qubit gates.
+   * @details The atoms are moved from @p currentPlacement to @p
+   * executionPlacement, the gates are executed, and the atoms are moved to
+   * @p targetPlacement.
+   */
+  auto appendTwoQubitGateLayer(const Context& context,
+                               const Placement& currentPlacement,
+                               const Routing& executionRouting,
+                               const Placement& executionPlacement,
+                               const Routing& targetRouting,
+                               const Placement& targetPlacement,
+                               CodeWriter& writer) const -> void;
+
 private:
   /// Append all single-qubit gates of a layer to the code
   auto appendSingleQubitGates(
       size_t nQubits, const SingleQubitGateLayer& singleQubitGates,
       const std::vector<std::reference_wrapper<const Atom>>& atoms,
-      const Zone& globalZone, NAComputation& code) const -> void;
+      const Zone& globalZone, CodeWriter& writer) const -> void;
 
   /// Append all necessary operations to perform the next set of two-qubit gates
   auto appendTwoQubitGates(
@@ -87,13 +184,13 @@ private:
       const Placement& targetPlacement,
       const std::vector<std::reference_wrapper<const Atom>>& atoms,
       const std::vector<std::reference_wrapper<const Zone>>& zones,
-      NAComputation& code) const -> void;
+      CodeWriter& writer) const -> void;
 
   /// Append all necessary operations to rearrange the atoms
   auto appendRearrangement(
       const Placement& startPlacement, const Routing& routing,
       const Placement& targetPlacement,
       const std::vector<std::reference_wrapper<const Atom>>& atoms,
-      NAComputation& code) const -> void;
+      CodeWriter& writer) const -> void;
 };
 } // namespace na::zoned
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2023 - 2025 Chair for Design Automation, TUM
+ * Copyright (c) 2025 Munich Quantum Software Company GmbH
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "na/NAComputation.hpp"
+#include "na/entities/Atom.hpp"
+#include "na/entities/Location.hpp"
+#include "na/entities/Zone.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace na::zoned {
+/// The zones and atoms all operations of the generated code refer to
+struct CodeHeader {
+  /// The atoms in the order of the qubits they represent
+  std::vector<std::reference_wrapper<const Atom>> atoms;
+  /// The initial locations of the atoms in the same order
+  std::vector<Location> initialLocations;
+  /// All zones in the order they were created
+  std::vector<std::reference_wrapper<const Zone>> zones;
+  /// The extents of the zones in the same order
+  std::vector<Zone::Extent> zoneExtents;
+};
+
+/**
+ * The class CodeWriter is the interface of all sinks the CodeGenerator can emit
+ * the generated code to.
+ * @details First, the header, i.e., the zones and the atoms at their initial
+ * locations, is written. Afterward, the operations are written one after the
+ * other in the order of their execution. This allows writing the code while it
+ * is generated without keeping the complete program in memory.
+ */
+class CodeWriter {
+public:
+  virtual ~CodeWriter() = default;
+  /**
+   * Write the zones and the atoms at their initial locations.
+   * @param code is the neutral atom computation that contains the zones and
+   * the atoms but no operations. All further operations refer to those.
+   * @param header lists the zones and the atoms contained in @p code
+   */
+  virtual auto writeHeader(const NAComputation& code, const CodeHeader& header)
+      -> void = 0;
+  /// Write a load operation of the given atoms
+  virtual auto writeLoad(const std::vector<const Atom*>& atoms) -> void = 0;
+  /// Write a move operation of the given atoms to the target locations
+  virtual auto writeMove(const std::vector<const Atom*>& atoms,
+                         const std::vector<Location>& targetLocations)
+      -> void = 0;
+  /// Write a store operation of the given atoms
+  virtual auto writeStore(const std::vector<const Atom*>& atoms) -> void = 0;
+  /// Write a global CZ operation, i.e., a rydberg pulse in the given zones
+  virtual auto writeGlobalCZ(const std::vector<const Zone*>& zones)
+      -> void = 0;
+  /// Write a global RY operation in the given zone
+  virtual auto writeGlobalRY(const Zone& zone, double angle) -> void = 0;
+  /// Write a local RZ operation on the given atom
+  virtual auto writeLocalRZ(const Atom& atom, double angle) -> void = 0;
+  /// Write a local U3 operation on the given atom
+  virtual auto writeLocalU(const Atom& atom, double theta, double phi,
+                           double lambda) -> void = 0;
+};
+
+/**
+ * The class NAComputationWriter appends all operations to a neutral atom
+ * computation.
+ * @details This writer is used to obtain the generated code as one
+ * NAComputation object. The header must be the computation itself, i.e., the
+ * zones and the atoms must already be contained in it.
+ */
+class NAComputationWriter final : public CodeWriter {
+  /// The neutral atom computation the operations are appended to
+  std::reference_wrapper<NAComputation> code_;
+
+public:
+  /// Create a new NAComputationWriter that appends to @p code
+  explicit NAComputationWriter(NAComputation& code) : code_(code) {}
+  auto writeHeader(const NAComputation& code, const CodeHeader& header)
+      -> void override;
+  auto writeLoad(const std::vector<const Atom*>& atoms) -> void override;
+  auto writeMove(const std::vector<const Atom*>& atoms,
+                 const std::vector<Location>& targetLocations)
+      -> void override;
+  auto writeStore(const std::vector<const Atom*>& atoms) -> void override;
+  auto writeGlobalCZ(const std::vector<const Zone*>& zones) -> void override;
+  auto writeGlobalRY(const Zone& zone, double angle) -> void override;
+  auto writeLocalRZ(const Atom& atom, double angle) -> void override;
+  auto writeLocalU(const Atom& atom, double theta, double phi, double lambda)
+      -> void override;
+};
+
+/**
+ * The class TextCodeWriter writes the code in the `.naviz` format, i.e., the
+ * same format as NAComputation::toString.
+ * @details Every operation is written as one chunk that ends with a newline.
+ * The chunks are either appended to an output stream, e.g., a file or a string
+ * stream, or passed to a callback.
+ */
+class TextCodeWriter final : public CodeWriter {
+  /// The function receiving the written chunks
+  std::function<void(const std::string&)> write_;
+
+public:
+  /// Create a new TextCodeWriter that writes to the output stream @p os
+  explicit TextCodeWriter(std::ostream& os);
+  /// Create a new TextCodeWriter that passes every chunk to @p callback
+  explicit TextCodeWriter(std::function<void(const std::string&)> callback)
+      : write_(std::move(callback)) {}
+  auto writeHeader(const NAComputation& code, const CodeHeader& header)
+      -> void override;
+  auto writeLoad(const std::vector<const Atom*>& atoms) -> void override;
+  auto writeMove(const std::vector<const Atom*>& atoms,
+                 const std::vector<Location>& targetLocations)
+      -> void override;
+  auto writeStore(const std::vector<const Atom*>& atoms) -> void override;
+  auto writeGlobalCZ(const std::vector<const Zone*>& zones) -> void override;
+  auto writeGlobalRY(const Zone& zone, double angle) -> void override;
+  auto writeLocalRZ(const Atom& atom, double angle) -> void override;
+  auto writeLocalU(const Atom& atom, double theta, double phi, double lambda)
+      -> void override;
+};
+
+/**
+ * The class BinaryCodeWriter writes the code in a compact binary encoding.
+ * @details All integers are unsigned and stored in little-endian byte order,
+ * all floating-point numbers are stored as IEEE 754 double precision numbers
+ * in little-endian byte order, and strings are stored as their length (u32)
+ * followed by their characters. Atoms and zones are referred to by their index
+ * (u32) in the header. The encoding is as follows:
+ * @code
+ * header       := "NAQC" version:u8
+ *                 nZones:u32 (name:str minX:f64 minY:f64 maxX:f64 maxY:f64)*
+ *                 nAtoms:u32 (name:str x:f64 y:f64)*
+ * operation    := 0x01 n:u32 atom:u32*n                   (load)
+ *               | 0x02 n:u32 (atom:u32 x:f64 y:f64)*n     (move)
+ *               | 0x03 n:u32 atom:u32*n                   (store)
+ *               | 0x04 n:u32 zone:u32*n                   (global cz)
+ *               | 0x05 zone:u32 angle:f64                 (global ry)
+ *               | 0x06 atom:u32 angle:f64                 (local rz)
+ *               | 0x07 atom:u32 theta:f64 phi:f64 lambda:f64 (local u)
+ * @endcode
+ */
+class BinaryCodeWriter final : public CodeWriter {
+public:
+  /// The opcodes of the operations in the binary encoding
+  enum class Opcode : uint8_t {
+    Load = 0x01,
+    Move = 0x02,
+    Store = 0x03,
+    GlobalCZ = 0x04,
+    GlobalRY = 0x05,
+    LocalRZ = 0x06,
+    LocalU = 0x07,
+  };
+  /// The version of the binary encoding
+  constexpr static uint8_t VERSION = 1;
+
+private:
+  /// The output stream the encoding is written to
+  std::reference_wrapper<std::ostream> os_;
+  /// The index of every atom in the header
+  std::unordered_map<const Atom*, uint32_t> atomIndices_;
+  /// The index of every zone in the header
+  std::unordered_map<const Zone*, uint32_t> zoneIndices_;
+
+  /// Write an unsigned integer in little-endian byte order
+  auto writeU32(uint32_t value) -> void;
+  /// Write a double in little-endian byte order
+  auto writeF64(double value) -> void;
+  /// Write the length of a string followed by its characters
+  auto writeString(const std::string& value) -> void;
+  /// Write an opcode
+  auto writeOpcode(Opcode opcode) -> void;
+  /// Write a list of atoms as their number followed by their indices
+  auto writeAtoms(const std::vector<const Atom*>& atoms) -> void;
+
+public:
+  /**
+   * Create a new BinaryCodeWriter.
+   * @param os is the output stream, which should be opened in binary mode
+   */
+  explicit BinaryCodeWriter(std::ostream& os) : os_(os) {}
+  auto writeHeader(const NAComputation& code, const CodeHeader& header)
+      -> void override;
+  auto writeLoad(const std::vector<const Atom*>& atoms) -> void override;
+  auto writeMove(const std::vector<const Atom*>& atoms,
+                 const std::vector<Location>& targetLocations)
+      -> void override;
+  auto writeStore(const std::vector<const Atom*>& atoms) -> void override;
+  auto writeGlobalCZ(const std::vector<const Zone*>& zones) -> void override;
+  auto writeGlobalRY(const Zone& zone, double angle) -> void override;
+  auto writeLocalRZ(const Atom& atom, double angle) -> void override;
+  auto writeLocalU(const Atom& atom, double theta, double phi, double lambda)
+      -> void override;
+};
+} // namespace na::zoned
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include "na/zoned/PlacementSequence.hpp"
 #include "na/zoned/Types.hpp"
 
 #include <unordered_set>
@@ -27,8 +28,8 @@ public:
    * Collection of the placement and routing results.
    */
   struct Layout {
-    std::vector<Placement> placement; ///< The placement of the qubits
-    std::vector<Routing> routing;     ///< The routing of the qubits
+    PlacementSequence placement;  ///< The placement of the qubits
+    std::vector<Routing> routing; ///< The routing of the qubits
   };
   /**
    * This function defines the interface of the layout synthesizer.
@@ -11,11 +11,24 @@
 #pragma once
 
 #include "LayoutSynthesizerBase.hpp"
+#include "na/zoned/Architecture.hpp"
+#include "na/zoned/BoundedQueue.hpp"
+#include "na/zoned/PlacementSequence.hpp"
+#include "na/zoned/Profiling.hpp"
 #include "na/zoned/Types.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
 #include <nlohmann/json.hpp>
+#include <spdlog/logger.h>
 #include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <thread>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace na::zoned {
@@ -36,10 +49,11 @@ namespace na::zoned {
  * methods of the placer and router.
  * @tparam Placer is the type of the placer used for placing qubits. It should
  * implement a `place` method that takes the number of qubits, two-qubit gate
- * layers, and reuse qubits, and returns a vector of `Placement` objects.
+ * layers, reuse qubits, and a callback that receives every `Placement`.
  * @tparam Router is the type of the router used for routing qubits. It should
- * implement a `route` method that takes a vector of `Placement` objects and
- * returns a vector of `Routing` objects.
+ * implement a `route` method that takes a `PlacementSequence` and an optional
+ * list for the routing time of every transition and returns a vector of
+ * `Routing` objects.
  */
 template <class ConcreteType, class Placer, class Router>
 class PlaceAndRouteSynthesizer : public LayoutSynthesizerBase,
@@ -68,13 +82,31 @@ public:
     int64_t placementTime; ///< Time taken for placement in us
     int64_t routingTime;   ///< Time taken for routing in us
     int64_t totalTime;     ///< Total time taken for the synthesis in us
+    /// Statistics collected by the placer
+    typename Placer::Statistics placerStatistics;
+    /**
+     * The number of groups of parallel moves in every transition between two
+     * placements, only collected if profiling is enabled, see @ref PROFILING
+     */
+    std::vector<size_t> routingGroups;
+    /**
+     * The time taken for routing every transition between two placements in
+     * us, only collected if profiling is enabled, see @ref PROFILING
+     */
+    std::vector<int64_t> routingTimes;
     NLOHMANN_DEFINE_TYPE_INTRUSIVE_ONLY_SERIALIZE(Statistics, placementTime,
-                                                  routingTime, totalTime);
+                                                  routingTime, totalTime,
+                                                  placerStatistics,
+                                                  routingGroups, routingTimes);
   };
 
 private:
+  /// The architecture the placements refer to
+  std::reference_wrapper<const Architecture> architecture_;
   /// The statistics collected during the synthesis process
   Statistics statistics_;
+  /// The logger used to report the timings of the synthesis process
+  std::shared_ptr<spdlog::logger> logger_ = spdlog::default_logger();
   /**
    * @brief Construct a PlaceAndRouteSynthesizer instance with the given
    * configuration.
@@ -85,7 +117,8 @@ private:
   PlaceAndRouteSynthesizer(const Architecture& architecture,
                            const Config& config)
       : Placer(architecture, config.placerConfig),
-        Router(architecture, config.routerConfig) {}
+        Router(architecture, config.routerConfig),
+        architecture_(architecture) {}
 
   /**
    * @brief Construct a PlaceAndRouteSynthesizer instance with default
@@ -97,33 +130,150 @@ private:
       : PlaceAndRouteSynthesizer(architecture, Config{}) {}
 
 public:
+  /// Set the logger used to report the timings of the synthesis process
+  auto setLogger(std::shared_ptr<spdlog::logger> logger) -> void {
+    logger_ = std::move(logger);
+  }
   [[nodiscard]] auto synthesize(
       size_t nQubits, const std::vector<TwoQubitGateLayer>& twoQubitGateLayers,
       const std::vector<std::unordered_set<qc::Qubit>>& reuseQubits) -> Layout {
     const auto& placementStart = std::chrono::system_clock::now();
-    const auto& placement =
-        SELF.place(nQubits, twoQubitGateLayers, reuseQubits);
+    // the placements are stored delta-encoded as soon as they are computed
+    PlacementSequence placement(architecture_);
+    SELF.place(nQubits, twoQubitGateLayers, reuseQubits,
+               [&placement](const Placement& next) { placement.append(next); });
     const auto& placementEnd = std::chrono::system_clock::now();
-    const auto& routing = SELF.route(placement);
+    statistics_.routingTimes.clear();
+    auto routing = SELF.route(
+        placement, PROFILING ? &statistics_.routingTimes : nullptr);
     const auto& routingEnd = std::chrono::system_clock::now();
+    statistics_.routingGroups.clear();
+    if constexpr (PROFILING) {
+      for (const auto& transition : routing) {
+        statistics_.routingGroups.emplace_back(transition.size());
+      }
+    }
 
     statistics_.placementTime =
         std::chrono::duration_cast<std::chrono::microseconds>(placementEnd -
                                                               placementStart)
             .count();
-    SPDLOG_INFO("Time for placement: {}us", statistics_.placementTime);
+    SPDLOG_LOGGER_INFO(logger_, "Time for placement: {}us",
+                       statistics_.placementTime);
+    statistics_.placerStatistics = SELF.getStatistics();
     statistics_.routingTime =
         std::chrono::duration_cast<std::chrono::microseconds>(routingEnd -
                                                               placementEnd)
             .count();
-    SPDLOG_INFO("Time for routing: {}us", statistics_.routingTime);
+    SPDLOG_LOGGER_INFO(logger_, "Time for routing: {}us",
+                       statistics_.routingTime);
+    statistics_.totalTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(routingEnd -
+                                                              placementStart)
+            .count();
+    SPDLOG_LOGGER_INFO(logger_, "Total time: {}us", statistics_.totalTime);
+
+    return {std::move(placement), std::move(routing)};
+  }
+  /**
+   * @brief Pipelined variant of the function above.
+   * @details The placement runs on the calling thread while a worker thread
+   * routes every transition between two placements as soon as both placements
+   * are known. The placements are handed over via a queue that holds at most
+   * @p queueCapacity placements. Every routed transition is passed to @p
+   * onRouting together with its target placement. The first call passes the
+   * initial placement together with an empty routing.
+   * @note @p onRouting is called on the worker thread. If it throws, the
+   * synthesis is stopped and the exception is rethrown to the caller.
+   * @tparam RoutingCallback is callable as `onRouting(const Routing&, const
+   * Placement&)`
+   */
+  template <class RoutingCallback>
+  [[nodiscard]] auto synthesize(
+      size_t nQubits, const std::vector<TwoQubitGateLayer>& twoQubitGateLayers,
+      const std::vector<std::unordered_set<qc::Qubit>>& reuseQubits,
+      const size_t queueCapacity, const RoutingCallback& onRouting) -> Layout {
+    const auto& placementStart = std::chrono::system_clock::now();
+    BoundedQueue<Placement> placements(queueCapacity);
+    PlacementSequence placement(architecture_);
+    std::vector<Routing> routing;
+    std::chrono::microseconds routingDuration{0};
+    std::exception_ptr routingError;
+    statistics_.routingGroups.clear();
+    statistics_.routingTimes.clear();
+    std::thread router([this, &placements, &placement, &routing,
+                        &routingDuration, &routingError, &onRouting]() {
+      try {
+        auto previous = placements.pop();
+        if (previous.has_value()) {
+          placement.append(*previous);
+          onRouting(Routing{}, *previous);
+          while (auto next = placements.pop()) {
+            placement.append(*next);
+            const auto& routingStart = std::chrono::system_clock::now();
+            routing.emplace_back(SELF.route(*previous, *next));
+            const auto& transitionDuration =
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::system_clock::now() - routingStart);
+            routingDuration += transitionDuration;
+            if constexpr (PROFILING) {
+              statistics_.routingGroups.emplace_back(routing.back().size());
+              statistics_.routingTimes.emplace_back(
+                  transitionDuration.count());
+            }
+            onRouting(routing.back(), *next);
+            previous = std::move(next);
+          }
+        }
+      } catch (...) {
+        routingError = std::current_exception();
+      }
+      // signals the placer to stop in case the routing stopped early
+      placements.close();
+    });
+    try {
+      SELF.place(nQubits, twoQubitGateLayers, reuseQubits,
+                 [&placements](const Placement& next) {
+                   if (!placements.push(next)) {
+                     throw std::runtime_error(
+                         "Routing stopped before all placements were routed.");
+                   }
+                 });
+    } catch (...) {
+      placements.close();
+      router.join();
+      if (routingError) {
+        std::rethrow_exception(routingError);
+      }
+      throw;
+    }
+    const auto& placementEnd = std::chrono::system_clock::now();
+    placements.close();
+    router.join();
+    if (routingError) {
+      std::rethrow_exception(routingError);
+    }
+    const auto& routingEnd = std::chrono::system_clock::now();
+
+    statistics_.placementTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(placementEnd -
+                                                              placementStart)
+            .count();
+    SPDLOG_LOGGER_INFO(logger_, "Time for placement: {}us",
+                       statistics_.placementTime);
+    statistics_.placerStatistics = SELF.getStatistics();
+    // the routing overlaps with the placement, hence, only the time spent
+    // routing is reported here
+    statistics_.routingTime = routingDuration.count();
+    SPDLOG_LOGGER_INFO(logger_, "Time for routing: {}us",
+                       statistics_.routingTime);
     statistics_.totalTime =
         std::chrono::duration_cast<std::chrono::microseconds>(routingEnd -
                                                               placementStart)
             .count();
-    SPDLOG_INFO("Total time: {}us", statistics_.totalTime);
+    SPDLOG_LOGGER_INFO(logger_, "Total time: {}us", statistics_.totalTime);
 
-    return {placement, routing};
+    return {std::move(placement), std::move(routing)};
   }
   /// @returns the statistics collected during the synthesis process.
   [[nodiscard]] auto getLayoutSynthesisStatistics() const -> const Statistics& {
@@ -12,18 +12,21 @@
 
 #include "ir/Definitions.hpp"
 #include "na/zoned/Architecture.hpp"
+#include "na/zoned/Profiling.hpp"
 #include "na/zoned/Types.hpp"
 #include "na/zoned/layout_synthesizer/placer/PlacerBase.hpp"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <bitset>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <functional>
-#include <map>
-#include <memory>
 #include <optional>
+#include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -45,9 +48,9 @@ using RowColumnSet =
  * placement of the atoms in each layer using the A* search algorithm.
  */
 class AStarPlacer : public PlacerBase {
-  friend class AStarPlacerTest_AStarSearch_Test;
   using DiscreteSite = std::array<uint8_t, 2>;
-  using CompatibilityGroup = std::array<std::map<uint8_t, uint8_t>, 2>;
+  using CompatibilityGroup =
+      std::array<std::vector<std::pair<uint8_t, uint8_t>>, 2>;
 
   std::reference_wrapper<const Architecture> architecture_;
   /**
@@ -68,6 +71,18 @@ class AStarPlacer : public PlacerBase {
   size_t windowMinHeight_;
 
 public:
+  /// The search used when the A* search reaches the maximum number of nodes
+  enum class Fallback : uint8_t {
+    /// No fallback is used and an error is raised instead
+    None,
+    /// Beam search with an adapted beam width until a placement is found
+    BeamSearch,
+    /**
+     * Weighted A* with an increasing weight of the heuristic. If all attempts
+     * exceed the maximum number of nodes, beam search is used eventually.
+     */
+    WeightedAStar
+  };
   /// The configuration of the A* placer
   struct Config {
     /**
@@ -143,22 +158,139 @@ public:
     /**
      * @brief The maximum number of nodes that are allowed to be visited in the
      * A* search tree.
-     * @detsils If this number is exceeded, the search is aborted and an error
-     * is raised. In the current implementation, one node roughly consumes 120
-     * Byte. Hence, allowing 50,000,000 nodes results in memory consumption of
-     * about 6 GB plus the size of the rest of the data structures.
+     * @details If this number is exceeded, the configured @ref fallback is
+     * used. Only if the fallback is @ref Fallback::None, the search is
+     * aborted and an error is raised. In the current implementation, every
+     * node consumes 24 Byte for the node itself, 24 Byte for its item in the
+     * search tree, and 8 Byte for the pointer in the open set, i.e., 56 Byte
+     * in total. Hence, allowing 50,000,000 nodes results in memory
+     * consumption of about 2.8 GB plus the size of the rest of the data
+     * structures.
      */
     size_t maxNodes = 50'000'000;
-    NLOHMANN_DEFINE_TYPE_INTRUSIVE_WITH_DEFAULT(Config, useWindow,
-                                                windowMinWidth, windowRatio,
-                                                windowShare, deepeningFactor,
-                                                deepeningValue, lookaheadFactor,
-                                                reuseLevel, maxNodes);
+    /**
+     * @brief The search used when the A* search reaches @ref maxNodes.
+     * @details The fallback searches are also limited to @ref maxNodes nodes.
+     * Beam search starts with @ref beamWidth and divides the width by four
+     * whenever the limit is reached again. If all nodes in the beam become
+     * dead ends, the width is multiplied by four instead, but kept below the
+     * smallest width that reached the limit. An error is raised only if no
+     * width remains in between.
+     */
+    Fallback fallback = Fallback::None;
+    /// The initial beam width of the beam search fallback
+    size_t beamWidth = 1000;
+    /**
+     * @brief The initial weight of the heuristic for the weighted A* fallback.
+     * @details The weight is doubled for every further attempt.
+     */
+    float fallbackWeight = 2.0F;
+    /**
+     * @brief The number of A* searches that run concurrently to place the
+     * gates in the entanglement zone.
+     * @details If greater than one, a portfolio of searches with different
+     * deepening and lookahead parameters runs on separate threads. The first
+     * search uses the configured parameters, the others increase the deepening
+     * factor or decrease the lookahead factor such that they usually reach a
+     * goal faster. The first search that finds a placement wins and all others
+     * are cancelled. The portfolio contains at most eight searches.
+     * @note Since the winning search depends on the timing of the threads, the
+     * placement is not deterministic if the portfolio contains more than one
+     * search. Every search is limited to @ref maxNodes nodes on its own.
+     */
+    size_t portfolioSize = 1;
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE_WITH_DEFAULT(
+        Config, useWindow, windowMinWidth, windowRatio, windowShare,
+        deepeningFactor, deepeningValue, lookaheadFactor, reuseLevel, maxNodes,
+        fallback, beamWidth, fallbackWeight, portfolioSize);
+  };
+
+  /**
+   * Fine-grained counters of the searches for one kind of jobs in one layer
+   * @note Only collected if profiling is enabled, see @ref PROFILING.
+   */
+  struct SearchCounters {
+    /// The number of expanded nodes
+    size_t nExpanded = 0;
+    /// The number of generated nodes, i.e., children of expanded nodes
+    size_t nGenerated = 0;
+    /// The maximum size of the open set
+    size_t openSetPeak = 0;
+    /// The memory allocated for the nodes and the open set in Byte
+    size_t bytesAllocated = 0;
+    /// The time spent in the searches including all fallbacks in us
+    int64_t searchTime = 0;
+    /// Accumulates the counters of another search, e.g., a fallback attempt
+    auto operator+=(const SearchCounters& other) -> SearchCounters& {
+      nExpanded += other.nExpanded;
+      nGenerated += other.nGenerated;
+      openSetPeak = std::max(openSetPeak, other.openSetPeak);
+      bytesAllocated += other.bytesAllocated;
+      searchTime += other.searchTime;
+      return *this;
+    }
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE_ONLY_SERIALIZE(SearchCounters, nExpanded,
+                                                  nGenerated, openSetPeak,
+                                                  bytesAllocated, searchTime);
+  };
+  /// Fine-grained counters of the searches for one two-qubit gate layer
+  struct LayerStatistics {
+    /// The counters of the searches placing the gates
+    SearchCounters gatePlacement;
+    /// The counters of the searches placing the atoms back in the storage
+    SearchCounters atomPlacement;
+    /// The time spent discretizing the sites of the layer in us
+    int64_t discretizationTime = 0;
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE_ONLY_SERIALIZE(LayerStatistics,
+                                                  gatePlacement, atomPlacement,
+                                                  discretizationTime);
+  };
+  /// Statistics of the A* searches performed during the last placement
+  struct Statistics {
+    /// The total number of nodes created in all searches
+    size_t nNodes = 0;
+    /// The memory occupied by the created nodes in Byte
+    size_t nodeMemory = 0;
+    /**
+     * The indices of the two-qubit gate layers for which the A* search reached
+     * the maximum number of nodes and the fallback was used
+     */
+    std::vector<size_t> degradedLayers;
+    /**
+     * The counters of every two-qubit gate layer, only collected if profiling
+     * is enabled, see @ref PROFILING
+     */
+    std::vector<LayerStatistics> layers;
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE_ONLY_SERIALIZE(Statistics, nNodes,
+                                                  nodeMemory, degradedLayers,
+                                                  layers);
   };
 
 private:
   /// The configuration of the A* placer
   Config config_;
+  /// The statistics of the last placement
+  Statistics statistics_;
+  /// Whether a search for the current layer has used the fallback
+  bool currentLayerDegraded_ = false;
+  /// The counters of the searches for the current layer
+  LayerStatistics currentLayerStatistics_;
+  /// The number of attempts with weighted A* before beam search is used
+  constexpr static size_t weightedAStarAttempts_ = 4;
+  /**
+   * The factors the deepening factor and the lookahead costs are multiplied
+   * with in the searches of the portfolio, @see Config::portfolioSize
+   */
+  constexpr static std::array<std::pair<float, float>, 8> portfolio_{{
+      {1.0F, 1.0F},
+      {1.5F, 1.0F},
+      {1.0F, 0.5F},
+      {2.0F, 1.0F},
+      {1.5F, 0.5F},
+      {3.0F, 1.0F},
+      {2.0F, 0.0F},
+      {4.0F, 1.0F},
+  }};
   /**
    * @brief When placing atoms after a rydberg layer back in the storage zone,
    * this struct stores for every such atom all required information, i.e., the
@@ -221,35 +353,30 @@ private:
    * that must be moved for the next stage starting from the last mapping
    * until a new mapping is found satisfying all constraints of the next
    * stage
+   * @details A node only stores the option chosen on its level together with
+   * a pointer to its parent. The remaining state, i.e., the consumed sites and
+   * the compatibility groups, is given by the options along the path to the
+   * root and reconstructed into a @ref SearchState when the node is expanded.
    */
   struct AtomNode {
-    /**
-     * The current level in the search tree. A level equal to the number of
-     * atoms to be placed indicates that all atoms have been placed.
-     */
-    uint8_t level = 0;
+    /// The parent node or nullptr for the root
+    const AtomNode* parent = nullptr;
+    /// The accumulated lookahead cost
+    float lookaheadCost = 0.0F;
+    /// The total cost to reach this node from the root, @see getCost
+    float cost = 0.0F;
+    /// The estimated cost to reach a goal from this node, @see getHeuristic
+    float heuristic = 0.0F;
     /**
      * The index of the chosen option for the current atom instead of a pointer
      * to that option to save memory
      */
     uint16_t option = 0;
-    /// The accumulated lookahead cost
-    float lookaheadCost = 0.0F;
-    /**
-     * A set of all sites that are already occupied by an atom due to the
-     * current placement
-     */
-    std::unordered_set<DiscreteSite> consumedFreeSites;
     /**
-     * A binary search tree representing the horizontal and vertical group,
-     * @see getNeighbors for more details
-     */
-    std::vector<CompatibilityGroup> groups;
-    /**
-     * The maximum distance of placed atoms in every group to their
-     * target location
+     * The current level in the search tree. A level equal to the number of
+     * atoms to be placed indicates that all atoms have been placed.
      */
-    std::vector<float> maxDistancesOfPlacedAtomsPerGroup;
+    uint8_t level = 0;
   };
 
   /**
@@ -257,28 +384,59 @@ private:
    * that must be moved for the next stage starting from the last mapping
    * until a new mapping is found satisfying all constraints of the next
    * stage.
+   * @details Like @ref AtomNode, a node only stores its parent and the option
+   * chosen on its level.
    */
   struct GateNode {
-    /**
-     * The current level in the search tree. A level equal to the number of
-     * gates to be placed indicates that all gates have been placed.
-     */
-    uint8_t level = 0;
+    /// The parent node or nullptr for the root
+    const GateNode* parent = nullptr;
+    /// The accumulated lookahead cost
+    float lookaheadCost = 0.0F;
+    /// The total cost to reach this node from the root, @see getCost
+    float cost = 0.0F;
+    /// The estimated cost to reach a goal from this node, @see getHeuristic
+    float heuristic = 0.0F;
     /**
      * The index of the chosen option for the current gate instead of a pointer
      * to that option to save memory
      */
     uint16_t option = 0;
-    /// The accumulated lookahead cost
-    float lookaheadCost = 0.0F;
     /**
-     * A set of all sites that are already occupied by an atom due to the
-     * current placement
+     * The current level in the search tree. A level equal to the number of
+     * gates to be placed indicates that all gates have been placed.
      */
-    std::unordered_set<DiscreteSite> consumedFreeSites;
+    uint8_t level = 0;
+  };
+
+  /// The modification of the groups by one placement such that it can be undone
+  struct GroupChange {
+    /// The index of the group the placement was added to
+    size_t group = 0;
+    /// Whether the group was formed by the placement
+    bool created = false;
+    /// The positions of the keys inserted into the horizontal and vertical
+    /// group, if any
+    std::array<std::optional<size_t>, 2> inserted;
+    /// The maximum distance of placed atoms in the group before the placement
+    float maxDistance = 0.F;
+  };
+
+  /**
+   * @brief The state of a node that is implied by the path from the root.
+   * @details Only one instance exists per search. Before every expansion, it
+   * is moved to the expanded node by undoing the placements down to the common
+   * ancestor with the previous node and applying the remaining ones. Then, it
+   * is used to evaluate all children of the expanded node.
+   */
+  struct SearchState {
     /**
-     * A binary search tree representing the horizontal and vertical group,
-     * @see getNeighbors for more details
+     * A bitset of all sites that are already occupied by an atom due to the
+     * current placement, indexed by the row and column of the site
+     */
+    std::bitset<1U << 16U> consumedFreeSites;
+    /**
+     * The horizontal and vertical groups, each as a list of key-value pairs
+     * sorted by key, @see expandNode for more details
      */
     std::vector<CompatibilityGroup> groups;
     /**
@@ -286,6 +444,143 @@ private:
      * target location
      */
     std::vector<float> maxDistancesOfPlacedAtomsPerGroup;
+    /// The options chosen along the path to the current node, one per level
+    std::vector<uint16_t> path;
+    /// The size of @ref changes when each level of @ref path was entered
+    std::vector<size_t> levelStarts;
+    /// The placements applied so far, each with the index of its site
+    std::vector<std::pair<size_t, GroupChange>> changes;
+    /// A buffer for the path of the node that is reconstructed next
+    std::vector<uint16_t> nextPath;
+
+    /// Enters the next level of the path by choosing @p option.
+    auto push(uint16_t option) -> void;
+    /// Undoes all placements of the last level and leaves it.
+    auto pop() -> void;
+    /// Places an atom from @p currentSite at @p site in the current level.
+    auto place(const DiscreteSite& currentSite, const DiscreteSite& site,
+               float distance) -> void;
+
+    /// @returns the index of the site in the consumed sites bitset
+    [[nodiscard]] static auto index(const DiscreteSite& site) -> size_t {
+      return (static_cast<size_t>(site.front()) << 8U) | site.back();
+    }
+    /// @returns true if the site is already occupied
+    [[nodiscard]] auto isConsumed(const DiscreteSite& site) const -> bool {
+      return consumedFreeSites.test(index(site));
+    }
+  };
+
+  /// Exception thrown by a search that was cancelled from another thread
+  class SearchCancelled : public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /// The parameters of the heuristic that are fixed during one search
+  struct HeuristicParameters {
+    /// @see Config::deepeningFactor
+    float deepeningFactor;
+    /// @see Config::deepeningValue
+    float deepeningValue;
+    /// The scale factors for the horizontal and vertical groups
+    std::array<float, 2> scaleFactors;
+  };
+
+  /**
+   * @brief The policy for @ref aStarTreeSearch that places either the gates in
+   * the entanglement zone or the atoms in the storage zone.
+   * @details The policy owns all nodes created during one search as well as
+   * the scratch state used to expand them.
+   * @tparam Job is either @ref GateJob or @ref AtomJob
+   * @tparam SearchNode is the respective node, i.e., @ref GateNode or
+   * @ref AtomNode
+   */
+  template <class Job, class SearchNode> class SearchPolicy {
+    /// The jobs to be placed
+    std::reference_wrapper<const std::vector<Job>> jobs_;
+    /// The parameters of the heuristic
+    HeuristicParameters parameters_;
+    /// The list of all nodes created so far with permanent memory allocation
+    std::deque<SearchNode> nodes_;
+    /// The state of the node that is currently expanded
+    SearchState state_;
+    /// The counters of this search, only collected if profiling is enabled
+    SearchCounters counters_;
+    /// If set, the search is cancelled as soon as the flag becomes true
+    const std::atomic<bool>* cancelled_;
+
+  public:
+    using Node = SearchNode;
+
+    /**
+     * Creates the policy together with the root node of the search tree.
+     * @param jobs are the jobs to be placed
+     * @param parameters are the parameters of the heuristic
+     * @param cancelled is an optional flag that is checked before every
+     * expansion. If it is set, the expansion throws @ref SearchCancelled.
+     */
+    SearchPolicy(const std::vector<Job>& jobs,
+                 const HeuristicParameters& parameters,
+                 const std::atomic<bool>* cancelled = nullptr)
+        : jobs_(jobs), parameters_(parameters), cancelled_(cancelled) {
+      nodes_.emplace_back().heuristic =
+          AStarPlacer::getHeuristic(jobs, parameters, 0, state_);
+    }
+
+    /// @returns the root node of the search tree
+    [[nodiscard]] auto getRoot() const -> const Node& { return nodes_.front(); }
+
+    /// @returns the number of nodes created so far
+    [[nodiscard]] auto getNumberOfNodes() const -> size_t {
+      return nodes_.size();
+    }
+
+    /// Creates the neighbors of @p node and passes them to @p emit.
+    template <class Emit> auto expand(const Node& node, Emit&& emit) -> void {
+      if (cancelled_ != nullptr &&
+          cancelled_->load(std::memory_order_relaxed)) {
+        throw SearchCancelled("Search cancelled.");
+      }
+      // the neighbors are appended consecutively to the list of nodes
+      const auto first = nodes_.size();
+      expandNode(nodes_, state_, jobs_.get(), parameters_, node);
+      for (auto i = first; i < nodes_.size(); ++i) {
+        emit(std::as_const(nodes_[i]));
+      }
+      if constexpr (PROFILING) {
+        ++counters_.nExpanded;
+        counters_.nGenerated += nodes_.size() - first;
+      }
+    }
+
+    /// Records the size and the memory of the open set after an expansion.
+    auto recordOpenSet(const size_t size, const size_t bytes) -> void {
+      counters_.openSetPeak = std::max(counters_.openSetPeak, size);
+      counters_.bytesAllocated = std::max(counters_.bytesAllocated, bytes);
+    }
+
+    /// @returns the counters of this search including the memory of the nodes
+    [[nodiscard]] auto getCounters() const -> SearchCounters {
+      auto counters = counters_;
+      counters.bytesAllocated += nodes_.size() * sizeof(Node);
+      return counters;
+    }
+
+    /// @returns true if all jobs have been placed in @p node
+    [[nodiscard]] auto isGoal(const Node& node) const -> bool {
+      return AStarPlacer::isGoal(jobs_.get().size(), node);
+    }
+
+    /// @returns the cost of @p node cached during its creation
+    [[nodiscard]] static auto getCost(const Node& node) -> double {
+      return node.cost;
+    }
+
+    /// @returns the heuristic of @p node cached during its creation
+    [[nodiscard]] static auto getHeuristic(const Node& node) -> double {
+      return node.heuristic;
+    }
   };
 
 public:
@@ -304,57 +599,52 @@ public:
         const std::vector<TwoQubitGateLayer>& twoQubitGateLayers,
         const std::vector<std::unordered_set<qc::Qubit>>& reuseQubits)
       -> std::vector<Placement>;
+  /**
+   * @brief Same as the function above but instead of collecting the
+   * placements, every placement is passed to @p onPlacement as soon as it is
+   * computed.
+   * @details The placements are passed in the order in which they appear in
+   * the vector returned by the function above. The placer itself only keeps
+   * the placements required to compute the next one.
+   */
+  auto place(size_t nQubits,
+             const std::vector<TwoQubitGateLayer>& twoQubitGateLayers,
+             const std::vector<std::unordered_set<qc::Qubit>>& reuseQubits,
+             const PlacementCallback& onPlacement) -> void;
+
+  /// @returns the statistics of the A* searches during the last placement
+  [[nodiscard]] auto getStatistics() const -> const Statistics& {
+    return statistics_;
+  }
 
 private:
   /**
-   * @brief A* search algorithm for trees
-   * @details A* is a graph traversal and path search algorithm that finds the
-   * shortest path between a start node and a goal node. It evaluates nodes by
-   * combining the cost to reach the node and the cost to get from the node to
-   * the goal estimated by a heuristic function.
-   * @par
-   * This implementation of the A* search algorithm has some particularities:
-   * - To increase performance for the special case of a tree, where there
-   * cannot be any cycles and a node can only be reached by one path, it does
-   * not keep visited nodes. This would require a hash set or similar data
-   * structure to store visited nodes and check if a node has already been
-   * visited. This check would take at least O(log(n)) time for a hash set and
-   * is superfluous for trees.
-   * - As a consequence of the first point, this implementation also does not
-   * check whether a node is already in the open set. This would also require an
-   * O(log(n)) check operation which is not necessary for trees as one path can
-   * only reach a node.
-   * @note This implementation of A* search can only handle trees and not
-   * general graphs. This is because it does not keep track of visited nodes and
-   * therefore cannot detect cycles. Also for DAGs it may expand nodes multiple
-   * times when they can be reached by different paths from the start node.
-   * @note @p getHeuristic must be admissible, meaning that it never
-   * overestimates the cost to reach the goal from the current node calculated
-   * by @p getCost for every edge on the path.
-   * @note The calling program has to make sure that the pointers passed to this
-   * function are valid and that the iterators are not invalidated during the
-   * search, e.g., by calling one of the passed functions like @p getNeighbors.
-   * @param start is a reference to the start node
-   * @param getNeighbors is a function that returns the neighbors of a node as
-   * references
-   * @param isGoal is a function that returns true if a node is one of
-   * potentially multiple goals
-   * @param getCost is a function that returns the total cost to reach that
-   * particular node from the start node
-   * @param getHeuristic is a function that returns the heuristic cost from the
-   * node to any goal.
-   * @return a vector of node references representing the path from the start to
-   * a goal
-   */
-  template <class Node>
-  [[nodiscard]] static auto aStarTreeSearch(
-      const Node& start,
-      const std::function<std::vector<std::reference_wrapper<const Node>>(
-          const Node&)>& getNeighbors,
-      const std::function<bool(const Node&)>& isGoal,
-      const std::function<double(const Node&)>& getCost,
-      const std::function<double(const Node&)>& getHeuristic, size_t maxNodes)
-      -> std::vector<std::reference_wrapper<const Node>>;
+   * @brief Runs a portfolio of A* searches for the gate placement in parallel.
+   * @details The searches use the parameters in @ref portfolio_. The first
+   * search that finds a goal wins and all others are cancelled.
+   * @param jobs are the gates to be placed
+   * @param parameters are the parameters of the heuristic of the first search
+   * @return the index of the chosen option for every job
+   * @throws NodeLimitExceeded if all searches reach the maximum number of
+   * nodes
+   */
+  [[nodiscard]] auto searchPortfolio(const std::vector<GateJob>& jobs,
+                                     const HeuristicParameters& parameters)
+      -> std::vector<uint16_t>;
+  /**
+   * @brief Searches the best option for every job using the A* search.
+   * @details If the A* search reaches the maximum number of nodes, the
+   * configured fallback is used and the current layer is marked as degraded.
+   * @tparam Job is either @ref GateJob or @ref AtomJob
+   * @tparam Node is the respective node, i.e., @ref GateNode or @ref AtomNode
+   * @param jobs are the jobs to be placed
+   * @param parameters are the parameters of the heuristic
+   * @return the index of the chosen option for every job
+   */
+  template <class Job, class Node>
+  [[nodiscard]] auto searchOptions(const std::vector<Job>& jobs,
+                                   const HeuristicParameters& parameters)
+      -> std::vector<uint16_t>;
 
   /**
    * @brief This function takes a list of atoms together with their current
@@ -504,20 +794,12 @@ private:
    * @details The cost of a node is the sum of the distances of all atoms to
    * their target sites. Additionally, the cost of the lookahead is added to the
    * total cost.
-   * @param node is the node to be checked
+   * @param lookaheadCost is the accumulated lookahead cost of the node
+   * @param state is the state of the node
    * @return the cost of the node
    */
-  [[nodiscard]] static auto getCost(const GateNode& node) -> float;
-  /**
-   * @brief Returns the cost of a node, i.e., the total cost to reach that node
-   * from the start node.
-   * @details The cost of a node is the sum of the distances of all atoms to
-   * their target sites. Additionally, the cost of the lookahead is added to the
-   * total cost.
-   * @param node is the node to be checked
-   * @return the cost of the node
-   */
-  [[nodiscard]] static auto getCost(const AtomNode& node) -> float;
+  [[nodiscard]] static auto getCost(float lookaheadCost,
+                                    const SearchState& state) -> float;
 
   /**
    * @brief Calculates the standard deviation of the differences value - key
@@ -541,82 +823,116 @@ private:
   /**
    * @brief Return the estimated cost still required to reach a goal node.
    * @param atomJobs are the atoms to be placed
-   * @param deepeningFactor is the factor to adjust the influence of the
-   * standard deviation term
-   * @param deepeningValue is the value added to the sum of standard deviations
-   * @param scaleFactors are the scale factors for the horizontal and vertical
-   * groups
-   * @param node is the node to be checked
+   * @param parameters are the parameters of the heuristic
+   * @param level is the level of the node to be checked
+   * @param state is the state of the node to be checked
    * @return the heuristic cost
    */
-  [[nodiscard]] static auto
-  getHeuristic(const std::vector<AtomJob>& atomJobs, float deepeningFactor,
-               float deepeningValue, const std::array<float, 2>& scaleFactors,
-               const AtomNode& node) -> float;
+  [[nodiscard]] static auto getHeuristic(const std::vector<AtomJob>& atomJobs,
+                                         const HeuristicParameters& parameters,
+                                         size_t level, const SearchState& state)
+      -> float;
 
   /**
    * @brief Return the estimated cost still required to reach a goal node.
    * @param gateJobs are the gates to be placed
-   * @param deepeningFactor is the factor to adjust the influence of the
-   * standard deviation term
-   * @param deepeningValue is the value added to the sum of standard deviations
-   * @param scaleFactors are the scale factors for the horizontal and vertical
-   * groups
-   * @param node is the node to be checked
+   * @param parameters are the parameters of the heuristic
+   * @param level is the level of the node to be checked
+   * @param state is the state of the node to be checked
    * @return the heuristic cost
    */
-  [[nodiscard]] static auto
-  getHeuristic(const std::vector<GateJob>& gateJobs, float deepeningFactor,
-               float deepeningValue, const std::array<float, 2>& scaleFactors,
-               const GateNode& node) -> float;
-
-  /**
-   * @brief Return references to all neighbors of the given node.
-   * @details When calling this function, the neighbors are allocated
-   * permanently such that (1) the returned references remain valid when the
-   * execution returned from this function and (2) not all nodes in the tree
-   * have to be created before they are needed. Hence, nodes are only created on
-   * demand in this function. Consequently, this function must only be called
-   * once per node. Otherwise, neighbors for the same node are created twice.
+  [[nodiscard]] static auto getHeuristic(const std::vector<GateJob>& gateJobs,
+                                         const HeuristicParameters& parameters,
+                                         size_t level, const SearchState& state)
+      -> float;
+
+  /**
+   * @brief Creates all neighbors of the given node.
+   * @details The neighbors are appended to @p nodes such that (1) they remain
+   * valid when the execution returned from this function and (2) not all nodes
+   * in the tree have to be created before they are needed. Hence, nodes are
+   * only created on demand in this function. Consequently, this function must
+   * only be called once per node. Otherwise, neighbors for the same node are
+   * created twice.
    * @par
    * When creating a new node, the horizontal and vertical groups are checked
    * whether the new corresponding placement is compatible with any of the
    * existing groups. If yes, the new placement is added to the respective group
    * and otherwise, a new group is formed with the new placement.
+   * @par
+   * The cost and the heuristic of every child are computed right away and
+   * cached in the child such that the state of the child does not need to be
+   * reconstructed again.
    * @param nodes is the list of all nodes created so far with permanent memory
    * allocation
+   * @param state is the scratch state used to reconstruct the state of the
+   * node to be expanded
    * @param atomJobs are the atoms to be placed
+   * @param parameters are the parameters of the heuristic
    * @param node is the node to be expanded
-   * @return a list of references to the neighbors of the given node
    */
-  [[nodiscard]] static auto
-  getNeighbors(std::deque<std::unique_ptr<AtomNode>>& nodes,
-               const std::vector<AtomJob>& atomJobs, const AtomNode& node)
-      -> std::vector<std::reference_wrapper<const AtomNode>>;
-
-  /**
-   * @brief Return references to all neighbors of the given node.
-   * @details When calling this function, the neighbors are allocated
-   * permanently such that (1) the returned references remain valid when the
-   * execution returned from this function and (2) not all nodes in the tree
-   * have to be created before they are needed. Hence, nodes are only created on
-   * demand in this function. Consequently, this function must only be called
-   * once per node. Otherwise, neighbors for the same node are created twice.
+  static auto expandNode(std::deque<AtomNode>& nodes, SearchState& state,
+                         const std::vector<AtomJob>& atomJobs,
+                         const HeuristicParameters& parameters,
+                         const AtomNode& node) -> void;
+
+  /**
+   * @brief Reconstructs the state of the given node from the state of the
+   * previously reconstructed node.
+   * @details The options along the path from the root to the node are
+   * compared with those of the current state. Only the levels after the common
+   * prefix are undone and replayed.
+   * @param atomJobs are the atoms to be placed
+   * @param node is the node whose state is reconstructed
+   * @param state is moved to the state of the node
+   */
+  static auto reconstructState(const std::vector<AtomJob>& atomJobs,
+                               const AtomNode& node, SearchState& state)
+      -> void;
+
+  /**
+   * @brief Creates all neighbors of the given node.
+   * @details The neighbors are appended to @p nodes such that (1) they remain
+   * valid when the execution returned from this function and (2) not all nodes
+   * in the tree have to be created before they are needed. Hence, nodes are
+   * only created on demand in this function. Consequently, this function must
+   * only be called once per node. Otherwise, neighbors for the same node are
+   * created twice.
    * @par
    * When creating a new node, the horizontal and vertical groups are checked
    * whether the new corresponding placement is compatible with any of the
    * existing groups. If yes, the new placement is added to the respective group
    * and otherwise, a new group is formed with the new placement.
+   * @par
+   * The cost and the heuristic of every child are computed right away and
+   * cached in the child such that the state of the child does not need to be
+   * reconstructed again.
    * @param nodes is the list of all nodes created so far with permanent memory
    * allocation
+   * @param state is the scratch state used to reconstruct the state of the
+   * node to be expanded
    * @param gateJobs are the gates to be placed
+   * @param parameters are the parameters of the heuristic
    * @param node is the node to be expanded
-   * @return a list of references to the neighbors of the given node
    */
-  [[nodiscard]] static auto
-  getNeighbors(std::deque<std::unique_ptr<GateNode>>& nodes,
-               const std::vector<GateJob>& gateJobs, const GateNode& node)
-      -> std::vector<std::reference_wrapper<const GateNode>>;
+  static auto expandNode(std::deque<GateNode>& nodes, SearchState& state,
+                         const std::vector<GateJob>& gateJobs,
+                         const HeuristicParameters& parameters,
+                         const GateNode& node) -> void;
+
+  /**
+   * @brief Reconstructs the state of the given node from the state of the
+   * previously reconstructed node.
+   * @details The options along the path from the root to the node are
+   * compared with those of the current state. Only the levels after the common
+   * prefix are undone and replayed.
+   * @param gateJobs are the gates to be placed
+   * @param node is the node whose state is reconstructed
+   * @param state is moved to the state of the node
+   */
+  static auto reconstructState(const std::vector<GateJob>& gateJobs,
+                               const GateNode& node, SearchState& state)
+      -> void;
 
   /**
    * Checks the compatibility with a new assignment, i.e., a key-value pair,
@@ -635,10 +951,11 @@ private:
    * not compatible with the group, an empty optional is returned.
    */
   [[nodiscard]] static auto
-  checkCompatibilityWithGroup(uint8_t key, uint8_t value,
-                              const std::map<uint8_t, uint8_t>& group)
-      -> std::optional<
-          std::pair<std::map<uint8_t, uint8_t>::const_iterator, bool>>;
+  checkCompatibilityWithGroup(
+      uint8_t key, uint8_t value,
+      const std::vector<std::pair<uint8_t, uint8_t>>& group)
+      -> std::optional<std::pair<
+          std::vector<std::pair<uint8_t, uint8_t>>::const_iterator, bool>>;
 
   /**
    * Checks for the new placement of the atom whether it is compatible with
@@ -651,13 +968,14 @@ private:
    * @param distance the distance the atom must travel to reach the target site
    * @param groups the groups to which the new placement can be added
    * @param maxDistances the maximum distances of placed atoms in each group
-   * @return true if the new placement could be added to an existing group
+   * @return the change of the groups required to undo the placement
    */
   static auto
   checkCompatibilityAndAddPlacement(uint8_t hKey, uint8_t hValue, uint8_t vKey,
                                     uint8_t vValue, float distance,
                                     std::vector<CompatibilityGroup>& groups,
-                                    std::vector<float>& maxDistances) -> bool;
+                                    std::vector<float>& maxDistances)
+      -> GroupChange;
 
   /**
    * @brief This function creates a new GateJob for the given parameters and
@@ -684,4 +1002,9 @@ private:
                      const SLM& nearestSLM, size_t r, size_t c,
                      GateJob& job) const -> void;
 };
+NLOHMANN_JSON_SERIALIZE_ENUM(AStarPlacer::Fallback,
+                             {{AStarPlacer::Fallback::None, "none"},
+                              {AStarPlacer::Fallback::BeamSearch, "beamSearch"},
+                              {AStarPlacer::Fallback::WeightedAStar,
+                               "weightedAStar"}})
 } // namespace na::zoned
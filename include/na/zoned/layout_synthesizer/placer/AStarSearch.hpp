@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2023 - 2025 Chair for Design Automation, TUM
+ * Copyright (c) 2025 Munich Quantum Software Company GmbH
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "na/zoned/Profiling.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+
+namespace na::zoned {
+/**
+ * @brief Exception thrown by the tree searches when the maximum number of nodes
+ * is reached before a goal is found.
+ */
+class NodeLimitExceeded : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Exception thrown by the beam search when no node of the beam is a goal
+ * and none of them has a child.
+ * @details A wider beam may still find a goal since it keeps more alternatives.
+ */
+class BeamExhausted : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
+/// Whether the policy of a search collects counters about the open set
+template <class Policy>
+constexpr bool RECORD_OPEN_SET = requires(Policy& policy) {
+  policy.recordOpenSet(size_t{}, size_t{});
+};
+
+/**
+ * @brief A* search algorithm for trees
+ * @details A* is a graph traversal and path search algorithm that finds the
+ * shortest path between a start node and a goal node. It evaluates nodes by
+ * combining the cost to reach the node and the cost to get from the node to
+ * the goal estimated by a heuristic function.
+ * @par
+ * This implementation of the A* search algorithm has some particularities:
+ * - To increase performance for the special case of a tree, where there
+ * cannot be any cycles and a node can only be reached by one path, it does
+ * not keep visited nodes. This would require a hash set or similar data
+ * structure to store visited nodes and check if a node has already been
+ * visited. This check would take at least O(log(n)) time for a hash set and
+ * is superfluous for trees.
+ * - As a consequence of the first point, this implementation also does not
+ * check whether a node is already in the open set. This would also require an
+ * O(log(n)) check operation which is not necessary for trees as one path can
+ * only reach a node.
+ * - The problem specific parts are provided by a policy whose member functions
+ * are resolved at compile time and can, hence, be inlined. Neighbors are not
+ * collected in a container but passed to a callback one by one.
+ * @note This implementation of A* search can only handle trees and not
+ * general graphs. This is because it does not keep track of visited nodes and
+ * therefore cannot detect cycles. Also for DAGs it may expand nodes multiple
+ * times when they can be reached by different paths from the start node.
+ * @note `getHeuristic` must be admissible, meaning that it never
+ * overestimates the cost to reach the goal from the current node calculated
+ * by `getCost` for every edge on the path.
+ * @note The policy has to make sure that the references to the nodes passed
+ * to the callback remain valid until the search returns.
+ * @note With a @p heuristicWeight greater than 1, this becomes weighted A*
+ * that usually finds a goal faster at the price of a more expensive path.
+ * @tparam Policy must provide
+ * - a type `Node` of the nodes in the search tree,
+ * - `expand(const Node& node, Emit&& emit)` that calls `emit(neighbor)` for
+ * every neighbor of `node`,
+ * - `isGoal(const Node& node) -> bool` that returns true if a node is one of
+ * potentially multiple goals,
+ * - `getCost(const Node& node) -> double` that returns the total cost to reach
+ * that particular node from the start node, and
+ * - `getHeuristic(const Node& node) -> double` that returns the heuristic cost
+ * from the node to any goal.
+ *
+ * If profiling is enabled, see @ref PROFILING, and the policy optionally
+ * provides `recordOpenSet(size_t size, size_t bytes)`, it is called after every
+ * expansion with the size of the open set and the memory occupied by the
+ * bookkeeping of the search in Byte.
+ * @param policy is the policy providing the problem specific functions
+ * @param start is a reference to the start node
+ * @param maxNodes is the maximum number of nodes that are visited before the
+ * search is aborted
+ * @param heuristicWeight is the factor the heuristic is multiplied with
+ * @return a vector of node references representing the path from the start to
+ * a goal
+ * @throws NodeLimitExceeded if @p maxNodes is reached before a goal is found
+ */
+template <class Policy>
+[[nodiscard]] auto aStarTreeSearch(Policy& policy,
+                                   const typename Policy::Node& start,
+                                   const size_t maxNodes,
+                                   const double heuristicWeight = 1.0)
+    -> std::vector<std::reference_wrapper<const typename Policy::Node>> {
+  using Node = typename Policy::Node;
+  //===--------------------------------------------------------------------===//
+  // Setup open set structure
+  //===--------------------------------------------------------------------===//
+  // struct for items in the open set
+  struct Item {
+    double priority_;  //< sum of cost and heuristic
+    const Node* node_; //< pointer to the node
+    // pointer to the parent item to reconstruct the path in the end
+    Item* parent_;
+
+    Item(const double priority, const Node& node, Item* parent)
+        : priority_(priority), node_(&node), parent_(parent) {
+      assert(!std::isnan(priority));
+    }
+  };
+  // compare function for the open set
+  struct ItemCompare {
+    auto operator()(const Item* a, const Item* b) const -> bool {
+      // this way, the item with the lowest priority is on top of the heap
+      return a->priority_ > b->priority_;
+    }
+  };
+  // deque of items serving as an arena to keep all items alive also after they
+  // are popped from the open set. they are required alive to reconstruct the
+  // path in the end. the deque allocates the items in chunks and never moves
+  // them, hence, pointers to the items remain valid.
+  std::deque<Item> items;
+  // open list of nodes to be evaluated as a minimum heap based on the
+  // priority. whenever an item is placed in the queue it is created in the
+  // deque `items` before and only a pointer is placed in the queue
+  std::priority_queue<Item*, std::vector<Item*>, ItemCompare> openSet;
+  openSet.emplace(&items.emplace_back(
+      heuristicWeight * policy.getHeuristic(start), start, nullptr));
+  //===--------------------------------------------------------------------===//
+  // Perform A* search
+  //===--------------------------------------------------------------------===//
+  while (items.size() < maxNodes && !openSet.empty()) {
+    Item* itm = openSet.top();
+    openSet.pop();
+    // if a goal is reached, that is the shortest path to a goal under the
+    // assumption that the heuristic is admissible
+    if (policy.isGoal(*itm->node_)) {
+      // reconstruct the path from the goal to the start and then reverse it
+      std::vector<std::reference_wrapper<const Node>> path;
+      for (; itm != nullptr; itm = itm->parent_) {
+        path.emplace_back(*itm->node_);
+      }
+      std::reverse(path.begin(), path.end());
+      return path;
+    }
+    // expand the current node by adding all neighbors to the open set
+    policy.expand(*itm->node_, [&policy, &items, &openSet, heuristicWeight,
+                                itm](const Node& neighbor) {
+      // getCost returns the total cost to reach the current node
+      const auto cost = policy.getCost(neighbor);
+      const auto heuristic = heuristicWeight * policy.getHeuristic(neighbor);
+      openSet.emplace(&items.emplace_back(cost + heuristic, neighbor, itm));
+    });
+    if constexpr (PROFILING && RECORD_OPEN_SET<Policy>) {
+      policy.recordOpenSet(openSet.size(),
+                           (items.size() * sizeof(Item)) +
+                               (openSet.size() * sizeof(Item*)));
+    }
+  }
+  if (items.size() >= maxNodes) {
+    throw NodeLimitExceeded(
+        "Maximum number of nodes reached. Increase max_nodes or increase "
+        "deepening_value and deepening_factor to reduce the number of explored "
+        "nodes.");
+  }
+  throw std::runtime_error("No path from start to any goal found.");
+}
+
+/**
+ * @brief Beam search for trees whose goals are all located on the same level
+ * @details The search proceeds level by level. Of all children of the nodes in
+ * the current beam, only the @p beamWidth most promising ones w.r.t. the sum of
+ * their cost and heuristic are kept for the next level. Hence, the number of
+ * created nodes grows only linearly with the depth of the tree. In return, the
+ * path found is not necessarily the shortest one.
+ * @tparam Policy is the same as for @ref aStarTreeSearch
+ * @param policy is the policy providing the problem specific functions
+ * @param start is a reference to the start node
+ * @param beamWidth is the maximum number of nodes kept on each level
+ * @param maxNodes is the maximum number of nodes that are visited before the
+ * search is aborted
+ * @return a vector of node references representing the path from the start to
+ * a goal
+ * @throws NodeLimitExceeded if @p maxNodes is reached before a goal is found
+ * @throws BeamExhausted if all nodes of a level are dead ends
+ */
+template <class Policy>
+[[nodiscard]] auto beamTreeSearch(Policy& policy,
+                                  const typename Policy::Node& start,
+                                  const size_t beamWidth, const size_t maxNodes)
+    -> std::vector<std::reference_wrapper<const typename Policy::Node>> {
+  using Node = typename Policy::Node;
+  assert(beamWidth > 0);
+  // struct for items in the beam
+  struct Item {
+    double priority_;  //< sum of cost and heuristic
+    const Node* node_; //< pointer to the node
+    // pointer to the parent item to reconstruct the path in the end
+    const Item* parent_;
+
+    Item(const double priority, const Node& node, const Item* parent)
+        : priority_(priority), node_(&node), parent_(parent) {
+      assert(!std::isnan(priority));
+    }
+  };
+  // deque of items serving as an arena, see aStarTreeSearch
+  std::deque<Item> items;
+  std::vector<const Item*> beam{
+      &items.emplace_back(policy.getHeuristic(start), start, nullptr)};
+  std::vector<const Item*> candidates;
+  while (!beam.empty()) {
+    // the beam is sorted by priority, hence, the first goal is the best one
+    if (const auto it = std::find_if(beam.cbegin(), beam.cend(),
+                                     [&policy](const Item* itm) -> bool {
+                                       return policy.isGoal(*itm->node_);
+                                     });
+        it != beam.cend()) {
+      // reconstruct the path from the goal to the start and then reverse it
+      std::vector<std::reference_wrapper<const Node>> path;
+      for (const Item* itm = *it; itm != nullptr; itm = itm->parent_) {
+        path.emplace_back(*itm->node_);
+      }
+      std::reverse(path.begin(), path.end());
+      return path;
+    }
+    candidates.clear();
+    for (const Item* itm : beam) {
+      policy.expand(*itm->node_, [&policy, &items, &candidates,
+                                  itm](const Node& neighbor) {
+        const auto priority =
+            policy.getCost(neighbor) + policy.getHeuristic(neighbor);
+        candidates.emplace_back(&items.emplace_back(priority, neighbor, itm));
+      });
+      if (items.size() >= maxNodes) {
+        throw NodeLimitExceeded(
+            "Maximum number of nodes reached in beam search. Decrease the "
+            "beam width.");
+      }
+    }
+    // in beam search, the candidates of the next level form the open set
+    if constexpr (PROFILING && RECORD_OPEN_SET<Policy>) {
+      policy.recordOpenSet(candidates.size(),
+                           (items.size() * sizeof(Item)) +
+                               (candidates.capacity() * sizeof(Item*)));
+    }
+    // keep only the most promising candidates for the next level
+    const auto width = std::min(beamWidth, candidates.size());
+    std::partial_sort(candidates.begin(),
+                      candidates.begin() + static_cast<std::ptrdiff_t>(width),
+                      candidates.end(),
+                      [](const Item* a, const Item* b) -> bool {
+                        return a->priority_ < b->priority_;
+                      });
+    candidates.resize(width);
+    beam.swap(candidates);
+  }
+  throw BeamExhausted("No node in the beam leads to a goal. Increase the beam "
+                      "width.");
+}
+} // namespace na::zoned
@@ -12,10 +12,17 @@
 
 #include "na/zoned/Types.hpp"
 
+#include <functional>
 #include <unordered_set>
 #include <vector>
 
 namespace na::zoned {
+/**
+ * Callback that is invoked by a placer with every placement as soon as it is
+ * computed, e.g., to start routing while later layers are still placed.
+ */
+using PlacementCallback = std::function<void(const Placement&)>;
+
 /**
  * The Abstract Base Class for the Placer of the MQT's Zoned Neutral Atom
  * Compiler.
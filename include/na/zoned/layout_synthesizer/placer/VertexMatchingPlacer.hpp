@@ -12,11 +12,13 @@
 
 #include "ir/Definitions.hpp"
 #include "na/zoned/Architecture.hpp"
+#include "na/zoned/SiteIndex.hpp"
 #include "na/zoned/Types.hpp"
 #include "na/zoned/layout_synthesizer/placer/PlacerBase.hpp"
 
 #include <cstddef>
 #include <functional>
+#include <nlohmann/json.hpp>
 #include <optional>
 #include <unordered_set>
 #include <utility>
@@ -36,6 +38,10 @@ class VertexMatchingPlacer : public PlacerBase {
       VertexMatchingPlacerTest_MinimumWeightFullBipartiteMatchingExceptions_Test;
   friend class
       VertexMatchingPlacerTest_MinimumWeightFullBipartiteMatchingEmpty_Test;
+  friend class VertexMatchingPlacerTest_SparseMatching_Test;
+  friend class VertexMatchingPlacerTest_SparseMatchingRandom_Test;
+  friend class VertexMatchingPlacerTest_SparseMatchingWarmStart_Test;
+  friend class VertexMatchingPlacerTest_SparseMatchingExceptions_Test;
 
   std::reference_wrapper<const Architecture> architecture_;
   /**
@@ -54,6 +60,11 @@ public:
      * best candidate site for an atom.
      */
     bool useWindow = true;
+    /**
+     * If the windows around an atom contain fewer free storage sites, the
+     * nearest free storage sites are added such that there are at least this
+     * many candidates.
+     */
     size_t windowSize = 10;
 
     /**
@@ -65,13 +76,46 @@ public:
      * zone is computed via the minimal vertex matching algorithm.
      */
     bool dynamicPlacement = true;
+
+    /**
+     * This flag indicates whether the matchings are computed on the original
+     * dense cost matrix instead of the sparse graph of candidate sites.
+     * @details Both variants yield a matching of minimum weight. The dense
+     * variant allocates a matrix over all gates and all candidate sites and is
+     * only kept for validation purposes.
+     */
+    bool denseMatching = false;
     NLOHMANN_DEFINE_TYPE_INTRUSIVE_WITH_DEFAULT(Config, useWindow, windowSize,
-                                                dynamicPlacement);
+                                                dynamicPlacement,
+                                                denseMatching);
+  };
+
+  /// The size of one bipartite matching problem solved by the placer
+  struct MatchingStatistics {
+    /// The number of rows, i.e., atoms or gates to be placed
+    size_t nRows = 0;
+    /// The number of columns, i.e., candidate sites
+    size_t nColumns = 0;
+    /// The number of edges, i.e., finite entries of the cost matrix
+    size_t nEdges = 0;
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE_ONLY_SERIALIZE(MatchingStatistics, nRows,
+                                                  nColumns, nEdges);
+  };
+  /// Statistics of the last placement
+  struct Statistics {
+    /**
+     * The sizes of all matching problems in the order they were solved, only
+     * collected if profiling is enabled, see @ref PROFILING
+     */
+    std::vector<MatchingStatistics> matchings;
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE_ONLY_SERIALIZE(Statistics, matchings);
   };
 
 private:
   /// The configuration of the VertexMatchingPlacer
   Config config_;
+  /// The statistics of the last placement
+  Statistics statistics_;
 
   /**
    * This is multiplied with the cost of the movement without reuse to resemble
@@ -79,6 +123,16 @@ private:
    */
   constexpr static double costAtomTransfer_ = 0.9999;
 
+  /**
+   * The dual prices of all sites indexed by their @ref SiteId as left by the
+   * last matching the site took part in. They are used to warm start the
+   * matching of the next layer.
+   */
+  std::vector<double> sitePrices_;
+
+  /// The free storage sites in the last placement computed by the placer
+  SiteIndex freeStorageSites_;
+
 public:
   /**
    * Create a VertexMatchingPlacer based on the given architecture and
@@ -100,6 +154,23 @@ public:
         const std::vector<TwoQubitGateLayer>& twoQubitGateLayers,
         const std::vector<std::unordered_set<qc::Qubit>>& reuseQubits)
       -> std::vector<Placement>;
+  /**
+   * @brief Same as the function above but instead of collecting the
+   * placements, every placement is passed to @p onPlacement as soon as it is
+   * computed.
+   * @details The placements are passed in the order in which they appear in
+   * the vector returned by the function above. The placer itself only keeps
+   * the placements required to compute the next one.
+   */
+  auto place(size_t nQubits,
+             const std::vector<TwoQubitGateLayer>& twoQubitGateLayers,
+             const std::vector<std::unordered_set<qc::Qubit>>& reuseQubits,
+             const PlacementCallback& onPlacement) -> void;
+
+  /// @returns the statistics of the last placement
+  [[nodiscard]] auto getStatistics() const -> const Statistics& {
+    return statistics_;
+  }
 
 private:
   /// Generate qubit initial layout
@@ -112,6 +183,50 @@ private:
   [[nodiscard]] static auto minimumWeightFullBipartiteMatching(
       const std::vector<std::vector<std::optional<double>>>& costMatrix)
       -> std::vector<size_t>;
+
+  /**
+   * A sparse bipartite graph given by the list of weighted edges, i.e., pairs
+   * of a column and a cost, for every row
+   */
+  using SparseCostMatrix = std::vector<std::vector<std::pair<size_t, double>>>;
+
+  /**
+   * @brief Computes a minimum weight full matching of a sparse bipartite graph.
+   * @details This is a shortest augmenting path algorithm in the style of
+   * Jonker and Volgenant that only traverses the edges present in the graph.
+   * Every row is matched by one Dijkstra search over the reduced costs that
+   * are kept non-negative by row and column potentials.
+   * @par
+   * The column potentials, i.e., the dual prices, are taken from @p prices and
+   * written back when the matching is complete. Any prices yield a matching of
+   * minimum weight, however, the prices of a similar previous instance steer
+   * the rows away from contested columns and shorten the augmenting paths.
+   * @param costMatrix contains the edges of every row
+   * @param nCols is the number of columns
+   * @param prices contains the initial prices of all columns and receives
+   * the final prices
+   * @returns the column matched to every row
+   * @throws std::invalid_argument if there are more rows than columns, a row
+   * is empty, or no full matching exists
+   */
+  [[nodiscard]] static auto
+  sparseMinimumWeightFullBipartiteMatching(const SparseCostMatrix& costMatrix,
+                                           size_t nCols,
+                                           std::vector<double>& prices)
+      -> std::vector<size_t>;
+
+  /**
+   * Computes a minimum weight full matching with the method selected in the
+   * configuration.
+   * @param costMatrix contains the edges of every row
+   * @param columnSites contains the site id of every column that is used to
+   * look up and store the dual price of the column
+   * @returns the column matched to every row
+   */
+  [[nodiscard]] auto matchSites(const SparseCostMatrix& costMatrix,
+                                const std::vector<SiteId>& columnSites)
+      -> std::vector<size_t>;
+
   /**
    * Calculates the cost of rearranging atoms from one placement to the next.
    * @details This function is used to evaluate whether the option with or
@@ -163,13 +278,22 @@ private:
                                const std::unordered_set<qc::Qubit>& reuseQubits,
                                const TwoQubitGateLayer& twoQubitGates,
                                const TwoQubitGateLayer& nextTwoQubitGates,
-                               bool reuse) const -> Placement;
+                               bool reuse) -> Placement;
+
+  /// Updates the free storage sites when the atoms move from one placement to
+  /// the next one
+  auto updateFreeStorageSites(const Placement& before, const Placement& after)
+      -> void;
 
-  /// Generate qubit mapping based on minimum weight matching.
+  /**
+   * Generate qubit mapping based on minimum weight matching.
+   * @note @p previousGatePlacement must be the last placement computed by
+   * the placer such that the free storage sites are up to date.
+   */
   auto placeAtomsInStorageZone(const Placement& initialPlacement,
                                const Placement& previousGatePlacement,
                                const std::unordered_set<qc::Qubit>& reuseQubits,
                                const TwoQubitGateLayer& nextTwoQubitGates,
-                               bool reuse) const -> Placement;
+                               bool reuse) -> Placement;
 };
 } // namespace na::zoned
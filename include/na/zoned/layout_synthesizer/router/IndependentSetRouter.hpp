@@ -12,13 +12,14 @@
 
 #include "ir/Definitions.hpp"
 #include "na/zoned/Architecture.hpp"
+#include "na/zoned/PlacementSequence.hpp"
 #include "na/zoned/Types.hpp"
 #include "na/zoned/layout_synthesizer/router/RouterBase.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <tuple>
-#include <unordered_map>
 #include <vector>
 
 namespace na::zoned {
@@ -29,6 +30,8 @@ namespace na::zoned {
  * set.
  */
 class IndependentSetRouter : public RouterBase {
+  friend class IndependentSetRouterTest_ConflictGraph_Test;
+
   std::reference_wrapper<const Architecture> architecture_;
 
 public:
@@ -61,26 +64,74 @@ public:
    */
   [[nodiscard]] auto route(const std::vector<Placement>& placement) const
       -> std::vector<Routing>;
+  /**
+   * Same as the function above but for a delta-encoded sequence of placements.
+   * @details Only the atoms that are moved between two placements are
+   * considered and no placement except for the current start and target
+   * placement is materialized.
+   * @param placement is the delta-encoded sequence of placements
+   * @param routingTimes is an optional list the time for routing every
+   * transition in us is appended to, only measured if profiling is enabled,
+   * see @ref PROFILING
+   */
+  [[nodiscard]] auto route(const PlacementSequence& placement,
+                           std::vector<int64_t>* routingTimes = nullptr) const
+      -> std::vector<Routing>;
+  /**
+   * Compute the routing for a single transition between two placements.
+   * @details This is the step performed by @ref route for every consecutive
+   * pair of placements. It only depends on the two given placements such that
+   * transitions can be routed as soon as their placements are known.
+   * @param startPlacement is the placement before the transition
+   * @param targetPlacement is the placement after the transition
+   * @return groups of atoms that can be moved simultaneously
+   */
+  [[nodiscard]] auto route(const Placement& startPlacement,
+                           const Placement& targetPlacement) const -> Routing;
 
 private:
+  /**
+   * Groups the given atoms into sets of atoms that can be moved
+   * simultaneously.
+   * @param atomsToMove are the atoms whose site differs in the two placements
+   * @param startPlacement is the placement before the transition
+   * @param targetPlacement is the placement after the transition
+   * @return groups of atoms that can be moved simultaneously
+   */
+  [[nodiscard]] auto routeAtoms(std::vector<qc::Qubit> atomsToMove,
+                                const Placement& startPlacement,
+                                const Placement& targetPlacement) const
+      -> Routing;
+
+  /**
+   * The conflict graph as an adjacency matrix. The nodes are the positions of
+   * the atoms in the vector of atoms to move and row i is a bitset of the
+   * nodes that conflict with node i, where node j is represented by bit
+   * j % 64 of word j / 64.
+   */
+  using ConflictGraph = std::vector<std::vector<std::uint64_t>>;
+
   /**
    * Creates the conflict graph.
-   * @details Atom/qubit indices are the nodes. Two nodes are connected if their
-   * corresponding move with respect to the given @p start- and @p
-   * targetPlacement stand in conflict with each other. The graph is
-   * represented as adjacency lists.
+   * @details Two nodes are connected if their corresponding moves with respect
+   * to the given @p start- and @p targetPlacement stand in conflict with each
+   * other, see @ref isCompatibleMovement. Instead of comparing all pairs of
+   * moves, the moves are sorted once by every coordinate of their start and
+   * target location. Two moves conflict in one dimension if and only if they
+   * are ordered differently by their start and target coordinates. Sweeping
+   * over the sorted moves yields for every move the bitsets of the moves that
+   * come before it, from which all conflicts of a move follow with a few
+   * word-wise operations.
    * @param atomsToMove are all atoms corresponding to nodes in the graph
    * @param startPlacement is the start placement of all atoms as a mapping from
    * atoms to their sites
    * @param targetPlacement is the target placement of the atoms
-   * @return the conflict graph as an unordered_map, where the keys are the
-   * nodes and the values are vectors of their neighbors
+   * @return the conflict graph as an adjacency matrix of bitsets
    */
   [[nodiscard]] auto
   createConflictGraph(const std::vector<qc::Qubit>& atomsToMove,
                       const Placement& startPlacement,
-                      const Placement& targetPlacement) const
-      -> std::unordered_map<qc::Qubit, std::vector<qc::Qubit>>;
+                      const Placement& targetPlacement) const -> ConflictGraph;
 
   /**
    * Takes two sites, the start and target site and returns a 4D-vector of the
@@ -33,6 +33,8 @@ class VertexMatchingReuseAnalyzer : public ReuseAnalyzerBase {
       VertexMatchingReuseAnalyzerMaximumBipartiteMatchingTest_Inverse_Test;
   friend class
       VertexMatchingReuseAnalyzerMaximumBipartiteMatchingInvertedTest_Direct_Test;
+  friend class
+      VertexMatchingReuseAnalyzerMaximumBipartiteMatchingRandomTest_Random_Test;
 
 public:
   /**
@@ -61,9 +63,53 @@ public:
       -> std::vector<std::unordered_set<qc::Qubit>>;
 
 private:
+  /// Marks an unmatched vertex or an unused qubit
+  constexpr static auto none_ = static_cast<std::size_t>(-1);
+
   /**
-   * Computes a maximum matching in a bipartite graph
+   * A bipartite graph in compressed sparse row format, i.e., the sinks
+   * adjacent to source `i` are `sinks[offsets[i]]` up to but excluding
+   * `sinks[offsets[i + 1]]`.
+   */
+  struct BipartiteGraph {
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> sinks;
+    std::size_t nSinks = 0;
+  };
+
+  /**
+   * The state of the matching algorithm. It is kept between the layers such
+   * that the buffers are only allocated once.
+   */
+  struct MatchingBuffers {
+    /// The sink matched to every source or @ref none_
+    std::vector<std::size_t> matching;
+    /// The source matched to every sink or @ref none_
+    std::vector<std::size_t> invMatching;
+    /// The layer of every source in the current phase or @ref none_
+    std::vector<std::size_t> distance;
+    /// The index of the next edge to explore for every source
+    std::vector<std::size_t> nextEdge;
+    /// The queue of the breadth-first search
+    std::vector<std::size_t> queue;
+    /// The current path of the depth-first search
+    std::vector<std::size_t> path;
+  };
+
+  /**
+   * Computes a maximum matching in a bipartite graph with the algorithm of
+   * Hopcroft and Karp
    * https://epubs.siam.org/doi/pdf/10.1137/0202019?download=true
+   * @details The matching is stored in @p buffers.
+   */
+  static auto maximumBipartiteMatching(const BipartiteGraph& graph,
+                                       MatchingBuffers& buffers) -> void;
+
+  /**
+   * Computes a maximum matching in a bipartite graph given as a list of the
+   * adjacent sinks of every source
+   * @returns the sink matched to every source or, if @p inverted is true, the
+   * source matched to every sink
    */
   [[nodiscard]] static auto maximumBipartiteMatching(
       const std::vector<std::vector<std::size_t>>& sparseMatrix,
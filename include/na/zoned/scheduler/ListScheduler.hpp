@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2023 - 2025 Chair for Design Automation, TUM
+ * Copyright (c) 2025 Munich Quantum Software Company GmbH
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "ir/QuantumComputation.hpp"
+#include "na/zoned/Architecture.hpp"
+#include "na/zoned/Types.hpp"
+#include "na/zoned/scheduler/SchedulerBase.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <nlohmann/json.hpp>
+#include <utility>
+#include <vector>
+
+namespace na::zoned {
+/**
+ * The class ListScheduler implements a list scheduling strategy for the zoned
+ * neutral atom compiler that exploits the commutation of CZ gates.
+ * @details CZ gates commute with each other and with diagonal single-qubit
+ * gates, e.g., Z, S, T, P, or RZ. Hence, the operations acting on a qubit are
+ * divided into blocks separated by non-diagonal single-qubit gates, global
+ * operations, and barriers. The CZ gates within a block of a qubit may be
+ * executed in any order. Every layer is filled with the CZ gates that are in
+ * the current block of both of their qubits in the order of their priority.
+ */
+class ListScheduler : public SchedulerBase {
+  /// A reference to the zoned neutral atom architecture
+  std::reference_wrapper<const Architecture> architecture_;
+  /**
+   * This value is calculated based on the architecture and indicates the
+   * maximum number of two-qubit gates that can be executed in parallel in
+   * the entanglement zone.
+   */
+  size_t maxTwoQubitGateNumPerLayer_ = 0;
+
+public:
+  /// The configuration of the ListScheduler
+  struct Config {
+    /**
+     * The priority of a CZ gate is the number of unscheduled CZ gates acting
+     * on the busier of its qubits, which is a lower bound for the number of
+     * layers still required by that qubit. For every qubit of the gate that
+     * is also involved in a CZ gate of the previous layer, this value is added
+     * to the priority. Such a qubit can remain in the entanglement zone, which
+     * saves a rearrangement step.
+     */
+    double reuseWeight = 0.5;
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE_WITH_DEFAULT(Config, reuseWeight);
+  };
+
+private:
+  /// The configuration of the ListScheduler
+  Config config_;
+
+public:
+  /**
+   * Create a new ListScheduler.
+   * @param architecture is the architecture of the neutral atom system
+   * @param config is the configuration of the scheduler
+   */
+  ListScheduler(const Architecture& architecture, const Config& config);
+  /**
+   * This function schedules the operations of a quantum computation.
+   * @details The result has the same structure as the one of the
+   * ASAPScheduler. Every layer (except for the last one) contains some
+   * single-qubit operations and two-qubit operations. The single-qubit
+   * operations are executed before the two-qubit operations. For every layer,
+   * all two-qubit operations can be executed in parallel, i.e., every qubit is
+   * involved in at most one two-qubit operation. The last layer contains only
+   * the remaining single-qubit operations. Diagonal single-qubit operations
+   * are scheduled in the layer where their block starts, i.e., possibly before
+   * CZ gates that precede them in the quantum computation.
+   * @param qc is the quantum computation
+   * @return a pair of two vectors. The first vector contains the layers of
+   * single-qubit operations. The second vector contains the layers of two-qubit
+   * operations. A pair of qubits represents every two-qubit operation.
+   * @throws std::invalid_argument if the quantum computation contains a
+   * non-global barrier or an operation other than single-qubit gates, CZ
+   * gates, and global operations
+   */
+  [[nodiscard]] auto schedule(const qc::QuantumComputation& qc) const
+      -> std::pair<std::vector<SingleQubitGateLayer>,
+                   std::vector<TwoQubitGateLayer>> override;
+};
+} // namespace na::zoned
@@ -42,8 +42,16 @@ class SynthesisConfiguration:
     use_maxsat: bool
     use_symmetry_breaking: bool
     verbosity: Verbosity
+    portfolio: bool
+    portfolio_solver_parameters: list[dict[str, bool | int | float | str]]
+    greedy: bool
+    greedy_upper_bound: bool
     heuristic: bool
     split_size: int
+    n_threads_heuristic: int
+    iterative_heuristic: bool
+    heuristic_max_passes: int
+    heuristic_time_limit: float
     linear_search: bool
 
     def __init__(self) -> None: ...
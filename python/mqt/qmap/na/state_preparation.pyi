@@ -85,6 +85,28 @@ class NAStatePreparationSolver:
             Returns:
                 the result as a JSON string
             """
+        def binary(self) -> bytes:
+            """Returns the result in a compact binary representation.
+
+            In contrast to the JSON representation, the binary representation
+            preserves all attributes of the result.
+
+            Returns:
+                the result as bytes
+            """
+        @staticmethod
+        def from_binary(data: bytes) -> NAStatePreparationSolver.Result:
+            """Reads a result from its binary representation.
+
+            Args:
+                data: is the binary representation returned by :meth:`binary`
+
+            Returns:
+                the result
+
+            Raises:
+                ValueError: if the data is not a valid binary representation
+            """
 
     def solve(
         self,
@@ -94,6 +116,7 @@ class NAStatePreparationSolver:
         num_transfers: int | None = ...,
         mind_ops_order: bool = ...,
         shield_idle_qubits: bool = ...,
+        break_symmetries: bool = ...,
     ) -> Result:
         """Solve the neutral atom state preparation problem.
 
@@ -109,7 +132,11 @@ class NAStatePreparationSolver:
         specified, then the solver will determine the optimal number of transfers. The
         parameter `mind_ops_order` specifies whether the order of the operations in the
         circuit should be preserved. The parameter `shield_idle_qubits` specifies
-        whether idle qubits should be shielded from the entangling operations.
+        whether idle qubits should be shielded from the entangling operations. The
+        parameter `break_symmetries` adds constraints that exclude solutions that
+        only differ by exchanging interchangeable qubits, translating all atoms, or
+        renumbering AOD rows and columns. This does not change whether a solution
+        exists.
 
         Note:
             To retrieve the list of qubit pairs from a quantum circuit, use the function
@@ -129,6 +156,8 @@ class NAStatePreparationSolver:
             mind_ops_order: is True if the order of the operations should be
                 preserved
             shield_idle_qubits: is True if idle qubits should be shielded
+            break_symmetries: is True if solutions that are symmetric to other
+                solutions should be excluded
 
         Returns:
             the result of the solver
@@ -138,6 +167,83 @@ class NAStatePreparationSolver:
             negative value
         """
 
+    def solve_optimal(
+        self,
+        ops: list[tuple[int, int]],
+        num_qubits: int,
+        max_num_stages: int,
+        mind_ops_order: bool = ...,
+        shield_idle_qubits: bool = ...,
+        break_symmetries: bool = ...,
+    ) -> Result:
+        """Solve the neutral atom state preparation problem with the minimal number of stages.
+
+        In contrast to :func:`solve`, the number of stages is not fixed. Instead, the
+        solver adds one stage after the other to the same SMT instance until the circuit
+        can be executed and, hence, avoids encoding the problem again for every number
+        of stages. Among the solutions with the minimal number of stages, it returns one
+        with the minimal number of transfer stages. The parameters `mind_ops_order` and
+        `shield_idle_qubits` have the same meaning as for :func:`solve`.
+
+        Args:
+            ops: is the list of operations in the circuit
+            num_qubits: is the number of qubits in the circuit
+            max_num_stages: is the maximal number of stages that is tried
+            mind_ops_order: is True if the order of the operations should be
+                preserved
+            shield_idle_qubits: is True if idle qubits should be shielded
+            break_symmetries: is True if solutions that are symmetric to other
+                solutions should be excluded
+
+        Returns:
+            the result of the solver, which is unsatisfiable if there is no
+            solution with at most `max_num_stages` stages
+
+        Raises:
+            ValueError: if `max_num_stages` is zero or one of the numeral parameters
+            is invalid
+        """
+
+    def solve_parallel(
+        self,
+        ops: list[tuple[int, int]],
+        num_qubits: int,
+        max_num_stages: int,
+        mind_ops_order: bool = ...,
+        shield_idle_qubits: bool = ...,
+        break_symmetries: bool = ...,
+        num_threads: int = ...,
+    ) -> Result:
+        """Solve the neutral atom state preparation problem with the minimal number of stages in parallel.
+
+        The solver solves the instances of :func:`solve` for all numbers of stages up to
+        `max_num_stages` and all numbers of transfers concurrently, each one in its own
+        SMT context. As soon as an instance is solved, all instances that cannot lead to
+        a better solution are skipped or interrupted. Like :func:`solve_optimal`, it
+        returns a solution with the minimal number of stages and, among those, with the
+        minimal number of transfer stages. The GIL is released while solving.
+
+        Args:
+            ops: is the list of operations in the circuit
+            num_qubits: is the number of qubits in the circuit
+            max_num_stages: is the maximal number of stages that is tried
+            mind_ops_order: is True if the order of the operations should be
+                preserved
+            shield_idle_qubits: is True if idle qubits should be shielded
+            break_symmetries: is True if solutions that are symmetric to other
+                solutions should be excluded
+            num_threads: is the number of instances solved concurrently, 0
+                means the number of hardware threads
+
+        Returns:
+            the result of the solver, which is unsatisfiable if there is no
+            solution with at most `max_num_stages` stages
+
+        Raises:
+            ValueError: if `max_num_stages` is zero or one of the numeral parameters
+            is invalid
+        """
+
 def get_ops_for_solver(
     qc: QuantumComputation,
     operation_type: str,
@@ -10,21 +10,29 @@
 
 from mqt.core.ir import QuantumComputation
 
+PROFILING: bool
+"""Whether the statistics of the compilers contain the fine-grained profiling counters."""
+
 class ZonedNeutralAtomArchitecture:
     """Class representing a Zoned Neutral Atom Architecture."""
 
     @classmethod
-    def from_json_file(cls, filename: str) -> ZonedNeutralAtomArchitecture:
+    def from_json_file(cls, filename: str, lookup_tables_file: str | None = None) -> ZonedNeutralAtomArchitecture:
         """Create an architecture from a JSON file.
 
         Args:
             filename: is the path to the JSON file
+            lookup_tables_file: is the path to a file caching the precomputed
+                nearest storage sites of the architecture. If the file does not exist or
+                belongs to a different architecture, the lookup tables are
+                computed and written to it.
 
         Returns:
             the architecture
 
         Raises:
-            ValueError: if the file does not exist or is not a valid JSON file
+            ValueError: if the file does not exist or is not a valid JSON file, or if
+                the lookup tables file belongs to this architecture but is corrupted
         """
     @classmethod
     def from_json_string(cls, json: str) -> ZonedNeutralAtomArchitecture:
@@ -64,6 +72,8 @@ class RoutingAgnosticCompiler:
         dynamic_placement: bool = ...,
         parking_offset: int = ...,
         warn_unsupported_gates: bool = ...,
+        pipelining: bool = ...,
+        dense_matching: bool = ...,
     ) -> None:
         """Create a routing-agnostic compiler for the given architecture and configurations.
 
@@ -76,6 +86,10 @@ class RoutingAgnosticCompiler:
             dynamic_placement: whether to use dynamic placement for the placer
             parking_offset: the parking offset of the code generator
             warn_unsupported_gates: whether to warn about unsupported gates in the code generator
+            pipelining: whether to route and generate code for already placed layers on
+                worker threads while the placer works on the next layers
+            dense_matching: whether the placer computes the matchings on the dense cost
+                matrix instead of the sparse graph of candidate sites, for validation only
         """
     @classmethod
     def from_json_string(cls, arch: ZonedNeutralAtomArchitecture, json: str) -> RoutingAgnosticCompiler:
@@ -100,9 +114,43 @@ class RoutingAgnosticCompiler:
         Returns:
             the compilations result as a string in the .naviz format.
         """
+    def compile_to_file(self, qc: QuantumComputation, filename: str, binary: bool = False) -> None:
+        """Compile a quantum circuit and write the result directly to a file.
+
+        The generated code is written to the file operation by operation. Hence, the
+        complete program is never held in memory, which is beneficial for large
+        circuits. Only with ``pipelining`` enabled, every layer is written as soon as it
+        is routed. Otherwise, all layers are placed and routed before the code is
+        generated.
+
+        Args:
+            qc: is the quantum circuit
+            filename: is the path to the output file
+            binary: whether to write the compact binary encoding instead of the .naviz format
+
+        Raises:
+            RuntimeError: if the file cannot be opened
+        """
+    def compile_batch(self, circuits: list[QuantumComputation], n_threads: int = 0) -> list[tuple[str, dict[str, float]]]:
+        """Compile several quantum circuits in parallel.
+
+        Every worker thread uses its own copy of the compiler while the architecture is shared.
+        This does not change the statistics returned by :meth:`stats`.
+
+        Args:
+            circuits: are the quantum circuits
+            n_threads: is the maximum number of worker threads, 0 means the number of hardware threads
+
+        Returns:
+            the compilation result in the .naviz format and the statistics for every circuit
+        """
     def stats(self) -> dict[str, float]:
         """Get the statistics of the last compilation.
 
+        If the module was built with the CMake option ``MQT_QMAP_ZONED_PROFILING``,
+        see :data:`PROFILING`, the statistics additionally contain fine-grained
+        counters, e.g., the number of expanded nodes per layer.
+
         Returns:
             the statistics as a dictionary
         """
@@ -125,6 +173,11 @@ class RoutingAwareCompiler:
         max_nodes: int = ...,
         parking_offset: int = ...,
         warn_unsupported_gates: bool = ...,
+        pipelining: bool = ...,
+        fallback: str = ...,
+        beam_width: int = ...,
+        fallback_weight: float = ...,
+        portfolio_size: int = ...,
     ) -> None:
         """Create a routing-aware compiler for the given architecture and configurations.
 
@@ -150,13 +203,35 @@ class RoutingAwareCompiler:
                 reused and instead moved to the storage zone and back to the
                 entanglement zone
             max_nodes: is the maximum number of nodes that are considered in the A*
-                search. If this number is exceeded, the search is aborted and an error
-                is raised. In the current implementation, one node roughly consumes 120
-                Byte. Hence, allowing 50,000,000 nodes results in memory consumption of
-                about 6 GB plus the size of the rest of the data structures.
+                search. If this number is exceeded, the configured ``fallback`` is
+                used. Only if ``fallback`` is "none", the search is aborted and an
+                error is raised. In the current implementation, every node consumes
+                24 Byte for the node itself, 24 Byte for its item in the search tree,
+                and 8 Byte for the pointer in the open set, i.e., 56 Byte in total.
+                Hence, allowing 50,000,000 nodes results in memory consumption of
+                about 2.8 GB plus the size of the rest of the data structures.
             parking_offset: is the parking offset of the code generator
             warn_unsupported_gates: is a flag whether to warn about unsupported gates
                 in the code generator
+            pipelining: is a flag whether to route and generate code for already
+                placed layers on worker threads while the placer works on the next
+                layers
+            fallback: is the search used when the A* search reaches ``max_nodes``,
+                possible values are "none", "beam_search", and "weighted_a_star".
+                The layers for which the fallback was used are reported in the
+                statistics.
+            beam_width: is the initial beam width of the beam search fallback. It is
+                divided by four whenever the beam search reaches ``max_nodes`` and
+                multiplied by four whenever all nodes in the beam are dead ends.
+            fallback_weight: is the initial weight of the heuristic for the weighted
+                A* fallback. It is doubled for every further attempt.
+            portfolio_size: is the number of A* searches with different deepening and
+                lookahead parameters that run concurrently to place the gates of a
+                layer. The first search that finds a placement wins. Hence, for
+                values greater than one, the result is not deterministic.
+
+        Raises:
+            ValueError: if ``fallback`` is not one of the possible values
         """
     @classmethod
     def from_json_string(cls, arch: ZonedNeutralAtomArchitecture, json: str) -> RoutingAwareCompiler:
@@ -181,9 +256,43 @@ class RoutingAwareCompiler:
         Returns:
             the compilations result as a string in the .naviz format.
         """
+    def compile_to_file(self, qc: QuantumComputation, filename: str, binary: bool = False) -> None:
+        """Compile a quantum circuit and write the result directly to a file.
+
+        The generated code is written to the file operation by operation. Hence, the
+        complete program is never held in memory, which is beneficial for large
+        circuits. Only with ``pipelining`` enabled, every layer is written as soon as it
+        is routed. Otherwise, all layers are placed and routed before the code is
+        generated.
+
+        Args:
+            qc: is the quantum circuit
+            filename: is the path to the output file
+            binary: whether to write the compact binary encoding instead of the .naviz format
+
+        Raises:
+            RuntimeError: if the file cannot be opened
+        """
+    def compile_batch(self, circuits: list[QuantumComputation], n_threads: int = 0) -> list[tuple[str, dict[str, float]]]:
+        """Compile several quantum circuits in parallel.
+
+        Every worker thread uses its own copy of the compiler while the architecture is shared.
+        This does not change the statistics returned by :meth:`stats`.
+
+        Args:
+            circuits: are the quantum circuits
+            n_threads: is the maximum number of worker threads, 0 means the number of hardware threads
+
+        Returns:
+            the compilation result in the .naviz format and the statistics for every circuit
+        """
     def stats(self) -> dict[str, float]:
         """Get the statistics of the last compilation.
 
+        If the module was built with the CMake option ``MQT_QMAP_ZONED_PROFILING``,
+        see :data:`PROFILING`, the statistics additionally contain fine-grained
+        counters, e.g., the number of expanded nodes per layer.
+
         Returns:
             the statistics as a dictionary
         """
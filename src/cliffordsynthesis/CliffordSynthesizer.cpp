@@ -11,6 +11,7 @@
 #include "cliffordsynthesis/CliffordSynthesizer.hpp"
 
 #include "cliffordsynthesis/Configuration.hpp"
+#include "cliffordsynthesis/GreedySynthesizer.hpp"
 #include "cliffordsynthesis/Tableau.hpp"
 #include "cliffordsynthesis/TargetMetric.hpp"
 #include "cliffordsynthesis/encoding/SATEncoder.hpp"
@@ -23,9 +24,12 @@
 #include <chrono>
 #include <cmath>
 #include <cstddef>
+#include <exception>
 #include <fstream>
 #include <future>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <plog/Appenders/ConsoleAppender.h>
 #include <plog/Formatters/TxtFormatter.h>
 #include <plog/Init.h>
@@ -64,6 +68,7 @@ void CliffordSynthesizer::synthesize(const Configuration& config) {
   encoderConfig.useMaxSAT = configuration.useMaxSAT;
   encoderConfig.useSymmetryBreaking = configuration.useSymmetryBreaking;
   encoderConfig.solverParameters = configuration.solverParameters;
+  encoderConfig.cancellation = cancellation;
   encoderConfig.useMultiGateEncoding =
       requiresMultiGateEncoding(encoderConfig.targetMetric);
 
@@ -75,6 +80,27 @@ void CliffordSynthesizer::synthesize(const Configuration& config) {
     return;
   }
 
+  if (configuration.greedy) {
+    // The greedy synthesis does not invoke the SAT solver at all.
+    results = GreedySynthesizer(initialTableau, targetTableau).run();
+    return;
+  }
+
+  if (configuration.portfolio) {
+    portfolioSynthesis();
+    return;
+  }
+
+  if (configuration.greedyUpperBound) {
+    // A solution obtained by the greedy synthesis provides an upper bound
+    // similar to an initial circuit. It is only used if it is better than the
+    // initial circuit.
+    PLOG_INFO << "Seeding the search with a greedily synthesized circuit.";
+    updateResults(configuration,
+                  GreedySynthesizer(initialTableau, targetTableau).run(),
+                  results);
+  }
+
   // First, determine an initial guess for the number of timesteps. This can
   // either be specified as a configuration parameter or starts at 1.
   determineInitialTimestepLimit(encoderConfig);
@@ -194,7 +220,7 @@ CliffordSynthesizer::determineUpperBound(EncoderConfig config) {
             << "with " << upperBound;
 
   config.useMaxSAT = false;
-  while (!results.sat()) {
+  while (!results.sat() && !isCancelled()) {
     results = callSolver(config);
     if (!results.sat()) {
       lowerBound = upperBound + 1U;
@@ -216,6 +242,98 @@ CliffordSynthesizer::determineUpperBound(EncoderConfig config) {
   return {lowerBound, upperBound};
 }
 
+namespace {
+// The configurations raced against each other in the portfolio mode. Each of
+// them leads to a proven optimal result, but their runtimes may differ by
+// orders of magnitude depending on the instance. The choice between the
+// single- and the multi-gate encoding is dictated by the target metric.
+std::vector<Configuration>
+portfolioConfigurations(const Configuration& configuration) {
+  auto base = configuration;
+  base.portfolio = false;
+  base.portfolioSolverParameters.clear();
+
+  std::vector<Configuration> configs{base};
+
+  auto symmetryBreaking = base;
+  symmetryBreaking.useSymmetryBreaking = !base.useSymmetryBreaking;
+  configs.emplace_back(symmetryBreaking);
+
+  // solver parameters are typically tuned for either MaxSAT or binary search
+  auto maxSAT = base;
+  maxSAT.useMaxSAT = !base.useMaxSAT;
+  maxSAT.linearSearch = false;
+  maxSAT.solverParameters.clear();
+  configs.emplace_back(maxSAT);
+
+  for (const auto& parameters : configuration.portfolioSolverParameters) {
+    auto withParameters = base;
+    withParameters.solverParameters = parameters;
+    configs.emplace_back(withParameters);
+  }
+
+  // only a single member may dump its intermediate results
+  for (std::size_t i = 1U; i < configs.size(); ++i) {
+    configs[i].dumpIntermediateResults = false;
+  }
+  return configs;
+}
+} // namespace
+
+void CliffordSynthesizer::portfolioSynthesis() {
+  const auto configs = portfolioConfigurations(configuration);
+  PLOG_INFO << "Racing a portfolio of " << configs.size()
+            << " configurations";
+
+  // The members are copied before any thread is started since the winner
+  // writes the results of this synthesizer.
+  const auto token = std::make_shared<CancellationToken>();
+  std::vector<CliffordSynthesizer> members(configs.size(), *this);
+  for (auto& member : members) {
+    member.cancellation = token;
+  }
+
+  std::mutex mutex;
+  std::optional<std::size_t> winner;
+  std::exception_ptr exception;
+  std::vector<std::future<void>> futures;
+  futures.reserve(members.size());
+  for (std::size_t i = 0U; i < members.size(); ++i) {
+    futures.emplace_back(std::async(std::launch::async, [&, i]() {
+      try {
+        members[i].synthesize(configs[i]);
+      } catch (...) {
+        const std::scoped_lock lock(mutex);
+        if (!exception) {
+          exception = std::current_exception();
+        }
+        return;
+      }
+      // The first member to finish without being cancelled has completed its
+      // search and, hence, found an optimal solution.
+      const std::scoped_lock lock(mutex);
+      if (!winner.has_value()) {
+        winner = i;
+        token->cancel();
+      }
+    }));
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+
+  if (!winner.has_value()) {
+    std::rethrow_exception(exception);
+  }
+  PLOG_INFO << "Portfolio member " << *winner << " finished first";
+
+  results = members[*winner].results;
+  for (const auto& member : members) {
+    solverCalls += member.solverCalls;
+  }
+  results.setSolverCalls(solverCalls);
+}
+
 void CliffordSynthesizer::gateOptimalSynthesis(EncoderConfig config,
                                                const std::size_t lower,
                                                const std::size_t upper) {
@@ -491,7 +609,7 @@ void gateToLayer(const qc::Operation& gate, std::size_t& i,
 // assume canonical sorting of gates
 std::vector<std::size_t> getLayers(const qc::QuantumComputation& qc) {
   std::vector<std::size_t> layerNum{};
-  layerNum.resize(qc.size());
+  layerNum.resize(qc.getNqubits());
   std::vector<std::size_t> layers{};
   std::size_t layer = 0U;
   std::size_t i = 0;
@@ -513,6 +631,46 @@ std::vector<std::size_t> getLayers(const qc::QuantumComputation& qc) {
   }
   return layers;
 }
+
+// collect the individual operations of a circuit with compound operations
+// resolved, such that indices match those used by `getLayers`
+std::vector<const qc::Operation*>
+getIndividualOps(const qc::QuantumComputation& qc) {
+  std::vector<const qc::Operation*> ops{};
+  ops.reserve(qc.getNindividualOps());
+  for (const auto& gate : qc) {
+    if (const auto* const compOp =
+            dynamic_cast<const qc::CompoundOperation* const>(gate.get());
+        compOp != nullptr) {
+      for (const auto& subGate : *compOp) {
+        ops.emplace_back(subGate.get());
+      }
+    } else {
+      ops.emplace_back(gate.get());
+    }
+  }
+  return ops;
+}
+
+std::size_t getDepth(const std::vector<const qc::Operation*>& ops,
+                     const std::size_t begin, const std::size_t end,
+                     const std::size_t nQubits) {
+  std::vector<std::size_t> qubitDepth(nQubits, 0U);
+  std::size_t depth = 0U;
+  for (std::size_t i = begin; i < end; ++i) {
+    const auto usedQubits = ops[i]->getUsedQubits();
+    std::size_t layer = 0U;
+    for (const auto& qubit : usedQubits) {
+      layer = std::max(layer, qubitDepth[qubit]);
+    }
+    ++layer;
+    for (const auto& qubit : usedQubits) {
+      qubitDepth[qubit] = layer;
+    }
+    depth = std::max(depth, layer);
+  }
+  return depth;
+}
 } // namespace
 
 void CliffordSynthesizer::depthHeuristicSynthesis() {
@@ -520,45 +678,149 @@ void CliffordSynthesizer::depthHeuristicSynthesis() {
   if (initialCircuit->getDepth() == 0) {
     return;
   }
+  const auto start = std::chrono::high_resolution_clock::now();
+
   auto optimalConfig = configuration;
   optimalConfig.heuristic = false;
   optimalConfig.target = TargetMetric::Depth;
   optimalConfig.initialTimestepLimit = configuration.splitSize;
 
   initialCircuit->reorderOperations();
-  qc::QuantumComputation optCircuit{initialCircuit->getNqubits()};
-  const std::vector<std::size_t>& layers = getLayers(*initialCircuit);
 
-  std::vector<std::future<std::shared_ptr<qc::QuantumComputation>>> subCircuits;
-  for (std::size_t i = 0; i < layers.size() - 1; i += configuration.splitSize) {
-    std::size_t const startIdx = layers[i];
-    std::size_t endIdx = 0;
+  // The first pass splits the circuit at every `splitSize` layers. The
+  // iterative mode alternates with a pass whose window boundaries are shifted
+  // by half a window, such that every seam of one pass lies inside a window
+  // of the next pass.
+  std::vector<std::size_t> offsets{0U};
+  if (configuration.iterativeHeuristic && configuration.splitSize > 1U) {
+    offsets.emplace_back(configuration.splitSize / 2U);
+  }
+
+  auto circuit = initialCircuit;
+  std::vector<bool> changedOps{};
+  for (std::size_t pass = 0U; configuration.heuristicMaxPasses == 0U ||
+                              pass < configuration.heuristicMaxPasses;
+       ++pass) {
+    const auto offset = offsets[pass % offsets.size()];
+    // The first pass for each offset considers all windows. Afterwards, only
+    // windows containing operations changed in the previous pass are
+    // resynthesized.
+    if (pass < offsets.size()) {
+      changedOps.clear();
+    }
+    PLOG_INFO << "Heuristic pass " << pass << " with offset " << offset;
+    auto [nextCircuit, nextChangedOps] = runHeuristicPass(
+        circuit, offset, changedOps, optimalConfig, pass == 0U);
+    circuit = std::move(nextCircuit);
+    changedOps = std::move(nextChangedOps);
 
-    if (i + configuration.splitSize >= layers.size()) {
-      endIdx = layers.back();
-    } else {
-      endIdx = layers[i + configuration.splitSize];
+    if (!configuration.iterativeHeuristic || circuit->empty()) {
+      break;
+    }
+    if (pass + 1U >= offsets.size() &&
+        std::none_of(changedOps.cbegin(), changedOps.cend(),
+                     [](const bool changed) { return changed; })) {
+      PLOG_INFO << "Heuristic converged after " << pass + 1U << " pass(es)";
+      break;
+    }
+    if (configuration.heuristicTimeLimit > 0.0) {
+      const std::chrono::duration<double> elapsed =
+          std::chrono::high_resolution_clock::now() - start;
+      if (elapsed.count() >= configuration.heuristicTimeLimit) {
+        PLOG_INFO << "Time limit of the heuristic exceeded after " << pass + 1U
+                  << " pass(es)";
+        break;
+      }
     }
+  }
 
-    // launch threads
-    subCircuits.emplace_back(
-        std::async(std::launch::async | std::launch::deferred,
-                   [this, startIdx, endIdx, &optimalConfig]() {
-                     return cs::CliffordSynthesizer::synthesizeSubcircuit(
-                         initialCircuit, startIdx, endIdx, optimalConfig);
-                   }));
+  results.setDepth(circuit->getDepth());
+  results.setResultCircuit(*circuit);
+}
+
+std::pair<std::shared_ptr<qc::QuantumComputation>, std::vector<bool>>
+CliffordSynthesizer::runHeuristicPass(
+    const std::shared_ptr<qc::QuantumComputation>& circuit,
+    const std::size_t offset, const std::vector<bool>& changedOps,
+    const Configuration& config, const bool acceptAll) const {
+  const auto ops = getIndividualOps(*circuit);
+  const auto layers = getLayers(*circuit);
+  const auto nLayers = layers.size() - 1U;
+
+  // split the layers into windows of `splitSize` layers starting at `offset`
+  std::vector<std::pair<std::size_t, std::size_t>> windows{};
+  if (offset > 0U) {
+    windows.emplace_back(layers.front(), layers[std::min(offset, nLayers)]);
+  }
+  for (std::size_t i = std::min(offset, nLayers); i < nLayers;
+       i += configuration.splitSize) {
+    windows.emplace_back(
+        layers[i], layers[std::min(i + configuration.splitSize, nLayers)]);
+  }
+
+  std::vector<std::size_t> toSynthesize{};
+  for (std::size_t w = 0U; w < windows.size(); ++w) {
+    const auto [begin, end] = windows[w];
+    if (changedOps.empty() ||
+        std::any_of(changedOps.cbegin() + static_cast<std::ptrdiff_t>(begin),
+                    changedOps.cbegin() + static_cast<std::ptrdiff_t>(end),
+                    [](const bool changed) { return changed; })) {
+      toSynthesize.emplace_back(w);
+    }
   }
 
-  for (auto& subCircuit : subCircuits) {
-    const auto& circ = subCircuit.get();
-    for (auto& it : *circ) {
-      optCircuit.emplace_back(std::move(it));
+  // synthesize the selected windows with at most `nThreadsHeuristic` threads
+  std::vector<std::shared_ptr<qc::QuantumComputation>> subCircuits(
+      windows.size());
+  const auto nThreads =
+      std::max<std::size_t>(1U, configuration.nThreadsHeuristic);
+  for (std::size_t i = 0U; i < toSynthesize.size(); i += nThreads) {
+    std::vector<std::future<std::shared_ptr<qc::QuantumComputation>>> futures;
+    for (std::size_t j = i; j < std::min(i + nThreads, toSynthesize.size());
+         ++j) {
+      const auto [begin, end] = windows[toSynthesize[j]];
+      futures.emplace_back(
+          std::async(std::launch::async | std::launch::deferred,
+                     [&circuit, begin, end, &config]() {
+                       return cs::CliffordSynthesizer::synthesizeSubcircuit(
+                           circuit, begin, end, config);
+                     }));
+    }
+    for (std::size_t j = i; j < std::min(i + nThreads, toSynthesize.size());
+         ++j) {
+      subCircuits[toSynthesize[j]] = futures[j - i].get();
     }
   }
-  results.setDepth(optCircuit.getDepth());
 
-  results.setResultCircuit(optCircuit);
+  auto optCircuit =
+      std::make_shared<qc::QuantumComputation>(circuit->getNqubits());
+  std::vector<bool> optChangedOps{};
+  for (std::size_t w = 0U; w < windows.size(); ++w) {
+    const auto [begin, end] = windows[w];
+    const auto& subCircuit = subCircuits[w];
+    bool improved = false;
+    if (subCircuit != nullptr) {
+      const auto depth = getDepth(ops, begin, end, circuit->getNqubits());
+      const auto newDepth = subCircuit->getDepth();
+      improved =
+          newDepth < depth || (newDepth == depth &&
+                               subCircuit->getNindividualOps() < end - begin);
+    }
+    if (subCircuit != nullptr && (acceptAll || improved)) {
+      for (auto& it : *subCircuit) {
+        optCircuit->emplace_back(std::move(it));
+        optChangedOps.emplace_back(improved);
+      }
+    } else {
+      for (std::size_t i = begin; i < end; ++i) {
+        optCircuit->emplace_back(ops[i]->clone());
+        optChangedOps.emplace_back(false);
+      }
+    }
+  }
+  return {optCircuit, optChangedOps};
 }
+
 std::shared_ptr<qc::QuantumComputation>
 CliffordSynthesizer::synthesizeSubcircuit(
     const std::shared_ptr<qc::QuantumComputation>& qc, std::size_t begin,
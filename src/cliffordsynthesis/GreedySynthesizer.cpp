@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) 2023 - 2025 Chair for Design Automation, TUM
+ * Copyright (c) 2025 Munich Quantum Software Company GmbH
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "cliffordsynthesis/GreedySynthesizer.hpp"
+
+#include "cliffordsynthesis/Results.hpp"
+#include "cliffordsynthesis/Tableau.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/Control.hpp"
+#include "ir/operations/OpType.hpp"
+#include "logicblocks/Logic.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <plog/Log.h>
+#include <stdexcept>
+#include <vector>
+
+namespace cs {
+
+namespace {
+// accessors for the entries of the row `row` of a tableau
+bool x(const Tableau& tableau, const std::size_t row, const std::size_t qubit) {
+  return tableau.getTableau()[row][qubit] == 1U;
+}
+bool z(const Tableau& tableau, const std::size_t row, const std::size_t qubit) {
+  return tableau.getTableau()[row][qubit + tableau.getQubitCount()] == 1U;
+}
+bool r(const Tableau& tableau, const std::size_t row) {
+  return tableau.getTableau()[row][2U * tableau.getQubitCount()] == 1U;
+}
+
+// number of qubits not yet eliminated on which the row acts non-trivially
+std::size_t support(const Tableau& tableau, const std::size_t row,
+                    const std::vector<bool>& eliminated) {
+  std::size_t count = 0U;
+  for (std::size_t q = 0U; q < tableau.getQubitCount(); ++q) {
+    if (!eliminated[q] && (x(tableau, row, q) || z(tableau, row, q))) {
+      ++count;
+    }
+  }
+  return count;
+}
+} // namespace
+
+Results GreedySynthesizer::run() const {
+  const auto start = std::chrono::high_resolution_clock::now();
+
+  const auto nQubits = initialTableau->getQubitCount();
+  if (targetTableau->getQubitCount() != nQubits) {
+    throw std::invalid_argument(
+        "Initial and target tableau must have the same number of qubits.");
+  }
+  const bool useDestabilizers = initialTableau->hasDestabilizers() &&
+                                targetTableau->hasDestabilizers();
+
+  // The gates reducing the initial tableau map it to the identity and the
+  // inverted gates reducing the target tableau map the identity to the target.
+  PLOG_INFO << "Running greedy synthesis for " << nQubits << " qubit(s)";
+  auto gates = reduce(*initialTableau, useDestabilizers);
+  const auto targetGates = reduce(*targetTableau, useDestabilizers);
+  for (auto it = targetGates.rbegin(); it != targetGates.rend(); ++it) {
+    gates.emplace_back(invert(*it));
+  }
+  gates = cancelGates(gates, nQubits);
+
+  qc::QuantumComputation qc(nQubits);
+  std::size_t nSingleQubitGates = 0U;
+  std::size_t nTwoQubitGates = 0U;
+  for (const auto& gate : gates) {
+    const auto target = static_cast<qc::Qubit>(gate.target);
+    if (gate.control.has_value()) {
+      qc.cx(qc::Control{static_cast<qc::Qubit>(*gate.control),
+                        qc::Control::Type::Pos},
+            target);
+      ++nTwoQubitGates;
+    } else {
+      qc.emplace_back<qc::StandardOperation>(target, gate.type);
+      ++nSingleQubitGates;
+    }
+  }
+
+  const auto end = std::chrono::high_resolution_clock::now();
+  const std::chrono::duration<double> runtime = end - start;
+  PLOG_INFO << "Greedy synthesis found a circuit with " << gates.size()
+            << " gate(s) in " << runtime.count() << " seconds";
+
+  Results res{};
+  res.setSolverResult(logicbase::Result::SAT);
+  res.setSingleQubitGates(nSingleQubitGates);
+  res.setTwoQubitGates(nTwoQubitGates);
+  res.setDepth(qc.getDepth());
+  res.setRuntime(runtime.count());
+  res.setResultCircuit(qc);
+  res.setResultTableau(*targetTableau);
+  return res;
+}
+
+GreedySynthesizer::GateList
+GreedySynthesizer::reduce(Tableau tableau, const bool useDestabilizers) {
+  GateList gates{};
+  if (useDestabilizers) {
+    reduceStabilizersAndDestabilizers(tableau, gates);
+  } else {
+    reduceStabilizers(tableau, gates);
+  }
+  return gates;
+}
+
+void GreedySynthesizer::reduceStabilizers(Tableau& tableau, GateList& gates) {
+  const auto n = tableau.getQubitCount();
+  // stabilizers follow the destabilizers if the tableau contains them
+  const auto offset = tableau.hasDestabilizers() ? n : 0U;
+
+  // Row i is reduced to Z_i. All rows not yet reduced commute with the reduced
+  // ones and, hence, have no X-component on eliminated qubits.
+  std::vector<bool> eliminated(n, false);
+  for (std::size_t step = 0U; step < n; ++step) {
+    // choose the row that requires the fewest two-qubit gates
+    std::size_t i = n;
+    std::size_t bestCost = std::numeric_limits<std::size_t>::max();
+    for (std::size_t candidate = 0U; candidate < n; ++candidate) {
+      if (eliminated[candidate]) {
+        continue;
+      }
+      const auto row = offset + candidate;
+      auto cost = support(tableau, row, eliminated);
+      if (!x(tableau, row, candidate) && !z(tableau, row, candidate)) {
+        ++cost;
+      }
+      for (std::size_t q = 0U; q < n; ++q) {
+        if (eliminated[q] && z(tableau, row, q)) {
+          ++cost;
+        }
+      }
+      if (cost < bestCost) {
+        bestCost = cost;
+        i = candidate;
+      }
+    }
+    const auto row = offset + i;
+
+    // turn the row into a product of X operators on the remaining qubits
+    std::optional<std::size_t> pivot = std::nullopt;
+    for (std::size_t q = 0U; q < n; ++q) {
+      if (eliminated[q]) {
+        if (x(tableau, row, q)) {
+          throw std::invalid_argument("Stabilizers do not commute.");
+        }
+        continue;
+      }
+      if (x(tableau, row, q) && z(tableau, row, q)) {
+        applyAndRecord(tableau, {qc::OpType::S, q}, gates);
+      } else if (z(tableau, row, q)) {
+        applyAndRecord(tableau, {qc::OpType::H, q}, gates);
+      }
+      if (x(tableau, row, q) && !pivot.has_value()) {
+        pivot = q;
+      }
+    }
+    if (!pivot.has_value()) {
+      throw std::invalid_argument("Stabilizers are not independent.");
+    }
+
+    // collect the X operators on qubit i
+    if (!x(tableau, row, i)) {
+      applyAndRecord(tableau, {qc::OpType::X, i, *pivot}, gates);
+    }
+    for (std::size_t q = 0U; q < n; ++q) {
+      if (q != i && !eliminated[q] && x(tableau, row, q)) {
+        applyAndRecord(tableau, {qc::OpType::X, q, i}, gates);
+      }
+    }
+    applyAndRecord(tableau, {qc::OpType::H, i}, gates);
+
+    // remove the Z operators on eliminated qubits
+    for (std::size_t q = 0U; q < n; ++q) {
+      if (eliminated[q] && z(tableau, row, q)) {
+        applyAndRecord(tableau, {qc::OpType::X, i, q}, gates);
+      }
+    }
+    eliminated[i] = true;
+  }
+
+  // fix the signs
+  for (std::size_t i = 0U; i < n; ++i) {
+    if (r(tableau, offset + i)) {
+      applyAndRecord(tableau, {qc::OpType::X, i}, gates);
+    }
+  }
+}
+
+void GreedySynthesizer::reduceStabilizersAndDestabilizers(Tableau& tableau,
+                                                          GateList& gates) {
+  const auto n = tableau.getQubitCount();
+
+  // The destabilizer i is reduced to X_i and the stabilizer i to Z_i. All
+  // other rows (anti-)commute accordingly and, hence, have no support on
+  // eliminated qubits.
+  std::vector<bool> eliminated(n, false);
+  for (std::size_t step = 0U; step < n; ++step) {
+    // choose the pair of rows that requires the fewest two-qubit gates
+    std::size_t i = n;
+    std::size_t bestCost = std::numeric_limits<std::size_t>::max();
+    for (std::size_t candidate = 0U; candidate < n; ++candidate) {
+      if (eliminated[candidate]) {
+        continue;
+      }
+      auto cost = support(tableau, candidate, eliminated) +
+                  support(tableau, n + candidate, eliminated);
+      if (!x(tableau, candidate, candidate) &&
+          !z(tableau, candidate, candidate)) {
+        ++cost;
+      }
+      if (cost < bestCost) {
+        bestCost = cost;
+        i = candidate;
+      }
+    }
+    const auto destabilizer = i;
+    const auto stabilizer = n + i;
+
+    // turn the destabilizer into a product of X operators
+    std::optional<std::size_t> pivot = std::nullopt;
+    for (std::size_t q = 0U; q < n; ++q) {
+      if (eliminated[q]) {
+        continue;
+      }
+      if (x(tableau, destabilizer, q) && z(tableau, destabilizer, q)) {
+        applyAndRecord(tableau, {qc::OpType::S, q}, gates);
+      } else if (z(tableau, destabilizer, q)) {
+        applyAndRecord(tableau, {qc::OpType::H, q}, gates);
+      }
+      if (x(tableau, destabilizer, q) && !pivot.has_value()) {
+        pivot = q;
+      }
+    }
+    if (!pivot.has_value()) {
+      throw std::invalid_argument("Destabilizers are not independent.");
+    }
+
+    // collect the X operators of the destabilizer on qubit i
+    if (!x(tableau, destabilizer, i)) {
+      applyAndRecord(tableau, {qc::OpType::X, i, *pivot}, gates);
+    }
+    for (std::size_t q = 0U; q < n; ++q) {
+      if (q != i && !eliminated[q] && x(tableau, destabilizer, q)) {
+        applyAndRecord(tableau, {qc::OpType::X, q, i}, gates);
+      }
+    }
+
+    // The stabilizer anti-commutes with X_i, i.e., it acts as Z or Y on qubit
+    // i. Gates on the other qubits leave the destabilizer unchanged.
+    if (!z(tableau, stabilizer, i)) {
+      throw std::invalid_argument(
+          "Stabilizer does not anti-commute with its destabilizer.");
+    }
+    for (std::size_t q = 0U; q < n; ++q) {
+      if (q == i || eliminated[q]) {
+        continue;
+      }
+      if (x(tableau, stabilizer, q) && z(tableau, stabilizer, q)) {
+        applyAndRecord(tableau, {qc::OpType::S, q}, gates);
+      }
+      if (x(tableau, stabilizer, q)) {
+        applyAndRecord(tableau, {qc::OpType::H, q}, gates);
+      }
+    }
+    for (std::size_t q = 0U; q < n; ++q) {
+      if (q != i && !eliminated[q] && z(tableau, stabilizer, q)) {
+        applyAndRecord(tableau, {qc::OpType::X, i, q}, gates);
+      }
+    }
+    if (x(tableau, stabilizer, i)) {
+      // H S H maps Y to Z and leaves X unchanged
+      applyAndRecord(tableau, {qc::OpType::H, i}, gates);
+      applyAndRecord(tableau, {qc::OpType::S, i}, gates);
+      applyAndRecord(tableau, {qc::OpType::H, i}, gates);
+    }
+    eliminated[i] = true;
+  }
+
+  // fix the signs
+  for (std::size_t i = 0U; i < n; ++i) {
+    if (r(tableau, i)) {
+      applyAndRecord(tableau, {qc::OpType::Z, i}, gates);
+    }
+    if (r(tableau, n + i)) {
+      applyAndRecord(tableau, {qc::OpType::X, i}, gates);
+    }
+  }
+}
+
+void GreedySynthesizer::apply(Tableau& tableau, const Gate& gate) {
+  if (gate.control.has_value()) {
+    tableau.applyCX(*gate.control, gate.target);
+    return;
+  }
+  switch (gate.type) {
+  case qc::OpType::H:
+    tableau.applyH(gate.target);
+    break;
+  case qc::OpType::S:
+    tableau.applyS(gate.target);
+    break;
+  case qc::OpType::Sdg:
+    tableau.applySdag(gate.target);
+    break;
+  case qc::OpType::X:
+    tableau.applyX(gate.target);
+    break;
+  case qc::OpType::Y:
+    tableau.applyY(gate.target);
+    break;
+  case qc::OpType::Z:
+    tableau.applyZ(gate.target);
+    break;
+  default:
+    throw std::runtime_error("Unsupported gate in greedy synthesis: " +
+                             qc::toString(gate.type));
+  }
+}
+
+void GreedySynthesizer::applyAndRecord(Tableau& tableau, const Gate& gate,
+                                       GateList& gates) {
+  apply(tableau, gate);
+  gates.emplace_back(gate);
+}
+
+GreedySynthesizer::Gate GreedySynthesizer::invert(const Gate& gate) {
+  auto inverted = gate;
+  if (gate.type == qc::OpType::S && !gate.control.has_value()) {
+    inverted.type = qc::OpType::Sdg;
+  } else if (gate.type == qc::OpType::Sdg) {
+    inverted.type = qc::OpType::S;
+  }
+  return inverted;
+}
+
+bool GreedySynthesizer::cancels(const Gate& lhs, const Gate& rhs) {
+  const auto inverted = invert(rhs);
+  return lhs.type == inverted.type && lhs.target == inverted.target &&
+         lhs.control == inverted.control;
+}
+
+GreedySynthesizer::GateList
+GreedySynthesizer::cancelGates(const GateList& gates,
+                               const std::size_t nQubits) {
+  // for every qubit, the indices of the remaining gates acting on it
+  std::vector<std::vector<std::size_t>> gatesOnQubit(nQubits);
+  std::vector<bool> removed(gates.size(), false);
+  for (std::size_t g = 0U; g < gates.size(); ++g) {
+    const auto& gate = gates[g];
+    auto& targetGates = gatesOnQubit[gate.target];
+    if (!targetGates.empty() && cancels(gates[targetGates.back()], gate)) {
+      const auto previous = targetGates.back();
+      if (!gate.control.has_value()) {
+        targetGates.pop_back();
+        removed[previous] = true;
+        removed[g] = true;
+        continue;
+      }
+      auto& controlGates = gatesOnQubit[*gate.control];
+      if (!controlGates.empty() && controlGates.back() == previous) {
+        targetGates.pop_back();
+        controlGates.pop_back();
+        removed[previous] = true;
+        removed[g] = true;
+        continue;
+      }
+    }
+    targetGates.emplace_back(g);
+    if (gate.control.has_value()) {
+      gatesOnQubit[*gate.control].emplace_back(g);
+    }
+  }
+
+  GateList result{};
+  for (std::size_t g = 0U; g < gates.size(); ++g) {
+    if (!removed[g]) {
+      result.emplace_back(gates[g]);
+    }
+  }
+  return result;
+}
+
+} // namespace cs
@@ -97,8 +97,8 @@ void GateEncoder::Variables::collectTwoQubitGateVariables(
 
 void GateEncoder::assertExactlyOne(const LogicVector& variables) const {
   const auto variableGrouping = encodings::groupVars(variables, 3U);
-  lb->assertFormula(encodings::exactlyOneCmdr(variableGrouping,
-                                              LogicTerm::noneTerm(), lb.get()));
+  encodings::addExactlyOneCmdr(variableGrouping, LogicTerm::noneTerm(),
+                               lb.get());
 }
 
 std::vector<GateEncoder::TransformationFamily>
@@ -13,10 +13,11 @@
 #include "cliffordsynthesis/TargetMetric.hpp"
 #include "cliffordsynthesis/encoding/GateEncoder.hpp"
 #include "ir/operations/OpType.hpp"
+#include "logicblocks/Encodings.hpp"
+#include "logicblocks/Logic.hpp"
 #include "logicblocks/LogicTerm.hpp"
 
 #include <cstddef>
-#include <functional>
 #include <plog/Log.h>
 #include <stdexcept>
 
@@ -28,14 +29,35 @@ LogicTerm
 ObjectiveEncoder::collectGateCount(const bool includeSingleQubitGates) const {
   auto cost = LogicTerm(0);
   for (std::size_t t = 0U; t < T; ++t) {
-    if (includeSingleQubitGates) {
-      collectSingleQubitGateTerms(t, cost, std::plus{});
-    }
-    collectTwoQubitGateTerms(t, cost, std::plus{});
+    forEachGateVariable(t, includeSingleQubitGates,
+                        [&cost](const LogicTerm& gate) { cost = cost + gate; });
   }
   return cost;
 }
 
+LogicVector ObjectiveEncoder::collectGateVariables(
+    const bool includeSingleQubitGates) const {
+  LogicVector variables;
+  for (std::size_t t = 0U; t < T; ++t) {
+    forEachGateVariable(t, includeSingleQubitGates,
+                        [&variables](const LogicTerm& gate) {
+                          variables.emplace_back(gate);
+                        });
+  }
+  return variables;
+}
+
+void ObjectiveEncoder::limitGateCount(
+    const std::size_t maxGateCount, const bool includeSingleQubitGates) const {
+  PLOG_DEBUG << "Limiting gate count to at most " << maxGateCount
+             << (includeSingleQubitGates ? "" : " two-qubit") << " gate(s)";
+
+  // The gate variables are Boolean, so the limit is a cardinality constraint
+  // that is emitted as clauses directly instead of an integer sum.
+  encodings::addAtMostK(collectGateVariables(includeSingleQubitGates),
+                        maxGateCount, lb.get());
+}
+
 void ObjectiveEncoder::optimizeGateCount(
     const bool includeSingleQubitGates) const {
   PLOG_DEBUG << "Optimizing " << (includeSingleQubitGates ? "" : "two-qubit ")
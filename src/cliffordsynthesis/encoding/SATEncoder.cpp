@@ -11,6 +11,7 @@
 #include "cliffordsynthesis/encoding/SATEncoder.hpp"
 
 #include "Logic.hpp"
+#include "cliffordsynthesis/CancellationToken.hpp"
 #include "cliffordsynthesis/Results.hpp"
 #include "cliffordsynthesis/encoding/MultiGateEncoder.hpp"
 #include "cliffordsynthesis/encoding/ObjectiveEncoder.hpp"
@@ -21,7 +22,6 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
-#include <functional>
 #include <memory>
 #include <plog/Log.h>
 #include <stdexcept>
@@ -98,12 +98,11 @@ void SATEncoder::createFormulation() {
       std::make_shared<ObjectiveEncoder>(N, T, gateEncoder->getVariables(), lb);
 
   if (config.gateLimit.has_value()) {
-    objectiveEncoder->limitGateCount(*config.gateLimit, std::less_equal{});
+    objectiveEncoder->limitGateCount(*config.gateLimit);
   }
 
   if (config.twoQubitGateLimit.has_value()) {
-    objectiveEncoder->limitGateCount(*config.twoQubitGateLimit,
-                                     std::less_equal{}, false);
+    objectiveEncoder->limitGateCount(*config.twoQubitGateLimit, false);
   }
 
   if (config.useMaxSAT) {
@@ -120,6 +119,14 @@ void SATEncoder::createFormulation() {
 Result SATEncoder::solve() const {
   PLOG_INFO << "Solving the SAT instance.";
 
+  // a cancellation after the registration is remembered by the logic block
+  // until its solver is started
+  const CancellationToken::ScopedRegistration registration(
+      config.cancellation.get(), lb.get());
+  if (!registration.isRegistered()) {
+    PLOG_INFO << "Solving cancelled.";
+    return Result::NDEF;
+  }
   const auto start = std::chrono::high_resolution_clock::now();
   const auto result = lb->solve();
   const auto end = std::chrono::high_resolution_clock::now();
@@ -142,6 +149,9 @@ void SATEncoder::cleanup() const {
   }
 }
 Results SATEncoder::run() {
+  if (config.cancellation && config.cancellation->isCancelled()) {
+    return {};
+  }
   const auto start = std::chrono::high_resolution_clock::now();
 
   createFormulation();
@@ -116,6 +116,124 @@ LogicTerm atMostOneCmdr(const std::vector<NestedVar>& subords,
   return ret && naiveAtMostOne(clauseVars);
 }
 
+void addAtLeastOne(const std::vector<LogicTerm>& literals, LogicBlock* logic) {
+  logic->addClause(literals);
+}
+
+void addNaiveAtMostOne(const std::vector<LogicTerm>& literals,
+                       LogicBlock* logic) {
+  for (std::size_t i = 0U; i < literals.size(); ++i) {
+    for (std::size_t j = i + 1U; j < literals.size(); ++j) {
+      logic->addClause({!literals[i], !literals[j]});
+    }
+  }
+}
+
+void addAtMostOneCmdr(const std::vector<NestedVar>& subords,
+                      const LogicTerm& cmdrVar, LogicBlock* logic) {
+  std::vector<LogicTerm> literals;
+  literals.reserve(subords.size() + 1U);
+  for (const auto& it : subords) {
+    if (it.var.getOpType() != OpType::None) {
+      literals.emplace_back(it.var);
+    } else {
+      LogicTerm const localCdr = logic->makeVariable("cdr_var");
+      literals.emplace_back(localCdr);
+      addAtMostOneCmdr(it.list, localCdr, logic);
+    }
+  }
+  if (cmdrVar.getOpType() == OpType::Variable) {
+    literals.emplace_back(!cmdrVar);
+  }
+  addNaiveAtMostOne(literals, logic);
+}
+
+void addExactlyOneCmdr(const std::vector<NestedVar>& subords,
+                       const LogicTerm& cmdrVar, LogicBlock* logic) {
+  std::vector<LogicTerm> literals;
+  literals.reserve(subords.size() + 1U);
+  for (const auto& it : subords) {
+    if (it.var.getOpType() != OpType::None) {
+      literals.emplace_back(it.var);
+    } else {
+      LogicTerm const localCdr = logic->makeVariable("cdr_var");
+      literals.emplace_back(localCdr);
+      addExactlyOneCmdr(it.list, localCdr, logic);
+    }
+  }
+  if (cmdrVar.getOpType() == OpType::Variable) {
+    literals.emplace_back(!cmdrVar);
+  }
+  addAtLeastOne(literals, logic);
+  addNaiveAtMostOne(literals, logic);
+}
+
+void addAtMostOneBiMander(const std::vector<LogicTerm>& literals,
+                          LogicBlock* logic) {
+  if (literals.size() < 2U) {
+    return;
+  }
+  const auto subords = groupVarsBimander(literals, literals.size() / 2);
+  const auto m = subords.size();
+  const auto nBits = static_cast<std::size_t>(std::ceil(std::log2(m)));
+  std::vector<LogicTerm> binaryVars{};
+  binaryVars.reserve(nBits);
+  for (std::size_t j = 0U; j < nBits; ++j) {
+    binaryVars.emplace_back(
+        logic->makeVariable("binary_var_" + std::to_string(j)));
+  }
+  // every literal of group i implies the binary representation of i
+  for (std::size_t i = 0U; i < m; ++i) {
+    addNaiveAtMostOne(subords[i], logic);
+    for (const auto& literal : subords[i]) {
+      for (std::size_t j = 0U; j < nBits; ++j) {
+        if ((i & 1U << j) != 0U) {
+          logic->addClause({!literal, binaryVars[j]});
+        } else {
+          logic->addClause({!literal, !binaryVars[j]});
+        }
+      }
+    }
+  }
+}
+
+void addAtMostK(const std::vector<LogicTerm>& literals, const std::size_t k,
+                LogicBlock* logic) {
+  const auto n = literals.size();
+  if (k >= n) {
+    return;
+  }
+  if (k == 0U) {
+    for (const auto& literal : literals) {
+      logic->addClause({!literal});
+    }
+    return;
+  }
+  // s[i][j] holds if at least j+1 of the first i+1 literals are true
+  std::vector<std::vector<LogicTerm>> s(n - 1U);
+  for (std::size_t i = 0U; i < n - 1U; ++i) {
+    s[i].reserve(k);
+    for (std::size_t j = 0U; j < k; ++j) {
+      s[i].emplace_back(logic->makeVariable("seq_counter_" + std::to_string(i) +
+                                            "_" + std::to_string(j)));
+    }
+  }
+  logic->addClause({!literals[0], s[0][0]});
+  for (std::size_t j = 1U; j < k; ++j) {
+    logic->addClause({!s[0][j]});
+  }
+  for (std::size_t i = 1U; i < n - 1U; ++i) {
+    logic->addClause({!literals[i], s[i][0]});
+    logic->addClause({!s[i - 1][0], s[i][0]});
+    for (std::size_t j = 1U; j < k; ++j) {
+      logic->addClause({!literals[i], !s[i - 1][j - 1], s[i][j]});
+      logic->addClause({!s[i - 1][j], s[i][j]});
+    }
+    logic->addClause({!literals[i], !s[i - 1][k - 1]});
+  }
+  logic->addClause({!literals[n - 1], !s[n - 2][k - 1]});
+}
+
 std::vector<NestedVar> groupVars(const std::vector<LogicTerm>& vars,
                                  std::size_t maxSize) {
   std::vector<NestedVar> vVars;
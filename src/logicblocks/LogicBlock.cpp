@@ -30,6 +30,14 @@ void LogicBlock::assertFormula(const LogicTerm& a) {
   }
 }
 
+void LogicBlock::addClause(const LogicVector& literals) {
+  auto clause = LogicTerm(false);
+  for (const auto& literal : literals) {
+    clause = clause || literal;
+  }
+  assertFormula(clause);
+}
+
 LogicTerm LogicBlock::makeVariable(const std::string& name, CType type,
                                    uint16_t bvSize) {
   if (type == CType::BITVECTOR && bvSize == 0) {
@@ -43,7 +51,9 @@ void LogicBlock::reset() {
   model = nullptr;
   clauses.clear();
   internalReset();
+  termTable.clear();
   gid = 0U;
+  interrupted = false;
 }
 
 void LogicBlockOptimizer::reset() {
@@ -51,7 +61,9 @@ void LogicBlockOptimizer::reset() {
   clauses.clear();
   weightedTerms.clear();
   internalReset();
+  termTable.clear();
   gid = 0U;
+  interrupted = false;
 }
 
 void LogicBlockOptimizer::weightedTerm(const LogicTerm& a, double weight) {
@@ -13,11 +13,14 @@
 #include "Logic.hpp"
 
 #include <algorithm>
+#include <bit>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <initializer_list>
 #include <limits>
+#include <memory>
 #include <ostream>
 #include <sstream>
 #include <stdexcept>
@@ -143,13 +146,22 @@ uint64_t LogicTerm::getNextId(Logic* logic) {
 
 LogicTerm::LogicTerm(OpType op, const std::initializer_list<LogicTerm>& n,
                      CType type, Logic* logic)
-    : lb(logic), id(getNextId(logic)), depth(getMax(n)), name(getStrRep(op)),
-      opType(op), bvSize(getMaxBVSize(n)), nodes(n), cType(type) {}
+    : LogicTerm(op, std::vector<LogicTerm>(n), type, logic) {}
 
 LogicTerm::LogicTerm(OpType op, const std::vector<LogicTerm>& n, CType type,
                      Logic* logic)
-    : lb(logic), id(getNextId(logic)), depth(getMax(n)), name(getStrRep(op)),
-      opType(op), bvSize(getMaxBVSize(n)), nodes(n), cType(type) {}
+    : lb(logic), depth(getMax(n)), name(getStrRep(op)), opType(op),
+      bvSize(getMaxBVSize(n)), cType(type) {
+  TermTable* table = logic == nullptr ? nullptr : logic->getTermTable();
+  if (table == nullptr) {
+    id = getNextId(logic);
+    nodes = std::make_shared<const std::vector<LogicTerm>>(n);
+    return;
+  }
+  auto entry = table->intern(op, type, n, logic);
+  id = entry.id;
+  nodes = std::move(entry.nodes);
+}
 
 LogicTerm::LogicTerm(Logic* logic)
     : lb(logic), id(getNextId(lb)), name(std::to_string(id)) {}
@@ -313,6 +325,11 @@ LogicTerm LogicTerm::operator<=(const LogicTerm& other) const {
 
 LogicTerm LogicTerm::operator!() const { return neg(*this); }
 
+const std::vector<LogicTerm>& LogicTerm::getNodes() const {
+  static const std::vector<LogicTerm> NO_NODES{};
+  return nodes ? *nodes : NO_NODES;
+}
+
 bool LogicTerm::isConst() const { return getOpType() == OpType::Constant; }
 
 bool LogicTerm::getBoolValue() const {
@@ -394,6 +411,11 @@ bool LogicTerm::deepEquals(const LogicTerm& other) const {
   if (getOpType() == OpType::Variable && getID() == other.getID()) {
     return true;
   }
+  // structurally equal compound terms of a logic are interned
+  if (!isConst() && getLogic() != nullptr && getLogic() == other.getLogic() &&
+      getLogic()->getTermTable() != nullptr && getID() == other.getID()) {
+    return true;
+  }
   if (getDepth() != other.getDepth()) {
     return false;
   }
@@ -707,6 +729,62 @@ bool TermHash::operator()(const LogicTerm& t1, const LogicTerm& t2) const {
   }
 }
 
+TermTable::Entry TermTable::intern(const OpType op, const CType type,
+                                   const std::vector<LogicTerm>& n,
+                                   Logic* logic) {
+  // Every child is identified by two words: a tag distinguishing non-constant
+  // terms (0) from constants of a certain type and size, and a payload that
+  // is either the id of the term or the value of the constant.
+  std::vector<uint64_t> key;
+  key.reserve(2 + (2 * n.size()));
+  key.emplace_back(static_cast<uint64_t>(op));
+  key.emplace_back(static_cast<uint64_t>(type));
+  for (const auto& child : n) {
+    if (!child.isConst()) {
+      if (child.getLogic() != logic) {
+        return {logic->getNextId(),
+                std::make_shared<const std::vector<LogicTerm>>(n)};
+      }
+      key.emplace_back(0U);
+      key.emplace_back(child.getID());
+      continue;
+    }
+    key.emplace_back(1U + static_cast<uint64_t>(child.getCType()) +
+                     (static_cast<uint64_t>(child.getBitVectorSize()) << 8U));
+    switch (child.getCType()) {
+    case CType::BOOL:
+      key.emplace_back(child.getBoolValue() ? 1U : 0U);
+      break;
+    case CType::INT:
+      key.emplace_back(static_cast<uint64_t>(child.getIntValue()));
+      break;
+    case CType::REAL:
+      key.emplace_back(std::bit_cast<uint64_t>(child.getFloatValue()));
+      break;
+    default:
+      key.emplace_back(child.getBitVectorValue());
+      break;
+    }
+  }
+
+  const auto [it, inserted] = table.try_emplace(std::move(key));
+  if (inserted) {
+    it->second.id = logic->getNextId();
+    it->second.nodes = std::make_shared<const std::vector<LogicTerm>>(n);
+  }
+  return it->second;
+}
+
+std::size_t
+TermTable::KeyHash::operator()(const std::vector<uint64_t>& key) const {
+  std::size_t seed = key.size();
+  for (const auto word : key) {
+    seed ^= std::hash<uint64_t>{}(word) + 0x9e3779b97f4a7c15ULL + (seed << 6U) +
+            (seed >> 2U);
+  }
+  return seed;
+}
+
 bool TermDepthComparator::operator()(const LogicTerm& t1,
                                      const LogicTerm& t2) const {
   if (t1.getOpType() == OpType::None || t2.getOpType() == OpType::None) {
@@ -14,10 +14,12 @@
 #include "LogicTerm.hpp"
 #include "Z3Model.hpp"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <plog/Log.h>
 #include <sstream>
 #include <stdexcept>
@@ -44,6 +46,23 @@ CType extractNumberType(
   }
   return res;
 }
+
+// After an interrupt, Z3 throws on every operation of the context until the
+// next check is started. solve() returns NDEF without a check in this case,
+// hence, formulas added to the solver in the meantime are dropped instead.
+template <class Add>
+void addUnlessInterrupted(const std::atomic<bool>& interrupted, Add&& add) {
+  if (interrupted) {
+    return;
+  }
+  try {
+    std::forward<Add>(add)();
+  } catch (const z3::exception&) {
+    if (!interrupted) {
+      throw;
+    }
+  }
+}
 } // namespace
 
 z3::expr Z3Base::getExprTerm(const uint64_t id, const CType type,
@@ -62,26 +81,23 @@ z3::expr Z3Base::convert(const LogicTerm& a, CType toType) {
   if (a.getOpType() == OpType::Constant) {
     return convertConstant(a, toType);
   }
-  std::vector<std::pair<bool, z3::expr>> v;
+  // Variables are cached separately
+  if (a.getOpType() == OpType::Variable) {
+    return convertVariableTo(a, toType);
+  }
 
-  // First, try to find the expression in the cache
-  if (cache.contains(a)) {
-    v = cache.at(a);
-    if (v[static_cast<size_t>(toType)].first) {
-      return v[static_cast<size_t>(toType)].second;
-    }
-  } else {
-    for (int32_t i = 0; i < 4; i++) {
-      v.emplace_back(false, ctx->bool_val(false));
-    }
+  // First, try to find the expression in the cache. Since structurally equal
+  // terms are interned, this also covers subterms shared between formulas.
+  const auto idx = static_cast<size_t>(toType);
+  const auto key = std::pair<const Logic*, uint64_t>{a.getLogic(), a.getID()};
+  if (const auto it = cache.find(key);
+      it != cache.end() && it->second[idx].has_value()) {
+    return *it->second[idx];
   }
 
   // If the expression is not in the cache, convert it
+  std::optional<z3::expr> e;
   switch (a.getOpType()) {
-  case OpType::Variable: {
-    v[static_cast<size_t>(toType)].second = convertVariableTo(a, toType);
-  } break;
-
   case OpType::AND: {
     z3::expr s = this->ctx->bool_val(true);
     bool alternate = false;
@@ -93,7 +109,7 @@ z3::expr Z3Base::convert(const LogicTerm& a, CType toType) {
       }
       alternate = !alternate;
     }
-    v[static_cast<size_t>(toType)].second = s.simplify();
+    e = s.simplify();
   } break;
   case OpType::OR: {
     z3::expr s = this->ctx->bool_val(false);
@@ -106,81 +122,73 @@ z3::expr Z3Base::convert(const LogicTerm& a, CType toType) {
       }
       alternate = !alternate;
     }
-    v[static_cast<size_t>(toType)].second = s.simplify();
+    e = s.simplify();
   } break;
   case OpType::EQ:
-    v[static_cast<size_t>(toType)].second = convertOperator(
-        a.getNodes()[0], a.getNodes()[1], z3::operator==, CType::ERRORTYPE);
+    e = convertOperator(a.getNodes()[0], a.getNodes()[1], z3::operator==,
+                        CType::ERRORTYPE);
     break;
   case OpType::XOR:
-    v[static_cast<size_t>(toType)].second = convertOperator(
-        a.getNodes()[0], a.getNodes()[1], z3::operator!=, CType::ERRORTYPE);
+    e = convertOperator(a.getNodes()[0], a.getNodes()[1], z3::operator!=,
+                        CType::ERRORTYPE);
     break;
   case OpType::NEG:
-    v[static_cast<size_t>(toType)].second =
-        convertOperator(a.getNodes()[0], z3::operator!, CType::ERRORTYPE);
+    e = convertOperator(a.getNodes()[0], z3::operator!, CType::ERRORTYPE);
     break;
   case OpType::ITE:
-    v[static_cast<size_t>(toType)].second =
-        convertOperator(a.getNodes()[0], a.getNodes()[1], a.getNodes()[2],
+    e = convertOperator(a.getNodes()[0], a.getNodes()[1], a.getNodes()[2],
                         z3::ite, CType::ERRORTYPE);
     break;
   case OpType::IMPL:
-    v[static_cast<size_t>(toType)].second = convertOperator(
-        a.getNodes()[0], a.getNodes()[1], z3::implies, CType::BOOL);
+    e = convertOperator(a.getNodes()[0], a.getNodes()[1], z3::implies,
+                        CType::BOOL);
     break;
   case OpType::ADD: {
-    v[static_cast<size_t>(toType)].second = convertOperator(
-        a.getNodes(), z3::operator+, extractNumberType(a.getNodes()));
+    e = convertOperator(a.getNodes(), z3::operator+,
+                        extractNumberType(a.getNodes()));
   } break;
   case OpType::SUB: {
-    v[static_cast<size_t>(toType)].second = convertOperator(
-        a.getNodes(), z3::operator-, extractNumberType(a.getNodes()));
+    e = convertOperator(a.getNodes(), z3::operator-,
+                        extractNumberType(a.getNodes()));
   } break;
   case OpType::MUL: {
-    v[static_cast<size_t>(toType)].second = convertOperator(
-        a.getNodes(), z3::operator*, extractNumberType(a.getNodes()));
+    e = convertOperator(a.getNodes(), z3::operator*,
+                        extractNumberType(a.getNodes()));
   } break;
   case OpType::DIV: {
-    v[static_cast<size_t>(toType)].second =
-        convertOperator(a.getNodes()[0], a.getNodes()[1], z3::operator/,
+    e = convertOperator(a.getNodes()[0], a.getNodes()[1], z3::operator/,
                         extractNumberType(a.getNodes()));
   } break;
   case OpType::GT: {
-    v[static_cast<size_t>(toType)].second =
-        convertOperator(a.getNodes()[0], a.getNodes()[1], z3::operator>,
+    e = convertOperator(a.getNodes()[0], a.getNodes()[1], z3::operator>,
                         extractNumberType(a.getNodes()));
   } break;
   case OpType::LT: {
-    v[static_cast<size_t>(toType)].second =
-        convertOperator(a.getNodes()[0], a.getNodes()[1], z3::operator<,
+    e = convertOperator(a.getNodes()[0], a.getNodes()[1], z3::operator<,
                         extractNumberType(a.getNodes()));
   } break;
   case OpType::GTE: {
-    v[static_cast<size_t>(toType)].second =
-        convertOperator(a.getNodes()[0], a.getNodes()[1], z3::operator>=,
+    e = convertOperator(a.getNodes()[0], a.getNodes()[1], z3::operator>=,
                         extractNumberType(a.getNodes()));
   } break;
   case OpType::LTE: {
-    v[static_cast<size_t>(toType)].second =
-        convertOperator(a.getNodes()[0], a.getNodes()[1], z3::operator<=,
+    e = convertOperator(a.getNodes()[0], a.getNodes()[1], z3::operator<=,
                         extractNumberType(a.getNodes()));
   } break;
   case OpType::BitAnd: {
-    v[static_cast<size_t>(toType)].second = convertOperator(
-        a.getNodes(), z3::operator&, extractNumberType(a.getNodes()));
+    e = convertOperator(a.getNodes(), z3::operator&,
+                        extractNumberType(a.getNodes()));
   } break;
   case OpType::BitOr: {
-    v[static_cast<size_t>(toType)].second = convertOperator(
-        a.getNodes(), z3::operator|, extractNumberType(a.getNodes()));
+    e = convertOperator(a.getNodes(), z3::operator|,
+                        extractNumberType(a.getNodes()));
   } break;
   case OpType::BitXor: {
-    v[static_cast<size_t>(toType)].second = convertOperator(
-        a.getNodes(), z3::operator^, extractNumberType(a.getNodes()));
+    e = convertOperator(a.getNodes(), z3::operator^,
+                        extractNumberType(a.getNodes()));
   } break;
   case OpType::BitEq: {
-    v[static_cast<size_t>(toType)].second =
-        convertOperator(a.getNodes()[0], a.getNodes()[1], z3::operator==,
+    e = convertOperator(a.getNodes()[0], a.getNodes()[1], z3::operator==,
                         extractNumberType(a.getNodes()));
   } break;
   default:
@@ -190,9 +198,8 @@ z3::expr Z3Base::convert(const LogicTerm& a, CType toType) {
   }
 
   // Cache the result and return it
-  v[static_cast<size_t>(toType)].first = true;
-  cache.insert_or_assign(a, v);
-  return cache.at(a)[static_cast<size_t>(toType)].second;
+  cache[key][idx] = *e;
+  return *e;
 }
 
 void Z3LogicBlock::assertFormula(const LogicTerm& a) {
@@ -200,17 +207,27 @@ void Z3LogicBlock::assertFormula(const LogicTerm& a) {
     for (const auto& clause : a.getNodes()) {
       clauses.insert(clause);
       if (convertWhenAssert) {
-        this->solver->add(convert(clause, CType::BOOL).simplify());
+        addUnlessInterrupted(interrupted, [this, &clause] {
+          this->solver->add(convert(clause, CType::BOOL).simplify());
+        });
       }
     }
   } else {
     clauses.insert(a);
     if (convertWhenAssert) {
-      this->solver->add(convert(a, CType::BOOL).simplify());
+      addUnlessInterrupted(interrupted, [this, &a] {
+        this->solver->add(convert(a, CType::BOOL).simplify());
+      });
     }
   }
 }
 
+void Z3LogicBlock::addClause(const LogicVector& literals) {
+  addUnlessInterrupted(interrupted, [this, &literals] {
+    solver->add(convertClause(literals));
+  });
+}
+
 void Z3LogicBlock::produceInstance() {
   for (const auto& clause : clauses) {
     solver->add(convert(clause, CType::BOOL).simplify());
@@ -218,17 +235,42 @@ void Z3LogicBlock::produceInstance() {
 }
 
 Result Z3LogicBlock::solve() {
-  produceInstance();
+  try {
+    produceInstance();
+  } catch (const z3::exception&) {
+    // an interrupt makes all operations on the context throw until the next
+    // check is started
+    if (interrupted) {
+      return Result::NDEF;
+    }
+    throw;
+  }
+  // the next check would clear a pending interrupt instead of stopping
+  if (interrupted) {
+    return Result::NDEF;
+  }
   const auto res = solver->check();
   if (res == z3::sat) {
     // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
     model = new Z3Model(ctx, std::make_shared<z3::model>(solver->get_model()));
     return Result::SAT;
   }
+  if (res == z3::unknown) {
+    return Result::NDEF;
+  }
   return Result::UNSAT;
 }
 
 void Z3LogicBlock::internalReset() {
+  if (interrupted) {
+    // An interrupt that did not stop a running check, e.g., because solve()
+    // returned before it started the solver, stays pending in the shared
+    // context until the next check is started. Until then, every operation on
+    // the context, e.g., simplify() in the next produceInstance(), throws. A
+    // check of an empty solver clears the interrupt, so the logic block can be
+    // reused after the reset.
+    z3::solver(*ctx).check();
+  }
   variables.clear();
   cache.clear();
   solver->reset();
@@ -402,6 +444,14 @@ z3::expr Z3Base::convertConstant(const LogicTerm& a, CType toType) {
   }
 }
 
+z3::expr Z3Base::convertClause(const LogicVector& literals) {
+  z3::expr_vector lits(*ctx);
+  for (const auto& literal : literals) {
+    lits.push_back(convert(literal, CType::BOOL));
+  }
+  return z3::mk_or(lits);
+}
+
 bool Z3LogicOptimizer::makeMinimize() {
   for (const auto& [term, weight] : weightedTerms) {
     optimizer->add(convert(LogicTerm::neg(term), CType::BOOL).simplify(),
@@ -432,17 +482,27 @@ void Z3LogicOptimizer::assertFormula(const LogicTerm& a) {
     for (const auto& clause : a.getNodes()) {
       clauses.insert(clause);
       if (convertWhenAssert) {
-        optimizer->add(convert(clause, CType::BOOL).simplify());
+        addUnlessInterrupted(interrupted, [this, &clause] {
+          optimizer->add(convert(clause, CType::BOOL).simplify());
+        });
       }
     }
   } else {
     clauses.insert(a);
     if (convertWhenAssert) {
-      optimizer->add(convert(a, CType::BOOL).simplify());
+      addUnlessInterrupted(interrupted, [this, &a] {
+        optimizer->add(convert(a, CType::BOOL).simplify());
+      });
     }
   }
 }
 
+void Z3LogicOptimizer::addClause(const LogicVector& literals) {
+  addUnlessInterrupted(interrupted, [this, &literals] {
+    optimizer->add(convertClause(literals));
+  });
+}
+
 void Z3LogicOptimizer::produceInstance() {
   for (const auto& clause : clauses) {
     optimizer->add(convert(clause, CType::BOOL).simplify());
@@ -450,7 +510,20 @@ void Z3LogicOptimizer::produceInstance() {
 }
 
 Result Z3LogicOptimizer::solve() {
-  produceInstance();
+  try {
+    produceInstance();
+  } catch (const z3::exception&) {
+    // an interrupt makes all operations on the context throw until the next
+    // check is started
+    if (interrupted) {
+      return Result::NDEF;
+    }
+    throw;
+  }
+  // the next check would clear a pending interrupt instead of stopping
+  if (interrupted) {
+    return Result::NDEF;
+  }
   const auto res = optimizer->check();
   if (res == z3::sat) {
     // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
@@ -458,10 +531,18 @@ Result Z3LogicOptimizer::solve() {
         new Z3Model(ctx, std::make_shared<z3::model>(optimizer->get_model()));
     return Result::SAT;
   }
+  if (res == z3::unknown) {
+    return Result::NDEF;
+  }
   return Result::UNSAT;
 }
 
 void Z3LogicOptimizer::internalReset() {
+  if (interrupted) {
+    // clears a pending interrupt of the context, see
+    // Z3LogicBlock::internalReset
+    z3::solver(*ctx).check();
+  }
   weightedTerms.clear();
   variables.clear();
   cache.clear();
@@ -15,17 +15,24 @@
 #include "ir/QuantumComputation.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include <numeric>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -104,6 +111,23 @@ auto NASolver::minBitsToRepresentInt(const int32_t num) -> uint32_t {
   return minBitsToRepresentUInt(static_cast<uint16_t>(std::abs(num))) + 1;
 }
 
+auto NASolver::getStageBits() const -> uint32_t {
+  // the stages are indexed from 0 to numStages - 1
+  return numStages > 1 ? minBitsToRepresentUInt(numStages - 1) : 1U;
+}
+
+auto NASolver::getBeforeStageConstraint(const expr& stage,
+                                        const int32_t t) const -> expr {
+  if (t <= 0) {
+    return ctx->bool_val(false);
+  }
+  if (t >= (1 << getStageBits())) {
+    // every value of the bit-vector is less than t
+    return ctx->bool_val(true);
+  }
+  return ult(stage, ctx->bv_val(t, getStageBits()));
+}
+
 auto NASolver::initVariables() -> void {
   stages.clear();
   stages.reserve(numStages);
@@ -117,7 +141,7 @@ auto NASolver::initVariables() -> void {
     for (uint16_t t = 0; t < numTransfers.value(); ++t) {
       transfers.emplace_back(
           ctx->bv_const(("transfer_" + std::to_string(t)).c_str(),
-                        minBitsToRepresentUInt(numStages)));
+                        getStageBits()));
     }
   } else {
     transfers.reserve(numStages);
@@ -136,8 +160,8 @@ auto NASolver::getExactNumTransfersConstraints() const -> std::vector<expr> {
       constraints.emplace_back(ult(transfers[t - 1], transfers[t]));
     }
     constraints.emplace_back(
-        ult(transfers[numTransfers.value() - 1],
-            ctx->bv_val(numStages, minBitsToRepresentUInt(numStages))));
+        getBeforeStageConstraint(transfers[numTransfers.value() - 1],
+                                 numStages));
   }
   return constraints;
 }
@@ -314,42 +338,119 @@ struct QubitPairHash {
     return qc::combineHash(x.first, x.second);
   }
 };
+
+/**
+ * Returns the classes of qubits that can be exchanged pairwise without
+ * changing the operations. If the order of the operations is minded, the
+ * sequence of operations must stay the same, otherwise only the multiset of
+ * operations. Only classes with at least two qubits are returned.
+ */
+auto getInterchangeableQubits(
+    const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
+    const uint16_t numQubits, const bool mindOpsOrder)
+    -> std::vector<std::vector<qc::Qubit>> {
+  const auto normalize = [](const qc::Qubit q0, const qc::Qubit q1) {
+    return std::make_pair(std::min(q0, q1), std::max(q0, q1));
+  };
+  std::vector<std::pair<qc::Qubit, qc::Qubit>> normalizedOps;
+  normalizedOps.reserve(ops.size());
+  std::vector<size_t> degrees(numQubits, 0);
+  for (const auto& [q0, q1] : ops) {
+    normalizedOps.emplace_back(normalize(q0, q1));
+    ++degrees[q0];
+    ++degrees[q1];
+  }
+  auto sortedOps = normalizedOps;
+  std::sort(sortedOps.begin(), sortedOps.end());
+  const auto isInterchangeable = [&](const qc::Qubit q, const qc::Qubit p) {
+    if (degrees[q] != degrees[p]) {
+      return false;
+    }
+    const auto swap = [q, p](const qc::Qubit x) {
+      return x == q ? p : (x == p ? q : x);
+    };
+    std::vector<std::pair<qc::Qubit, qc::Qubit>> swappedOps;
+    swappedOps.reserve(normalizedOps.size());
+    for (const auto& [q0, q1] : normalizedOps) {
+      swappedOps.emplace_back(normalize(swap(q0), swap(q1)));
+    }
+    if (mindOpsOrder) {
+      return swappedOps == normalizedOps;
+    }
+    std::sort(swappedOps.begin(), swappedOps.end());
+    return swappedOps == sortedOps;
+  };
+  // exchangeability is an equivalence relation, hence, it suffices to compare
+  // with the first qubit of every class
+  std::vector<std::vector<qc::Qubit>> classes;
+  for (qc::Qubit q = 0; q < numQubits; ++q) {
+    const auto it =
+        std::find_if(classes.begin(), classes.end(), [&](const auto& c) {
+          return isInterchangeable(c.front(), q);
+        });
+    if (it == classes.end()) {
+      classes.emplace_back(std::vector{q});
+    } else {
+      it->emplace_back(q);
+    }
+  }
+  std::erase_if(classes, [](const auto& c) { return c.size() < 2; });
+  return classes;
+}
 } // namespace
 
-auto NASolver::getCircuitExecutionConstraints(
+auto NASolver::initGates(
     const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
-    const bool mindOpsOrder, const bool shieldIdleAtoms) -> std::vector<expr> {
+    const bool mindOpsOrder) -> void {
   const auto numGates = ops.size();
-  std::unordered_map<std::pair<qc::Qubit, qc::Qubit>, std::vector<expr>,
-                     QubitPairHash>
-      pairToGates;
   gates.clear();
   gates.reserve(numGates);
-  std::vector<std::vector<expr>> gatesForQubit(numQubits);
   for (std::uint16_t i = 0; static_cast<std::size_t>(i) < numGates; ++i) {
     gates.emplace_back(ctx->bv_const(("gate_" + std::to_string(i)).c_str(),
-                                     minBitsToRepresentUInt(numStages)));
-    const auto key = std::make_pair(std::min(ops[i].first, ops[i].second),
-                                    std::max(ops[i].first, ops[i].second));
-    if (pairToGates.find(key) == pairToGates.end()) {
-      pairToGates.emplace(key, std::vector<expr>());
+                                     getStageBits()));
+  }
+  gateDepths.assign(numGates, 0);
+  gateHeights.assign(numGates, 0);
+  minNumRydbergStages = 0;
+  if (mindOpsOrder) {
+    // the depth of a gate is the number of gates that must be executed before
+    // it, the height is the number of gates that must be executed after it
+    std::vector<std::uint16_t> depthOnQubit(numQubits, 0);
+    for (std::size_t i = 0; i < numGates; ++i) {
+      const auto& [q0, q1] = ops[i];
+      gateDepths[i] = std::max(depthOnQubit[q0], depthOnQubit[q1]);
+      depthOnQubit[q0] = depthOnQubit[q1] = gateDepths[i] + 1;
+      minNumRydbergStages = std::max(minNumRydbergStages, depthOnQubit[q0]);
+    }
+    std::vector<std::uint16_t> heightOnQubit(numQubits, 0);
+    for (std::size_t i = numGates; i > 0; --i) {
+      const auto& [q0, q1] = ops[i - 1];
+      gateHeights[i - 1] = std::max(heightOnQubit[q0], heightOnQubit[q1]);
+      heightOnQubit[q0] = heightOnQubit[q1] = gateHeights[i - 1] + 1;
+    }
+  } else {
+    // all gates acting on the same qubit are executed in different stages
+    std::vector<std::uint16_t> gatesOnQubit(numQubits, 0);
+    for (const auto& [q0, q1] : ops) {
+      ++gatesOnQubit[q0];
+      ++gatesOnQubit[q1];
+      minNumRydbergStages = std::max(
+          {minNumRydbergStages, gatesOnQubit[q0], gatesOnQubit[q1]});
     }
-    pairToGates.at(key).emplace_back(gates.back());
-    gatesForQubit[ops[i].first].emplace_back(gates.back());
-    gatesForQubit[ops[i].second].emplace_back(gates.back());
   }
+}
+
+auto NASolver::getGateOrderConstraints(
+    const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
+    const bool mindOpsOrder) const -> std::vector<expr> {
+  const auto numGates = ops.size();
   std::vector<expr> constraints;
   if (mindOpsOrder) {
+    constraints.reserve(3 * numGates);
     std::vector<std::optional<const expr>> lastGateOnQubit(numQubits,
                                                            std::nullopt);
     for (std::uint16_t i = 0; i < numGates; ++i) {
       const auto& gate = gates[i];
-      // if (!lastGateOnQubit[ops[i].first].has_value() &&
-      // !lastGateOnQubit[ops[i].
-      //       second].has_value()) {
-      //   constraints.emplace_back(
-      //       0 <= gate);
-      // }
       if (lastGateOnQubit[ops[i].first].has_value()) {
         constraints.emplace_back(
             // NOLINTNEXTLINE (bugprone-unchecked-optional-access)
@@ -362,25 +463,16 @@ auto NASolver::getCircuitExecutionConstraints(
       }
       lastGateOnQubit[ops[i].first].emplace(gate);
       lastGateOnQubit[ops[i].second].emplace(gate);
-    }
-    std::unordered_set<expr, ExprHash> lastGates;
-    for (const auto& lastGate : lastGateOnQubit) {
-      if (lastGate.has_value()) {
-        lastGates.emplace(lastGate.value());
+      // implied by the constraints above, but states the earliest stage of
+      // the gate directly
+      if (gateDepths[i] > 0) {
+        constraints.emplace_back(
+            !getBeforeStageConstraint(gate, gateDepths[i]));
       }
     }
-    for (const auto& lastGate : lastGates) {
-      constraints.emplace_back(ult(lastGate, numStages));
-    }
-    constraints.reserve((3 * numGates) +
-                        (numStages * numQubits * (numQubits - 1U) / 2U));
   } else {
-    constraints.reserve((numGates * (numGates - 1) / 2) + (4 * numGates) +
-                        (numStages * numQubits * (numQubits - 1U) / 2U));
+    constraints.reserve(numGates * (numGates - 1) / 2);
     for (std::uint16_t g = 0; static_cast<size_t>(g) < numGates; ++g) {
-      constraints.emplace_back(
-          // 0 <= gates[g] &&
-          ult(gates[g], numStages));
       for (std::uint16_t h = g + 1; static_cast<size_t>(h) < numGates; ++h) {
         if (ops[g].first == ops[h].first || ops[g].first == ops[h].second ||
             ops[g].second == ops[h].first || ops[g].second == ops[h].second) {
@@ -389,71 +481,196 @@ auto NASolver::getCircuitExecutionConstraints(
       }
     }
   }
-  for (std::uint16_t t = 0; t < numStages; ++t) {
-    for (std::uint16_t i = 0; i < numQubits; ++i) {
-      for (std::uint16_t j = i + 1; j < numQubits; ++j) {
-        if (const auto& it = pairToGates.find({i, j});
-            it != pairToGates.end() && !it->second.empty()) {
-          const auto& gatesForPair = it->second;
-          for (const auto& gate : gatesForPair) {
-            auto hDiff =
-                stages[t].getQubit(j).getH() - stages[t].getQubit(i).getH();
-            auto hDiffSign = ashr(
-                hDiff,
-                static_cast<signed int>(minBitsToRepresentInt(maxHOffset)) - 1);
-            auto absHDiff = (hDiff ^ hDiffSign) - hDiffSign;
-            auto vDiff =
-                stages[t].getQubit(j).getV() - stages[t].getQubit(i).getV();
-            auto vDiffSign = ashr(
-                vDiff,
-                static_cast<signed int>(minBitsToRepresentInt(maxVOffset)) - 1);
-            auto absVDiff = (vDiff ^ vDiffSign) - vDiffSign;
-
-            constraints.emplace_back(implies(
-                gate == ctx->bv_val(t, minBitsToRepresentUInt(numStages)),
-                getRydbergStageConstraint(t) &&
-                    getHaveSamePositionConstraint(i, j, t) &&
-                    getAffectedByRydbergBeamConstraint(i, t) &&
-                    getAffectedByRydbergBeamConstraint(j, t) &&
-                    ult(absHDiff, maxHDist) &&
-                    ult(absVDiff, ctx->bv_val(maxVDist, minBitsToRepresentInt(
-                                                            maxVOffset)))));
-          }
-          expr premisses = getRydbergStageConstraint(t) &&
-                           getAffectedByRydbergBeamConstraint(i, t) &&
-                           getAffectedByRydbergBeamConstraint(j, t);
-          for (const auto& gate : gatesForPair) {
-            premisses =
-                premisses &&
-                gate != ctx->bv_val(t, minBitsToRepresentUInt(numStages));
-          }
-          constraints.emplace_back(
-              implies(premisses, getHaveDifferentPositionConstraint(i, j, t)));
-        } else {
-          constraints.emplace_back(
-              implies(getRydbergStageConstraint(t) &&
-                          getAffectedByRydbergBeamConstraint(i, t) &&
-                          getAffectedByRydbergBeamConstraint(j, t),
-                      getHaveDifferentPositionConstraint(i, j, t)));
+  return constraints;
+}
+
+auto NASolver::getGatesBeforeStageConstraints(const uint16_t t) const
+    -> std::vector<expr> {
+  std::vector<expr> constraints;
+  constraints.reserve(gates.size() + 1);
+  // if the order is minded, every gate must leave enough stages for the gates
+  // that must be executed after it
+  for (std::size_t i = 0; i < gates.size(); ++i) {
+    constraints.emplace_back(getBeforeStageConstraint(
+        gates[i], static_cast<int32_t>(t) - gateHeights[i]));
+  }
+  // the gates require at least minNumRydbergStages Rydberg stages, this is
+  // implied by the other constraints but lets the solver refute too few
+  // Rydberg stages without trying all assignments of the gates
+  const auto maxNumTransfers = static_cast<int32_t>(t) - minNumRydbergStages;
+  if (maxNumTransfers < 0) {
+    constraints.emplace_back(ctx->bool_val(false));
+  } else if (numTransfers.has_value()) {
+    if (static_cast<int32_t>(numTransfers.value()) > maxNumTransfers) {
+      constraints.emplace_back(ctx->bool_val(false));
+    }
+  } else {
+    const auto countBits = std::max(minBitsToRepresentUInt(t), 1U);
+    auto count = ctx->bv_val(0, countBits);
+    for (std::uint16_t i = 0; i < t; ++i) {
+      count = count + ite(transfers[i], ctx->bv_val(1, countBits),
+                          ctx->bv_val(0, countBits));
+    }
+    constraints.emplace_back(
+        ule(count, ctx->bv_val(maxNumTransfers, countBits)));
+  }
+  return constraints;
+}
+
+auto NASolver::getStageExecutionConstraints(
+    const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops, const uint16_t t,
+    const bool shieldIdleAtoms) const -> std::vector<expr> {
+  std::unordered_map<std::pair<qc::Qubit, qc::Qubit>, std::vector<expr>,
+                     QubitPairHash>
+      pairToGates;
+  std::vector<std::vector<expr>> gatesForQubit(numQubits);
+  for (std::size_t i = 0; i < ops.size(); ++i) {
+    // gates that cannot be executed in this stage due to their order are
+    // omitted
+    if (gateDepths[i] > t || t + gateHeights[i] >= numStages) {
+      continue;
+    }
+    const auto key = std::make_pair(std::min(ops[i].first, ops[i].second),
+                                    std::max(ops[i].first, ops[i].second));
+    pairToGates[key].emplace_back(gates[i]);
+    gatesForQubit[ops[i].first].emplace_back(gates[i]);
+    gatesForQubit[ops[i].second].emplace_back(gates[i]);
+  }
+  const auto stage = ctx->bv_val(t, getStageBits());
+  std::vector<expr> constraints;
+  constraints.reserve(numQubits * (numQubits + 1U) / 2U);
+  for (std::uint16_t i = 0; i < numQubits; ++i) {
+    for (std::uint16_t j = i + 1; j < numQubits; ++j) {
+      if (const auto& it = pairToGates.find({i, j});
+          it != pairToGates.end() && !it->second.empty()) {
+        const auto& gatesForPair = it->second;
+        for (const auto& gate : gatesForPair) {
+          auto hDiff =
+              stages[t].getQubit(j).getH() - stages[t].getQubit(i).getH();
+          auto hDiffSign = ashr(
+              hDiff,
+              static_cast<signed int>(minBitsToRepresentInt(maxHOffset)) - 1);
+          auto absHDiff = (hDiff ^ hDiffSign) - hDiffSign;
+          auto vDiff =
+              stages[t].getQubit(j).getV() - stages[t].getQubit(i).getV();
+          auto vDiffSign = ashr(
+              vDiff,
+              static_cast<signed int>(minBitsToRepresentInt(maxVOffset)) - 1);
+          auto absVDiff = (vDiff ^ vDiffSign) - vDiffSign;
+
+          constraints.emplace_back(implies(
+              gate == stage,
+              getRydbergStageConstraint(t) &&
+                  getHaveSamePositionConstraint(i, j, t) &&
+                  getAffectedByRydbergBeamConstraint(i, t) &&
+                  getAffectedByRydbergBeamConstraint(j, t) &&
+                  ult(absHDiff, maxHDist) &&
+                  ult(absVDiff,
+                      ctx->bv_val(maxVDist,
+                                  minBitsToRepresentInt(maxVOffset)))));
         }
-      }
-      if (shieldIdleAtoms) {
-        if (gatesForQubit[i].empty()) {
-          constraints.emplace_back(
-              implies(getRydbergStageConstraint(t),
-                      getShieldedFromRydbergBeamConstraint(i, t)));
-        } else {
-          expr premisses = getRydbergStageConstraint(t);
-          for (const auto& gate : gatesForQubit[i]) {
-            premisses =
-                premisses &&
-                gate != ctx->bv_val(t, minBitsToRepresentUInt(numStages));
-          }
-          constraints.emplace_back(
-              implies(premisses, getShieldedFromRydbergBeamConstraint(i, t)));
+        expr premisses = getRydbergStageConstraint(t) &&
+                         getAffectedByRydbergBeamConstraint(i, t) &&
+                         getAffectedByRydbergBeamConstraint(j, t);
+        for (const auto& gate : gatesForPair) {
+          premisses = premisses && gate != stage;
         }
+        constraints.emplace_back(
+            implies(premisses, getHaveDifferentPositionConstraint(i, j, t)));
+      } else {
+        constraints.emplace_back(
+            implies(getRydbergStageConstraint(t) &&
+                        getAffectedByRydbergBeamConstraint(i, t) &&
+                        getAffectedByRydbergBeamConstraint(j, t),
+                    getHaveDifferentPositionConstraint(i, j, t)));
       }
     }
+    if (shieldIdleAtoms) {
+      expr premisses = getRydbergStageConstraint(t);
+      for (const auto& gate : gatesForQubit[i]) {
+        premisses = premisses && gate != stage;
+      }
+      constraints.emplace_back(
+          implies(premisses, getShieldedFromRydbergBeamConstraint(i, t)));
+    }
+  }
+  return constraints;
+}
+
+auto NASolver::getCircuitExecutionConstraints(
+    const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
+    const bool mindOpsOrder, const bool shieldIdleAtoms) -> std::vector<expr> {
+  initGates(ops, mindOpsOrder);
+  auto constraints = getGateOrderConstraints(ops, mindOpsOrder);
+  for (auto&& c : getGatesBeforeStageConstraints(numStages)) {
+    constraints.emplace_back(std::move(c));
+  }
+  for (std::uint16_t t = 0; t < numStages; ++t) {
+    for (auto&& c : getStageExecutionConstraints(ops, t, shieldIdleAtoms)) {
+      constraints.emplace_back(std::move(c));
+    }
+  }
+  return constraints;
+}
+
+auto NASolver::getSymmetryBreakingConstraints(
+    const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
+    const bool mindOpsOrder, const uint16_t t) const -> std::vector<expr> {
+  std::vector<expr> constraints;
+  if (t == 0 || numQubits == 0) {
+    return constraints;
+  }
+  // order exchangeable qubits lexicographically by (x, y, h, v) in the first
+  // stage, which is a strict order since no two atoms share a location
+  for (const auto& qubits : getInterchangeableQubits(ops, numQubits,
+                                                      mindOpsOrder)) {
+    for (size_t k = 1; k < qubits.size(); ++k) {
+      const auto& q = stages[0].getQubit(qubits[k - 1]);
+      const auto& p = stages[0].getQubit(qubits[k]);
+      constraints.emplace_back(
+          ult(q.getX(), p.getX()) ||
+          (q.getX() == p.getX() &&
+           (ult(q.getY(), p.getY()) ||
+            (q.getY() == p.getY() &&
+             (slt(q.getH(), p.getH()) ||
+              (q.getH() == p.getH() && slt(q.getV(), p.getV())))))));
+    }
+  }
+  // some atom is located in the first column of interaction sites
+  expr leftmost = ctx->bool_val(false);
+  for (std::uint16_t s = 0; s < t; ++s) {
+    for (std::uint16_t i = 0; i < numQubits; ++i) {
+      leftmost = leftmost || stages[s].getQubit(i).getX() ==
+                                 ctx->bv_val(0, minBitsToRepresentUInt(maxX));
+    }
+  }
+  constraints.emplace_back(leftmost);
+  // the AOD columns and rows with a positive index are used without gaps
+  const auto isUsed = [this, t](const auto& getIndex, const uint16_t index,
+                                const uint16_t maxIndex) {
+    const auto value = ctx->bv_val(index, minBitsToRepresentUInt(maxIndex));
+    expr used = ctx->bool_val(false);
+    for (std::uint16_t s = 0; s < t; ++s) {
+      for (std::uint16_t i = 0; i < numQubits; ++i) {
+        const auto& qubit = stages[s].getQubit(i);
+        used = used || (qubit.getA() && getIndex(qubit) == value);
+      }
+    }
+    return used;
+  };
+  const auto getC = [](const Qubit& qubit) -> const expr& {
+    return qubit.getC();
+  };
+  const auto getR = [](const Qubit& qubit) -> const expr& {
+    return qubit.getR();
+  };
+  for (std::uint16_t c = 1; c < maxC; ++c) {
+    constraints.emplace_back(
+        implies(isUsed(getC, c + 1, maxC), isUsed(getC, c, maxC)));
+  }
+  for (std::uint16_t r = 1; r < maxR; ++r) {
+    constraints.emplace_back(
+        implies(isUsed(getR, r + 1, maxR), isUsed(getR, r, maxR)));
   }
   return constraints;
 }
@@ -466,8 +683,7 @@ auto NASolver::getTransferStageConstraint(const std::uint16_t t) const -> expr {
   if (numTransfers.has_value()) {
     expr clauses = ctx->bool_val(false);
     for (const auto& transfer : transfers) {
-      clauses = clauses ||
-                transfer == ctx->bv_val(t, minBitsToRepresentUInt(numStages));
+      clauses = clauses || transfer == ctx->bv_val(t, getStageBits());
     }
     return clauses;
   }
@@ -583,12 +799,10 @@ NASolver::NASolver(const std::uint16_t newMaxX, const std::uint16_t newMaxY,
   }
 }
 
-auto NASolver::solve(const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
-                     const std::uint16_t newNumQubits,
-                     const std::uint16_t newNumStages,
-                     const std::optional<std::uint16_t> newNumTransfers,
-                     const bool mindOpsOrder, const bool shieldIdleQubits)
-    -> Result {
+auto NASolver::checkInput(
+    const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
+    const std::uint16_t newNumQubits, const bool shieldIdleQubits) const
+    -> void {
   if (shieldIdleQubits) {
     if (storage == Storage::None) {
       throw std::invalid_argument("No storage zone is available.");
@@ -605,6 +819,124 @@ auto NASolver::solve(const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
         "The operations reference qubits with an index larger or equal to the "
         "given number of qubits.");
   }
+}
+
+namespace {
+/**
+ * The values of all constants in a model. They are collected in a single pass
+ * over the model such that extracting the result does not require a call to
+ * `model::eval` and, hence, the construction of a new expression for every
+ * variable.
+ */
+class ModelValues {
+  /// Maps the id of the declaration of a constant to its value, Boolean
+  /// constants are represented by 0 and 1
+  std::unordered_map<unsigned, std::uint64_t> values;
+
+public:
+  explicit ModelValues(const model& model) {
+    const auto n = model.num_consts();
+    values.reserve(n);
+    for (unsigned i = 0; i < n; ++i) {
+      const auto decl = model.get_const_decl(i);
+      const auto interp = model.get_const_interp(decl);
+      if (interp.is_bool()) {
+        values.emplace(decl.id(), interp.is_true() ? 1 : 0);
+      } else if (interp.is_numeral()) {
+        values.emplace(decl.id(), interp.get_numeral_uint64());
+      }
+    }
+  }
+  /// Returns the value of the constant @p e as unsigned integer. Constants
+  /// that do not occur in the model are unconstrained and are assigned zero.
+  [[nodiscard]] auto getUInt(const expr& e) const -> std::uint64_t {
+    const auto it = values.find(e.decl().id());
+    return it == values.end() ? 0 : it->second;
+  }
+  /// Returns the value of the Boolean constant @p e
+  [[nodiscard]] auto getBool(const expr& e) const -> bool {
+    return getUInt(e) != 0;
+  }
+  /// Returns the value of the bit-vector constant @p e interpreted in two's
+  /// complement
+  [[nodiscard]] auto getInt(const expr& e) const -> std::int64_t {
+    const auto bits = e.get_sort().bv_size();
+    const auto value = getUInt(e);
+    if (bits < 64 && (value >> (bits - 1)) != 0) {
+      return static_cast<std::int64_t>(value) -
+             (static_cast<std::int64_t>(1) << bits);
+    }
+    return static_cast<std::int64_t>(value);
+  }
+};
+} // namespace
+
+auto NASolver::extractResult(
+    const model& model, const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
+    const std::uint16_t nStages) const -> Result {
+  const ModelValues values(model);
+  // the stage of every gate is looked up once instead of once per stage
+  std::vector<std::vector<Result::Gate>> resultGates(nStages);
+  for (std::size_t i = 0; i < gates.size(); ++i) {
+    const auto t = values.getUInt(gates[i]);
+    if (t < nStages) {
+      resultGates[t].emplace_back<Result::Gate>(
+          {static_cast<std::uint16_t>(t), ops[i]});
+    }
+  }
+  std::uint16_t nTrans = 0;
+  std::vector<Result::Stage> resultStages;
+  resultStages.reserve(nStages);
+  for (std::uint16_t t = 0; t < nStages; ++t) {
+    const auto& stage = stages[t];
+    const bool rydberg =
+        numTransfers.has_value()
+            ? (nTrans == numTransfers ||
+               values.getUInt(transfers[nTrans]) != stage.getT())
+            : !values.getBool(transfers[stage.getT()]);
+    if (numTransfers.has_value() && !rydberg) {
+      ++nTrans;
+    }
+    std::vector<Result::Qubit> resultQubits;
+    resultQubits.reserve(numQubits);
+    for (std::uint16_t i = 0; i < numQubits; ++i) {
+      const auto& qubit = stage.getQubit(i);
+      resultQubits.emplace_back<Result::Qubit>(
+          {static_cast<uint32_t>(values.getUInt(qubit.getX())),
+           static_cast<uint32_t>(values.getUInt(qubit.getY())),
+           values.getBool(qubit.getA()),
+           static_cast<uint32_t>(values.getUInt(qubit.getC())),
+           static_cast<uint32_t>(values.getUInt(qubit.getR())),
+           static_cast<int32_t>(values.getInt(qubit.getH())),
+           static_cast<int32_t>(values.getInt(qubit.getV()))});
+    }
+    resultStages.emplace_back<Result::Stage>(
+        {rydberg, std::move(resultQubits), std::move(resultGates[t])});
+  }
+  return Result{true,           resultStages, minEntanglingY,
+                maxEntanglingY, maxHOffset,   maxVOffset};
+}
+
+auto NASolver::solve(const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
+                     const std::uint16_t newNumQubits,
+                     const std::uint16_t newNumStages,
+                     const std::optional<std::uint16_t> newNumTransfers,
+                     const bool mindOpsOrder, const bool shieldIdleQubits,
+                     const bool breakSymmetries) -> Result {
+  // NOLINTNEXTLINE (bugprone-unchecked-optional-access)
+  return *solveUnlessCancelled(ops, newNumQubits, newNumStages,
+                               newNumTransfers, mindOpsOrder, shieldIdleQubits,
+                               breakSymmetries, nullptr);
+}
+
+auto NASolver::solveUnlessCancelled(
+    const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
+    const std::uint16_t newNumQubits, const std::uint16_t newNumStages,
+    const std::optional<std::uint16_t> newNumTransfers,
+    const bool mindOpsOrder, const bool shieldIdleQubits,
+    const bool breakSymmetries, const std::function<bool()>& isCancelled)
+    -> std::optional<Result> {
+  checkInput(ops, newNumQubits, shieldIdleQubits);
 
   numQubits = newNumQubits;
   numStages = newNumStages;
@@ -624,6 +956,12 @@ auto NASolver::solve(const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
        getCircuitExecutionConstraints(ops, mindOpsOrder, shieldIdleQubits)) {
     solver.add(c);
   }
+  if (breakSymmetries) {
+    for (const auto& c :
+         getSymmetryBreakingConstraints(ops, mindOpsOrder, numStages)) {
+      solver.add(c);
+    }
+  }
   for (std::uint16_t t = 0; t < numStages; ++t) {
     for (const auto& c : getValidStageConstraints(t)) {
       solver.add(c);
@@ -638,49 +976,336 @@ auto NASolver::solve(const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
     }
   }
 
+  // Z3 clears a pending interrupt of the context when the check starts and
+  // then runs the check to completion. Hence, a cancellation while the
+  // constraints were built is only noticed here.
+  if (isCancelled && isCancelled()) {
+    return std::nullopt;
+  }
   // Check satisfiability
-  if (solver.check() == unsat) {
+  const auto checkResult = solver.check();
+  // a cancellation that arrived during the check invalidates its result
+  if (isCancelled && isCancelled()) {
+    return std::nullopt;
+  }
+  if (checkResult == unsat) {
     return Result{false,          {},         minEntanglingY,
                   maxEntanglingY, maxHOffset, maxVOffset};
   }
-  const auto model = solver.get_model();
-  std::uint16_t nTrans = 0;
-  std::vector<Result::Stage> resultStages;
-  resultStages.reserve(numStages);
-  for (const auto& stage : stages) {
-    const bool rydberg =
-        numTransfers.has_value()
-            ? (nTrans == numTransfers ||
-               model.eval(transfers[nTrans]).as_uint64() != stage.getT())
-            : model.eval(transfers[stage.getT()]).is_false();
-    if (numTransfers.has_value() && !rydberg) {
-      ++nTrans;
+  if (checkResult == unknown) {
+    // this only happens if the solver was interrupted
+    throw std::runtime_error("The solver returned unknown: " +
+                             solver.reason_unknown());
+  }
+  return extractResult(solver.get_model(), ops, numStages);
+}
+
+auto NASolver::solveOptimal(
+    const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
+    const std::uint16_t newNumQubits, const std::uint16_t maxNumStages,
+    const bool mindOpsOrder, const bool shieldIdleQubits,
+    const bool breakSymmetries) -> Result {
+  if (maxNumStages == 0) {
+    throw std::invalid_argument(
+        "The maximum number of stages must be at least one.");
+  }
+  checkInput(ops, newNumQubits, shieldIdleQubits);
+
+  // All variables are created once for the maximum number of stages such that
+  // the bit widths do not change while stages are added. The number of
+  // transfers is variable and only fixed by the assumptions below.
+  numQubits = newNumQubits;
+  numStages = maxNumStages;
+  numTransfers = std::nullopt;
+
+  solver solver(*ctx, "QF_BV");
+
+  initVariables();
+  initGates(ops, mindOpsOrder);
+
+  for (const auto& c : getGateOrderConstraints(ops, mindOpsOrder)) {
+    solver.add(c);
+  }
+  const auto transferBits = minBitsToRepresentUInt(numStages);
+  auto numTransfersExpr = ctx->bv_val(0, transferBits);
+  for (std::uint16_t k = 1; k <= numStages; ++k) {
+    // Add the constraints of stage k - 1. Those are valid for all stage counts
+    // greater or equal to k and, hence, remain in the solver.
+    const std::uint16_t t = k - 1;
+    for (const auto& c : getValidStageConstraints(t)) {
+      solver.add(c);
     }
-    std::vector<Result::Qubit> resultQubits;
-    resultQubits.reserve(numQubits);
-    for (std::uint16_t i = 0; i < numQubits; ++i) {
-      resultQubits.emplace_back<Result::Qubit>(
-          {model.eval(stage.getQubit(i).getX()).get_numeral_uint(),
-           model.eval(stage.getQubit(i).getY()).get_numeral_uint(),
-           model.eval(stage.getQubit(i).getA()).is_true(),
-           model.eval(stage.getQubit(i).getC()).get_numeral_uint(),
-           model.eval(stage.getQubit(i).getR()).get_numeral_uint(),
-           model.eval(bv2int(stage.getQubit(i).getH(), true)).get_numeral_int(),
-           model.eval(bv2int(stage.getQubit(i).getV(), true))
-               .get_numeral_int()});
-    }
-    std::vector<Result::Gate> resultGates;
-    for (std::uint16_t i = 0; i < static_cast<std::uint16_t>(gates.size());
-         ++i) {
-      if (model.eval(gates[i]).as_uint64() == stage.getT()) {
-        resultGates.emplace_back<Result::Gate>({stage.getT(), ops[i]});
+    if (t > 0) {
+      for (const auto& c : getValidRydbergTransitionConstraints(t - 1)) {
+        solver.add(c);
+      }
+      for (const auto& c : getValidTransferTransitionConstraints(t - 1)) {
+        solver.add(c);
+      }
+    }
+    for (const auto& c :
+         getStageExecutionConstraints(ops, t, shieldIdleQubits)) {
+      solver.add(c);
+    }
+    numTransfersExpr =
+        numTransfersExpr + ite(transfers[t], ctx->bv_val(1, transferBits),
+                               ctx->bv_val(0, transferBits));
+    // Only the constraints requiring all gates to be executed within the first
+    // k stages and the symmetry breaking constraints depend on k. They are
+    // guarded by an activation literal that is passed as an assumption such
+    // that the solver keeps all learned lemmas for the next k.
+    const auto numStagesLit =
+        ctx->bool_const(("stages_" + std::to_string(k)).c_str());
+    for (const auto& c : getGatesBeforeStageConstraints(k)) {
+      solver.add(implies(numStagesLit, c));
+    }
+    if (breakSymmetries) {
+      for (const auto& c :
+           getSymmetryBreakingConstraints(ops, mindOpsOrder, k)) {
+        solver.add(implies(numStagesLit, c));
+      }
+    }
+    expr_vector assumptions(*ctx);
+    assumptions.push_back(numStagesLit);
+    if (solver.check(assumptions) != sat) {
+      continue;
+    }
+    // Find the minimal number of transfers for k stages
+    for (std::uint16_t n = 0; n <= k; ++n) {
+      const auto numTransfersLit = ctx->bool_const(
+          ("transfers_" + std::to_string(k) + "^" + std::to_string(n)).c_str());
+      solver.add(implies(numTransfersLit,
+                         numTransfersExpr == ctx->bv_val(n, transferBits)));
+      expr_vector transferAssumptions(*ctx);
+      transferAssumptions.push_back(numStagesLit);
+      transferAssumptions.push_back(numTransfersLit);
+      if (solver.check(transferAssumptions) == sat) {
+        return extractResult(solver.get_model(), ops, k);
       }
     }
-    resultStages.emplace_back<Result::Stage>(
-        {rydberg, resultQubits, resultGates});
   }
-  return Result{true,           resultStages, minEntanglingY,
-                maxEntanglingY, maxHOffset,   maxVOffset};
+  return Result{false,          {},         minEntanglingY,
+                maxEntanglingY, maxHOffset, maxVOffset};
+}
+
+ContextInterrupter::ContextInterrupter(const size_t nJobs)
+    : contexts_(nJobs, nullptr), cancelled_(nJobs, false) {
+  thread_ = std::thread([this] {
+    std::unique_lock lock(mutex_);
+    while (!finished_) {
+      bool pending = false;
+      for (size_t job = 0; job < contexts_.size(); ++job) {
+        if (cancelled_[job] && contexts_[job] != nullptr) {
+          contexts_[job]->interrupt();
+          pending = true;
+        }
+      }
+      if (pending) {
+        wakeup_.wait_for(lock, std::chrono::milliseconds(1));
+      } else {
+        wakeup_.wait(lock);
+      }
+    }
+  });
+}
+
+ContextInterrupter::~ContextInterrupter() {
+  {
+    const std::lock_guard lock(mutex_);
+    finished_ = true;
+  }
+  wakeup_.notify_one();
+  thread_.join();
+}
+
+auto ContextInterrupter::registerContext(const size_t job, context& ctx)
+    -> bool {
+  const std::lock_guard lock(mutex_);
+  if (cancelled_[job]) {
+    return false;
+  }
+  contexts_[job] = &ctx;
+  return true;
+}
+
+auto ContextInterrupter::unregisterContext(const size_t job) -> void {
+  const std::lock_guard lock(mutex_);
+  contexts_[job] = nullptr;
+}
+
+auto ContextInterrupter::cancel(const size_t job) -> void {
+  {
+    const std::lock_guard lock(mutex_);
+    cancelled_[job] = true;
+    if (contexts_[job] == nullptr) {
+      return;
+    }
+  }
+  wakeup_.notify_one();
+}
+
+auto ContextInterrupter::isCancelled(const size_t job) -> bool {
+  const std::lock_guard lock(mutex_);
+  return cancelled_[job];
+}
+
+auto NASolver::solveParallel(
+    const std::vector<std::pair<qc::Qubit, qc::Qubit>>& ops,
+    const std::uint16_t newNumQubits, const std::uint16_t maxNumStages,
+    const bool mindOpsOrder, const bool shieldIdleQubits,
+    const bool breakSymmetries, size_t numThreads) -> Result {
+  if (maxNumStages == 0) {
+    throw std::invalid_argument(
+        "The maximum number of stages must be at least one.");
+  }
+  checkInput(ops, newNumQubits, shieldIdleQubits);
+  // The queries in the order they are started. For every number of stages,
+  // the query with a variable number of transfers comes first because, if it
+  // is unsatisfiable, all other queries with the same number of stages are
+  // unsatisfiable as well.
+  struct Query {
+    std::uint16_t numStages;
+    std::optional<std::uint16_t> numTransfers;
+  };
+  enum class Status : uint8_t { Pending, Running, Sat, Unsat, Pruned };
+  std::vector<Query> queries;
+  for (std::uint16_t s = 1; s <= maxNumStages; ++s) {
+    queries.emplace_back(Query{s, std::nullopt});
+    for (std::uint16_t n = 0; n <= s; ++n) {
+      queries.emplace_back(Query{s, n});
+    }
+  }
+  std::vector status(queries.size(), Status::Pending);
+  std::vector<std::optional<Result>> results(queries.size());
+  // interrupts the running queries when they become redundant
+  ContextInterrupter interrupter(queries.size());
+  std::mutex mutex;
+  std::exception_ptr error;
+  // must be called with the mutex locked
+  const auto prune = [&queries, &status,
+                      &interrupter](const auto& isRedundant) {
+    for (size_t j = 0; j < queries.size(); ++j) {
+      if ((status[j] == Status::Pending || status[j] == Status::Running) &&
+          isRedundant(queries[j])) {
+        interrupter.cancel(j);
+        status[j] = Status::Pruned;
+      }
+    }
+  };
+  const auto work = [this, &ops, newNumQubits, mindOpsOrder, shieldIdleQubits,
+                     breakSymmetries, &queries, &status, &results, &interrupter,
+                     &mutex, &error, &prune] {
+    while (true) {
+      size_t i = 0;
+      {
+        const std::lock_guard lock(mutex);
+        while (i < queries.size() && status[i] != Status::Pending) {
+          ++i;
+        }
+        if (i == queries.size()) {
+          return;
+        }
+        status[i] = Status::Running;
+      }
+      const auto& [s, n] = queries[i];
+      std::optional<Result> result;
+      std::exception_ptr queryError;
+      try {
+        // every query runs on its own solver with its own context since the
+        // context of this solver is not thread-safe
+        NASolver querySolver(maxX, maxY, maxC, maxR, maxHOffset, maxVOffset,
+                             maxHDist, maxVDist, minEntanglingY,
+                             maxEntanglingY);
+        if (interrupter.registerContext(i, *querySolver.ctx)) {
+          try {
+            // a query that is pruned while its constraints are built returns
+            // right before the check, a running check is interrupted
+            result = querySolver.solveUnlessCancelled(
+                ops, newNumQubits, s, n, mindOpsOrder, shieldIdleQubits,
+                breakSymmetries, [&interrupter, i] {
+                  return interrupter.isCancelled(i);
+                });
+          } catch (...) {
+            interrupter.unregisterContext(i);
+            throw;
+          }
+          interrupter.unregisterContext(i);
+        }
+      } catch (...) {
+        queryError = std::current_exception();
+      }
+      const std::lock_guard lock(mutex);
+      if (status[i] == Status::Pruned) {
+        // the query was interrupted or its result is not needed anymore
+        continue;
+      }
+      if (queryError) {
+        if (!error) {
+          error = queryError;
+        }
+        prune([](const Query&) { return true; });
+        return;
+      }
+      // NOLINTNEXTLINE (bugprone-unchecked-optional-access)
+      if (!result->sat) {
+        status[i] = Status::Unsat;
+        if (!n.has_value()) {
+          prune([s](const Query& q) { return q.numStages == s; });
+        }
+        continue;
+      }
+      status[i] = Status::Sat;
+      if (n.has_value()) {
+        results[i] = std::move(result);
+        // only solutions with fewer stages or fewer transfers are of interest
+        prune([s, n](const Query& q) {
+          return q.numStages > s ||
+                 (q.numStages == s &&
+                  // NOLINTNEXTLINE (bugprone-unchecked-optional-access)
+                  (!q.numTransfers.has_value() || *q.numTransfers > *n));
+        });
+      } else {
+        prune([s](const Query& q) { return q.numStages > s; });
+      }
+    }
+  };
+  if (numThreads == 0) {
+    numThreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  numThreads = std::min(numThreads, queries.size());
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads - 1);
+  try {
+    for (size_t t = 1; t < numThreads; ++t) {
+      threads.emplace_back(work);
+    }
+  } catch (...) {
+    // not all threads could be started, stop the ones that are running
+    {
+      const std::lock_guard lock(mutex);
+      prune([](const Query&) { return true; });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    throw;
+  }
+  work();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  // A query is only pruned if a query with fewer stages or fewer transfers is
+  // satisfiable, hence, the first satisfiable query is the optimal one.
+  for (auto& result : results) {
+    if (result.has_value()) {
+      return *std::move(result);
+    }
+  }
+  return Result{false,          {},         minEntanglingY,
+                maxEntanglingY, maxHOffset, maxVOffset};
 }
 
 /// Initialize a Qubit from a JSON string.
@@ -784,6 +1409,176 @@ auto NASolver::Result::json() const -> nlohmann::json {
 auto NASolver::Result::operator==(const Result& other) const -> bool {
   return sat == other.sat && stages == other.stages;
 }
+
+namespace {
+/// The version of the binary representation of a result
+constexpr std::uint8_t BINARY_VERSION = 1;
+
+/// Appends @p value as LEB128 variable-length integer to @p out
+auto writeVarUInt(std::string& out, std::uint64_t value) -> void {
+  while (value >= 0x80U) {
+    out.push_back(static_cast<char>((value & 0x7FU) | 0x80U));
+    value >>= 7U;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+/// Appends @p value zigzag encoded as LEB128 variable-length integer to @p out
+auto writeVarInt(std::string& out, const std::int64_t value) -> void {
+  // the zigzag encoding maps values with small magnitude to small unsigned
+  // values, i.e., 0, -1, 1, -2, ... to 0, 1, 2, 3, ...
+  writeVarUInt(out, (static_cast<std::uint64_t>(value) << 1U) ^
+                        static_cast<std::uint64_t>(value >> 63));
+}
+
+/// Reads the values written by writeVarUInt and writeVarInt
+class BinaryReader {
+  const std::string* data;
+  std::size_t pos;
+
+public:
+  BinaryReader(const std::string& data, const std::size_t pos)
+      : data(&data), pos(pos) {}
+  [[nodiscard]] auto atEnd() const -> bool { return pos == data->size(); }
+  auto readByte() -> std::uint8_t {
+    if (pos >= data->size()) {
+      throw std::invalid_argument(
+          "Unexpected end of the binary representation of the result.");
+    }
+    return static_cast<std::uint8_t>((*data)[pos++]);
+  }
+  auto readBool() -> bool {
+    const auto byte = readByte();
+    if (byte > 1) {
+      throw std::invalid_argument("Invalid boolean value " +
+                                  std::to_string(byte) +
+                                  " in the binary representation of the "
+                                  "result.");
+    }
+    return byte == 1;
+  }
+  auto readVarUInt() -> std::uint64_t {
+    std::uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      const auto byte = readByte();
+      // the tenth byte only holds the most significant bit and must be the
+      // last one
+      if (shift == 63 && byte > 1) {
+        break;
+      }
+      value |= static_cast<std::uint64_t>(byte & 0x7FU) << shift;
+      if ((byte & 0x80U) == 0) {
+        return value;
+      }
+    }
+    throw std::invalid_argument("Invalid variable-length integer in the "
+                                "binary representation of the result.");
+  }
+  template <typename T> auto readUInt() -> T {
+    const auto value = readVarUInt();
+    if (value > std::numeric_limits<T>::max()) {
+      throw std::invalid_argument("Value " + std::to_string(value) +
+                                  " in the binary representation of the "
+                                  "result is out of range.");
+    }
+    return static_cast<T>(value);
+  }
+  template <typename T> auto readInt() -> T {
+    const auto zigzag = readVarUInt();
+    const auto value = static_cast<std::int64_t>(zigzag >> 1U) ^
+                       -static_cast<std::int64_t>(zigzag & 1U);
+    if (value < std::numeric_limits<T>::min() ||
+        value > std::numeric_limits<T>::max()) {
+      throw std::invalid_argument("Value " + std::to_string(value) +
+                                  " in the binary representation of the "
+                                  "result is out of range.");
+    }
+    return static_cast<T>(value);
+  }
+};
+} // namespace
+
+auto NASolver::Result::binary() const -> std::string {
+  std::string data = "NASP";
+  data.push_back(static_cast<char>(BINARY_VERSION));
+  data.push_back(static_cast<char>(sat));
+  writeVarUInt(data, minEntanglingY);
+  writeVarUInt(data, maxEntanglingY);
+  writeVarUInt(data, maxHOffset);
+  writeVarUInt(data, maxVOffset);
+  writeVarUInt(data, stages.size());
+  for (const auto& stage : stages) {
+    data.push_back(static_cast<char>(stage.rydberg));
+    writeVarUInt(data, stage.qubits.size());
+    for (const auto& qubit : stage.qubits) {
+      writeVarUInt(data, qubit.x);
+      writeVarUInt(data, qubit.y);
+      data.push_back(static_cast<char>(qubit.a));
+      writeVarUInt(data, qubit.c);
+      writeVarUInt(data, qubit.r);
+      writeVarInt(data, qubit.h);
+      writeVarInt(data, qubit.v);
+    }
+    writeVarUInt(data, stage.gates.size());
+    for (const auto& gate : stage.gates) {
+      writeVarUInt(data, gate.stage);
+      writeVarUInt(data, gate.qubits.first);
+      writeVarUInt(data, gate.qubits.second);
+    }
+  }
+  return data;
+}
+
+auto NASolver::Result::fromBinary(const std::string& data) -> Result {
+  if (data.compare(0, 4, "NASP") != 0) {
+    throw std::invalid_argument(
+        "The data is not a binary representation of a result.");
+  }
+  BinaryReader reader(data, 4);
+  if (const auto version = reader.readByte(); version != BINARY_VERSION) {
+    throw std::invalid_argument(
+        "Unsupported version " + std::to_string(version) +
+        " of the binary representation of the result.");
+  }
+  Result result{};
+  result.sat = reader.readBool();
+  result.minEntanglingY = reader.readUInt<std::uint16_t>();
+  result.maxEntanglingY = reader.readUInt<std::uint16_t>();
+  result.maxHOffset = reader.readUInt<std::uint16_t>();
+  result.maxVOffset = reader.readUInt<std::uint16_t>();
+  const auto numStages = reader.readUInt<std::uint16_t>();
+  result.stages.reserve(numStages);
+  for (std::uint16_t t = 0; t < numStages; ++t) {
+    Stage stage{};
+    stage.rydberg = reader.readBool();
+    const auto numQubits = reader.readUInt<std::uint32_t>();
+    for (std::uint32_t i = 0; i < numQubits; ++i) {
+      Qubit qubit{};
+      qubit.x = reader.readUInt<std::uint32_t>();
+      qubit.y = reader.readUInt<std::uint32_t>();
+      qubit.a = reader.readBool();
+      qubit.c = reader.readUInt<std::uint32_t>();
+      qubit.r = reader.readUInt<std::uint32_t>();
+      qubit.h = reader.readInt<std::int32_t>();
+      qubit.v = reader.readInt<std::int32_t>();
+      stage.qubits.emplace_back(qubit);
+    }
+    const auto numGates = reader.readUInt<std::uint32_t>();
+    for (std::uint32_t i = 0; i < numGates; ++i) {
+      Gate gate{};
+      gate.stage = reader.readUInt<std::uint16_t>();
+      gate.qubits.first = reader.readUInt<qc::Qubit>();
+      gate.qubits.second = reader.readUInt<qc::Qubit>();
+      stage.gates.emplace_back(gate);
+    }
+    result.stages.emplace_back(std::move(stage));
+  }
+  if (!reader.atEnd()) {
+    throw std::invalid_argument(
+        "Unexpected data after the binary representation of the result.");
+  }
+  return result;
+}
 auto NASolver::getOpsForSolver(const qc::QuantumComputation& circ,
                                const qc::OpType opType, const std::size_t ctrls,
                                const bool quiet)
@@ -13,9 +13,12 @@
 #include "spdlog/spdlog.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <filesystem>
 #include <fstream>
 #include <functional>
 #include <iostream>
@@ -164,6 +167,14 @@ auto SLM::operator==(const SLM& other) const -> bool {
 }
 
 auto Architecture::fromJSON(const nlohmann::json& json) -> Architecture {
+  auto arch = parseJSON(json);
+  // preprocess the created architecture, i.e., calculate the nearest sites for
+  // entanglement and storage zones
+  arch.preprocessing();
+  return arch;
+}
+
+auto Architecture::parseJSON(const nlohmann::json& json) -> Architecture {
   Architecture arch;
   // check if the name exists and is a string, otherwise throw an error
   // JSON Example:
@@ -509,11 +520,28 @@ auto Architecture::fromJSON(const nlohmann::json& json) -> Architecture {
   } else {
     throw std::invalid_argument("AOD is missed in architecture spec");
   }
-  // preprocess the created architecture, i.e., calculate the nearest sites for
-  // entanglement and storage zones
-  arch.preprocessing();
   return arch;
 }
+auto Architecture::fromJSON(const nlohmann::json& json,
+                            const std::filesystem::path& lookupTablesPath)
+    -> Architecture {
+  // only parse the architecture and postpone the preprocessing
+  auto arch = parseJSON(json);
+  arch.assignSiteIds();
+  if (std::ifstream is(lookupTablesPath, std::ios::binary);
+      is && arch.importLookupTables(is)) {
+    return arch;
+  }
+  arch.computeLookupTables();
+  if (std::ofstream os(lookupTablesPath, std::ios::binary); os) {
+    arch.exportLookupTables(os);
+  } else {
+    SPDLOG_WARN("Could not write the lookup tables of the architecture to {}.",
+                lookupTablesPath.string());
+  }
+  return arch;
+}
+
 auto Architecture::exportNAVizMachine() const -> std::string {
   std::stringstream ss;
   ss << "name: \"" << name << "\"\n";
@@ -652,152 +680,183 @@ auto Architecture::findNearestEntanglementSLM(const size_t x, const size_t y,
   return *nearestEntanglementSLM;
 }
 
-auto Architecture::preprocessing() -> void {
-  //===--------------------------------------------------------------------===//
-  // calculate the nearest storage site for each entanglement site
-  //===--------------------------------------------------------------------===//
-  entanglementToNearestStorageSite.clear();
+auto Architecture::assignSiteIds() -> void {
+  slmsBySiteId_.clear();
+  std::size_t nSites = 0;
+  const auto assign = [this, &nSites](SLM& slm) {
+    slm.firstSiteId_ = static_cast<SiteId>(nSites);
+    slmsBySiteId_.emplace_back(&slm);
+    nSites += slm.nRows * slm.nCols;
+  };
+  for (const auto& slm : storageZones) {
+    assign(*slm);
+  }
+  const auto nStorageSites = nSites;
   for (const auto& slms : entanglementZones) {
-    for (const auto& slm : *slms) {
-      entanglementToNearestStorageSite.emplace(
-          slm,
-          std::vector<std::vector<std::tuple<std::reference_wrapper<const SLM>,
-                                             std::size_t, std::size_t>>>{});
-      entanglementToNearestStorageSite.at(slm).reserve(slm.nRows);
-      for (std::size_t row = 0; row < slm.nRows; ++row) {
-        entanglementToNearestStorageSite.at(slm).emplace_back();
-        entanglementToNearestStorageSite.at(slm).back().reserve(slm.nCols);
-        for (std::size_t col = 0; col < slm.nCols; ++col) {
-          const auto& [x, y] = exactSLMLocation(slm, row, col);
-          //===------------------------------------------------------------===//
-          // In the first step, find the nearest storage SLM (not the specific
-          // site in the storage SLM yet)
-          //===------------------------------------------------------------===//
-          const auto& nearestStorageSLM = findNearestStorageSLM(x, y);
-          //===------------------------------------------------------------===//
-          // In the second step, find the specific site in the determined
-          // storage SLM
-          //===------------------------------------------------------------===//
-          std::size_t storageCol = 0;
-          if (const auto maxX = nearestStorageSLM.location.first +
-                                ((nearestStorageSLM.nCols - 1) *
-                                 nearestStorageSLM.siteSeparation.first);
-              x > maxX) {
-            storageCol = nearestStorageSLM.nCols - 1;
-          } else if (x >= nearestStorageSLM.location.first) {
-            storageCol = (x - nearestStorageSLM.location.first +
-                          (nearestStorageSLM.siteSeparation.first / 2)) /
-                         nearestStorageSLM.siteSeparation.first;
-          }
-          std::size_t storageRow = 0;
-          if (const auto maxY = nearestStorageSLM.location.second +
-                                ((nearestStorageSLM.nRows - 1) *
-                                 nearestStorageSLM.siteSeparation.second);
-              y > maxY) {
-            storageRow = nearestStorageSLM.nRows - 1;
-          } else if (y >= nearestStorageSLM.location.second) {
-            storageRow = (y - nearestStorageSLM.location.second +
-                          (nearestStorageSLM.siteSeparation.second / 2)) /
-                         nearestStorageSLM.siteSeparation.second;
-          }
-          entanglementToNearestStorageSite.at(slm).back().emplace_back(
-              nearestStorageSLM, storageRow, storageCol);
-        }
-      }
+    for (auto& slm : *slms) {
+      assign(slm);
     }
   }
-  //===--------------------------------------------------------------------===//
-  // calculate the nearest entanglement site for each storage site
-  //===--------------------------------------------------------------------===//
-  storageToNearestEntanglementSite.clear();
-  for (const auto& slm : storageZones) {
-    storageToNearestEntanglementSite.emplace(
-        *slm,
-        std::vector<std::vector<std::unordered_map<
-            std::reference_wrapper<const SLM>,
-            std::vector<std::vector<std::tuple<
-                std::reference_wrapper<const SLM>, size_t, size_t>>>>>>{});
-    storageToNearestEntanglementSite.at(*slm).reserve(slm->nRows);
+  if (nSites > std::numeric_limits<SiteId>::max()) {
+    throw std::invalid_argument(
+        "The architecture contains more sites than can be identified by a "
+        "32-bit site id.");
+  }
+  nSites_ = static_cast<SiteId>(nSites);
+  nStorageSites_ = static_cast<SiteId>(nStorageSites);
+  siteLocations_.clear();
+  siteLocations_.reserve(nSites);
+  for (const auto* slm : slmsBySiteId_) {
     for (std::size_t row = 0; row < slm->nRows; ++row) {
-      storageToNearestEntanglementSite.at(*slm).emplace_back();
-      storageToNearestEntanglementSite.at(*slm).back().reserve(slm->nCols);
       for (std::size_t col = 0; col < slm->nCols; ++col) {
-        const auto& [x, y] = exactSLMLocation(*slm, row, col);
-        auto& storageToNearestEntanglementSiteForThisSite =
-            storageToNearestEntanglementSite.at(*slm).back().emplace_back();
-        for (const auto& otherSLM : storageZones) {
-          if (otherSLM < slm) {
-            continue;
-          }
-          storageToNearestEntanglementSiteForThisSite.emplace(
-              *otherSLM,
-              std::vector<
-                  std::vector<std::tuple<std::reference_wrapper<const SLM>,
-                                         std::size_t, std::size_t>>>{});
-          storageToNearestEntanglementSiteForThisSite.at(*otherSLM).reserve(
-              slm == otherSLM ? otherSLM->nRows - row : otherSLM->nRows);
-          for (std::size_t otherRow = (slm == otherSLM ? row : 0);
-               otherRow < otherSLM->nRows; ++otherRow) {
-            storageToNearestEntanglementSiteForThisSite[*otherSLM]
-                .emplace_back();
-            storageToNearestEntanglementSiteForThisSite[*otherSLM]
-                .back()
-                .reserve(slm == otherSLM && row == otherRow
-                             ? otherSLM->nCols - col
-                             : otherSLM->nCols);
-            for (std::size_t otherCol =
-                     (slm == otherSLM && row == otherRow ? col : 0);
-                 otherCol < otherSLM->nCols; ++otherCol) {
-              const auto& [otherX, otherY] =
-                  exactSLMLocation(*otherSLM, otherRow, otherCol);
-              //===------------------------------------------------------------===//
-              // In the first step, find the nearest storage SLM (not the
-              // specific site in the storage SLM yet)
-              //===------------------------------------------------------------===//
-              const auto& nearestEntanglementSLM =
-                  findNearestEntanglementSLM(x, y, otherX, otherY);
-              //===------------------------------------------------------------===//
-              // In the second step, find the specific site in the determined
-              // storage SLM
-              //===------------------------------------------------------------===//
-              std::size_t entangleCol = 0;
-              if (const auto maxX =
-                      nearestEntanglementSLM.location.first +
-                      ((nearestEntanglementSLM.nCols - 1) *
-                       nearestEntanglementSLM.siteSeparation.first);
-                  x > maxX) {
-                entangleCol = nearestEntanglementSLM.nCols - 1;
-              } else if (x >= nearestEntanglementSLM.location.first) {
-                entangleCol =
-                    (x - nearestEntanglementSLM.location.first +
-                     (nearestEntanglementSLM.siteSeparation.first / 2)) /
-                    nearestEntanglementSLM.siteSeparation.first;
-              }
-              std::size_t entangleRow = 0;
-              if (const auto maxY =
-                      nearestEntanglementSLM.location.second +
-                      ((nearestEntanglementSLM.nRows - 1) *
-                       nearestEntanglementSLM.siteSeparation.second);
-                  y > maxY) {
-                entangleRow = nearestEntanglementSLM.nRows - 1;
-              } else if (y >= nearestEntanglementSLM.location.second) {
-                entangleRow =
-                    (y - nearestEntanglementSLM.location.second +
-                     (nearestEntanglementSLM.siteSeparation.second / 2)) /
-                    nearestEntanglementSLM.siteSeparation.second;
-              }
-              storageToNearestEntanglementSiteForThisSite.at(*otherSLM)
-                  .back()
-                  .emplace_back(nearestEntanglementSLM, entangleRow,
-                                entangleCol);
-            }
-          }
-        }
+        siteLocations_.emplace_back(exactSLMLocation(*slm, row, col));
       }
     }
   }
 }
 
+auto Architecture::getSite(const SiteId id) const -> Site {
+  assert(id < nSites_);
+  // find the last SLM whose first site id is not larger than the given id
+  const auto it = std::prev(std::upper_bound(
+      slmsBySiteId_.cbegin(), slmsBySiteId_.cend(), id,
+      [](const SiteId value, const SLM* slm) -> bool {
+        return value < slm->firstSiteId_;
+      }));
+  const auto& slm = **it;
+  const auto offset = static_cast<std::size_t>(id - slm.firstSiteId_);
+  return {slm, offset / slm.nCols, offset % slm.nCols};
+}
+
+auto Architecture::nearestSiteInSLM(const SLM& slm, const std::size_t x,
+                                    const std::size_t y)
+    -> std::pair<std::size_t, std::size_t> {
+  std::size_t col = 0;
+  if (const auto maxX =
+          slm.location.first + ((slm.nCols - 1) * slm.siteSeparation.first);
+      x > maxX) {
+    col = slm.nCols - 1;
+  } else if (x >= slm.location.first) {
+    col = (x - slm.location.first + (slm.siteSeparation.first / 2)) /
+          slm.siteSeparation.first;
+  }
+  std::size_t row = 0;
+  if (const auto maxY =
+          slm.location.second + ((slm.nRows - 1) * slm.siteSeparation.second);
+      y > maxY) {
+    row = slm.nRows - 1;
+  } else if (y >= slm.location.second) {
+    row = (y - slm.location.second + (slm.siteSeparation.second / 2)) /
+          slm.siteSeparation.second;
+  }
+  return {row, col};
+}
+
+auto Architecture::preprocessing() -> void {
+  assignSiteIds();
+  computeLookupTables();
+}
+
+auto Architecture::computeLookupTables() -> void {
+  //===--------------------------------------------------------------------===//
+  // calculate the nearest storage site for each entanglement site
+  //===--------------------------------------------------------------------===//
+  nearestStorageSiteIds_.clear();
+  nearestStorageSiteIds_.reserve(nSites_ - nStorageSites_);
+  for (SiteId site = nStorageSites_; site < nSites_; ++site) {
+    const auto& [x, y] = siteLocations_[site];
+    //===------------------------------------------------------------------===//
+    // In the first step, find the nearest storage SLM (not the specific site
+    // in the storage SLM yet)
+    //===------------------------------------------------------------------===//
+    const auto& nearestStorageSLM = findNearestStorageSLM(x, y);
+    //===------------------------------------------------------------------===//
+    // In the second step, find the specific site in the determined storage
+    // SLM
+    //===------------------------------------------------------------------===//
+    const auto& [storageRow, storageCol] =
+        nearestSiteInSLM(nearestStorageSLM, x, y);
+    nearestStorageSiteIds_.emplace_back(
+        getSiteId(nearestStorageSLM, storageRow, storageCol));
+  }
+}
+
+namespace {
+/**
+ * The header of the lookup tables written by
+ * Architecture::exportLookupTables. It is followed by the nearest storage
+ * site ids.
+ */
+struct LookupTablesHeader {
+  /// Identifies the file format including its version
+  std::array<char, 8> magic;
+  /// The fingerprint of the geometry of the architecture
+  std::uint64_t fingerprint;
+  /// The total number of sites
+  std::uint32_t nSites;
+  /// The number of storage sites
+  std::uint32_t nStorageSites;
+  /// The length of the array with the nearest storage site ids
+  std::uint64_t nNearestStorageSiteIds;
+};
+constexpr std::array<char, 8> LOOKUP_TABLES_MAGIC{'N', 'A', 'Z', 'L',
+                                                  'U', 'T', '0', '2'};
+} // namespace
+
+auto Architecture::getGeometryFingerprint() const -> std::uint64_t {
+  std::size_t fingerprint = 0;
+  for (const auto* slm : slmsBySiteId_) {
+    for (const auto value :
+         {slm->location.first, slm->location.second, slm->siteSeparation.first,
+          slm->siteSeparation.second, slm->nRows, slm->nCols,
+          static_cast<std::size_t>(slm->isEntanglement())}) {
+      fingerprint = qc::combineHash(fingerprint, value);
+    }
+  }
+  return fingerprint;
+}
+
+auto Architecture::exportLookupTables(std::ostream& os) const -> void {
+  const LookupTablesHeader header{LOOKUP_TABLES_MAGIC,
+                                  getGeometryFingerprint(),
+                                  nSites_,
+                                  nStorageSites_,
+                                  nearestStorageSiteIds_.size()};
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  os.write(reinterpret_cast<const char*>(nearestStorageSiteIds_.data()),
+           static_cast<std::streamsize>(nearestStorageSiteIds_.size() *
+                                        sizeof(SiteId)));
+}
+
+auto Architecture::importLookupTables(std::istream& is) -> bool {
+  LookupTablesHeader header{};
+  if (!is.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      header.magic != LOOKUP_TABLES_MAGIC ||
+      header.fingerprint != getGeometryFingerprint() ||
+      header.nSites != nSites_ || header.nStorageSites != nStorageSites_ ||
+      header.nNearestStorageSiteIds != nSites_ - nStorageSites_) {
+    return false;
+  }
+  std::vector<SiteId> nearestStorageSiteIds(header.nNearestStorageSiteIds);
+  if (!is.read(reinterpret_cast<char*>(nearestStorageSiteIds.data()),
+               static_cast<std::streamsize>(nearestStorageSiteIds.size() *
+                                            sizeof(SiteId)))) {
+    return false;
+  }
+  // the header matches, hence, out-of-range ids indicate a corrupted file
+  for (const auto site : nearestStorageSiteIds) {
+    if (site >= nStorageSites_) {
+      std::stringstream ss;
+      ss << "Corrupted lookup tables: nearest storage site id " << site
+         << " is out of range, the architecture has only " << nStorageSites_
+         << " storage sites.";
+      throw std::invalid_argument(ss.str());
+    }
+  }
+  nearestStorageSiteIds_ = std::move(nearestStorageSiteIds);
+  return true;
+}
+
 auto Architecture::distance(const SLM& idx1, const std::size_t r1,
                             const std::size_t c1, const SLM& idx2,
                             const std::size_t r2, const std::size_t c2) const
@@ -808,26 +867,51 @@ auto Architecture::distance(const SLM& idx1, const std::size_t r1,
                     static_cast<double>(y1) - static_cast<double>(y2));
 }
 
+auto Architecture::distance(const SiteId site1, const SiteId site2) const
+    -> double {
+  const auto& [x1, y1] = getSiteLocation(site1);
+  const auto& [x2, y2] = getSiteLocation(site2);
+  return std::hypot(static_cast<double>(x1) - static_cast<double>(x2),
+                    static_cast<double>(y1) - static_cast<double>(y2));
+}
+
 auto Architecture::nearestStorageSite(const SLM& slm, const std::size_t r,
-                                      const std::size_t c) const -> const
-    std::tuple<std::reference_wrapper<const SLM>, std::size_t, std::size_t>& {
-  return entanglementToNearestStorageSite.at(std::cref(slm))[r][c];
+                                      const std::size_t c) const -> Site {
+  assert(slm.isEntanglement());
+  return getSite(nearestStorageSiteId(getSiteId(slm, r, c)));
+}
+
+auto Architecture::nearestEntanglementSiteId(SiteId site1, SiteId site2) const
+    -> SiteId {
+  assert(site1 < nStorageSites_ && site2 < nStorageSites_);
+  // the result is not symmetric, hence, the order of the sites is fixed
+  if (site1 > site2) {
+    std::swap(site1, site2);
+  }
+  const auto& [x, y] = siteLocations_[site1];
+  const auto& [otherX, otherY] = siteLocations_[site2];
+  //===--------------------------------------------------------------------===//
+  // In the first step, find the nearest entanglement SLM (not the specific
+  // site in the entanglement SLM yet)
+  //===--------------------------------------------------------------------===//
+  const auto& nearestEntanglementSLM =
+      findNearestEntanglementSLM(x, y, otherX, otherY);
+  //===--------------------------------------------------------------------===//
+  // In the second step, find the specific site in the determined entanglement
+  // SLM
+  //===--------------------------------------------------------------------===//
+  const auto& [entangleRow, entangleCol] =
+      nearestSiteInSLM(nearestEntanglementSLM, x, y);
+  return getSiteId(nearestEntanglementSLM, entangleRow, entangleCol);
 }
 
 auto Architecture::nearestEntanglementSite(
     const SLM& idx1, const std::size_t r1, const std::size_t c1,
-    const SLM& idx2, const std::size_t r2, const std::size_t c2) const -> const
-    std::tuple<std::reference_wrapper<const SLM>, std::size_t, std::size_t>& {
+    const SLM& idx2, const std::size_t r2, const std::size_t c2) const
+    -> Site {
   assert(idx1.isStorage() && idx2.isStorage());
-  if (&idx1 > &idx2 || (&idx1 == &idx2 && r1 > r2) ||
-      (&idx1 == &idx2 && r1 == r2 && c1 > c2)) {
-    return nearestEntanglementSite(idx2, r2, c2, idx1, r1, c1);
-  }
-  assert(&idx1 < &idx2 || (&idx1 == &idx2 && r1 < r2) ||
-         (&idx1 == &idx2 && r1 == r2 && c1 <= c2));
-  return storageToNearestEntanglementSite.at(std::cref(idx1))[r1][c1].at(
-      std::cref(idx2))[&idx1 == &idx2 ? r2 - r1 : r2]
-                      [&idx1 == &idx2 && r1 == r2 ? c2 - c1 : c2];
+  return getSite(nearestEntanglementSiteId(getSiteId(idx1, r1, c1),
+                                           getSiteId(idx2, r2, c2)));
 }
 
 auto Architecture::nearestEntanglementSiteDistance(
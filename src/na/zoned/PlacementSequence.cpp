@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2023 - 2025 Chair for Design Automation, TUM
+ * Copyright (c) 2025 Munich Quantum Software Company GmbH
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "na/zoned/PlacementSequence.hpp"
+
+#include "ir/Definitions.hpp"
+#include "na/zoned/Architecture.hpp"
+#include "na/zoned/Types.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace na::zoned {
+PlacementSequence::PlacementSequence(const Architecture& architecture,
+                                     const size_t checkpointInterval)
+    : architecture_(architecture),
+      checkpointInterval_(std::max<size_t>(1, checkpointInterval)) {}
+
+PlacementSequence::PlacementSequence(const Architecture& architecture,
+                                     const std::vector<Placement>& placements,
+                                     const size_t checkpointInterval)
+    : PlacementSequence(architecture, checkpointInterval) {
+  moveOffsets_.reserve(placements.size());
+  for (const auto& placement : placements) {
+    append(placement);
+  }
+}
+
+auto PlacementSequence::append(const Placement& placement) -> void {
+  if (size_ == 0) {
+    back_.clear();
+    back_.reserve(placement.size());
+    for (const auto& site : placement) {
+      back_.emplace_back(architecture_.get().getSiteId(site));
+    }
+  } else {
+    assert(placement.size() == back_.size());
+    for (qc::Qubit atom = 0; atom < placement.size(); ++atom) {
+      if (const auto site = architecture_.get().getSiteId(placement[atom]);
+          site != back_[atom]) {
+        moves_.emplace_back(Move{atom, site});
+        back_[atom] = site;
+      }
+    }
+  }
+  moveOffsets_.emplace_back(moves_.size());
+  if (size_ % checkpointInterval_ == 0) {
+    checkpoints_.emplace_back(back_);
+  }
+  ++size_;
+}
+
+auto PlacementSequence::getMoves(const size_t i) const
+    -> std::span<const Move> {
+  assert(i < size_);
+  if (i == 0) {
+    return {};
+  }
+  return std::span<const Move>(moves_).subspan(
+      moveOffsets_[i - 1], moveOffsets_[i] - moveOffsets_[i - 1]);
+}
+
+auto PlacementSequence::applyMoves(const size_t i, Placement& placement) const
+    -> void {
+  for (const auto& [atom, site] : getMoves(i)) {
+    placement[atom] = architecture_.get().getSite(site);
+  }
+}
+
+auto PlacementSequence::getSiteIds(const size_t i) const
+    -> std::vector<SiteId> {
+  assert(i < size_);
+  if (i + 1 == size_) {
+    return back_;
+  }
+  // start from the closest checkpoint before the requested placement
+  const auto checkpoint = i / checkpointInterval_;
+  auto siteIds = checkpoints_[checkpoint];
+  for (auto j = (checkpoint * checkpointInterval_) + 1; j <= i; ++j) {
+    for (const auto& [atom, site] : getMoves(j)) {
+      siteIds[atom] = site;
+    }
+  }
+  return siteIds;
+}
+
+auto PlacementSequence::getPlacement(const size_t i) const -> Placement {
+  const auto& siteIds = getSiteIds(i);
+  Placement placement;
+  placement.reserve(siteIds.size());
+  for (const auto site : siteIds) {
+    placement.emplace_back(architecture_.get().getSite(site));
+  }
+  return placement;
+}
+
+auto PlacementSequence::back() const -> Placement {
+  assert(size_ > 0);
+  return getPlacement(size_ - 1);
+}
+
+auto PlacementSequence::toVector() const -> std::vector<Placement> {
+  std::vector<Placement> placements;
+  if (size_ == 0) {
+    return placements;
+  }
+  placements.reserve(size_);
+  placements.emplace_back(front());
+  for (size_t i = 1; i < size_; ++i) {
+    placements.emplace_back(placements.back());
+    applyMoves(i, placements.back());
+  }
+  return placements;
+}
+
+auto PlacementSequence::getMemory() const -> size_t {
+  size_t memory = sizeof(PlacementSequence) +
+                  (moves_.capacity() * sizeof(Move)) +
+                  (moveOffsets_.capacity() * sizeof(size_t)) +
+                  (back_.capacity() * sizeof(SiteId)) +
+                  (checkpoints_.capacity() * sizeof(std::vector<SiteId>));
+  for (const auto& checkpoint : checkpoints_) {
+    memory += checkpoint.capacity() * sizeof(SiteId);
+  }
+  return memory;
+}
+} // namespace na::zoned
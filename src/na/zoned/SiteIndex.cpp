@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2023 - 2025 Chair for Design Automation, TUM
+ * Copyright (c) 2025 Munich Quantum Software Company GmbH
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "na/zoned/SiteIndex.hpp"
+
+#include "na/zoned/Architecture.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace na::zoned {
+SiteIndex::SiteIndex(const Architecture& architecture, const SiteId firstSite,
+                     const SiteId lastSite)
+    : architecture_(architecture), firstSite_(firstSite), lastSite_(lastSite) {
+  assert(firstSite <= lastSite && lastSite <= architecture.getNumberOfSites());
+  const auto nSites = static_cast<std::size_t>(lastSite - firstSite);
+  cellOfSite_.resize(nSites);
+  positionInCell_.assign(nSites, absent_);
+  if (nSites == 0) {
+    cells_.resize(1);
+    return;
+  }
+  auto maxX = std::numeric_limits<std::size_t>::min();
+  auto maxY = std::numeric_limits<std::size_t>::min();
+  minX_ = std::numeric_limits<std::size_t>::max();
+  minY_ = std::numeric_limits<std::size_t>::max();
+  for (auto site = firstSite; site < lastSite; ++site) {
+    const auto& [x, y] = architecture.getSiteLocation(site);
+    minX_ = std::min(minX_, x);
+    minY_ = std::min(minY_, y);
+    maxX = std::max(maxX, x);
+    maxY = std::max(maxY, y);
+  }
+  // choose the cell size such that every cell contains about one site if the
+  // sites are distributed uniformly over their bounding box
+  const auto area = static_cast<double>(maxX - minX_ + 1) *
+                    static_cast<double>(maxY - minY_ + 1);
+  cellSize_ = std::max<std::size_t>(
+      1, static_cast<std::size_t>(
+             std::ceil(std::sqrt(area / static_cast<double>(nSites)))));
+  nCellsX_ = ((maxX - minX_) / cellSize_) + 1;
+  nCellsY_ = ((maxY - minY_) / cellSize_) + 1;
+  cells_.resize(nCellsX_ * nCellsY_);
+  for (auto site = firstSite; site < lastSite; ++site) {
+    const auto& [x, y] = architecture.getSiteLocation(site);
+    cellOfSite_[site - firstSite] =
+        static_cast<std::uint32_t>((cellY(y) * nCellsX_) + cellX(x));
+  }
+}
+
+auto SiteIndex::insert(const SiteId site) -> bool {
+  assert(covers(site));
+  auto& position = positionInCell_[site - firstSite_];
+  if (position != absent_) {
+    return false;
+  }
+  auto& cell = cells_[cellOfSite_[site - firstSite_]];
+  position = static_cast<std::uint32_t>(cell.size());
+  cell.emplace_back(site);
+  ++size_;
+  return true;
+}
+
+auto SiteIndex::erase(const SiteId site) -> bool {
+  assert(covers(site));
+  auto& position = positionInCell_[site - firstSite_];
+  if (position == absent_) {
+    return false;
+  }
+  // move the last site of the cell into the gap
+  auto& cell = cells_[cellOfSite_[site - firstSite_]];
+  const auto last = cell.back();
+  cell[position] = last;
+  positionInCell_[last - firstSite_] = position;
+  cell.pop_back();
+  position = absent_;
+  --size_;
+  return true;
+}
+
+auto SiteIndex::fill() -> void {
+  for (auto site = firstSite_; site < lastSite_; ++site) {
+    insert(site);
+  }
+}
+
+auto SiteIndex::contains(const SiteId site) const -> bool {
+  return covers(site) && positionInCell_[site - firstSite_] != absent_;
+}
+
+auto SiteIndex::nearest(const std::size_t x, const std::size_t y,
+                        const std::size_t k) const -> std::vector<SiteId> {
+  if (k == 0 || empty()) {
+    return {};
+  }
+  // the k closest sites found so far with the farthest one on top
+  std::priority_queue<std::pair<double, SiteId>> closest;
+  const auto cx = static_cast<std::int64_t>(cellX(x));
+  const auto cy = static_cast<std::int64_t>(cellY(y));
+  const auto visit = [&](const std::int64_t i, const std::int64_t j) {
+    if (i < 0 || j < 0 || std::cmp_greater_equal(i, nCellsX_) ||
+        std::cmp_greater_equal(j, nCellsY_)) {
+      return;
+    }
+    for (const auto site :
+         cells_[(static_cast<std::size_t>(j) * nCellsX_) +
+                static_cast<std::size_t>(i)]) {
+      closest.emplace(distance(site, x, y), site);
+      if (closest.size() > k) {
+        closest.pop();
+      }
+    }
+  };
+  const auto maxRing =
+      static_cast<std::int64_t>(std::max(nCellsX_, nCellsY_));
+  for (std::int64_t ring = 0; ring < maxRing; ++ring) {
+    // every site in a cell of this ring, i.e., a cell whose Chebyshev distance
+    // to the cell of the query is `ring`, is at least `ring - 1` cells away
+    if (closest.size() == k &&
+        closest.top().first <
+            static_cast<double>((ring - 1) *
+                                static_cast<std::int64_t>(cellSize_))) {
+      break;
+    }
+    for (auto j = cy - ring; j <= cy + ring; ++j) {
+      if (j == cy - ring || j == cy + ring) {
+        for (auto i = cx - ring; i <= cx + ring; ++i) {
+          visit(i, j);
+        }
+      } else {
+        visit(cx - ring, j);
+        visit(cx + ring, j);
+      }
+    }
+  }
+  std::vector<SiteId> result(closest.size());
+  for (auto it = result.rbegin(); it != result.rend(); ++it) {
+    *it = closest.top().second;
+    closest.pop();
+  }
+  return result;
+}
+
+auto SiteIndex::withinRadius(const std::size_t x, const std::size_t y,
+                             const double radius) const
+    -> std::vector<SiteId> {
+  const auto offset = static_cast<std::size_t>(std::max(0.0, radius));
+  const auto lowX = cellX(x > offset ? x - offset : 0);
+  const auto highX = cellX(x + offset);
+  const auto lowY = cellY(y > offset ? y - offset : 0);
+  const auto highY = cellY(y + offset);
+  std::vector<std::pair<double, SiteId>> found;
+  for (auto j = lowY; j <= highY; ++j) {
+    for (auto i = lowX; i <= highX; ++i) {
+      for (const auto site : cells_[(j * nCellsX_) + i]) {
+        if (const auto d = distance(site, x, y); d <= radius) {
+          found.emplace_back(d, site);
+        }
+      }
+    }
+  }
+  std::sort(found.begin(), found.end());
+  std::vector<SiteId> result;
+  result.reserve(found.size());
+  for (const auto& [_, site] : found) {
+    result.emplace_back(site);
+  }
+  return result;
+}
+
+auto SiteIndex::cellX(const std::size_t x) const -> std::size_t {
+  return x < minX_ ? 0 : std::min((x - minX_) / cellSize_, nCellsX_ - 1);
+}
+
+auto SiteIndex::cellY(const std::size_t y) const -> std::size_t {
+  return y < minY_ ? 0 : std::min((y - minY_) / cellSize_, nCellsY_ - 1);
+}
+
+auto SiteIndex::distance(const SiteId site, const std::size_t x,
+                         const std::size_t y) const -> double {
+  const auto& [siteX, siteY] = architecture_.get().getSiteLocation(site);
+  return std::hypot(static_cast<double>(siteX) - static_cast<double>(x),
+                    static_cast<double>(siteY) - static_cast<double>(y));
+}
+} // namespace na::zoned
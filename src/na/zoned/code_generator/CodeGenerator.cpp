@@ -18,15 +18,10 @@
 #include "na/entities/Atom.hpp"
 #include "na/entities/Location.hpp"
 #include "na/entities/Zone.hpp"
-#include "na/operations/GlobalCZOp.hpp"
-#include "na/operations/GlobalRYOp.hpp"
-#include "na/operations/LoadOp.hpp"
-#include "na/operations/LocalRZOp.hpp"
-#include "na/operations/LocalUOp.hpp"
-#include "na/operations/MoveOp.hpp"
-#include "na/operations/StoreOp.hpp"
 #include "na/zoned/Architecture.hpp"
+#include "na/zoned/PlacementSequence.hpp"
 #include "na/zoned/Types.hpp"
+#include "na/zoned/code_generator/CodeWriter.hpp"
 
 #include <cassert>
 #include <cstddef>
@@ -43,7 +38,7 @@ namespace na::zoned {
 auto CodeGenerator::appendSingleQubitGates(
     const size_t nQubits, const SingleQubitGateLayer& singleQubitGates,
     const std::vector<std::reference_wrapper<const Atom>>& atoms,
-    const Zone& globalZone, NAComputation& code) const -> void {
+    const Zone& globalZone, CodeWriter& writer) const -> void {
   for (const auto& op : singleQubitGates) {
     // A flag to indicate if the gate is a gate on one qubit.
     // This flag is used for circuit consisting of only one qubit since in this
@@ -57,10 +52,10 @@ auto CodeGenerator::appendSingleQubitGates(
             dynamic_cast<const qc::CompoundOperation&>(op.get());
         const auto opType = compOp.front()->getType();
         if (opType == qc::RY) {
-          code.emplaceBack<GlobalRYOp>(globalZone,
+          writer.writeGlobalRY(globalZone,
                                        compOp.front()->getParameter().front());
         } else if (opType == qc::Y) {
-          code.emplaceBack<GlobalRYOp>(globalZone, qc::PI);
+          writer.writeGlobalRY(globalZone, qc::PI);
         } else {
           // this case should never occur since the scheduler should filter out
           // other global gates that are not supported already.
@@ -69,10 +64,10 @@ auto CodeGenerator::appendSingleQubitGates(
       } else {
         const auto opType = op.get().getType();
         if (opType == qc::RY) {
-          code.emplaceBack<GlobalRYOp>(globalZone,
+          writer.writeGlobalRY(globalZone,
                                        op.get().getParameter().front());
         } else if (opType == qc::Y) {
-          code.emplaceBack<GlobalRYOp>(globalZone, qc::PI);
+          writer.writeGlobalRY(globalZone, qc::PI);
         } else if (nQubits == 1) {
           // special case for one qubit, fall through to local gates
           singleQubitGate = true;
@@ -93,20 +88,20 @@ auto CodeGenerator::appendSingleQubitGates(
       const qc::Qubit qubit = op.get().getTargets().front();
       // By default, all variants of rotational z-gates are supported
       if (op.get().getType() == qc::RZ) {
-        code.emplaceBack<LocalRZOp>(atoms[qubit],
+        writer.writeLocalRZ(atoms[qubit],
                                     op.get().getParameter().front());
       } else if (op.get().getType() == qc::Z) {
-        code.emplaceBack<LocalRZOp>(atoms[qubit], qc::PI);
+        writer.writeLocalRZ(atoms[qubit], qc::PI);
       } else if (op.get().getType() == qc::S) {
-        code.emplaceBack<LocalRZOp>(atoms[qubit], qc::PI_2);
+        writer.writeLocalRZ(atoms[qubit], qc::PI_2);
       } else if (op.get().getType() == qc::Sdg) {
-        code.emplaceBack<LocalRZOp>(atoms[qubit], -qc::PI_2);
+        writer.writeLocalRZ(atoms[qubit], -qc::PI_2);
       } else if (op.get().getType() == qc::T) {
-        code.emplaceBack<LocalRZOp>(atoms[qubit], qc::PI_4);
+        writer.writeLocalRZ(atoms[qubit], qc::PI_4);
       } else if (op.get().getType() == qc::Tdg) {
-        code.emplaceBack<LocalRZOp>(atoms[qubit], -qc::PI_4);
+        writer.writeLocalRZ(atoms[qubit], -qc::PI_4);
       } else if (op.get().getType() == qc::P) {
-        code.emplaceBack<LocalRZOp>(atoms[qubit],
+        writer.writeLocalRZ(atoms[qubit],
                                     op.get().getParameter().front());
       } else {
         // in this case, the gate is not any variant of a rotational z-gate.
@@ -117,37 +112,37 @@ auto CodeGenerator::appendSingleQubitGates(
               qc::toString(op.get().getType()));
         }
         if (op.get().getType() == qc::U) {
-          code.emplaceBack<LocalUOp>(
+          writer.writeLocalU(
               atoms[qubit], op.get().getParameter().front(),
               op.get().getParameter().at(1), op.get().getParameter().at(2));
         } else if (op.get().getType() == qc::U2) {
-          code.emplaceBack<LocalUOp>(atoms[qubit], qc::PI_2,
+          writer.writeLocalU(atoms[qubit], qc::PI_2,
                                      op.get().getParameter().front(),
                                      op.get().getParameter().at(1));
         } else if (op.get().getType() == qc::RX) {
-          code.emplaceBack<LocalUOp>(atoms[qubit],
+          writer.writeLocalU(atoms[qubit],
                                      op.get().getParameter().front(), -qc::PI_2,
                                      qc::PI_2);
         } else if (op.get().getType() == qc::RY) {
-          code.emplaceBack<LocalUOp>(atoms[qubit],
+          writer.writeLocalU(atoms[qubit],
                                      op.get().getParameter().front(), 0, 0);
         } else if (op.get().getType() == qc::H) {
-          code.emplaceBack<LocalUOp>(atoms[qubit], qc::PI_2, 0, qc::PI);
+          writer.writeLocalU(atoms[qubit], qc::PI_2, 0, qc::PI);
         } else if (op.get().getType() == qc::X) {
-          code.emplaceBack<LocalUOp>(atoms[qubit], qc::PI, 0, qc::PI);
+          writer.writeLocalU(atoms[qubit], qc::PI, 0, qc::PI);
         } else if (op.get().getType() == qc::Y) {
-          code.emplaceBack<LocalUOp>(atoms[qubit], qc::PI, qc::PI_2, qc::PI_2);
+          writer.writeLocalU(atoms[qubit], qc::PI, qc::PI_2, qc::PI_2);
         } else if (op.get().getType() == qc::V) {
-          code.emplaceBack<LocalUOp>(atoms[qubit], -qc::PI_2, -qc::PI_2,
+          writer.writeLocalU(atoms[qubit], -qc::PI_2, -qc::PI_2,
                                      qc::PI_2);
         } else if (op.get().getType() == qc::Vdg) {
-          code.emplaceBack<LocalUOp>(atoms[qubit], -qc::PI_2, qc::PI_2,
+          writer.writeLocalU(atoms[qubit], -qc::PI_2, qc::PI_2,
                                      -qc::PI_2);
         } else if (op.get().getType() == qc::SX) {
-          code.emplaceBack<LocalUOp>(atoms[qubit], qc::PI_2, -qc::PI_2,
+          writer.writeLocalU(atoms[qubit], qc::PI_2, -qc::PI_2,
                                      qc::PI_2);
         } else if (op.get().getType() == qc::SXdg) {
-          code.emplaceBack<LocalUOp>(atoms[qubit], -qc::PI_2, -qc::PI_2,
+          writer.writeLocalU(atoms[qubit], -qc::PI_2, -qc::PI_2,
                                      qc::PI_2);
         } else {
           // if the gate type is not recognized, an error is printed and the
@@ -167,22 +162,22 @@ auto CodeGenerator::appendTwoQubitGates(
     const Placement& targetPlacement,
     const std::vector<std::reference_wrapper<const Atom>>& atoms,
     const std::vector<std::reference_wrapper<const Zone>>& zones,
-    NAComputation& code) const -> void {
+    CodeWriter& writer) const -> void {
   appendRearrangement(currentPlacement, executionRouting, executionPlacement,
-                      atoms, code);
+                      atoms, writer);
   std::vector<const Zone*> zonePtrs;
   zonePtrs.reserve(zones.size());
   std::transform(zones.begin(), zones.end(), std::back_inserter(zonePtrs),
                  [](const auto& zone) { return &zone.get(); });
-  code.emplaceBack<GlobalCZOp>(zonePtrs);
+  writer.writeGlobalCZ(zonePtrs);
   appendRearrangement(executionPlacement, targetRouting, targetPlacement, atoms,
-                      code);
+                      writer);
 }
 auto CodeGenerator::appendRearrangement(
     const Placement& startPlacement, const Routing& routing,
     const Placement& targetPlacement,
     const std::vector<std::reference_wrapper<const Atom>>& atoms,
-    NAComputation& code) const -> void {
+    CodeWriter& writer) const -> void {
   for (const auto& qubits : routing) {
     std::map<size_t, std::map<size_t, qc::Qubit>> rowsWithQubits;
     std::vector<const Atom*> atomsToMove;
@@ -209,7 +204,7 @@ auto CodeGenerator::appendRearrangement(
       alreadyLoadedQubits.emplace_back(qubit, std::pair{x, minY});
       firstAtomsToLoad.emplace_back(&atoms[qubit].get());
     }
-    code.emplaceBack<LoadOp>(firstAtomsToLoad);
+    writer.writeLoad(firstAtomsToLoad);
     // if there are more than one row with atoms to move, we pick them up
     // row-by-row as a simple strategy to avoid ghost-spots
     for (auto it = std::next(rowsWithQubits.cbegin());
@@ -237,7 +232,7 @@ auto CodeGenerator::appendRearrangement(
                        static_cast<double>(y + config_.parkingOffset)});
         }
       }
-      code.emplaceBack<MoveOp>(atomsToOffset, offsetTargetLocations);
+      writer.writeMove(atomsToOffset, offsetTargetLocations);
       // load the new atoms
       std::vector<const Atom*> atomsToLoad;
       atomsToLoad.reserve(row.size());
@@ -245,11 +240,11 @@ auto CodeGenerator::appendRearrangement(
         alreadyLoadedQubits.emplace_back(qubit, std::pair{x, yCoordinateOfRow});
         atomsToLoad.emplace_back(&atoms[qubit].get());
       }
-      code.emplaceBack<LoadOp>(atomsToLoad);
+      writer.writeLoad(atomsToLoad);
     }
     // all atoms are loaded, now move them to their target locations
-    code.emplaceBack<MoveOp>(atomsToMove, targetLocations);
-    code.emplaceBack<StoreOp>(atomsToMove);
+    writer.writeMove(atomsToMove, targetLocations);
+    writer.writeStore(atomsToMove);
   }
 }
 auto CodeGenerator::generate(
@@ -257,15 +252,101 @@ auto CodeGenerator::generate(
     const std::vector<Placement>& placement,
     const std::vector<Routing>& routing) const -> NAComputation {
   NAComputation code;
-  std::vector<std::reference_wrapper<const Zone>> rydbergZones;
+  NAComputationWriter writer(code);
+  generate(singleQubitGateLayers, placement, routing, code, writer);
+  return code;
+}
+auto CodeGenerator::generate(
+    const std::vector<SingleQubitGateLayer>& singleQubitGateLayers,
+    const PlacementSequence& placement,
+    const std::vector<Routing>& routing) const -> NAComputation {
+  NAComputation code;
+  NAComputationWriter writer(code);
+  generate(singleQubitGateLayers, placement, routing, code, writer);
+  return code;
+}
+auto CodeGenerator::generate(
+    const std::vector<SingleQubitGateLayer>& singleQubitGateLayers,
+    const std::vector<Placement>& placement,
+    const std::vector<Routing>& routing, CodeWriter& writer) const -> void {
+  // the header only holds the zones and atoms the operations refer to
+  NAComputation header;
+  generate(singleQubitGateLayers, placement, routing, header, writer);
+}
+auto CodeGenerator::generate(
+    const std::vector<SingleQubitGateLayer>& singleQubitGateLayers,
+    const PlacementSequence& placement,
+    const std::vector<Routing>& routing, CodeWriter& writer) const -> void {
+  // the header only holds the zones and atoms the operations refer to
+  NAComputation header;
+  generate(singleQubitGateLayers, placement, routing, header, writer);
+}
+auto CodeGenerator::generate(
+    const std::vector<SingleQubitGateLayer>& singleQubitGateLayers,
+    const std::vector<Placement>& placement,
+    const std::vector<Routing>& routing, NAComputation& code,
+    CodeWriter& writer) const -> void {
+  const auto& context = initializeCode(placement.front(), code, writer);
+  // early return if no single-qubit gates are given
+  if (singleQubitGateLayers.empty()) {
+    return;
+  }
+  assert(2 * singleQubitGateLayers.size() == placement.size() + 1);
+  assert(placement.size() == routing.size() + 1);
+  appendSingleQubitGateLayer(context, singleQubitGateLayers.front(), writer);
+  for (size_t layer = 0; layer + 1 < singleQubitGateLayers.size(); ++layer) {
+    appendTwoQubitGateLayer(context, placement[2 * layer], routing[2 * layer],
+                            placement[(2 * layer) + 1],
+                            routing[(2 * layer) + 1],
+                            placement[2 * (layer + 1)], writer);
+    appendSingleQubitGateLayer(context, singleQubitGateLayers[layer + 1],
+                               writer);
+  }
+}
+auto CodeGenerator::generate(
+    const std::vector<SingleQubitGateLayer>& singleQubitGateLayers,
+    const PlacementSequence& placement,
+    const std::vector<Routing>& routing, NAComputation& code,
+    CodeWriter& writer) const -> void {
+  auto currentPlacement = placement.front();
+  const auto& context = initializeCode(currentPlacement, code, writer);
+  // early return if no single-qubit gates are given
+  if (singleQubitGateLayers.empty()) {
+    return;
+  }
+  assert(2 * singleQubitGateLayers.size() == placement.size() + 1);
+  assert(placement.size() == routing.size() + 1);
+  appendSingleQubitGateLayer(context, singleQubitGateLayers.front(), writer);
+  // the placements are materialized one after the other by only updating the
+  // atoms that are moved
+  auto executionPlacement = currentPlacement;
+  for (size_t layer = 0; layer + 1 < singleQubitGateLayers.size(); ++layer) {
+    placement.applyMoves((2 * layer) + 1, executionPlacement);
+    auto targetPlacement = executionPlacement;
+    placement.applyMoves(2 * (layer + 1), targetPlacement);
+    appendTwoQubitGateLayer(context, currentPlacement, routing[2 * layer],
+                            executionPlacement, routing[(2 * layer) + 1],
+                            targetPlacement, writer);
+    appendSingleQubitGateLayer(context, singleQubitGateLayers[layer + 1],
+                               writer);
+    currentPlacement = targetPlacement;
+    executionPlacement = std::move(targetPlacement);
+  }
+}
+auto CodeGenerator::initializeCode(const Placement& initialPlacement,
+                                   NAComputation& code,
+                                   CodeWriter& writer) const -> Context {
+  Context context;
+  CodeHeader header;
   for (size_t i = 0; i < architecture_.get().rydbergRangeMinX.size(); ++i) {
-    rydbergZones.emplace_back(code.emplaceBackZone(
-        "zone_cz" + std::to_string(i),
-        Zone::Extent{
-            static_cast<double>(architecture_.get().rydbergRangeMinX.at(i)),
-            static_cast<double>(architecture_.get().rydbergRangeMinY.at(i)),
-            static_cast<double>(architecture_.get().rydbergRangeMaxX.at(i)),
-            static_cast<double>(architecture_.get().rydbergRangeMaxY.at(i))}));
+    const auto& extent = header.zoneExtents.emplace_back(Zone::Extent{
+        static_cast<double>(architecture_.get().rydbergRangeMinX.at(i)),
+        static_cast<double>(architecture_.get().rydbergRangeMinY.at(i)),
+        static_cast<double>(architecture_.get().rydbergRangeMaxX.at(i)),
+        static_cast<double>(architecture_.get().rydbergRangeMaxY.at(i))});
+    context.rydbergZones.emplace_back(
+        code.emplaceBackZone("zone_cz" + std::to_string(i), extent));
+    header.zones.emplace_back(context.rydbergZones.back());
   }
   size_t minX = std::numeric_limits<size_t>::max();
   size_t maxX = std::numeric_limits<size_t>::min();
@@ -279,34 +360,38 @@ auto CodeGenerator::generate(
     maxY = std::max(maxY, zone->location.second +
                               zone->siteSeparation.second * zone->nRows);
   }
-  const auto& globalZone = code.emplaceBackZone(
-      "global",
+  const auto& globalExtent = header.zoneExtents.emplace_back(
       Zone::Extent{static_cast<double>(minX), static_cast<double>(minY),
                    static_cast<double>(maxX), static_cast<double>(maxY)});
-  const auto& initialPlacement = placement.front();
-  std::vector<std::reference_wrapper<const Atom>> atoms;
-  atoms.reserve(initialPlacement.size());
+  context.globalZone = &code.emplaceBackZone("global", globalExtent);
+  header.zones.emplace_back(*context.globalZone);
+  context.atoms.reserve(initialPlacement.size());
+  header.initialLocations.reserve(initialPlacement.size());
   for (const auto& [slm, r, c] : initialPlacement) {
-    atoms.emplace_back(
-        code.emplaceBackAtom("atom" + std::to_string(atoms.size())));
+    context.atoms.emplace_back(
+        code.emplaceBackAtom("atom" + std::to_string(context.atoms.size())));
     const auto& [x, y] = architecture_.get().exactSLMLocation(slm, r, c);
-    code.emplaceInitialLocation(atoms.back(), x, y);
-  }
-  // early return if no single-qubit gates are given
-  if (singleQubitGateLayers.empty()) {
-    return code;
+    code.emplaceInitialLocation(context.atoms.back(), x, y);
+    header.initialLocations.emplace_back(
+        Location{static_cast<double>(x), static_cast<double>(y)});
   }
-  assert(2 * singleQubitGateLayers.size() == placement.size() + 1);
-  assert(placement.size() == routing.size() + 1);
-  appendSingleQubitGates(atoms.size(), singleQubitGateLayers.front(), atoms,
-                         globalZone, code);
-  for (size_t layer = 0; layer + 1 < singleQubitGateLayers.size(); ++layer) {
-    appendTwoQubitGates(placement[2 * layer], routing[2 * layer],
-                        placement[(2 * layer) + 1], routing[(2 * layer) + 1],
-                        placement[2 * (layer + 1)], atoms, rydbergZones, code);
-    appendSingleQubitGates(atoms.size(), singleQubitGateLayers[layer + 1],
-                           atoms, globalZone, code);
-  }
-  return code;
+  header.atoms = context.atoms;
+  writer.writeHeader(code, header);
+  return context;
+}
+auto CodeGenerator::appendSingleQubitGateLayer(
+    const Context& context, const SingleQubitGateLayer& singleQubitGates,
+    CodeWriter& writer) const -> void {
+  appendSingleQubitGates(context.atoms.size(), singleQubitGates, context.atoms,
+                         *context.globalZone, writer);
+}
+auto CodeGenerator::appendTwoQubitGateLayer(
+    const Context& context, const Placement& currentPlacement,
+    const Routing& executionRouting, const Placement& executionPlacement,
+    const Routing& targetRouting, const Placement& targetPlacement,
+    CodeWriter& writer) const -> void {
+  appendTwoQubitGates(currentPlacement, executionRouting, executionPlacement,
+                      targetRouting, targetPlacement, context.atoms,
+                      context.rydbergZones, writer);
 }
 } // namespace na::zoned
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2023 - 2025 Chair for Design Automation, TUM
+ * Copyright (c) 2025 Munich Quantum Software Company GmbH
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "na/zoned/code_generator/CodeWriter.hpp"
+
+#include "na/NAComputation.hpp"
+#include "na/entities/Atom.hpp"
+#include "na/entities/Location.hpp"
+#include "na/entities/Zone.hpp"
+#include "na/operations/GlobalCZOp.hpp"
+#include "na/operations/GlobalRYOp.hpp"
+#include "na/operations/LoadOp.hpp"
+#include "na/operations/LocalRZOp.hpp"
+#include "na/operations/LocalUOp.hpp"
+#include "na/operations/MoveOp.hpp"
+#include "na/operations/StoreOp.hpp"
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace na::zoned {
+auto NAComputationWriter::writeHeader(const NAComputation& code,
+                                      const CodeHeader& /* unused */) -> void {
+  // the zones and atoms are created directly in the computation
+  assert(&code == &code_.get());
+  static_cast<void>(code);
+}
+auto NAComputationWriter::writeLoad(const std::vector<const Atom*>& atoms)
+    -> void {
+  code_.get().emplaceBack<LoadOp>(atoms);
+}
+auto NAComputationWriter::writeMove(
+    const std::vector<const Atom*>& atoms,
+    const std::vector<Location>& targetLocations) -> void {
+  code_.get().emplaceBack<MoveOp>(atoms, targetLocations);
+}
+auto NAComputationWriter::writeStore(const std::vector<const Atom*>& atoms)
+    -> void {
+  code_.get().emplaceBack<StoreOp>(atoms);
+}
+auto NAComputationWriter::writeGlobalCZ(const std::vector<const Zone*>& zones)
+    -> void {
+  code_.get().emplaceBack<GlobalCZOp>(zones);
+}
+auto NAComputationWriter::writeGlobalRY(const Zone& zone, const double angle)
+    -> void {
+  code_.get().emplaceBack<GlobalRYOp>(zone, angle);
+}
+auto NAComputationWriter::writeLocalRZ(const Atom& atom, const double angle)
+    -> void {
+  code_.get().emplaceBack<LocalRZOp>(atom, angle);
+}
+auto NAComputationWriter::writeLocalU(const Atom& atom, const double theta,
+                                      const double phi, const double lambda)
+    -> void {
+  code_.get().emplaceBack<LocalUOp>(atom, theta, phi, lambda);
+}
+
+TextCodeWriter::TextCodeWriter(std::ostream& os)
+    : write_([&os](const std::string& chunk) { os << chunk; }) {}
+auto TextCodeWriter::writeHeader(const NAComputation& code,
+                                 const CodeHeader& /* unused */) -> void {
+  // the header does not contain any operations, hence, its string
+  // representation only consists of the atoms at their initial locations
+  write_(code.toString());
+}
+auto TextCodeWriter::writeLoad(const std::vector<const Atom*>& atoms) -> void {
+  write_(LoadOp(atoms).toString() + "\n");
+}
+auto TextCodeWriter::writeMove(const std::vector<const Atom*>& atoms,
+                               const std::vector<Location>& targetLocations)
+    -> void {
+  write_(MoveOp(atoms, targetLocations).toString() + "\n");
+}
+auto TextCodeWriter::writeStore(const std::vector<const Atom*>& atoms)
+    -> void {
+  write_(StoreOp(atoms).toString() + "\n");
+}
+auto TextCodeWriter::writeGlobalCZ(const std::vector<const Zone*>& zones)
+    -> void {
+  write_(GlobalCZOp(zones).toString() + "\n");
+}
+auto TextCodeWriter::writeGlobalRY(const Zone& zone, const double angle)
+    -> void {
+  write_(GlobalRYOp(zone, angle).toString() + "\n");
+}
+auto TextCodeWriter::writeLocalRZ(const Atom& atom, const double angle)
+    -> void {
+  write_(LocalRZOp(atom, angle).toString() + "\n");
+}
+auto TextCodeWriter::writeLocalU(const Atom& atom, const double theta,
+                                 const double phi, const double lambda)
+    -> void {
+  write_(LocalUOp(atom, theta, phi, lambda).toString() + "\n");
+}
+
+auto BinaryCodeWriter::writeU32(const uint32_t value) -> void {
+  const std::array bytes{static_cast<char>(value & 0xFFU),
+                         static_cast<char>((value >> 8U) & 0xFFU),
+                         static_cast<char>((value >> 16U) & 0xFFU),
+                         static_cast<char>((value >> 24U) & 0xFFU)};
+  os_.get().write(bytes.data(), bytes.size());
+}
+auto BinaryCodeWriter::writeF64(const double value) -> void {
+  const auto bits = std::bit_cast<uint64_t>(value);
+  std::array<char, sizeof(uint64_t)> bytes{};
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] = static_cast<char>((bits >> (8 * i)) & 0xFFU);
+  }
+  os_.get().write(bytes.data(), bytes.size());
+}
+auto BinaryCodeWriter::writeString(const std::string& value) -> void {
+  writeU32(static_cast<uint32_t>(value.size()));
+  os_.get().write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+auto BinaryCodeWriter::writeOpcode(const Opcode opcode) -> void {
+  os_.get().put(static_cast<char>(opcode));
+}
+auto BinaryCodeWriter::writeAtoms(const std::vector<const Atom*>& atoms)
+    -> void {
+  writeU32(static_cast<uint32_t>(atoms.size()));
+  for (const auto* atom : atoms) {
+    writeU32(atomIndices_.at(atom));
+  }
+}
+auto BinaryCodeWriter::writeHeader(const NAComputation& /* unused */,
+                                   const CodeHeader& header) -> void {
+  assert(header.atoms.size() == header.initialLocations.size());
+  assert(header.zones.size() == header.zoneExtents.size());
+  os_.get().write("NAQC", 4);
+  os_.get().put(static_cast<char>(VERSION));
+  zoneIndices_.clear();
+  writeU32(static_cast<uint32_t>(header.zones.size()));
+  for (size_t i = 0; i < header.zones.size(); ++i) {
+    const auto& zone = header.zones[i].get();
+    zoneIndices_.emplace(&zone, static_cast<uint32_t>(i));
+    writeString(zone.getName());
+    const auto& extent = header.zoneExtents[i];
+    writeF64(extent.minX);
+    writeF64(extent.minY);
+    writeF64(extent.maxX);
+    writeF64(extent.maxY);
+  }
+  atomIndices_.clear();
+  atomIndices_.reserve(header.atoms.size());
+  writeU32(static_cast<uint32_t>(header.atoms.size()));
+  for (size_t i = 0; i < header.atoms.size(); ++i) {
+    const auto& atom = header.atoms[i].get();
+    atomIndices_.emplace(&atom, static_cast<uint32_t>(i));
+    writeString(atom.getName());
+    writeF64(header.initialLocations[i].x);
+    writeF64(header.initialLocations[i].y);
+  }
+}
+auto BinaryCodeWriter::writeLoad(const std::vector<const Atom*>& atoms)
+    -> void {
+  writeOpcode(Opcode::Load);
+  writeAtoms(atoms);
+}
+auto BinaryCodeWriter::writeMove(const std::vector<const Atom*>& atoms,
+                                 const std::vector<Location>& targetLocations)
+    -> void {
+  assert(atoms.size() == targetLocations.size());
+  writeOpcode(Opcode::Move);
+  writeU32(static_cast<uint32_t>(atoms.size()));
+  for (size_t i = 0; i < atoms.size(); ++i) {
+    writeU32(atomIndices_.at(atoms[i]));
+    writeF64(targetLocations[i].x);
+    writeF64(targetLocations[i].y);
+  }
+}
+auto BinaryCodeWriter::writeStore(const std::vector<const Atom*>& atoms)
+    -> void {
+  writeOpcode(Opcode::Store);
+  writeAtoms(atoms);
+}
+auto BinaryCodeWriter::writeGlobalCZ(const std::vector<const Zone*>& zones)
+    -> void {
+  writeOpcode(Opcode::GlobalCZ);
+  writeU32(static_cast<uint32_t>(zones.size()));
+  for (const auto* zone : zones) {
+    writeU32(zoneIndices_.at(zone));
+  }
+}
+auto BinaryCodeWriter::writeGlobalRY(const Zone& zone, const double angle)
+    -> void {
+  writeOpcode(Opcode::GlobalRY);
+  writeU32(zoneIndices_.at(&zone));
+  writeF64(angle);
+}
+auto BinaryCodeWriter::writeLocalRZ(const Atom& atom, const double angle)
+    -> void {
+  writeOpcode(Opcode::LocalRZ);
+  writeU32(atomIndices_.at(&atom));
+  writeF64(angle);
+}
+auto BinaryCodeWriter::writeLocalU(const Atom& atom, const double theta,
+                                   const double phi, const double lambda)
+    -> void {
+  writeOpcode(Opcode::LocalU);
+  writeU32(atomIndices_.at(&atom));
+  writeF64(theta);
+  writeF64(phi);
+  writeF64(lambda);
+}
+} // namespace na::zoned
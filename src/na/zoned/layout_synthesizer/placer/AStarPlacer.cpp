@@ -12,114 +12,267 @@
 
 #include "ir/Definitions.hpp"
 #include "na/zoned/Architecture.hpp"
+#include "na/zoned/Profiling.hpp"
+#include "na/zoned/layout_synthesizer/placer/AStarSearch.hpp"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <deque>
+#include <exception>
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <map>
-#include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include <numeric>
 #include <optional>
 #include <queue>
 #include <set>
+#include <spdlog/spdlog.h>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 #include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 namespace na::zoned {
+namespace {
+/// Extracts the chosen option of every job from the path to a goal
 template <class Node>
-auto AStarPlacer::aStarTreeSearch(
-    const Node& start,
-    const std::function<std::vector<std::reference_wrapper<const Node>>(
-        const Node&)>& getNeighbors,
-    const std::function<bool(const Node&)>& isGoal,
-    const std::function<double(const Node&)>& getCost,
-    const std::function<double(const Node&)>& getHeuristic,
-    const size_t maxNodes) -> std::vector<std::reference_wrapper<const Node>> {
-  //===--------------------------------------------------------------------===//
-  // Setup open set structure
-  //===--------------------------------------------------------------------===//
-  // struct for items in the open set
-  struct Item {
-    double priority_;  //< sum of cost and heuristic
-    const Node* node_; //< pointer to the node
-    // pointer to the parent item to reconstruct the path in the end
-    Item* parent_;
+auto extractOptions(
+    const std::vector<std::reference_wrapper<const Node>>& path)
+    -> std::vector<uint16_t> {
+  std::vector<uint16_t> options;
+  options.reserve(path.size() - 1);
+  for (auto it = std::next(path.cbegin()); it != path.cend(); ++it) {
+    options.emplace_back(it->get().option);
+  }
+  return options;
+}
+/**
+ * Collects the options along the path from the root to @p node in @p path and
+ * returns the number of leading levels that coincide with @p currentPath.
+ */
+template <class Node>
+auto collectPath(const Node& node, const std::vector<uint16_t>& currentPath,
+                 std::vector<uint16_t>& path) -> size_t {
+  // the root does not correspond to any chosen option
+  path.resize(node.level);
+  for (const auto* n = &node; n->parent != nullptr; n = n->parent) {
+    path[n->level - 1] = n->option;
+  }
+  const auto length = std::min(path.size(), currentPath.size());
+  return static_cast<size_t>(
+      std::mismatch(path.cbegin(),
+                    path.cbegin() + static_cast<std::ptrdiff_t>(length),
+                    currentPath.cbegin())
+          .first -
+      path.cbegin());
+}
+} // namespace
 
-    Item(const double priority, const Node& node, Item* parent)
-        : priority_(priority), node_(&node), parent_(parent) {
-      assert(!std::isnan(priority));
+template <class Job, class Node>
+auto AStarPlacer::searchOptions(const std::vector<Job>& jobs,
+                                const HeuristicParameters& parameters)
+    -> std::vector<uint16_t> {
+  const ProfilingTimer timer((std::is_same_v<Job, GateJob>
+                                  ? currentLayerStatistics_.gatePlacement
+                                  : currentLayerStatistics_.atomPlacement)
+                                 .searchTime);
+  // runs one search with a fresh policy such that the nodes of a failed
+  // attempt are released before the next attempt starts
+  const auto run = [this, &jobs, &parameters](
+                       const auto& search) -> std::vector<uint16_t> {
+    SearchPolicy<Job, Node> policy(jobs, parameters);
+    const auto record = [this, &policy]() {
+      statistics_.nNodes += policy.getNumberOfNodes();
+      statistics_.nodeMemory += policy.getNumberOfNodes() * sizeof(Node);
+      if constexpr (PROFILING) {
+        if constexpr (std::is_same_v<Job, GateJob>) {
+          currentLayerStatistics_.gatePlacement += policy.getCounters();
+        } else {
+          currentLayerStatistics_.atomPlacement += policy.getCounters();
+        }
+      }
+    };
+    try {
+      const auto& path = search(policy);
+      record();
+      assert(path.size() == jobs.size() + 1);
+      return extractOptions(path);
+    } catch (const std::runtime_error&) {
+      record();
+      throw;
     }
   };
-  // compare function for the open set
-  struct ItemCompare {
-    auto operator()(const Item* a, const Item* b) const -> bool {
-      // this way, the item with the lowest priority is on top of the heap
-      return a->priority_ > b->priority_;
+  const auto maxNodes = config_.maxNodes;
+  try {
+    if constexpr (std::is_same_v<Job, GateJob>) {
+      if (config_.portfolioSize > 1) {
+        return searchPortfolio(jobs, parameters);
+      }
     }
-  };
-  // vector of items to store all items and keep them alive also after they
-  // are popped from the open set. they are required alive to reconstruct the
-  // path in the end.
-  std::vector<std::unique_ptr<Item>> items;
-  // open list of nodes to be evaluated as a minimum heap based on the
-  // priority. whenever an item is placed in the queue it is created in the
-  // vector `items` before and only a reference is placed in the queue
-  std::priority_queue<Item*, std::vector<Item*>, ItemCompare> openSet;
-  openSet.emplace(items
-                      .emplace_back(std::make_unique<Item>(getHeuristic(start),
-                                                           start, nullptr))
-                      .get());
-  //===--------------------------------------------------------------------===//
-  // Perform A* search
-  //===--------------------------------------------------------------------===//
-  while (items.size() < maxNodes && !openSet.empty()) {
-    Item* itm = openSet.top();
-    openSet.pop();
-    // if a goal is reached, that is the shortest path to a goal under the
-    // assumption that the heuristic is admissible
-    if (isGoal(*itm->node_)) {
-      // reconstruct the path from the goal to the start and then reverse it
-      std::vector<std::reference_wrapper<const Node>> path;
-      for (; itm != nullptr; itm = itm->parent_) {
-        path.emplace_back(*itm->node_);
+    return run([maxNodes](auto& policy) {
+      return aStarTreeSearch(policy, policy.getRoot(), maxNodes);
+    });
+  } catch (const NodeLimitExceeded&) {
+    if (config_.fallback == Fallback::None) {
+      throw;
+    }
+  }
+  currentLayerDegraded_ = true;
+  if (config_.fallback == Fallback::WeightedAStar) {
+    auto weight = static_cast<double>(config_.fallbackWeight);
+    for (size_t i = 0; i < weightedAStarAttempts_; ++i, weight *= 2) {
+      SPDLOG_WARN("A* search reached the maximum number of nodes, retrying "
+                  "with weighted A* and weight {}",
+                  weight);
+      try {
+        return run([maxNodes, weight](auto& policy) {
+          return aStarTreeSearch(policy, policy.getRoot(), maxNodes, weight);
+        });
+      } catch (const NodeLimitExceeded&) {
+        // try again with a larger weight
       }
-      std::reverse(path.begin(), path.end());
-      return path;
     }
-    // expand the current node by adding all neighbors to the open set
-    const auto& neighbors = getNeighbors(*itm->node_);
-    if (!neighbors.empty()) {
-      for (const auto& neighbor : neighbors) {
-        // getCost returns the total cost to reach the current node
-        const auto cost = getCost(neighbor);
-        const auto heuristic = getHeuristic(neighbor);
-        openSet.emplace(items
-                            .emplace_back(std::make_unique<Item>(
-                                cost + heuristic, neighbor, itm))
-                            .get());
+  }
+  // The beam is narrowed if it reaches the maximum number of nodes and widened
+  // if all of its nodes are dead ends. The search gives up once the widths in
+  // between are exhausted.
+  auto beamWidth = std::max<size_t>(1, config_.beamWidth);
+  // the largest width known to run into dead ends
+  size_t deadEndWidth = 0;
+  // the smallest width known to reach the maximum number of nodes
+  auto exceededWidth = std::numeric_limits<size_t>::max();
+  while (true) {
+    SPDLOG_WARN("Search did not find a placement, retrying with beam search "
+                "and beam width {}",
+                beamWidth);
+    try {
+      return run([maxNodes, beamWidth](auto& policy) {
+        return beamTreeSearch(policy, policy.getRoot(), beamWidth, maxNodes);
+      });
+    } catch (const NodeLimitExceeded&) {
+      exceededWidth = beamWidth;
+    } catch (const BeamExhausted&) {
+      deadEndWidth = beamWidth;
+    }
+    if (deadEndWidth + 1 >= exceededWidth) {
+      throw NodeLimitExceeded(
+          "Beam search found no placement since every beam width either "
+          "reaches the maximum number of nodes or runs into dead ends. "
+          "Increase max_nodes.");
+    }
+    if (beamWidth == exceededWidth) {
+      beamWidth = std::max(deadEndWidth + 1, beamWidth / 4);
+    } else {
+      beamWidth = beamWidth < (exceededWidth - 1) / 4 ? beamWidth * 4
+                                                      : exceededWidth - 1;
+    }
+  }
+}
+auto AStarPlacer::searchPortfolio(const std::vector<GateJob>& jobs,
+                                  const HeuristicParameters& parameters)
+    -> std::vector<uint16_t> {
+  const auto nSearches = std::min(config_.portfolioSize, portfolio_.size());
+  // the nodes created by every search, they are recorded in the statistics
+  // after all threads are joined
+  std::vector<size_t> nNodes(nSearches, 0);
+  std::vector<SearchCounters> counters(nSearches);
+  std::atomic<bool> finished = false;
+  std::mutex mutex;
+  std::optional<std::vector<uint16_t>> result;
+  std::exception_ptr error;
+  const auto search = [this, &jobs, &parameters, &nNodes, &counters, &finished,
+                       &mutex, &result, &error](const size_t i) {
+    try {
+      const auto& [deepeningScale, lookaheadScale] = portfolio_[i];
+      // the lookahead is part of the options, hence, every search except the
+      // first one works on its own copy of the jobs
+      std::vector<GateJob> scaledJobs;
+      if (i > 0) {
+        scaledJobs = jobs;
+        for (auto& job : scaledJobs) {
+          job.meanLookaheadCost *= lookaheadScale;
+          for (auto& option : job.options) {
+            option.lookaheadCost *= lookaheadScale;
+          }
+        }
+      }
+      auto scaledParameters = parameters;
+      scaledParameters.deepeningFactor *= deepeningScale;
+      SearchPolicy<GateJob, GateNode> policy(i == 0 ? jobs : scaledJobs,
+                                             scaledParameters, &finished);
+      try {
+        const auto& path =
+            aStarTreeSearch(policy, policy.getRoot(), config_.maxNodes);
+        const std::lock_guard lock(mutex);
+        if (!result.has_value()) {
+          result = extractOptions(path);
+          finished = true;
+        }
+      } catch (const SearchCancelled&) {
+        // another search found a placement first
+      } catch (const NodeLimitExceeded&) {
+        // the remaining searches may still find a placement
       }
+      nNodes[i] = policy.getNumberOfNodes();
+      counters[i] = policy.getCounters();
+    } catch (...) {
+      const std::lock_guard lock(mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+      finished = true;
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(nSearches - 1);
+  try {
+    for (size_t i = 1; i < nSearches; ++i) {
+      threads.emplace_back(search, i);
     }
+  } catch (...) {
+    // not all threads could be started, stop the ones that are running
+    finished = true;
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    throw;
   }
-  if (items.size() >= maxNodes) {
-    throw std::runtime_error(
-        "Maximum number of nodes reached. Increase max_nodes or increase "
-        "deepening_value and deepening_factor to reduce the number of explored "
-        "nodes.");
+  // the calling thread runs the search with the configured parameters
+  search(0);
+  for (auto& thread : threads) {
+    thread.join();
   }
-  throw std::runtime_error("No path from start to any goal found.");
+  for (size_t i = 0; i < nSearches; ++i) {
+    statistics_.nNodes += nNodes[i];
+    statistics_.nodeMemory += nNodes[i] * sizeof(GateNode);
+    if constexpr (PROFILING) {
+      currentLayerStatistics_.gatePlacement += counters[i];
+    }
+  }
+  if (result.has_value()) {
+    return *std::move(result);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  throw NodeLimitExceeded(
+      "Maximum number of nodes reached in all searches of the portfolio. "
+      "Increase max_nodes or increase deepening_value and deepening_factor to "
+      "reduce the number of explored nodes.");
 }
 auto AStarPlacer::isGoal(const size_t nGates, const GateNode& node) -> bool {
   return node.level == nGates;
@@ -435,8 +588,10 @@ auto AStarPlacer::placeGatesInEntanglementZone(
   //===------------------------------------------------------------------===//
   // Discretize the previous placement of the atoms to be placed
   //===------------------------------------------------------------------===//
-  const auto& [discreteRows, discreteColumns] =
-      discretizePlacementOfAtoms(previousPlacement, atomsToPlace);
+  const auto& [discreteRows, discreteColumns] = [&] {
+    const ProfilingTimer timer(currentLayerStatistics_.discretizationTime);
+    return discretizePlacementOfAtoms(previousPlacement, atomsToPlace);
+  }();
   //===------------------------------------------------------------------===//
   // Extract occupied entanglement sites from the previous placement
   //===------------------------------------------------------------------===//
@@ -699,35 +854,16 @@ auto AStarPlacer::placeGatesInEntanglementZone(
   //===------------------------------------------------------------------===//
   // Run the A* algorithm
   //===------------------------------------------------------------------===//
-  /**
-   * A list of all nodes that have been created so far.
-   * This happens when a node is expanded by calling getNeighbors.
-   */
-  std::deque<std::unique_ptr<GateNode>> nodes;
-  // make the root node
-  nodes.emplace_back(std::make_unique<GateNode>());
-  const auto deepeningFactor = config_.deepeningFactor;
-  const auto deepeningValue = config_.deepeningValue;
-  const auto& path = aStarTreeSearch<GateNode>(
-      *nodes.front(),
-      [&nodes, &gateJobs](const auto& node) {
-        return getNeighbors(nodes, gateJobs, std::move(node));
-      },
-      [nJobs](const auto& node) { return isGoal(nJobs, std::move(node)); },
-      [](const auto& node) { return getCost(std::move(node)); },
-      [&gateJobs, deepeningFactor, deepeningValue,
-       &scaleFactors](const auto& node) {
-        return getHeuristic(gateJobs, deepeningFactor, deepeningValue,
-                            scaleFactors, std::move(node));
-      },
-      config_.maxNodes);
+  const auto& chosenOptions = searchOptions<GateJob, GateNode>(
+      gateJobs,
+      {config_.deepeningFactor, config_.deepeningValue, scaleFactors});
   //===------------------------------------------------------------------===//
   // Extract the final mapping
   //===------------------------------------------------------------------===//
-  assert(path.size() == nJobs + 1);
+  assert(chosenOptions.size() == nJobs);
   for (size_t i = 0; i < nJobs; ++i) {
     const auto& job = gateJobs[i];
-    const auto& option = job.options[path[i + 1].get().option];
+    const auto& option = job.options[chosenOptions[i]];
     for (size_t j = 0; j < 2; ++j) {
       const auto atom = job.qubits[j];
       const auto& [row, col] = option.sites[j];
@@ -789,8 +925,10 @@ auto AStarPlacer::placeAtomsInStorageZone(
                  [](const auto& pair) { return pair.second; });
   // Discretize the previous placement of the atoms to be placed that are
   // ordered now
-  const auto& [discreteRows, discreteColumns] =
-      discretizePlacementOfAtoms(previousPlacement, atomsToPlace);
+  const auto& [discreteRows, discreteColumns] = [&] {
+    const ProfilingTimer timer(currentLayerStatistics_.discretizationTime);
+    return discretizePlacementOfAtoms(previousPlacement, atomsToPlace);
+  }();
   //===------------------------------------------------------------------===//
   // Extract occupied storage sites from the previous placement
   //===------------------------------------------------------------------===//
@@ -803,8 +941,10 @@ auto AStarPlacer::placeAtomsInStorageZone(
   //===------------------------------------------------------------------===//
   // Discretize the free sites for the atoms to be placed
   //===------------------------------------------------------------------===//
-  const auto& [discreteTargetRows, discreteTargetColumns] =
-      discretizeNonOccupiedStorageSites(occupiedStorageSites);
+  const auto& [discreteTargetRows, discreteTargetColumns] = [&] {
+    const ProfilingTimer timer(currentLayerStatistics_.discretizationTime);
+    return discretizeNonOccupiedStorageSites(occupiedStorageSites);
+  }();
   std::unordered_map<uint8_t, std::unordered_map<uint8_t, Site>> targetSites;
   for (const auto& [row, r] : discreteTargetRows) {
     const SLM& slm = row.first.get();
@@ -1105,34 +1245,16 @@ auto AStarPlacer::placeAtomsInStorageZone(
   //===------------------------------------------------------------------===//
   // Run the A* algorithm
   //===------------------------------------------------------------------===//
-  /**
-   * A list of all nodes that have been created so far.
-   * This happens when a node is expanded by calling getNeighbors.
-   */
-  std::deque<std::unique_ptr<AtomNode>> nodes;
-  nodes.emplace_back(std::make_unique<AtomNode>());
-  const auto deepeningFactor = config_.deepeningFactor;
-  const auto deepeningValue = config_.deepeningValue;
-  const auto& path = aStarTreeSearch<AtomNode>(
-      *nodes.front(),
-      [&nodes, &atomJobs](const auto& node) {
-        return getNeighbors(nodes, atomJobs, std::move(node));
-      },
-      [nJobs](const auto& node) { return isGoal(nJobs, std::move(node)); },
-      [](const auto& node) { return getCost(std::move(node)); },
-      [&atomJobs, deepeningFactor, deepeningValue,
-       &scaleFactors](const auto& node) {
-        return getHeuristic(atomJobs, deepeningFactor, deepeningValue,
-                            scaleFactors, std::move(node));
-      },
-      config_.maxNodes);
+  const auto& chosenOptions = searchOptions<AtomJob, AtomNode>(
+      atomJobs,
+      {config_.deepeningFactor, config_.deepeningValue, scaleFactors});
   //===------------------------------------------------------------------===//
   // Extract the final mapping
   //===------------------------------------------------------------------===//
-  assert(path.size() == nJobs + 1);
+  assert(chosenOptions.size() == nJobs);
   for (size_t i = 0; i < nJobs; ++i) {
     const auto& job = atomJobs[i];
-    const auto& option = job.options[path[i + 1].get().option];
+    const auto& option = job.options[chosenOptions[i]];
     if (!option.reuse) {
       const auto atom = job.atom;
       const auto& [row, col] = option.site;
@@ -1142,17 +1264,10 @@ auto AStarPlacer::placeAtomsInStorageZone(
   return currentPlacement;
 }
 
-auto AStarPlacer::getCost(const GateNode& node) -> float {
-  float cost = node.lookaheadCost;
-  for (const auto d : node.maxDistancesOfPlacedAtomsPerGroup) {
-    cost += std::sqrt(d);
-  }
-  return cost;
-}
-
-auto AStarPlacer::getCost(const AtomNode& node) -> float {
-  float cost = node.lookaheadCost;
-  for (const auto d : node.maxDistancesOfPlacedAtomsPerGroup) {
+auto AStarPlacer::getCost(const float lookaheadCost, const SearchState& state)
+    -> float {
+  float cost = lookaheadCost;
+  for (const auto d : state.maxDistancesOfPlacedAtomsPerGroup) {
     cost += std::sqrt(d);
   }
   return cost;
@@ -1186,15 +1301,15 @@ auto AStarPlacer::sumStdDeviationForGroups(
 }
 
 auto AStarPlacer::getHeuristic(const std::vector<AtomJob>& atomJobs,
-                               const float deepeningFactor,
-                               const float deepeningValue,
-                               const std::array<float, 2>& scaleFactors,
-                               const AtomNode& node) -> float {
+                               const HeuristicParameters& parameters,
+                               const size_t level, const SearchState& state)
+    -> float {
+  const auto& [deepeningFactor, deepeningValue, scaleFactors] = parameters;
   const auto nAtomJobs = atomJobs.size();
-  const auto nUnplacedAtoms = static_cast<float>(nAtomJobs - node.level);
+  const auto nUnplacedAtoms = static_cast<float>(nAtomJobs - level);
   float maxDistanceOfUnplacedAtom = 0.0F;
   float accMinLookaheadCost = 0.0F;
-  for (size_t i = node.level; i < nAtomJobs; ++i) {
+  for (size_t i = level; i < nAtomJobs; ++i) {
     const auto& job = atomJobs[i];
     accMinLookaheadCost += job.meanLookaheadCost;
     for (const auto& option : job.options) {
@@ -1204,8 +1319,7 @@ auto AStarPlacer::getHeuristic(const std::vector<AtomJob>& atomJobs,
         // first one for atoms that may be reused
         break;
       }
-      if (node.consumedFreeSites.find(option.site) ==
-          node.consumedFreeSites.end()) {
+      if (!state.isConsumed(option.site)) {
         // this assumes that the first found free site is the nearest free site
         // for that atom. This requires that the job options are sorted by
         // distance.
@@ -1216,7 +1330,7 @@ auto AStarPlacer::getHeuristic(const std::vector<AtomJob>& atomJobs,
     }
   }
   float maxDistanceOfPlacedAtom = 0.0F;
-  for (const auto d : node.maxDistancesOfPlacedAtomsPerGroup) {
+  for (const auto d : state.maxDistancesOfPlacedAtomsPerGroup) {
     maxDistanceOfPlacedAtom = std::max(maxDistanceOfPlacedAtom, d);
   }
   float heuristic = maxDistanceOfUnplacedAtom <= maxDistanceOfPlacedAtom
@@ -1226,21 +1340,21 @@ auto AStarPlacer::getHeuristic(const std::vector<AtomJob>& atomJobs,
   heuristic += accMinLookaheadCost;
   heuristic +=
       deepeningFactor *
-      (sumStdDeviationForGroups(scaleFactors, node.groups) + deepeningValue) *
+      (sumStdDeviationForGroups(scaleFactors, state.groups) + deepeningValue) *
       nUnplacedAtoms;
   return heuristic;
 }
 
 auto AStarPlacer::getHeuristic(const std::vector<GateJob>& gateJobs,
-                               const float deepeningFactor,
-                               const float deepeningValue,
-                               const std::array<float, 2>& scaleFactors,
-                               const GateNode& node) -> float {
+                               const HeuristicParameters& parameters,
+                               const size_t level, const SearchState& state)
+    -> float {
+  const auto& [deepeningFactor, deepeningValue, scaleFactors] = parameters;
   const auto nGateJobs = gateJobs.size();
-  const auto nUnplacedGates = static_cast<float>(nGateJobs - node.level);
+  const auto nUnplacedGates = static_cast<float>(nGateJobs - level);
   float maxDistanceOfUnplacedAtom = 0.0F;
   float accMeanLookaheadCost = 0.0F;
-  for (size_t i = node.level; i < nGateJobs; ++i) {
+  for (size_t i = level; i < nGateJobs; ++i) {
     const auto& job = gateJobs[i];
     accMeanLookaheadCost += job.meanLookaheadCost;
     for (const auto& option : job.options) {
@@ -1248,9 +1362,8 @@ auto AStarPlacer::getHeuristic(const std::vector<GateJob>& gateJobs,
       // pair of free sites for that gate. This requires that the job options
       // are sorted by distance.
       if (std::all_of(option.sites.cbegin(), option.sites.cend(),
-                      [&node](const DiscreteSite& site) -> bool {
-                        return node.consumedFreeSites.find(site) ==
-                               node.consumedFreeSites.end();
+                      [&state](const DiscreteSite& site) -> bool {
+                        return !state.isConsumed(site);
                       })) {
         maxDistanceOfUnplacedAtom =
             std::max(maxDistanceOfUnplacedAtom,
@@ -1261,7 +1374,7 @@ auto AStarPlacer::getHeuristic(const std::vector<GateJob>& gateJobs,
     }
   }
   float maxDistanceOfPlacedAtom = 0.0F;
-  for (const auto d : node.maxDistancesOfPlacedAtomsPerGroup) {
+  for (const auto d : state.maxDistancesOfPlacedAtomsPerGroup) {
     maxDistanceOfPlacedAtom = std::max(maxDistanceOfPlacedAtom, d);
   }
   float heuristic = maxDistanceOfUnplacedAtom <= maxDistanceOfPlacedAtom
@@ -1271,54 +1384,136 @@ auto AStarPlacer::getHeuristic(const std::vector<GateJob>& gateJobs,
   heuristic += accMeanLookaheadCost;
   heuristic +=
       deepeningFactor *
-      (sumStdDeviationForGroups(scaleFactors, node.groups) + deepeningValue) *
+      (sumStdDeviationForGroups(scaleFactors, state.groups) + deepeningValue) *
       nUnplacedGates;
   return heuristic;
 }
 
-auto AStarPlacer::getNeighbors(std::deque<std::unique_ptr<AtomNode>>& nodes,
-                               const std::vector<AtomJob>& atomJobs,
-                               const AtomNode& node)
-    -> std::vector<std::reference_wrapper<const AtomNode>> {
+auto AStarPlacer::SearchState::push(const uint16_t option) -> void {
+  path.emplace_back(option);
+  levelStarts.emplace_back(changes.size());
+}
+
+auto AStarPlacer::SearchState::pop() -> void {
+  assert(!path.empty());
+  // undo the placements of the last level in reverse order
+  while (changes.size() > levelStarts.back()) {
+    const auto& [siteIndex, change] = changes.back();
+    consumedFreeSites.reset(siteIndex);
+    if (change.created) {
+      groups.pop_back();
+      maxDistancesOfPlacedAtomsPerGroup.pop_back();
+    } else {
+      auto& group = groups[change.group];
+      for (size_t i = 0; i < 2; ++i) {
+        if (change.inserted[i]) {
+          group[i].erase(group[i].cbegin() +
+                         static_cast<std::ptrdiff_t>(*change.inserted[i]));
+        }
+      }
+      maxDistancesOfPlacedAtomsPerGroup[change.group] = change.maxDistance;
+    }
+    changes.pop_back();
+  }
+  path.pop_back();
+  levelStarts.pop_back();
+}
+
+auto AStarPlacer::SearchState::place(const DiscreteSite& currentSite,
+                                     const DiscreteSite& site,
+                                     const float distance) -> void {
+  assert(!path.empty());
+  const auto siteIndex = index(site);
+  consumedFreeSites.set(siteIndex);
+  // check whether the current placement is compatible with any existing group
+  changes.emplace_back(siteIndex,
+                       checkCompatibilityAndAddPlacement(
+                           currentSite.front(), site.front(),
+                           currentSite.back(), site.back(), distance, groups,
+                           maxDistancesOfPlacedAtomsPerGroup));
+}
+
+auto AStarPlacer::reconstructState(const std::vector<AtomJob>& atomJobs,
+                                   const AtomNode& node, SearchState& state)
+    -> void {
+  const auto common = collectPath(node, state.path, state.nextPath);
+  while (state.path.size() > common) {
+    state.pop();
+  }
+  // replay the remaining options in the order they were chosen such that the
+  // groups are formed exactly in the same way as when the nodes were created
+  for (size_t level = common; level < state.nextPath.size(); ++level) {
+    const auto& atomJob = atomJobs[level];
+    const auto option = state.nextPath[level];
+    const auto& [site, reuse, distance, lookaheadCost] =
+        atomJob.options[option];
+    state.push(option);
+    if (!reuse) {
+      state.place(atomJob.currentSite, site, distance);
+    }
+  }
+}
+
+auto AStarPlacer::reconstructState(const std::vector<GateJob>& gateJobs,
+                                   const GateNode& node, SearchState& state)
+    -> void {
+  const auto common = collectPath(node, state.path, state.nextPath);
+  while (state.path.size() > common) {
+    state.pop();
+  }
+  // replay the remaining options in the order they were chosen such that the
+  // groups are formed exactly in the same way as when the nodes were created
+  for (size_t level = common; level < state.nextPath.size(); ++level) {
+    const auto& gateJob = gateJobs[level];
+    const auto option = state.nextPath[level];
+    const auto& [sites, distances, lookaheadCost] = gateJob.options[option];
+    state.push(option);
+    for (size_t j = 0; j < 2; ++j) {
+      state.place(gateJob.currentSites[j], sites[j], distances[j]);
+    }
+  }
+}
+
+auto AStarPlacer::expandNode(std::deque<AtomNode>& nodes, SearchState& state,
+                             const std::vector<AtomJob>& atomJobs,
+                             const HeuristicParameters& parameters,
+                             const AtomNode& node) -> void {
+  reconstructState(atomJobs, node, state);
   const size_t atomToBePlacedNext = node.level;
   const auto& atomJob = atomJobs[atomToBePlacedNext];
-  std::vector<std::reference_wrapper<const AtomNode>> neighbors;
   assert(atomJob.options.size() <= std::numeric_limits<uint16_t>::max());
   for (uint16_t i = 0; i < static_cast<uint16_t>(atomJob.options.size()); ++i) {
     const auto& option = atomJob.options[i];
     const auto& [site, reuse, distance, lookaheadCost] = option;
     // skip the sites that are already consumed
-    if (!reuse &&
-        node.consumedFreeSites.find(site) != node.consumedFreeSites.end()) {
+    if (!reuse && state.isConsumed(site)) {
       continue;
     }
-    // make a copy of node, the parent of child
-    AtomNode& child = *nodes.emplace_back(std::make_unique<AtomNode>(node));
+    AtomNode& child = nodes.emplace_back();
+    child.parent = &node;
+    child.level = static_cast<uint8_t>(node.level + 1);
+    child.option = i;
+    child.lookaheadCost = node.lookaheadCost + lookaheadCost;
+    // temporarily apply the placement to the state to evaluate the child and
+    // restore the state of the parent afterward. If the atom is reused, it is
+    // not moved, hence, the state of the child equals the state of its parent.
+    state.push(i);
     if (!reuse) {
-      child.consumedFreeSites.emplace(site);
-      // check whether the current placement is compatible with any existing
-      // group
-      checkCompatibilityAndAddPlacement(
-          atomJob.currentSite.front(), site.front(), atomJob.currentSite.back(),
-          site.back(), distance, child.groups,
-          child.maxDistancesOfPlacedAtomsPerGroup);
+      state.place(atomJob.currentSite, site, distance);
     }
-    child.option = i;
-    ++child.level;
-    child.lookaheadCost += lookaheadCost;
-    // add the child to the list of children to be returned
-    neighbors.emplace_back(child);
+    child.cost = getCost(child.lookaheadCost, state);
+    child.heuristic = getHeuristic(atomJobs, parameters, child.level, state);
+    state.pop();
   }
-  return neighbors;
 }
 
-auto AStarPlacer::getNeighbors(std::deque<std::unique_ptr<GateNode>>& nodes,
-                               const std::vector<GateJob>& gateJobs,
-                               const GateNode& node)
-    -> std::vector<std::reference_wrapper<const GateNode>> {
+auto AStarPlacer::expandNode(std::deque<GateNode>& nodes, SearchState& state,
+                             const std::vector<GateJob>& gateJobs,
+                             const HeuristicParameters& parameters,
+                             const GateNode& node) -> void {
+  reconstructState(gateJobs, node, state);
   const size_t gateToBePlacedNext = node.level;
   const auto& gateJob = gateJobs[gateToBePlacedNext];
-  std::vector<std::reference_wrapper<const GateNode>> neighbors;
   // Get the current placement of the atoms that must be placed next
   const auto& [currentSiteOfLeftAtom, currentSiteOfRightAtom] =
       gateJob.currentSites;
@@ -1328,41 +1523,36 @@ auto AStarPlacer::getNeighbors(std::deque<std::unique_ptr<GateNode>>& nodes,
     const auto& [sites, distances, lookaheadCost] = option;
     const auto& [leftSite, rightSite] = sites;
     // skip if one of the sites is already consumed
-    if (node.consumedFreeSites.find(leftSite) != node.consumedFreeSites.end() ||
-        node.consumedFreeSites.find(rightSite) !=
-            node.consumedFreeSites.end()) {
+    if (state.isConsumed(leftSite) || state.isConsumed(rightSite)) {
       continue;
     }
-    // make a copy of node, the parent of child as use this as a starting
-    // point for the new node
-    GateNode& child = *nodes.emplace_back(std::make_unique<GateNode>(node));
-    ++child.level;
+    GateNode& child = nodes.emplace_back();
+    child.parent = &node;
+    child.level = static_cast<uint8_t>(node.level + 1);
     child.option = i;
-    child.consumedFreeSites.emplace(leftSite);
-    child.consumedFreeSites.emplace(rightSite);
-    // check whether the current placement is compatible with any existing
-    // horizontal group
-    checkCompatibilityAndAddPlacement(
-        currentSiteOfLeftAtom.front(), leftSite.front(),
-        currentSiteOfLeftAtom.back(), leftSite.back(), distances.front(),
-        child.groups, child.maxDistancesOfPlacedAtomsPerGroup);
-    checkCompatibilityAndAddPlacement(
-        currentSiteOfRightAtom.front(), rightSite.front(),
-        currentSiteOfRightAtom.back(), rightSite.back(), distances.back(),
-        child.groups, child.maxDistancesOfPlacedAtomsPerGroup);
-    child.lookaheadCost += lookaheadCost;
-    // add the final child to the list of children to be returned
-    neighbors.emplace_back(child);
+    child.lookaheadCost = node.lookaheadCost + lookaheadCost;
+    // temporarily apply the placement to the state to evaluate the child and
+    // restore the state of the parent afterward
+    state.push(i);
+    state.place(currentSiteOfLeftAtom, leftSite, distances.front());
+    state.place(currentSiteOfRightAtom, rightSite, distances.back());
+    child.cost = getCost(child.lookaheadCost, state);
+    child.heuristic = getHeuristic(gateJobs, parameters, child.level, state);
+    state.pop();
   }
-  return neighbors;
 }
 
 auto AStarPlacer::checkCompatibilityWithGroup(
     const uint8_t key, const uint8_t value,
-    const std::map<uint8_t, uint8_t>& group)
-    -> std::optional<
-        std::pair<std::map<uint8_t, uint8_t>::const_iterator, bool>> {
-  if (auto it = group.lower_bound(key); it != group.end()) {
+    const std::vector<std::pair<uint8_t, uint8_t>>& group)
+    -> std::optional<std::pair<
+        std::vector<std::pair<uint8_t, uint8_t>>::const_iterator, bool>> {
+  // the group is sorted by key, hence, binary search can be used
+  if (auto it = std::lower_bound(group.cbegin(), group.cend(), key,
+                                 [](const auto& assignment, const uint8_t k) {
+                                   return assignment.first < k;
+                                 });
+      it != group.cend()) {
     // an assignment for this key already exists in this group
     if (const auto& [upperKey, upperValue] = *it; upperKey == key) {
       if (upperValue == value) {
@@ -1371,7 +1561,7 @@ auto AStarPlacer::checkCompatibilityWithGroup(
       }
     } else {
       // if (upperKey > key)
-      if (it != group.begin()) {
+      if (it != group.cbegin()) {
         // it can be safely decremented
         if (const auto lowerValue = std::prev(it)->second;
             lowerValue < value && value < upperValue) {
@@ -1402,7 +1592,7 @@ auto AStarPlacer::checkCompatibilityAndAddPlacement(
     const uint8_t hKey, const uint8_t hValue, const uint8_t vKey,
     const uint8_t vValue, const float distance,
     std::vector<CompatibilityGroup>& groups, std::vector<float>& maxDistances)
-    -> bool {
+    -> GroupChange {
   size_t i = 0;
   for (auto& group : groups) {
     auto& [hGroup, vGroup] = group;
@@ -1414,24 +1604,29 @@ auto AStarPlacer::checkCompatibilityAndAddPlacement(
         const auto& [hIt, hExists] = *hCompatible;
         const auto& [vIt, vExists] = *vCompatible;
         // new placement is compatible with this group
+        GroupChange change{i, false, {}, maxDistances[i]};
         if (!hExists) {
-          hGroup.emplace_hint(hIt, hKey, hValue);
+          change.inserted.front() =
+              static_cast<size_t>(std::distance(hGroup.cbegin(), hIt));
+          hGroup.emplace(hIt, hKey, hValue);
         }
         if (!vExists) {
-          vGroup.emplace_hint(vIt, vKey, vValue);
+          change.inserted.back() =
+              static_cast<size_t>(std::distance(vGroup.cbegin(), vIt));
+          vGroup.emplace(vIt, vKey, vValue);
         }
         maxDistances[i] = std::max(maxDistances[i], distance);
-        return true;
+        return change;
       }
     }
     ++i;
   }
   // no compatible group could be found and a new group is created
   auto& [hGroup, vGroup] = groups.emplace_back();
-  hGroup.emplace(hKey, hValue);
-  vGroup.emplace(vKey, vValue);
+  hGroup.emplace_back(hKey, hValue);
+  vGroup.emplace_back(vKey, vValue);
   maxDistances.emplace_back(distance);
-  return false;
+  return {i, true, {}, 0.F};
 }
 
 AStarPlacer::AStarPlacer(const Architecture& architecture, const Config& config)
@@ -1459,19 +1654,40 @@ auto AStarPlacer::place(
     -> std::vector<Placement> {
   std::vector<Placement> placement;
   placement.reserve((2 * twoQubitGateLayers.size()) + 1);
-  placement.emplace_back(makeInitialPlacement(nQubits));
+  place(nQubits, twoQubitGateLayers, reuseQubits,
+        [&placement](const Placement& next) { placement.emplace_back(next); });
+  return placement;
+}
+auto AStarPlacer::place(
+    const size_t nQubits,
+    const std::vector<TwoQubitGateLayer>& twoQubitGateLayers,
+    const std::vector<std::unordered_set<qc::Qubit>>& reuseQubits,
+    const PlacementCallback& onPlacement) -> void {
+  statistics_ = Statistics{};
+  // only the last placement is required to compute the next one, all other
+  // placements are handed over to the callback
+  auto previous = makeInitialPlacement(nQubits);
+  onPlacement(previous);
   for (size_t layer = 0; layer < twoQubitGateLayers.size(); ++layer) {
-    const auto& [gatePlacement, qubitPlacement] = makeIntermediatePlacement(
-        placement.back(),
+    currentLayerDegraded_ = false;
+    currentLayerStatistics_ = LayerStatistics{};
+    auto [gatePlacement, qubitPlacement] = makeIntermediatePlacement(
+        previous,
         layer == 0 ? std::unordered_set<qc::Qubit>{} : reuseQubits[layer - 1],
         layer == reuseQubits.size() ? std::unordered_set<qc::Qubit>{}
                                     : reuseQubits[layer],
         twoQubitGateLayers[layer],
         layer == twoQubitGateLayers.size() - 1 ? TwoQubitGateLayer{}
                                                : twoQubitGateLayers[layer + 1]);
-    placement.emplace_back(gatePlacement);
-    placement.emplace_back(qubitPlacement);
+    onPlacement(gatePlacement);
+    onPlacement(qubitPlacement);
+    previous = std::move(qubitPlacement);
+    if (currentLayerDegraded_) {
+      statistics_.degradedLayers.emplace_back(layer);
+    }
+    if constexpr (PROFILING) {
+      statistics_.layers.emplace_back(currentLayerStatistics_);
+    }
   }
-  return placement;
 }
 } // namespace na::zoned
@@ -12,6 +12,8 @@
 
 #include "ir/Definitions.hpp"
 #include "na/zoned/Architecture.hpp"
+#include "na/zoned/Profiling.hpp"
+#include "na/zoned/SiteIndex.hpp"
 #include "na/zoned/Types.hpp"
 
 #include <algorithm>
@@ -199,6 +201,171 @@ auto VertexMatchingPlacer::minimumWeightFullBipartiteMatching(
   }
   return matching;
 }
+auto VertexMatchingPlacer::sparseMinimumWeightFullBipartiteMatching(
+    const SparseCostMatrix& costMatrix, const size_t nCols,
+    std::vector<double>& prices) -> std::vector<size_t> {
+  const auto nRows = costMatrix.size();
+  if (nRows > nCols) {
+    throw std::invalid_argument(
+        "Input matrix must have more columns than rows");
+  }
+  if (std::any_of(costMatrix.cbegin(), costMatrix.cend(),
+                  [](const auto& row) { return row.empty(); })) {
+    throw std::invalid_argument("Input matrix must not contain empty rows");
+  }
+  assert(prices.size() == nCols);
+  if (nRows == 0) {
+    return {};
+  }
+  constexpr auto inf = std::numeric_limits<double>::infinity();
+  constexpr auto none = std::numeric_limits<size_t>::max();
+  // the column matched to every row and vice versa
+  std::vector matching(nRows, none);
+  std::vector invMatching(nCols, none);
+  // the row potentials, the column potentials are the prices
+  std::vector potentials(nRows, 0.0);
+  // the scratch space of the Dijkstra search that is reset after every search
+  // by only touching the columns that were reached
+  std::vector distances(nCols, inf);
+  std::vector predecessors(nCols, none);
+  std::vector finalized(nCols, false);
+  std::vector<size_t> reached;
+  std::vector<size_t> popped;
+  std::priority_queue<std::pair<double, size_t>,
+                      std::vector<std::pair<double, size_t>>, std::greater<>>
+      queue;
+  // a lower bound of the prices of all free columns; prices only decrease,
+  // hence, it suffices to update the bound whenever a price changes
+  double minFreePrice = *std::min_element(prices.cbegin(), prices.cend());
+  // relaxes all edges of a row whose distance from the source is known
+  const auto relax = [&](const size_t row, const double distance) {
+    for (const auto& [col, cost] : costMatrix[row]) {
+      assert(col < nCols);
+      if (finalized[col]) {
+        continue;
+      }
+      if (const auto d = distance + cost - potentials[row] - prices[col];
+          d < distances[col]) {
+        if (distances[col] == inf) {
+          reached.emplace_back(col);
+        }
+        distances[col] = d;
+        predecessors[col] = row;
+        queue.emplace(d, col);
+      }
+    }
+  };
+  for (size_t source = 0; source < nRows; ++source) {
+    // the potential of a fresh row is chosen such that all reduced costs of
+    // its edges are non-negative and at least one vanishes
+    potentials[source] = inf;
+    for (const auto& [col, cost] : costMatrix[source]) {
+      potentials[source] = std::min(potentials[source], cost - prices[col]);
+    }
+    relax(source, 0.0);
+    // the real cost of an augmenting path ending in the free column t is the
+    // distance of t plus its price (up to a constant), since free columns may
+    // carry different prices, the search continues until no column can yield
+    // a cheaper path
+    auto target = none;
+    double targetCost = inf;
+    while (!queue.empty()) {
+      const auto [distance, col] = queue.top();
+      queue.pop();
+      if (finalized[col] || distance > distances[col]) {
+        continue;
+      }
+      if (distance + minFreePrice >= targetCost) {
+        break;
+      }
+      finalized[col] = true;
+      popped.emplace_back(col);
+      if (const auto row = invMatching[col]; row != none) {
+        relax(row, distance);
+      } else if (distance + prices[col] < targetCost) {
+        target = col;
+        targetCost = distance + prices[col];
+      }
+    }
+    if (target == none) {
+      throw std::invalid_argument("Input matrix has no full matching");
+    }
+    // update the potentials such that the reduced costs remain non-negative
+    // and vanish along the augmenting path
+    const auto targetDistance = distances[target];
+    potentials[source] += targetDistance;
+    for (const auto col : popped) {
+      if (const auto delta = targetDistance - distances[col]; delta > 0) {
+        prices[col] -= delta;
+        if (const auto row = invMatching[col]; row != none) {
+          potentials[row] += delta;
+        } else {
+          minFreePrice = std::min(minFreePrice, prices[col]);
+        }
+      }
+    }
+    // augment the matching along the path
+    for (auto col = target;;) {
+      const auto row = predecessors[col];
+      const auto next = matching[row];
+      matching[row] = col;
+      invMatching[col] = row;
+      if (row == source) {
+        break;
+      }
+      col = next;
+    }
+    // reset the scratch space
+    for (const auto col : reached) {
+      distances[col] = inf;
+      finalized[col] = false;
+    }
+    reached.clear();
+    popped.clear();
+    queue = {};
+  }
+  return matching;
+}
+auto VertexMatchingPlacer::matchSites(const SparseCostMatrix& costMatrix,
+                                      const std::vector<SiteId>& columnSites)
+    -> std::vector<size_t> {
+  if constexpr (PROFILING) {
+    auto& matching = statistics_.matchings.emplace_back();
+    matching.nRows = costMatrix.size();
+    matching.nColumns = columnSites.size();
+    for (const auto& row : costMatrix) {
+      matching.nEdges += row.size();
+    }
+  }
+  if (config_.denseMatching) {
+    std::vector matrix(
+        costMatrix.size(),
+        std::vector<std::optional<double>>(columnSites.size(), std::nullopt));
+    for (size_t row = 0; row < costMatrix.size(); ++row) {
+      for (const auto& [col, cost] : costMatrix[row]) {
+        matrix[row][col] = cost;
+      }
+    }
+    return minimumWeightFullBipartiteMatching(matrix);
+  }
+  std::vector<double> prices;
+  prices.reserve(columnSites.size());
+  for (const auto site : columnSites) {
+    prices.emplace_back(sitePrices_[site]);
+  }
+  const auto& matching =
+      sparseMinimumWeightFullBipartiteMatching(costMatrix, columnSites.size(),
+                                               prices);
+  // store the prices normalized to a maximum of zero such that they do not
+  // drift over many layers
+  if (!prices.empty()) {
+    const auto maxPrice = *std::max_element(prices.cbegin(), prices.cend());
+    for (size_t col = 0; col < columnSites.size(); ++col) {
+      sitePrices_[columnSites[col]] = prices[col] - maxPrice;
+    }
+  }
+  return matching;
+}
 auto VertexMatchingPlacer::computeMovementCostBetweenPlacements(
     const Placement& placementBefore, const Placement& placementAfter) const
     -> double {
@@ -259,7 +426,7 @@ auto VertexMatchingPlacer::placeGatesInEntanglementZone(
     const Placement& previousQubitPlacement,
     const std::unordered_set<qc::Qubit>& reuseQubits,
     const TwoQubitGateLayer& twoQubitGates,
-    const TwoQubitGateLayer& nextTwoQubitGates, const bool reuse) const
+    const TwoQubitGateLayer& nextTwoQubitGates, const bool reuse)
     -> Placement {
   std::unordered_map<qc::Qubit, qc::Qubit> dictReuseQubitNeighbor;
   if (!nextTwoQubitGates.empty() and reuse) {
@@ -286,12 +453,10 @@ auto VertexMatchingPlacer::placeGatesInEntanglementZone(
   std::vector<std::tuple<std::reference_wrapper<const std::array<SLM, 2>>,
                          size_t, size_t>>
       listRydberg;
-  // WARNING: The role of listColCoo and listRowCoo is swapped compared to
-  // the original implementation because our matching algorithm only
-  // supports a single direction, i.e., fewer rows than columns.
-  std::vector<size_t> listRowCoo;
-  std::vector<size_t> listColCoo;
-  std::vector<double> listData;
+  // WARNING: The role of rows and columns is swapped compared to the original
+  // implementation because our matching algorithm only supports a single
+  // direction, i.e., fewer rows than columns.
+  SparseCostMatrix costMatrix(twoQubitGates.size());
   for (size_t i = 0; i < twoQubitGates.size(); ++i) {
     const auto& [q1, q2] = twoQubitGates[i];
     // a set of possible locations sites for one operand of the gate
@@ -385,14 +550,13 @@ auto VertexMatchingPlacer::placeGatesInEntanglementZone(
         dis3 =
             architecture_.get().distance(slm3, r3, c3, slm.get().front(), r, c);
       }
-      listColCoo.emplace_back(idxRydberg);
-      listRowCoo.emplace_back(i);
       if (&slm1.get() == &slm2.get() && r1 == r2) {
-        listData.emplace_back(std::sqrt(std::max(dis1, dis2)) +
-                              std::sqrt(dis3));
+        costMatrix[i].emplace_back(
+            idxRydberg, std::sqrt(std::max(dis1, dis2)) + std::sqrt(dis3));
       } else {
-        listData.emplace_back(std::sqrt(dis1) + std::sqrt(dis2) +
-                              std::sqrt(dis3));
+        costMatrix[i].emplace_back(idxRydberg, std::sqrt(dis1) +
+                                                   std::sqrt(dis2) +
+                                                   std::sqrt(dis3));
       }
     }
   }
@@ -405,17 +569,14 @@ auto VertexMatchingPlacer::placeGatesInEntanglementZone(
     throw std::invalid_argument(ss.str());
   }
 
-  std::vector matrix(
-      twoQubitGates.size(),
-      std::vector<std::optional<double>>(listRydberg.size(), std::nullopt));
-  for (size_t i = 0; i < listRowCoo.size(); ++i) {
-    matrix[listRowCoo[i]][listColCoo[i]] = listData[i];
-  }
-  const auto& matching = minimumWeightFullBipartiteMatching(matrix);
-  double cost = 0;
-  for (size_t i = 0; i < matching.size(); ++i) {
-    cost = cost + matrix[i][matching[i]].value();
+  // the price of a pair of entanglement sites is stored at its first site
+  std::vector<SiteId> columnSites;
+  columnSites.reserve(listRydberg.size());
+  for (const auto& [zone, r, c] : listRydberg) {
+    columnSites.emplace_back(
+        architecture_.get().getSiteId(zone.get().front(), r, c));
   }
+  const auto& matching = matchSites(costMatrix, columnSites);
   auto newPlacement = previousQubitPlacement;
   for (size_t idxGate = 0; idxGate < matching.size(); ++idxGate) {
     const auto q0 = twoQubitGates[idxGate].front();
@@ -458,16 +619,14 @@ auto VertexMatchingPlacer::placeGatesInEntanglementZone(
 auto VertexMatchingPlacer::placeAtomsInStorageZone(
     const Placement& initialPlacement, const Placement& previousGatePlacement,
     const std::unordered_set<qc::Qubit>& reuseQubits,
-    const TwoQubitGateLayer& nextTwoQubitGates, const bool reuse) const
+    const TwoQubitGateLayer& nextTwoQubitGates, const bool reuse)
     -> Placement {
-  // for each storage SLM array, construct a matrix indicating occupancy of
-  // sites
-  SLMMap<std::vector<std::vector<bool>>> isEmptyStorageSite{};
-  // for each SLM array, initialize the site as empty
-  for (const auto& slm : architecture_.get().storageZones) {
-    isEmptyStorageSite.emplace(
-        *slm, std::vector(slm->nRows, std::vector(slm->nCols, true)));
-  }
+  const auto isFreeSite = [this](const SLM& slm, const size_t r,
+                                const size_t c) -> bool {
+    const auto site = architecture_.get().getSiteId(slm, r, c);
+    return !freeStorageSites_.covers(site) ||
+           freeStorageSites_.contains(site);
+  };
   // qubits that need to be placed, in particular, this does not include
   // qubits that are reused NOTE: the indices stored in qubitToPlace are
   // the indices of the lastGateMapping and do not refer to the actual
@@ -476,10 +635,8 @@ auto VertexMatchingPlacer::placeAtomsInStorageZone(
   // go through the placement of qubits after the last gate
   for (qc::Qubit q = 0; q < previousGatePlacement.size(); ++q) {
     const auto& [slm, r, c] = previousGatePlacement[q];
-    if (isEmptyStorageSite.find(slm) != isEmptyStorageSite.end()) {
-      // the mapped qubit is in the storage zone, set the site as occupied
-      isEmptyStorageSite.at(slm)[r][c] = false;
-    } else if (!reuse || reuseQubits.find(q) == reuseQubits.end()) {
+    if (!slm.get().isStorage() &&
+        (!reuse || reuseQubits.find(q) == reuseQubits.end())) {
       // the mapped qubit is in the entangling zone and must be placed (if
       // not reused)
       qubitToPlace.emplace_back(q);
@@ -490,17 +647,8 @@ auto VertexMatchingPlacer::placeAtomsInStorageZone(
   // guaranteed that they exist
   SiteSet commonSite{};
   for (const auto& [slm, r, c] : initialPlacement) {
-    if (isEmptyStorageSite.find(slm) != isEmptyStorageSite.end()) {
-      if (isEmptyStorageSite.at(slm)[r][c]) {
-        // add site to common sites if it is currently unoccupied
-        commonSite.emplace(slm, r, c);
-      }
-    } else {
-      // site is in an entangling zone and not yet added to
-      // isEmptyStorageSite
-      isEmptyStorageSite.emplace(
-          slm,
-          std::vector(slm.get().nRows, std::vector(slm.get().nCols, true)));
+    if (isFreeSite(slm, r, c)) {
+      // add site to common sites if it is currently unoccupied
       commonSite.emplace(slm, r, c);
     }
   }
@@ -527,9 +675,7 @@ auto VertexMatchingPlacer::placeAtomsInStorageZone(
 
   SiteMap<size_t> siteStorageToIdx{};
   std::vector<Site> listStorage{};
-  std::vector<size_t> listColCoo{};
-  std::vector<size_t> listRowCoo{};
-  std::vector<double> listData{};
+  SparseCostMatrix costMatrix(qubitToPlace.size());
 
   for (size_t i = 0; i < qubitToPlace.size(); ++i) {
     const auto q = qubitToPlace[i];
@@ -598,10 +744,11 @@ auto VertexMatchingPlacer::placeAtomsInStorageZone(
                               nearestCol - ratio, nearestCol + ratio};
     }
     auto setNearbySite = commonSite;
-    if (isEmptyStorageSite.at(initSLM)[initRow][initCol]) {
+    if (isFreeSite(initSLM, initRow, initCol)) {
       setNearbySite.emplace(initialPlacement[q]);
     }
 
+    size_t nWindowSites = 0;
     for (auto& [slmId, boundingBox] : dictBoudingbox) {
       auto& [lower, upper, left, right] = boundingBox;
       lower = lower > expandFactor ? lower - expandFactor : 0;
@@ -610,13 +757,22 @@ auto VertexMatchingPlacer::placeAtomsInStorageZone(
       right = std::min(right + expandFactor + 1, slmId.get().nCols);
       for (auto row = lower; row < upper; ++row) {
         for (auto col = left; col < right; ++col) {
-          if (isEmptyStorageSite.find(slmId) == isEmptyStorageSite.end() ||
-              isEmptyStorageSite.at(slmId)[row][col]) {
+          if (isFreeSite(slmId, row, col)) {
             setNearbySite.emplace(slmId, row, col);
+            ++nWindowSites;
           }
         }
       }
     }
+    // if the windows are (almost) fully occupied, add the nearest free sites
+    if (config_.useWindow && nWindowSites < config_.windowSize) {
+      const auto& [x, y] = architecture_.get().exactSLMLocation(
+          nearestSLM, nearestRow, nearestCol);
+      for (const auto site :
+           freeStorageSites_.nearest(x, y, config_.windowSize)) {
+        setNearbySite.emplace(architecture_.get().getSite(site));
+      }
+    }
 
     for (const auto& site : setNearbySite) {
       const auto& [it, success] =
@@ -647,33 +803,49 @@ auto VertexMatchingPlacer::placeAtomsInStorageZone(
         }
       }
       const double cost = std::sqrt(dis) + (0.1 * lookaheadCost);
-      listColCoo.emplace_back(idxStorage);
-      listRowCoo.emplace_back(i);
-      listData.emplace_back(cost);
+      costMatrix[i].emplace_back(idxStorage, cost);
     }
   }
-
-  // to construct from three arrays:
-  // - listData the entries of the matrix, in any order
-  // - listRowCoo the row indices of the matrix entries
-  // - listColCoo the column indices of the matrix entries
-  // Where A[listRowCoo[k], listColCoo[k]] = listData[k].
-  std::vector costMatrix(
-      qubitToPlace.size(),
-      std::vector<std::optional<double>>(listStorage.size(), std::nullopt));
-  for (size_t k = 0; k < listData.size(); ++k) {
-    costMatrix[listRowCoo[k]][listColCoo[k]] = listData[k];
-  }
-  const auto& matching = minimumWeightFullBipartiteMatching(costMatrix);
+  std::vector<SiteId> columnSites;
+  columnSites.reserve(listStorage.size());
+  for (const auto& site : listStorage) {
+    columnSites.emplace_back(architecture_.get().getSiteId(site));
+  }
+  const auto& matching = matchSites(costMatrix, columnSites);
   auto newPlacement = previousGatePlacement;
   for (size_t j = 0; j < matching.size(); ++j) {
     newPlacement[qubitToPlace[j]] = listStorage[matching[j]];
   }
   return newPlacement;
 }
+auto VertexMatchingPlacer::updateFreeStorageSites(const Placement& before,
+                                                  const Placement& after)
+    -> void {
+  assert(before.size() == after.size());
+  // first release all sites that are left such that an atom can move to a
+  // site that is left by another atom at the same time
+  for (size_t q = 0; q < before.size(); ++q) {
+    if (before[q] != after[q]) {
+      if (const auto site = architecture_.get().getSiteId(before[q]);
+          freeStorageSites_.covers(site)) {
+        freeStorageSites_.insert(site);
+      }
+    }
+  }
+  for (size_t q = 0; q < after.size(); ++q) {
+    if (before[q] != after[q]) {
+      if (const auto site = architecture_.get().getSiteId(after[q]);
+          freeStorageSites_.covers(site)) {
+        freeStorageSites_.erase(site);
+      }
+    }
+  }
+}
 VertexMatchingPlacer::VertexMatchingPlacer(const Architecture& architecture,
                                            const Config& config)
-    : architecture_(architecture), config_(config) {
+    : architecture_(architecture), config_(config),
+      freeStorageSites_(architecture, 0,
+                        architecture.getNumberOfStorageSites()) {
   // get first storage SLM and first entanglement SLM
   const auto& firstStorageSLM = *architecture_.get().storageZones.front();
   const auto& firstEntanglementSLM =
@@ -694,13 +866,40 @@ auto VertexMatchingPlacer::place(
     -> std::vector<Placement> {
   std::vector<Placement> placement;
   placement.reserve((2 * twoQubitGateLayers.size()) + 1);
-  placement.emplace_back(makeInitialPlacement(nQubits));
+  place(nQubits, twoQubitGateLayers, reuseQubits,
+        [&placement](const Placement& next) { placement.emplace_back(next); });
+  return placement;
+}
+auto VertexMatchingPlacer::place(
+    const size_t nQubits,
+    const std::vector<TwoQubitGateLayer>& twoQubitGateLayers,
+    const std::vector<std::unordered_set<qc::Qubit>>& reuseQubits,
+    const PlacementCallback& onPlacement) -> void {
+  // only the initial and the last placement are required to compute the next
+  // one, all placements are handed over to the callback
+  statistics_ = Statistics{};
+  // the dual prices are only carried over between the layers of one circuit
+  sitePrices_.assign(architecture_.get().getNumberOfSites(), 0.0);
+  std::array<Placement, 2> placement;
+  auto& [initial, previous] = placement;
+  const auto emit = [this, &previous, &onPlacement](Placement next) {
+    updateFreeStorageSites(previous, next);
+    previous = std::move(next);
+    onPlacement(previous);
+  };
+  initial = makeInitialPlacement(nQubits);
+  onPlacement(initial);
+  freeStorageSites_.fill();
+  for (const auto& site : initial) {
+    freeStorageSites_.erase(architecture_.get().getSiteId(site));
+  }
   // early return if no two-qubit gates are present
   if (twoQubitGateLayers.empty()) {
-    return placement;
+    return;
   }
-  placement.emplace_back(placeGatesInEntanglementZone(
-      placement.front(), std::unordered_set<qc::Qubit>{},
+  previous = initial;
+  emit(placeGatesInEntanglementZone(
+      initial, std::unordered_set<qc::Qubit>{},
       twoQubitGateLayers.front(),
       twoQubitGateLayers.size() > 1 ? twoQubitGateLayers[1]
                                     : TwoQubitGateLayer{},
@@ -710,7 +909,7 @@ auto VertexMatchingPlacer::place(
     Placement qubitPlacementWithoutReuse;
     if (config_.dynamicPlacement) {
       qubitPlacementWithoutReuse = placeAtomsInStorageZone(
-          placement.front(), placement.back(),
+          initial, previous,
           layer < reuseQubits.size() ? reuseQubits[layer]
                                      : std::unordered_set<qc::Qubit>{},
           layer + 1 < twoQubitGateLayers.size() ? twoQubitGateLayers[layer + 1]
@@ -718,7 +917,7 @@ auto VertexMatchingPlacer::place(
           false);
     } else {
       // keep the initial mapping for static placement
-      qubitPlacementWithoutReuse = placement.front();
+      qubitPlacementWithoutReuse = initial;
     }
     if (layer + 1 < twoQubitGateLayers.size()) {
       const auto& gatePlacementWithoutReuse = placeGatesInEntanglementZone(
@@ -732,16 +931,16 @@ auto VertexMatchingPlacer::place(
         Placement qubitPlacementWithReuse;
         if (config_.dynamicPlacement) {
           qubitPlacementWithReuse = placeAtomsInStorageZone(
-              placement.front(), placement.back(), reuseQubits[layer],
+              initial, previous, reuseQubits[layer],
               layer + 1 < twoQubitGateLayers.size()
                   ? twoQubitGateLayers[layer + 1]
                   : TwoQubitGateLayer{},
               true);
         } else {
           // keep the initial mapping for static placement
-          qubitPlacementWithReuse = placement.front();
+          qubitPlacementWithReuse = initial;
           for (const auto q : reuseQubits[layer]) {
-            qubitPlacementWithReuse[q] = placement.back()[q];
+            qubitPlacementWithReuse[q] = previous[q];
           }
         }
         const auto& gatePlacementWithReuse = placeGatesInEntanglementZone(
@@ -753,20 +952,19 @@ auto VertexMatchingPlacer::place(
             true);
         // keep the mapping with shorter distance
         const auto& [gatePlacement, qubitPlacement] = filterMapping(
-            placement.back(),
+            previous,
             std::pair{qubitPlacementWithoutReuse, gatePlacementWithoutReuse},
             std::pair{qubitPlacementWithReuse, gatePlacementWithReuse});
-        placement.emplace_back(gatePlacement);
-        placement.emplace_back(qubitPlacement);
+        emit(gatePlacement);
+        emit(qubitPlacement);
       } else {
-        placement.emplace_back(qubitPlacementWithoutReuse);
-        placement.emplace_back(gatePlacementWithoutReuse);
+        emit(std::move(qubitPlacementWithoutReuse));
+        emit(gatePlacementWithoutReuse);
       }
     } else {
-      placement.emplace_back(qubitPlacementWithoutReuse);
+      emit(std::move(qubitPlacementWithoutReuse));
     }
   }
-  return placement;
 }
 auto VertexMatchingPlacer::makeInitialPlacement(const size_t nQubits) const
     -> Placement {
@@ -12,41 +12,111 @@
 
 #include "ir/Definitions.hpp"
 #include "na/zoned/Architecture.hpp"
+#include "na/zoned/PlacementSequence.hpp"
+#include "na/zoned/Profiling.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
-#include <iostream>
+#include <iterator>
+#include <numeric>
 #include <set>
-#include <sstream>
 #include <tuple>
-#include <unordered_map>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
 namespace na::zoned {
+namespace {
+/// The bitsets of the nodes whose value is smaller than a certain rank
+struct RankedBitsets {
+  /// The rank of every node, equal values have the same rank
+  std::vector<size_t> rank;
+  /**
+   * The bitset of all nodes with a rank smaller than r at index r. The last
+   * bitset contains all nodes.
+   */
+  std::vector<std::vector<std::uint64_t>> less;
+};
+
+/// Sorts the nodes by their values and sweeps over them to compute the bitsets
+/// of the nodes with smaller values
+auto sweep(const std::vector<size_t>& values) -> RankedBitsets {
+  const auto nNodes = values.size();
+  const auto nWords = (nNodes + 63) / 64;
+  std::vector<size_t> order(nNodes);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&values](const auto a, const auto b) {
+    return values[a] < values[b];
+  });
+  RankedBitsets result{.rank = std::vector<size_t>(nNodes), .less = {}};
+  std::vector<std::uint64_t> current(nWords, 0);
+  for (size_t i = 0; i < nNodes; ++i) {
+    // a new rank starts whenever the value changes
+    if (i == 0 || values[order[i]] != values[order[i - 1]]) {
+      result.less.emplace_back(current);
+    }
+    result.rank[order[i]] = result.less.size() - 1;
+    current[order[i] / 64] |= std::uint64_t{1} << (order[i] % 64);
+  }
+  result.less.emplace_back(std::move(current));
+  return result;
+}
+
+/**
+ * Adds an edge between every two nodes that are ordered differently by their
+ * start and their target values. Here, equal values count as an order of
+ * their own, i.e., two nodes with equal start values must also have equal
+ * target values.
+ */
+auto addOrderConflicts(const std::vector<size_t>& startValues,
+                       const std::vector<size_t>& targetValues,
+                       std::vector<std::vector<std::uint64_t>>& graph)
+    -> void {
+  const auto& start = sweep(startValues);
+  const auto& target = sweep(targetValues);
+  const auto& all = start.less.back();
+  for (size_t node = 0; node < graph.size(); ++node) {
+    const auto& startLess = start.less[start.rank[node]];
+    const auto& startLessEqual = start.less[start.rank[node] + 1];
+    const auto& targetLess = target.less[target.rank[node]];
+    const auto& targetLessEqual = target.less[target.rank[node] + 1];
+    auto& conflicts = graph[node];
+    for (size_t w = 0; w < conflicts.size(); ++w) {
+      const auto startEqual = startLessEqual[w] & ~startLess[w];
+      const auto targetEqual = targetLessEqual[w] & ~targetLess[w];
+      const auto sameOrder = (startLess[w] & targetLess[w]) |
+                             (startEqual & targetEqual) |
+                             (~startLessEqual[w] & ~targetLessEqual[w]);
+      conflicts[w] |= all[w] & ~sameOrder;
+    }
+  }
+}
+} // namespace
+
 auto IndependentSetRouter::createConflictGraph(
     const std::vector<qc::Qubit>& atomsToMove, const Placement& startPlacement,
-    const Placement& targetPlacement) const
-    -> std::unordered_map<qc::Qubit, std::vector<qc::Qubit>> {
-  std::unordered_map<qc::Qubit, std::vector<qc::Qubit>> conflictGraph;
-  for (auto atomIt = atomsToMove.cbegin(); atomIt != atomsToMove.cend();
-       ++atomIt) {
-    const auto& atom = *atomIt;
-    const auto& atomMovementVector =
+    const Placement& targetPlacement) const -> ConflictGraph {
+  const auto nAtoms = atomsToMove.size();
+  ConflictGraph conflictGraph(
+      nAtoms, std::vector<std::uint64_t>((nAtoms + 63) / 64, 0));
+  std::array<std::vector<size_t>, 4> coordinates;
+  for (auto& values : coordinates) {
+    values.reserve(nAtoms);
+  }
+  for (const auto atom : atomsToMove) {
+    const auto& [startX, startY, targetX, targetY] =
         getMovementVector(startPlacement[atom], targetPlacement[atom]);
-    for (auto neighborIt = atomIt + 1; neighborIt != atomsToMove.cend();
-         ++neighborIt) {
-      const auto& neighbor = *neighborIt;
-      const auto& neighborMovementVector = getMovementVector(
-          startPlacement[neighbor], targetPlacement[neighbor]);
-      if (!isCompatibleMovement(atomMovementVector, neighborMovementVector)) {
-        conflictGraph.try_emplace(atom).first->second.emplace_back(neighbor);
-        conflictGraph.try_emplace(neighbor).first->second.emplace_back(atom);
-      }
-    }
+    coordinates[0].emplace_back(startX);
+    coordinates[1].emplace_back(startY);
+    coordinates[2].emplace_back(targetX);
+    coordinates[3].emplace_back(targetY);
   }
+  // the moves must preserve the order in x- and in y-direction
+  addOrderConflicts(coordinates[0], coordinates[2], conflictGraph);
+  addOrderConflicts(coordinates[1], coordinates[3], conflictGraph);
   return conflictGraph;
 }
 auto IndependentSetRouter::getMovementVector(
@@ -87,61 +157,114 @@ auto IndependentSetRouter::route(const std::vector<Placement>& placement) const
   if (placement.empty()) {
     return routing;
   }
-  for (auto it = placement.cbegin(); true;) {
-    const auto& startPlacement = *it;
-    if (++it == placement.cend()) {
-      break;
+  routing.reserve(placement.size() - 1);
+  for (auto it = std::next(placement.cbegin()); it != placement.cend(); ++it) {
+    routing.emplace_back(route(*std::prev(it), *it));
+  }
+  return routing;
+}
+auto IndependentSetRouter::route(const PlacementSequence& placement,
+                                 std::vector<int64_t>* routingTimes) const
+    -> std::vector<Routing> {
+  std::vector<Routing> routing;
+  // early return if no placement is given
+  if (placement.empty()) {
+    return routing;
+  }
+  routing.reserve(placement.size() - 1);
+  // only two placements are materialized, they are advanced by the atoms
+  // that are moved in every step
+  auto startPlacement = placement.front();
+  auto targetPlacement = startPlacement;
+  for (size_t i = 1; i < placement.size(); ++i) {
+    placement.applyMoves(i, targetPlacement);
+    const auto moves = placement.getMoves(i);
+    std::vector<qc::Qubit> atomsToMove;
+    atomsToMove.reserve(moves.size());
+    for (const auto& move : moves) {
+      atomsToMove.emplace_back(move.atom);
     }
-    const auto& targetPlacement = *it;
-    std::set<std::pair<double, qc::Qubit>, std::greater<>>
-        atomsToMoveOrderedAscByDist;
-    assert(startPlacement.size() == targetPlacement.size());
-    for (qc::Qubit atom = 0; atom < startPlacement.size(); ++atom) {
-      const auto& [startSLM, startRow, startColumn] = startPlacement[atom];
-      const auto& [targetSLM, targetRow, targetColumn] = targetPlacement[atom];
-      // if atom must be moved
-      if (&startSLM.get() != &targetSLM.get() || startRow != targetRow ||
-          startColumn != targetColumn) {
-        const auto distance =
-            architecture_.get().distance(startSLM, startRow, startColumn,
-                                         targetSLM, targetRow, targetColumn);
-        atomsToMoveOrderedAscByDist.emplace(distance, atom);
-      }
+    int64_t routingTime = 0;
+    {
+      const ProfilingTimer timer(routingTime);
+      routing.emplace_back(
+          routeAtoms(std::move(atomsToMove), startPlacement, targetPlacement));
     }
-    std::vector<qc::Qubit> atomsToMove;
-    atomsToMove.reserve(atomsToMoveOrderedAscByDist.size());
-    // put the atoms into the vector such they are ordered decreasingly by their
-    // movement distance
-    for (const auto& atomIt : atomsToMoveOrderedAscByDist) {
-      atomsToMove.emplace_back(atomIt.second);
+    if (routingTimes != nullptr) {
+      routingTimes->emplace_back(routingTime);
     }
-    auto conflictGraph =
-        createConflictGraph(atomsToMove, startPlacement, targetPlacement);
-    auto& currentRouting = routing.emplace_back();
-    while (!atomsToMove.empty()) {
-      auto& independentSet = currentRouting.emplace_back();
-      std::vector<qc::Qubit> remainingAtoms;
-      std::unordered_set<qc::Qubit> conflictingAtomsMoves;
-      for (const auto& atom : atomsToMove) {
-        if (conflictingAtomsMoves.find(atom) == conflictingAtomsMoves.end()) {
-          // if the atom does not conflict with any atom that is already in the
-          // independent set, add it and mark its neighbors as conflicting
-          independentSet.emplace_back(atom);
-          if (const auto conflictingNeighbors = conflictGraph.find(atom);
-              conflictingNeighbors != conflictGraph.end()) {
-            for (const auto neighbor : conflictingNeighbors->second) {
-              conflictingAtomsMoves.emplace(neighbor);
-            }
-          }
-        } else {
-          // if an atom could not be put into the current independent set, add
-          // it to the remaining atoms
-          remainingAtoms.emplace_back(atom);
+    placement.applyMoves(i, startPlacement);
+  }
+  return routing;
+}
+auto IndependentSetRouter::route(const Placement& startPlacement,
+                                 const Placement& targetPlacement) const
+    -> Routing {
+  assert(startPlacement.size() == targetPlacement.size());
+  std::vector<qc::Qubit> atomsToMove;
+  for (qc::Qubit atom = 0; atom < startPlacement.size(); ++atom) {
+    const auto& [startSLM, startRow, startColumn] = startPlacement[atom];
+    const auto& [targetSLM, targetRow, targetColumn] = targetPlacement[atom];
+    // if atom must be moved
+    if (&startSLM.get() != &targetSLM.get() || startRow != targetRow ||
+        startColumn != targetColumn) {
+      atomsToMove.emplace_back(atom);
+    }
+  }
+  return routeAtoms(std::move(atomsToMove), startPlacement, targetPlacement);
+}
+auto IndependentSetRouter::routeAtoms(std::vector<qc::Qubit> atomsToMove,
+                                      const Placement& startPlacement,
+                                      const Placement& targetPlacement) const
+    -> Routing {
+  std::set<std::pair<double, qc::Qubit>, std::greater<>>
+      atomsToMoveOrderedAscByDist;
+  for (const auto atom : atomsToMove) {
+    const auto& [startSLM, startRow, startColumn] = startPlacement[atom];
+    const auto& [targetSLM, targetRow, targetColumn] = targetPlacement[atom];
+    const auto distance =
+        architecture_.get().distance(startSLM, startRow, startColumn,
+                                     targetSLM, targetRow, targetColumn);
+    atomsToMoveOrderedAscByDist.emplace(distance, atom);
+  }
+  atomsToMove.clear();
+  // put the atoms into the vector such they are ordered decreasingly by their
+  // movement distance
+  for (const auto& atomIt : atomsToMoveOrderedAscByDist) {
+    atomsToMove.emplace_back(atomIt.second);
+  }
+  const auto& conflictGraph =
+      createConflictGraph(atomsToMove, startPlacement, targetPlacement);
+  // Every atom is put into the first group that does not contain a conflicting
+  // atom yet. This yields the same groups as repeatedly extracting a maximal
+  // independent set from the remaining atoms in the given order since an atom
+  // is only rejected from a group by conflicting atoms that come before it.
+  Routing currentRouting;
+  std::vector<std::vector<std::uint64_t>> groupMembers;
+  for (size_t i = 0; i < atomsToMove.size(); ++i) {
+    const auto& conflicts = conflictGraph[i];
+    // only atoms before the current one are already assigned to groups
+    const auto nWords = (i / 64) + 1;
+    const auto isCompatible = [&conflicts,
+                               nWords](const auto& members) -> bool {
+      for (size_t w = 0; w < nWords; ++w) {
+        if ((conflicts[w] & members[w]) != 0) {
+          return false;
         }
       }
-      atomsToMove = remainingAtoms;
+      return true;
+    };
+    size_t group = 0;
+    while (group < groupMembers.size() && !isCompatible(groupMembers[group])) {
+      ++group;
     }
+    if (group == groupMembers.size()) {
+      groupMembers.emplace_back(conflicts.size(), 0);
+      currentRouting.emplace_back();
+    }
+    groupMembers[group][i / 64] |= std::uint64_t{1} << (i % 64);
+    currentRouting[group].emplace_back(atomsToMove[i]);
   }
-  return routing;
+  return currentRouting;
 }
 } // namespace na::zoned
@@ -16,12 +16,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
-#include <deque>
-#include <numeric>
 #include <optional>
-#include <queue>
-#include <stack>
-#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -34,15 +29,24 @@ auto VertexMatchingReuseAnalyzer::analyzeReuse(
     // early exit if there are no qubits to reuse between layers
     return std::vector<std::unordered_set<qc::Qubit>>{};
   }
-  std::vector<std::unordered_map<qc::Qubit, size_t>> usedQubitsInLayers;
-  usedQubitsInLayers.reserve(twoQubitGateLayers.size());
-  const auto& firstGateLayer = twoQubitGateLayers.front();
-  auto& usedQubitsInFirstLayer = usedQubitsInLayers.emplace_back();
-  for (size_t gateIdx = 0; gateIdx < firstGateLayer.size(); ++gateIdx) {
-    for (const auto qubit : firstGateLayer[gateIdx]) {
-      usedQubitsInFirstLayer[qubit] = gateIdx;
+  qc::Qubit nQubits = 0;
+  for (const auto& layer : twoQubitGateLayers) {
+    for (const auto& gate : layer) {
+      nQubits = std::max({nQubits, gate.front() + 1, gate.back() + 1});
     }
   }
+  // the index of the gate every qubit is used in or none_ if the qubit is not
+  // used in the previous and current layer, respectively
+  std::vector gateInPreviousLayer(nQubits, none_);
+  std::vector gateInCurrentLayer(nQubits, none_);
+  for (size_t gateIdx = 0; gateIdx < twoQubitGateLayers.front().size();
+       ++gateIdx) {
+    for (const auto qubit : twoQubitGateLayers.front()[gateIdx]) {
+      gateInPreviousLayer[qubit] = gateIdx;
+    }
+  }
+  BipartiteGraph graph;
+  MatchingBuffers buffers;
   std::vector<std::unordered_set<qc::Qubit>> reuseQubits;
   reuseQubits.reserve(twoQubitGateLayers.size() - 1);
   for (auto layer = twoQubitGateLayers.begin();;) {
@@ -51,177 +55,168 @@ auto VertexMatchingReuseAnalyzer::analyzeReuse(
       break;
     }
     const auto& twoQubitGatesInCurrentLayer = *layer;
-    std::vector matrix(twoQubitGatesInCurrentLayer.size(),
-                       std::vector(twoQubitGatesInPreviousLayer.size(), false));
-    const auto& usedQubitsInPreviousLayer = usedQubitsInLayers.back();
-    auto& usedQubitsInCurrentLayer = usedQubitsInLayers.emplace_back();
     auto& reuseQubitsInCurrentLayer = reuseQubits.emplace_back();
+    // every gate in the current layer is adjacent to at most one gate in the
+    // previous layer
+    graph.offsets.assign(1, 0);
+    graph.sinks.clear();
+    graph.nSinks = twoQubitGatesInPreviousLayer.size();
     for (size_t gateIdx = 0; gateIdx < twoQubitGatesInCurrentLayer.size();
          ++gateIdx) {
       const auto& gate = twoQubitGatesInCurrentLayer[gateIdx];
-      const auto& itFirst = usedQubitsInPreviousLayer.find(gate.front());
-      const auto& itSecond = usedQubitsInPreviousLayer.find(gate.back());
-      const auto firstReusable = itFirst != usedQubitsInPreviousLayer.end();
-      const auto secondReusable = itSecond != usedQubitsInPreviousLayer.end();
-      if (firstReusable && secondReusable &&
-          itFirst->second == itSecond->second) {
+      const auto first = gateInPreviousLayer[gate.front()];
+      const auto second = gateInPreviousLayer[gate.back()];
+      if (first != none_ && first == second) {
         // If both qubits of the gate are used in the previous layer also
         // by the identical gate, then both qubits can stay at their location
         // and be reused.
         reuseQubitsInCurrentLayer.emplace(gate.front());
         reuseQubitsInCurrentLayer.emplace(gate.back());
-      } else if (firstReusable) {
-        matrix[gateIdx][itFirst->second] = true;
-      } else if (secondReusable) {
-        matrix[gateIdx][itSecond->second] = true;
-      }
-      usedQubitsInCurrentLayer[gate.front()] = gateIdx;
-      usedQubitsInCurrentLayer[gate.back()] = gateIdx;
-    }
-    std::vector sparseMatrix(matrix.size(), std::vector<std::size_t>{});
-    for (std::size_t r = 0; r < matrix.size(); ++r) {
-      for (std::size_t c = 0; c < matrix[r].size(); ++c) {
-        if (matrix[r][c]) {
-          sparseMatrix[r].emplace_back(c);
-        }
+      } else if (first != none_) {
+        graph.sinks.emplace_back(first);
+      } else if (second != none_) {
+        graph.sinks.emplace_back(second);
       }
+      graph.offsets.emplace_back(graph.sinks.size());
+      gateInCurrentLayer[gate.front()] = gateIdx;
+      gateInCurrentLayer[gate.back()] = gateIdx;
     }
-    const auto& matching = maximumBipartiteMatching(sparseMatrix);
-    for (std::size_t gateIdx = 0; gateIdx < matching.size(); ++gateIdx) {
-      if (const auto& reuseGateIdx = matching[gateIdx]; reuseGateIdx) {
+    maximumBipartiteMatching(graph, buffers);
+    for (std::size_t gateIdx = 0; gateIdx < twoQubitGatesInCurrentLayer.size();
+         ++gateIdx) {
+      if (const auto reuseGateIdx = buffers.matching[gateIdx];
+          reuseGateIdx != none_) {
         const auto& gate = twoQubitGatesInCurrentLayer[gateIdx];
-        if (const auto& it = usedQubitsInPreviousLayer.find(gate.front());
-            it != usedQubitsInPreviousLayer.end() &&
-            it->second == *reuseGateIdx) {
+        if (gateInPreviousLayer[gate.front()] == reuseGateIdx) {
           reuseQubitsInCurrentLayer.emplace(gate.front());
         } else {
-          assert(usedQubitsInPreviousLayer.at(gate.back()) == *reuseGateIdx);
+          assert(gateInPreviousLayer[gate.back()] == reuseGateIdx);
           reuseQubitsInCurrentLayer.emplace(gate.back());
         }
       }
     }
+    // only reset the entries of the qubits used in the previous layer such
+    // that the cost does not depend on the number of qubits
+    for (const auto& gate : twoQubitGatesInPreviousLayer) {
+      gateInPreviousLayer[gate.front()] = none_;
+      gateInPreviousLayer[gate.back()] = none_;
+    }
+    std::swap(gateInPreviousLayer, gateInCurrentLayer);
   }
   return reuseQubits;
 }
 auto VertexMatchingReuseAnalyzer::maximumBipartiteMatching(
-    const std::vector<std::vector<std::size_t>>& sparseMatrix, bool inverted)
-    -> std::vector<std::optional<std::size_t>> {
+    const BipartiteGraph& graph, MatchingBuffers& buffers) -> void {
   // Conversely, to other implementations and the literature, we do NOT
   // introduce two extra nodes, one connected to all free sources and one
   // connected to all free sinks. Instead, we start the search directly from
   // free sources and end as soon as we encountered a free sink.
-  const auto maxSink = std::accumulate(
-      sparseMatrix.cbegin(), sparseMatrix.cend(), static_cast<std::size_t>(0),
-      [](const std::size_t max, const std::vector<std::size_t>& row) {
-        if (const auto maxIt = std::max_element(row.cbegin(), row.cend());
-            maxIt != row.cend()) {
-          return std::max(max, *maxIt);
-        }
-        return max;
-      });
-  std::vector freeSources(sparseMatrix.size(), true);
-  std::vector<std::optional<std::size_t>> invMatching(maxSink + 1,
-                                                      std::nullopt);
+  const auto nSources = graph.offsets.size() - 1;
+  auto& [matching, invMatching, distance, nextEdge, queue, path] = buffers;
+  matching.assign(nSources, none_);
+  invMatching.assign(graph.nSinks, none_);
+  distance.resize(nSources);
+  nextEdge.resize(nSources);
   while (true) {
-    // find the reachable free sinks on shortest augmenting paths via bfs
-    // for all distances, std::nullopt means "not visited yet", i.e., infinite
-    // distance
-    std::vector<std::optional<std::size_t>> distance(sparseMatrix.size(),
-                                                     std::nullopt);
-    for (std::size_t s = 0; s < freeSources.size(); ++s) {
-      if (freeSources[s]) {
-        distance[s] = 0;
+    // find the reachable free sinks on shortest augmenting paths via bfs,
+    // none_ means "not visited yet", i.e., infinite distance
+    queue.clear();
+    for (std::size_t source = 0; source < nSources; ++source) {
+      if (matching[source] == none_) {
+        distance[source] = 0;
+        queue.emplace_back(source);
+      } else {
+        distance[source] = none_;
       }
     }
-    std::queue<std::size_t> queue{};
-    for (std::size_t source = 0; source < freeSources.size(); ++source) {
-      if (freeSources[source]) {
-        queue.push(source);
+    auto maxDistance = none_;
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+      const auto source = queue[i];
+      if (distance[source] >= maxDistance) {
+        // all shortest augmenting paths are found, queue is sorted by distance
+        break;
       }
-    }
-    std::optional<std::size_t> maxDistance = std::nullopt;
-    while (!queue.empty()) {
-      const auto source = queue.front();
-      queue.pop();
-      if (!maxDistance || *distance[source] <= *maxDistance) {
-        for (const auto sink : sparseMatrix[source]) {
-          if (invMatching[sink]) { // a matched sink is found
-            const auto nextSource = *invMatching[sink];
-            if (!distance[nextSource]) { // nextSource is not visited yet
-              distance[nextSource] = *distance[source] + 1;
-              queue.push(nextSource);
-            }
-          } else { // a free sink is found
-            maxDistance = distance[source];
-          }
+      for (auto e = graph.offsets[source]; e < graph.offsets[source + 1]; ++e) {
+        if (const auto nextSource = invMatching[graph.sinks[e]];
+            nextSource == none_) { // a free sink is found
+          maxDistance = distance[source];
+        } else if (distance[nextSource] == none_) {
+          // nextSource is not visited yet
+          distance[nextSource] = distance[source] + 1;
+          queue.emplace_back(nextSource);
         }
       }
     }
-    if (!maxDistance) { // no augmenting path exists
+    if (maxDistance == none_) { // no augmenting path exists
       break;
     }
-    // find the augmenting paths via dfs and update the matching
-    for (std::size_t freeSource = 0; freeSource < freeSources.size();
-         ++freeSource) {
-      if (freeSources[freeSource]) {
-        std::stack<std::size_t, std::deque<std::size_t>> stack(
-            std::deque<std::size_t>{freeSource});
-        // this vector tracks the predecessors of each source, i.e., the sink
-        // AND the source coming before the source in the augmenting path
-        std::vector<std::optional<std::pair<std::size_t, std::size_t>>> parents(
-            sparseMatrix.size(), std::nullopt);
-        std::optional<std::pair<std::size_t, std::size_t>> freeSinkFound =
-            std::nullopt;
-        while (!freeSinkFound && !stack.empty()) {
-          const auto source = stack.top();
-          stack.pop();
-          for (const auto sink : sparseMatrix[source]) {
-            if (invMatching[sink]) { // a matched sink is found
-              const auto nextSource = *invMatching[sink];
-              if (distance[nextSource] &&
-                  *distance[nextSource] == *distance[source] + 1) {
-                // the edge from source to sink is a valid edge that was
-                // encountered during the bfs
-                parents[nextSource] = {source, sink};
-                stack.push(nextSource);
-              }
-            } else { // a free sink is found
-              freeSinkFound = {source, sink};
-              break;
-            }
-          }
-          distance[source] = std::nullopt; // mark source as visited
+    // find vertex-disjoint augmenting paths via dfs and update the matching
+    for (std::size_t source = 0; source < nSources; ++source) {
+      nextEdge[source] = graph.offsets[source];
+    }
+    for (std::size_t freeSource = 0; freeSource < nSources; ++freeSource) {
+      if (matching[freeSource] != none_ || distance[freeSource] != 0) {
+        continue;
+      }
+      path.assign(1, freeSource);
+      while (!path.empty()) {
+        const auto source = path.back();
+        if (nextEdge[source] == graph.offsets[source + 1]) {
+          // dead end, the source is not considered again in this phase
+          distance[source] = none_;
+          path.pop_back();
+          continue;
         }
-        if (freeSinkFound) {
-          // augment the matching
-          auto source = freeSinkFound->first;
-          auto sink = freeSinkFound->second;
-          invMatching[sink] =
-              source; // that is the additional edge in the matching
-          while (source != freeSource) {
-            sink = parents[source]->second;
-            source = parents[source]->first;
-            invMatching[sink] =
-                source; // update the matching, i.e., flip the edge from the
-            // successor to the predecessor
+        const auto sink = graph.sinks[nextEdge[source]++];
+        const auto nextSource = invMatching[sink];
+        if (nextSource == none_) {
+          if (distance[source] == maxDistance) {
+            // augment the matching along the path, the sink of every source
+            // on the path is the one of the last explored edge
+            for (const auto s : path) {
+              const auto t = graph.sinks[nextEdge[s] - 1];
+              matching[s] = t;
+              invMatching[t] = s;
+              // the source is part of an augmenting path of this phase
+              distance[s] = none_;
+            }
+            break;
           }
-          freeSources[freeSource] = false;
+        } else if (distance[nextSource] != none_ &&
+                   distance[nextSource] == distance[source] + 1) {
+          // the edge from source to sink is a valid edge that was
+          // encountered during the bfs
+          path.emplace_back(nextSource);
         }
       }
     }
   }
-  // ===-------------------------------===
-  if (inverted) {
-    return invMatching;
+}
+auto VertexMatchingReuseAnalyzer::maximumBipartiteMatching(
+    const std::vector<std::vector<std::size_t>>& sparseMatrix, bool inverted)
+    -> std::vector<std::optional<std::size_t>> {
+  BipartiteGraph graph;
+  graph.offsets.reserve(sparseMatrix.size() + 1);
+  graph.offsets.emplace_back(0);
+  for (const auto& row : sparseMatrix) {
+    for (const auto sink : row) {
+      graph.sinks.emplace_back(sink);
+      graph.nSinks = std::max(graph.nSinks, sink + 1);
+    }
+    graph.offsets.emplace_back(graph.sinks.size());
   }
-  // invert the matching
-  std::vector<std::optional<std::size_t>> matching(sparseMatrix.size(),
-                                                   std::nullopt);
-  for (std::size_t i = 0; i < invMatching.size(); ++i) {
-    if (invMatching[i]) {
-      matching[*invMatching[i]] = i;
+  // keep at least one sink as the result is indexed by the sinks if inverted
+  graph.nSinks = std::max<std::size_t>(graph.nSinks, 1);
+  MatchingBuffers buffers;
+  maximumBipartiteMatching(graph, buffers);
+  const auto& result = inverted ? buffers.invMatching : buffers.matching;
+  std::vector<std::optional<std::size_t>> optionalResult(result.size(),
+                                                         std::nullopt);
+  for (std::size_t i = 0; i < result.size(); ++i) {
+    if (result[i] != none_) {
+      optionalResult[i] = result[i];
     }
   }
-  return matching;
+  return optionalResult;
 }
 } // namespace na::zoned
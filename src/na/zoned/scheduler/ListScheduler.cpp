@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2023 - 2025 Chair for Design Automation, TUM
+ * Copyright (c) 2025 Munich Quantum Software Company GmbH
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "na/zoned/scheduler/ListScheduler.hpp"
+
+#include "ir/Definitions.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/OpType.hpp"
+#include "ir/operations/Operation.hpp"
+#include "ir/operations/StandardOperation.hpp"
+#include "na/zoned/Architecture.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace na::zoned {
+namespace {
+/// @returns true if a single-qubit gate of this type commutes with CZ gates
+[[nodiscard]] auto isDiagonal(const qc::OpType type) -> bool {
+  switch (type) {
+  case qc::I:
+  case qc::Z:
+  case qc::S:
+  case qc::Sdg:
+  case qc::T:
+  case qc::Tdg:
+  case qc::P:
+  case qc::RZ:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/// An entry in the sequence of operations acting on one qubit
+struct Entry {
+  enum class Kind : std::uint8_t {
+    /// A single-qubit gate that commutes with CZ gates
+    Diagonal,
+    /// A single-qubit gate that ends the current block
+    NonDiagonal,
+    /// A global operation or barrier that all qubits must reach together
+    Synchronization,
+    /// A CZ gate
+    TwoQubitGate
+  };
+  Kind kind;
+  /// The operation of the entry or nullptr for barriers and CZ gates
+  const qc::Operation* op = nullptr;
+  /// The index of the CZ gate
+  size_t gate = 0;
+};
+
+/// A CZ gate together with its position in the blocks of its qubits
+struct Gate {
+  QubitPair qubits;
+  /// The block of every qubit the gate belongs to
+  std::array<size_t, 2> block{};
+  /// The position of the gate in the list of unscheduled gates of the block
+  std::array<size_t, 2> position{};
+};
+} // namespace
+
+ListScheduler::ListScheduler(const Architecture& architecture,
+                             const Config& config)
+    : architecture_(architecture), config_(config) {
+  // calculate the maximum possible number of two-qubit gates per layer
+  for (const auto& zone : architecture_.get().entanglementZones) {
+    maxTwoQubitGateNumPerLayer_ += zone->front().nRows * zone->front().nCols;
+  }
+  if (maxTwoQubitGateNumPerLayer_ == 0) {
+    throw std::invalid_argument("Architecture must contain at least one site "
+                                "in an entanglement zone");
+  }
+}
+auto ListScheduler::schedule(const qc::QuantumComputation& qc) const
+    -> std::pair<std::vector<SingleQubitGateLayer>,
+                 std::vector<TwoQubitGateLayer>> {
+  if (qc.empty()) {
+    // early exit if there are no operations to schedule
+    return std::pair{std::vector<SingleQubitGateLayer>{},
+                     std::vector<TwoQubitGateLayer>{}};
+  }
+  const auto nQubits = qc.getNqubits();
+  //===--------------------------------------------------------------------===//
+  // Split the operations into the sequences of every qubit
+  //===--------------------------------------------------------------------===//
+  std::vector<std::vector<Entry>> entries(nQubits);
+  std::vector<Gate> gates;
+  // the unscheduled CZ gates of every block of every qubit
+  std::vector<std::vector<std::vector<size_t>>> blocks(
+      nQubits, std::vector<std::vector<size_t>>(1));
+  const auto synchronize = [&](const qc::Operation* op) {
+    for (qc::Qubit q = 0; q < nQubits; ++q) {
+      entries[q].emplace_back(Entry{Entry::Kind::Synchronization, op});
+      blocks[q].emplace_back();
+    }
+  };
+  for (const auto& op : qc) {
+    if (op->getType() == qc::Barrier) {
+      if (op->getNqubits() < nQubits) {
+        throw std::invalid_argument("Only global barriers are allowed.");
+      }
+      synchronize(nullptr);
+    } else if (op->isGlobal(nQubits) && !op->isControlled() && nQubits > 1) {
+      synchronize(op.get());
+    } else if (op->isStandardOperation()) {
+      const auto& stdOp = dynamic_cast<qc::StandardOperation&>(*op);
+      if (stdOp.getNtargets() == 1 && stdOp.getNcontrols() == 0) {
+        const auto q = stdOp.getTargets().front();
+        if (isDiagonal(stdOp.getType())) {
+          entries[q].emplace_back(Entry{Entry::Kind::Diagonal, &stdOp});
+        } else {
+          entries[q].emplace_back(Entry{Entry::Kind::NonDiagonal, &stdOp});
+          blocks[q].emplace_back();
+        }
+      } else if (stdOp.getType() == qc::Z && stdOp.getNtargets() == 1 &&
+                 stdOp.getNcontrols() == 1) {
+        const auto qubit1 = stdOp.getTargets().front();
+        const auto qubit2 = stdOp.getControls().cbegin()->qubit;
+        auto& gate = gates.emplace_back(
+            Gate{{std::min(qubit1, qubit2), std::max(qubit1, qubit2)}});
+        for (size_t i = 0; i < 2; ++i) {
+          const auto q = gate.qubits[i];
+          gate.block[i] = blocks[q].size() - 1;
+          gate.position[i] = blocks[q].back().size();
+          blocks[q].back().emplace_back(gates.size() - 1);
+          entries[q].emplace_back(
+              Entry{Entry::Kind::TwoQubitGate, nullptr, gates.size() - 1});
+        }
+      } else {
+        std::stringstream ss;
+        ss << "Operation type not supported: " << stdOp.getType() << " with "
+           << stdOp.getNcontrols() << " controls and " << stdOp.getNtargets()
+           << " targets";
+        throw std::invalid_argument(ss.str());
+      }
+    } else {
+      std::stringstream ss;
+      ss << "Operation type not supported: " << op->getType() << " with "
+         << op->getNcontrols() << " controls and " << op->getNtargets()
+         << " targets";
+      throw std::invalid_argument(ss.str());
+    }
+  }
+  //===--------------------------------------------------------------------===//
+  // Schedule the operations layer by layer
+  //===--------------------------------------------------------------------===//
+  std::vector<SingleQubitGateLayer> singleQubitGateLayers(1);
+  std::vector<TwoQubitGateLayer> twoQubitGateLayers(0);
+  // the next entry to process and the current block of every qubit
+  std::vector<size_t> nextEntry(nQubits, 0);
+  std::vector<size_t> currentBlock(nQubits, 0);
+  //===--------------------------------------------------------------------===//
+  // Compute a lower bound for the number of layers required from every block
+  //===--------------------------------------------------------------------===//
+  // for every qubit and block, the minimum number of layers required to
+  // execute all CZ gates of the qubit starting from that block; a block
+  // requires one layer per CZ gate, and every CZ gate must precede the gates
+  // of the subsequent blocks of both of its qubits
+  std::vector<std::vector<size_t>> requiredLayers(nQubits);
+  // the blocks of every qubit up to this one have not yet been initialized
+  std::vector<size_t> initializedFrom(nQubits);
+  for (qc::Qubit q = 0; q < nQubits; ++q) {
+    requiredLayers[q].assign(blocks[q].size() + 1, 0);
+    initializedFrom[q] = blocks[q].size();
+  }
+  const auto initializeFrom = [&](const qc::Qubit q, const size_t block) {
+    auto& b = initializedFrom[q];
+    while (b > block) {
+      --b;
+      requiredLayers[q][b] = blocks[q][b].size() + requiredLayers[q][b + 1];
+    }
+  };
+  // the gates are processed in reverse order such that all gates of the
+  // subsequent blocks have already been considered
+  for (auto g = gates.size(); g-- > 0;) {
+    const auto& [qubits, block, _] = gates[g];
+    initializeFrom(qubits.front(), block.front());
+    initializeFrom(qubits.back(), block.back());
+    auto& first = requiredLayers[qubits.front()][block.front()];
+    auto& second = requiredLayers[qubits.back()][block.back()];
+    first =
+        std::max(first, 1 + requiredLayers[qubits.back()][block.back() + 1]);
+    second =
+        std::max(second, 1 + requiredLayers[qubits.front()][block.front() + 1]);
+  }
+  // advances a qubit until it reaches a synchronization or the end of a block
+  // that still contains unscheduled CZ gates and returns true if the qubit
+  // waits at a synchronization
+  const auto advance = [&](const qc::Qubit q) {
+    const auto& qubitEntries = entries[q];
+    auto& i = nextEntry[q];
+    for (; i < qubitEntries.size(); ++i) {
+      const auto& entry = qubitEntries[i];
+      if (entry.kind == Entry::Kind::Diagonal) {
+        // diagonal gates commute with all CZ gates of the block
+        singleQubitGateLayers.back().emplace_back(*entry.op);
+      } else if (entry.kind != Entry::Kind::TwoQubitGate) {
+        if (!blocks[q][currentBlock[q]].empty()) {
+          return false;
+        }
+        if (entry.kind == Entry::Kind::Synchronization) {
+          return true;
+        }
+        singleQubitGateLayers.back().emplace_back(*entry.op);
+        ++currentBlock[q];
+      }
+    }
+    return false;
+  };
+  // advances all qubits as far as possible and releases synchronizations
+  // that all qubits are waiting at
+  const auto advanceAll = [&] {
+    for (;;) {
+      bool allWaiting = true;
+      for (qc::Qubit q = 0; q < nQubits; ++q) {
+        allWaiting &= advance(q);
+      }
+      if (!allWaiting) {
+        break;
+      }
+      // all qubits wait at the same synchronization since every qubit
+      // contains all synchronizations in the same order
+      if (const auto* op = entries.front()[nextEntry.front()].op;
+          op != nullptr) {
+        singleQubitGateLayers.back().emplace_back(*op);
+      }
+      for (qc::Qubit q = 0; q < nQubits; ++q) {
+        ++nextEntry[q];
+        ++currentBlock[q];
+      }
+    }
+  };
+  const auto removeFromBlock = [&](const size_t g) {
+    const auto& gate = gates[g];
+    for (size_t i = 0; i < 2; ++i) {
+      auto& block = blocks[gate.qubits[i]][gate.block[i]];
+      const auto last = block.back();
+      const auto side = gates[last].qubits.front() == gate.qubits[i] ? 0 : 1;
+      gates[last].position[side] = gate.position[i];
+      block[gate.position[i]] = last;
+      block.pop_back();
+    }
+  };
+  // whether a qubit is involved in a CZ gate of the previous layer
+  std::vector<bool> inPreviousLayer(nQubits, false);
+  std::vector<bool> inCurrentLayer(nQubits, false);
+  // candidates as tuples of the negated priority, the negated number of layers
+  // required after the gate, and the gate index such that sorting them yields
+  // the order in which they are considered
+  std::vector<std::tuple<double, double, size_t>> candidates;
+  for (size_t nScheduled = 0; nScheduled < gates.size();) {
+    advanceAll();
+    candidates.clear();
+    for (qc::Qubit q = 0; q < nQubits; ++q) {
+      for (const auto g : blocks[q][currentBlock[q]]) {
+        const auto& [q1, q2] = gates[g].qubits;
+        // every gate is collected from its first qubit if it is also in the
+        // current block of its second qubit
+        if (q == q1 && gates[g].block[1] == currentBlock[q2]) {
+          // the number of layers still required by the qubits
+          const auto required1 = blocks[q1][currentBlock[q1]].size() +
+                                 requiredLayers[q1][currentBlock[q1] + 1];
+          const auto required2 = blocks[q2][currentBlock[q2]].size() +
+                                 requiredLayers[q2][currentBlock[q2] + 1];
+          const auto priority =
+              static_cast<double>(std::max(required1, required2)) +
+              (config_.reuseWeight *
+               static_cast<double>(static_cast<int>(inPreviousLayer[q1]) +
+                                   static_cast<int>(inPreviousLayer[q2])));
+          // the number of layers required after the gate breaks ties
+          const auto after = std::max(requiredLayers[q1][currentBlock[q1] + 1],
+                                      requiredLayers[q2][currentBlock[q2] + 1]);
+          candidates.emplace_back(-priority, -static_cast<double>(after), g);
+        }
+      }
+    }
+    // the earliest unscheduled CZ gate is always a candidate
+    assert(!candidates.empty());
+    std::sort(candidates.begin(), candidates.end());
+    auto& layer = twoQubitGateLayers.emplace_back();
+    std::fill(inCurrentLayer.begin(), inCurrentLayer.end(), false);
+    for (const auto& candidate : candidates) {
+      const auto g = std::get<2>(candidate);
+      if (layer.size() >= maxTwoQubitGateNumPerLayer_) {
+        break;
+      }
+      const auto& [q1, q2] = gates[g].qubits;
+      if (!inCurrentLayer[q1] && !inCurrentLayer[q2]) {
+        layer.emplace_back(gates[g].qubits);
+        inCurrentLayer[q1] = true;
+        inCurrentLayer[q2] = true;
+        removeFromBlock(g);
+      }
+    }
+    nScheduled += layer.size();
+    std::swap(inPreviousLayer, inCurrentLayer);
+    singleQubitGateLayers.emplace_back();
+  }
+  // schedule the remaining single-qubit operations
+  advanceAll();
+  return std::pair{singleQubitGateLayers, twoQubitGateLayers};
+}
+} // namespace na::zoned
@@ -524,22 +524,20 @@ number of variables: (|L|-1) * m!
           varIDs.emplace_back(x[k][i][j]);
         }
         if (config.commanderGrouping == CommanderGrouping::Fixed2) {
-          lb->assertFormula(
-              encodings::atMostOneCmdr(encodings::groupVars(varIDs, 2),
-                                       LogicTerm::noneTerm(), lb.get()));
+          encodings::addAtMostOneCmdr(encodings::groupVars(varIDs, 2),
+                                      LogicTerm::noneTerm(), lb.get());
         } else if (config.commanderGrouping == CommanderGrouping::Fixed3) {
-          lb->assertFormula(
-              encodings::atMostOneCmdr(encodings::groupVars(varIDs, 3),
-                                       LogicTerm::noneTerm(), lb.get()));
+          encodings::addAtMostOneCmdr(encodings::groupVars(varIDs, 3),
+                                      LogicTerm::noneTerm(), lb.get());
         } else if (config.commanderGrouping == CommanderGrouping::Logarithm) {
-          lb->assertFormula(encodings::atMostOneCmdr(
+          encodings::addAtMostOneCmdr(
               encodings::groupVars(
                   varIDs, static_cast<std::size_t>(std::log(varIDs.size()))),
-              LogicTerm::noneTerm(), lb.get()));
+              LogicTerm::noneTerm(), lb.get());
         } else if (config.commanderGrouping == CommanderGrouping::Halves) {
-          lb->assertFormula(encodings::atMostOneCmdr(
+          encodings::addAtMostOneCmdr(
               encodings::groupVars(varIDs, varIDs.size() / 2),
-              LogicTerm::noneTerm(), lb.get()));
+              LogicTerm::noneTerm(), lb.get());
         }
       }
 
@@ -551,22 +549,20 @@ number of variables: (|L|-1) * m!
         }
 
         if (config.commanderGrouping == CommanderGrouping::Fixed2) {
-          lb->assertFormula(
-              encodings::exactlyOneCmdr(encodings::groupVars(varIDs, 2),
-                                        LogicTerm::noneTerm(), lb.get()));
+          encodings::addExactlyOneCmdr(encodings::groupVars(varIDs, 2),
+                                       LogicTerm::noneTerm(), lb.get());
         } else if (config.commanderGrouping == CommanderGrouping::Fixed3) {
-          lb->assertFormula(
-              encodings::exactlyOneCmdr(encodings::groupVars(varIDs, 3),
-                                        LogicTerm::noneTerm(), lb.get()));
+          encodings::addExactlyOneCmdr(encodings::groupVars(varIDs, 3),
+                                       LogicTerm::noneTerm(), lb.get());
         } else if (config.commanderGrouping == CommanderGrouping::Logarithm) {
-          lb->assertFormula(encodings::exactlyOneCmdr(
+          encodings::addExactlyOneCmdr(
               encodings::groupVars(
                   varIDs, static_cast<std::size_t>(std::log(varIDs.size()))),
-              LogicTerm::noneTerm(), lb.get()));
+              LogicTerm::noneTerm(), lb.get());
         } else if (config.commanderGrouping == CommanderGrouping::Halves) {
-          lb->assertFormula(encodings::exactlyOneCmdr(
+          encodings::addExactlyOneCmdr(
               encodings::groupVars(varIDs, varIDs.size() / 2),
-              LogicTerm::noneTerm(), lb.get()));
+              LogicTerm::noneTerm(), lb.get());
         }
       }
     }
@@ -581,7 +577,7 @@ number of variables: (|L|-1) * m!
           vars.emplace_back(x[k][i][j]);
           varIDs.emplace_back(j);
         }
-        lb->assertFormula(encodings::atMostOneBiMander(vars, lb.get()));
+        encodings::addAtMostOneBiMander(vars, lb.get());
       }
 
       for (std::size_t j = 0; j < qc.getNqubits();
@@ -593,22 +589,20 @@ number of variables: (|L|-1) * m!
         }
 
         if (config.commanderGrouping == CommanderGrouping::Fixed2) {
-          lb->assertFormula(
-              encodings::exactlyOneCmdr(encodings::groupVars(varIDs, 2),
-                                        LogicTerm::noneTerm(), lb.get()));
+          encodings::addExactlyOneCmdr(encodings::groupVars(varIDs, 2),
+                                       LogicTerm::noneTerm(), lb.get());
         } else if (config.commanderGrouping == CommanderGrouping::Fixed3) {
-          lb->assertFormula(
-              encodings::exactlyOneCmdr(encodings::groupVars(varIDs, 3),
-                                        LogicTerm::noneTerm(), lb.get()));
+          encodings::addExactlyOneCmdr(encodings::groupVars(varIDs, 3),
+                                       LogicTerm::noneTerm(), lb.get());
         } else if (config.commanderGrouping == CommanderGrouping::Logarithm) {
-          lb->assertFormula(encodings::exactlyOneCmdr(
+          encodings::addExactlyOneCmdr(
               encodings::groupVars(
                   varIDs, static_cast<std::size_t>(std::log(varIDs.size()))),
-              LogicTerm::noneTerm(), lb.get()));
+              LogicTerm::noneTerm(), lb.get());
         } else if (config.commanderGrouping == CommanderGrouping::Halves) {
-          lb->assertFormula(encodings::exactlyOneCmdr(
+          encodings::addExactlyOneCmdr(
               encodings::groupVars(varIDs, varIDs.size() / 2),
-              LogicTerm::noneTerm(), lb.get()));
+              LogicTerm::noneTerm(), lb.get());
         }
       }
     }
@@ -704,20 +698,20 @@ number of variables: (|L|-1) * m!
         ++piCount;
       } while (std::ranges::next_permutation(pi).found);
       if (config.commanderGrouping == CommanderGrouping::Fixed2) {
-        lb->assertFormula(encodings::exactlyOneCmdr(
-            encodings::groupVars(varIDs, 2), LogicTerm::noneTerm(), lb.get()));
+        encodings::addExactlyOneCmdr(encodings::groupVars(varIDs, 2),
+                                     LogicTerm::noneTerm(), lb.get());
       } else if (config.commanderGrouping == CommanderGrouping::Fixed3) {
-        lb->assertFormula(encodings::exactlyOneCmdr(
-            encodings::groupVars(varIDs, 3), LogicTerm::noneTerm(), lb.get()));
+        encodings::addExactlyOneCmdr(encodings::groupVars(varIDs, 3),
+                                     LogicTerm::noneTerm(), lb.get());
       } else if (config.commanderGrouping == CommanderGrouping::Logarithm) {
-        lb->assertFormula(encodings::exactlyOneCmdr(
+        encodings::addExactlyOneCmdr(
             encodings::groupVars(
                 varIDs, static_cast<std::size_t>(std::log(varIDs.size()))),
-            LogicTerm::noneTerm(), lb.get()));
+            LogicTerm::noneTerm(), lb.get());
       } else if (config.commanderGrouping == CommanderGrouping::Halves) {
-        lb->assertFormula(encodings::exactlyOneCmdr(
+        encodings::addExactlyOneCmdr(
             encodings::groupVars(varIDs, varIDs.size() / 2),
-            LogicTerm::noneTerm(), lb.get()));
+            LogicTerm::noneTerm(), lb.get());
       }
     }
   }
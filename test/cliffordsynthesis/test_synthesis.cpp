@@ -21,6 +21,7 @@
 #include <iostream>
 #include <limits>
 #include <plog/Severity.h>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -188,6 +189,64 @@ TEST_P(SynthesisTest, GatesLinearSearch) {
   EXPECT_EQ(results.getGates(), test.expectedMinimalGates);
 }
 
+TEST_P(SynthesisTest, GatesGreedyUpperBound) {
+  config.target = TargetMetric::Gates;
+  config.greedyUpperBound = true;
+  synthesizer.synthesize(config);
+  results = synthesizer.getResults();
+
+  EXPECT_EQ(results.getGates(), test.expectedMinimalGates);
+}
+
+TEST_P(SynthesisTest, GatesPortfolio) {
+  config.target = TargetMetric::Gates;
+  config.portfolio = true;
+  config.portfolioSolverParameters = {{{"sat.random_seed", 42U}}};
+  synthesizer.synthesize(config);
+  results = synthesizer.getResults();
+
+  EXPECT_EQ(results.getGates(), test.expectedMinimalGates);
+}
+
+TEST_P(SynthesisTest, DepthPortfolio) {
+  config.target = TargetMetric::Depth;
+  config.portfolio = true;
+  synthesizer.synthesize(config);
+  results = synthesizer.getResults();
+
+  EXPECT_EQ(results.getDepth(), test.expectedMinimalDepth);
+}
+
+TEST_P(SynthesisTest, Greedy) {
+  config.greedy = true;
+  synthesizer.synthesize(config);
+  results = synthesizer.getResults();
+
+  EXPECT_TRUE(results.sat());
+  EXPECT_GE(results.getGates(), test.expectedMinimalGates);
+  EXPECT_EQ(results.getSolverCalls(), 0U);
+
+  // the greedy synthesis reports the target tableau as its result, hence, the
+  // circuit is checked against the target tableau directly
+  auto circuitTableau = initialTableau;
+  for (const auto& gate : synthesizer.getResultCircuit()) {
+    circuitTableau.applyGate(gate.get());
+  }
+  EXPECT_EQ(circuitTableau, targetTableau);
+
+  if (!initialTableauWithDestabilizer.getTableau().empty()) {
+    synthesizerWithDestabilizer.synthesize(config);
+    resultsWithDestabilizer = synthesizerWithDestabilizer.getResults();
+    EXPECT_TRUE(resultsWithDestabilizer.sat());
+
+    auto circuitTableauWithDestabilizer = initialTableauWithDestabilizer;
+    for (const auto& gate : synthesizerWithDestabilizer.getResultCircuit()) {
+      circuitTableauWithDestabilizer.applyGate(gate.get());
+    }
+    EXPECT_EQ(circuitTableauWithDestabilizer, targetTableauWithDestabilizer);
+  }
+}
+
 TEST_P(SynthesisTest, Depth) {
   config.target = TargetMetric::Depth;
   synthesizer.synthesize(config);
@@ -426,4 +485,105 @@ TEST(HeuristicTest, fourLayers) {
   synth.synthesize(config);
   EXPECT_EQ(synth.getResults().getDepth(), 2);
 }
+
+TEST(HeuristicTest, iterativeAcrossSeams) {
+  auto config = Configuration();
+  auto qc = qc::QuantumComputation(1);
+  for (std::size_t i = 0U; i < 6U; ++i) {
+    qc.s(0);
+  }
+  config.heuristic = true;
+  config.splitSize = 2;
+  config.target = TargetMetric::Depth;
+  auto synth = CliffordSynthesizer(qc);
+  synth.synthesize(config);
+  EXPECT_EQ(synth.getResults().getDepth(), 3);
+
+  // the shifted windows of the second pass merge the Z gates across the seams
+  config.iterativeHeuristic = true;
+  auto iterativeSynth = CliffordSynthesizer(qc);
+  iterativeSynth.synthesize(config);
+  EXPECT_EQ(iterativeSynth.getResults().getDepth(), 1);
+}
+
+TEST(HeuristicTest, iterativeMaxPasses) {
+  auto config = Configuration();
+  auto qc = qc::QuantumComputation(1);
+  for (std::size_t i = 0U; i < 6U; ++i) {
+    qc.s(0);
+  }
+  config.heuristic = true;
+  config.iterativeHeuristic = true;
+  config.splitSize = 2;
+  config.target = TargetMetric::Depth;
+
+  // the Z gates are only merged across the seams in the second pass
+  config.heuristicMaxPasses = 1U;
+  auto onePassSynth = CliffordSynthesizer(qc);
+  onePassSynth.synthesize(config);
+  EXPECT_EQ(onePassSynth.getResults().getDepth(), 3);
+
+  config.heuristicMaxPasses = 2U;
+  auto twoPassSynth = CliffordSynthesizer(qc);
+  twoPassSynth.synthesize(config);
+  EXPECT_EQ(twoPassSynth.getResults().getDepth(), 1);
+}
+
+TEST(HeuristicTest, iterativeTimeLimit) {
+  auto config = Configuration();
+  auto qc = qc::QuantumComputation(1);
+  for (std::size_t i = 0U; i < 6U; ++i) {
+    qc.s(0);
+  }
+  config.heuristic = true;
+  config.iterativeHeuristic = true;
+  config.splitSize = 2;
+  config.target = TargetMetric::Depth;
+
+  // the time limit is exceeded by the first pass, which is always completed
+  config.heuristicTimeLimit = 1e-9;
+  auto synth = CliffordSynthesizer(qc);
+  synth.synthesize(config);
+  EXPECT_EQ(synth.getResults().getDepth(), 3);
+}
+
+TEST(GreedyTest, largeCircuit) {
+  constexpr std::size_t nQubits = 100U;
+  auto qc = qc::QuantumComputation(nQubits);
+  std::mt19937 rng(12345U);
+  std::uniform_int_distribution<std::size_t> qubitDist(0U, nQubits - 1U);
+  std::uniform_int_distribution<std::size_t> gateDist(0U, 3U);
+  for (std::size_t i = 0U; i < 2000U; ++i) {
+    const auto q = static_cast<qc::Qubit>(qubitDist(rng));
+    switch (gateDist(rng)) {
+    case 0U:
+      qc.h(q);
+      break;
+    case 1U:
+      qc.s(q);
+      break;
+    default:
+      const auto t = static_cast<qc::Qubit>(qubitDist(rng));
+      if (t != q) {
+        qc.cx(qc::Control{q}, t);
+      }
+      break;
+    }
+  }
+  const auto targetTableau =
+      Tableau(qc, 0, std::numeric_limits<std::size_t>::max(), true);
+
+  auto config = Configuration();
+  config.greedy = true;
+  auto synth = CliffordSynthesizer(qc, true);
+  synth.synthesize(config);
+  EXPECT_TRUE(synth.getResults().sat());
+  EXPECT_EQ(synth.getResultTableau(), targetTableau);
+
+  auto circuitTableau = Tableau(nQubits, true);
+  for (const auto& gate : synth.getResultCircuit()) {
+    circuitTableau.applyGate(gate.get());
+  }
+  EXPECT_EQ(circuitTableau, targetTableau);
+}
 } // namespace cs
@@ -14,11 +14,15 @@
 #include "Model.hpp"
 #include "Z3Logic.hpp"
 
+#include <chrono>
 #include <cstddef>
 #include <gtest/gtest.h>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <vector>
 #include <z3++.h>
 
@@ -469,6 +473,67 @@ TEST_F(TestZ3, AMOAndExactlyOneBimander) {
   z3logic.reset();
 }
 
+TEST_F(TestZ3, DirectClauseEncodings) {
+  using namespace encodings;
+
+  constexpr size_t n = 9;
+  // checks the encoding with exactly the variables in trueVars set to true
+  const auto checkTrue = [&n](const auto& encode,
+                              const std::set<size_t>& trueVars) {
+    auto c = std::make_shared<z3::context>();
+    auto z3logic = std::make_unique<z3logic::Z3LogicBlock>(
+        c, std::make_shared<z3::solver>(*c), false);
+    std::vector<LogicTerm> vars;
+    for (size_t i = 0; i < n; ++i) {
+      vars.emplace_back(
+          z3logic->makeVariable("a_" + std::to_string(i), CType::BOOL));
+    }
+    encode(vars, z3logic.get());
+    for (size_t i = 0; i < n; ++i) {
+      z3logic->addClause({trueVars.contains(i) ? vars[i] : !vars[i]});
+    }
+    return z3logic->solve();
+  };
+  // checks the encoding with the first nTrue variables set to true
+  const auto check = [&checkTrue](const auto& encode, const size_t nTrue) {
+    std::set<size_t> trueVars;
+    for (size_t i = 0; i < nTrue; ++i) {
+      trueVars.emplace(i);
+    }
+    return checkTrue(encode, trueVars);
+  };
+
+  const auto eo = [](const std::vector<LogicTerm>& vars, LogicBlock* lb) {
+    addExactlyOneCmdr(groupVars(vars, 3), LogicTerm::noneTerm(), lb);
+  };
+  EXPECT_EQ(check(eo, 0), Result::UNSAT);
+  EXPECT_EQ(check(eo, 1), Result::SAT);
+  EXPECT_EQ(check(eo, 2), Result::UNSAT);
+
+  const auto amo = [](const std::vector<LogicTerm>& vars, LogicBlock* lb) {
+    addAtMostOneCmdr(groupVars(vars, 2), LogicTerm::noneTerm(), lb);
+  };
+  EXPECT_EQ(check(amo, 0), Result::SAT);
+  EXPECT_EQ(check(amo, 1), Result::SAT);
+  EXPECT_EQ(check(amo, 2), Result::UNSAT);
+
+  const auto bimander = [](const std::vector<LogicTerm>& vars,
+                           LogicBlock* lb) { addAtMostOneBiMander(vars, lb); };
+  EXPECT_EQ(check(bimander, 1), Result::SAT);
+  EXPECT_EQ(check(bimander, 2), Result::UNSAT);
+  // the 9 variables are split into the groups {0, 1}, {2, 3}, {4, 5}, {6, 7},
+  // and {8}, the first two variables are in the same group
+  EXPECT_EQ(checkTrue(bimander, {8}), Result::SAT);
+  EXPECT_EQ(checkTrue(bimander, {0, 2}), Result::UNSAT);
+  EXPECT_EQ(checkTrue(bimander, {3, 6}), Result::UNSAT);
+  EXPECT_EQ(checkTrue(bimander, {0, 8}), Result::UNSAT);
+
+  const auto atMostThree = [](const std::vector<LogicTerm>& vars,
+                              LogicBlock* lb) { addAtMostK(vars, 3, lb); };
+  EXPECT_EQ(check(atMostThree, 3), Result::SAT);
+  EXPECT_EQ(check(atMostThree, 4), Result::UNSAT);
+}
+
 TEST_F(TestZ3, TestBasicModel) {
   auto z3logic = std::make_unique<z3logic::Z3LogicBlock>(ctx, solver, false);
 
@@ -493,6 +558,62 @@ TEST_F(TestZ3, TestBasicModel) {
   z3logic.reset();
 }
 
+TEST_F(TestZ3, HashConsing) {
+  z3logic::Z3LogicBlock z3logic(ctx, solver, false);
+
+  const LogicTerm a = z3logic.makeVariable("a", CType::BOOL);
+  const LogicTerm b = z3logic.makeVariable("b", CType::BOOL);
+  const LogicTerm c = z3logic.makeVariable("c", CType::INT);
+
+  // structurally equal terms share their id and their children
+  const auto t1 = (a || b) && (c == LogicTerm(1));
+  const auto t2 = (a || b) && (c == LogicTerm(1));
+  EXPECT_EQ(t1.getID(), t2.getID());
+  EXPECT_EQ(&t1.getNodes(), &t2.getNodes());
+  EXPECT_TRUE(t1.deepEquals(t2));
+
+  // different operands or constants lead to different terms
+  EXPECT_NE((c == LogicTerm(1)).getID(), (c == LogicTerm(2)).getID());
+  EXPECT_NE((a || b).getID(), (b || a).getID());
+  EXPECT_FALSE((a || b).deepEquals(a && b));
+
+  z3logic.assertFormula(t1);
+  z3logic.assertFormula(!a);
+  z3logic.produceInstance();
+  EXPECT_EQ(z3logic.solve(), Result::SAT);
+  EXPECT_TRUE(z3logic.getModel()->getBoolValue(b, &z3logic));
+
+  // the table is cleared upon reset
+  z3logic.reset();
+  const LogicTerm x = z3logic.makeVariable("x", CType::BOOL);
+  const LogicTerm y = z3logic.makeVariable("y", CType::BOOL);
+  z3logic.assertFormula(x && !x && y);
+  z3logic.produceInstance();
+  EXPECT_EQ(z3logic.solve(), Result::UNSAT);
+}
+
+TEST_F(TestZ3, CacheDistinguishesLogics) {
+  z3logic::Z3LogicBlock z3logic(ctx, solver, true);
+
+  const LogicTerm a = z3logic.makeVariable("a", CType::BOOL);
+  const LogicTerm b = z3logic.makeVariable("b", CType::BOOL);
+  const auto conjunction = a && b;
+  std::ignore = z3logic.convert(conjunction, CType::BOOL);
+
+  // a term without logic takes its id from the global counter and may share
+  // its id with a term of the logic block
+  LogicTerm::reset();
+  auto disjunction = LogicTerm(OpType::OR, a, b, CType::BOOL, nullptr);
+  while (disjunction.getID() < conjunction.getID()) {
+    disjunction = LogicTerm(OpType::OR, a, b, CType::BOOL, nullptr);
+  }
+  ASSERT_EQ(disjunction.getID(), conjunction.getID());
+  z3logic.assertFormula(disjunction);
+  z3logic.assertFormula(!a);
+  z3logic.produceInstance();
+  EXPECT_EQ(z3logic.solve(), Result::SAT);
+}
+
 TEST_F(TestZ3, TestVariableConversionsToBool) {
   auto z3logic = std::make_unique<z3logic::Z3LogicBlock>(ctx, solver, true);
 
@@ -559,6 +680,96 @@ TEST_F(TestZ3, TestVariableConversionsToReal) {
   z3logic.reset();
 }
 
+TEST_F(TestZ3, InterruptBeforeSolve) {
+  z3logic::Z3LogicBlock z3logic(ctx, solver, false);
+
+  const LogicTerm a = z3logic.makeVariable("a", CType::BOOL);
+  z3logic.assertFormula(a);
+  // the interrupt arrives before the solver is started and must not be lost
+  z3logic.interrupt();
+  EXPECT_EQ(z3logic.solve(), Result::NDEF);
+  // the interrupt is still pending in the context and must be cleared
+  z3logic.reset();
+
+  const LogicTerm b = z3logic.makeVariable("b", CType::BOOL);
+  z3logic.assertFormula(b);
+  EXPECT_EQ(z3logic.solve(), Result::SAT);
+}
+
+namespace {
+// Adds the pigeonhole problem with one pigeon more than holes. It is
+// unsatisfiable, but the solver needs several seconds to prove it for ten
+// holes.
+void addPigeonhole(LogicBlock& lb, const size_t holes) {
+  std::vector<LogicVector> inHole(holes + 1);
+  for (size_t p = 0; p <= holes; ++p) {
+    for (size_t h = 0; h < holes; ++h) {
+      inHole[p].emplace_back(lb.makeVariable(
+          "p_" + std::to_string(p) + "_" + std::to_string(h), CType::BOOL));
+    }
+    lb.addClause(inHole[p]);
+  }
+  for (size_t h = 0; h < holes; ++h) {
+    for (size_t p = 0; p <= holes; ++p) {
+      for (size_t q = p + 1; q <= holes; ++q) {
+        lb.addClause({!inHole[p][h], !inHole[q][h]});
+      }
+    }
+  }
+}
+} // namespace
+
+TEST_F(TestZ3, TimeoutIsUndefined) {
+  z3logic::Z3LogicBlock z3logic(ctx, solver, false);
+  solver->set("timeout", 1U);
+
+  addPigeonhole(z3logic, 10);
+  // an unknown result must not be mistaken for a proof of unsatisfiability
+  EXPECT_EQ(z3logic.solve(), Result::NDEF);
+}
+
+TEST_F(TestZ3, InterruptRunningSolve) {
+  z3logic::Z3LogicBlock z3logic(ctx, solver, false);
+
+  addPigeonhole(z3logic, 10);
+  std::thread interrupter([&z3logic] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    z3logic.interrupt();
+  });
+  const auto start = std::chrono::steady_clock::now();
+  const auto result = z3logic.solve();
+  const auto duration = std::chrono::steady_clock::now() - start;
+  interrupter.join();
+  EXPECT_EQ(result, Result::NDEF);
+  EXPECT_LT(duration, std::chrono::seconds(2));
+
+  // the logic block and its context are reusable after the reset
+  z3logic.reset();
+  const LogicTerm a = z3logic.makeVariable("a", CType::BOOL);
+  z3logic.assertFormula(a);
+  EXPECT_EQ(z3logic.solve(), Result::SAT);
+  EXPECT_TRUE(z3logic.getModel()->getBoolValue(a, &z3logic));
+}
+
+TEST_F(TestZ3, InterruptDuringEncoding) {
+  z3logic::Z3LogicBlock z3logic(ctx, solver, true);
+
+  const LogicTerm a = z3logic.makeVariable("a", CType::BOOL);
+  const LogicTerm b = z3logic.makeVariable("b", CType::BOOL);
+  z3logic.addClause({a, b});
+  z3logic.interrupt();
+  // Z3 throws on every operation of the interrupted context, the encoding
+  // must nevertheless finish and report the interrupt as an undefined result
+  EXPECT_NO_THROW(z3logic.addClause({!a, !b}));
+  EXPECT_NO_THROW(z3logic.assertFormula(a || !b));
+  EXPECT_EQ(z3logic.solve(), Result::NDEF);
+  z3logic.reset();
+
+  const LogicTerm c = z3logic.makeVariable("c", CType::BOOL);
+  z3logic.addClause({c});
+  EXPECT_EQ(z3logic.solve(), Result::SAT);
+}
+
 class TestZ3Opt : public testing::TestWithParam<logicbase::OpType> {
 protected:
   void SetUp() override {}
@@ -14,12 +14,19 @@
 #include "qasm3/Importer.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <gtest/gtest.h>
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <stdexcept>
+#include <string>
+#include <thread>
 #include <tuple>
+#include <utility>
+#include <vector>
+#include <z3++.h>
 
 TEST(Solver, SteaneDoubleSidedStorage) {
   const auto& circ =
@@ -102,6 +109,146 @@ TEST(Solver, SteaneBottomStorage) {
   }
 }
 
+TEST(Solver, OptimalSteaneBottomStorage) {
+  const auto& circ =
+      qasm3::Importer::importf(TEST_CIRCUITS_PATH "/steane.qasm");
+  // create solver
+  na::NASolver solver(3, 7, 2, 3, 2, 2, 2, 2, 0, 4);
+  // get operations for solver
+  const auto& pairs = na::NASolver::getOpsForSolver(circ, qc::Z, 1, true);
+  // solve, the instance is unsatisfiable for 4 stages, see above
+  const auto result = solver.solveOptimal(
+      pairs, static_cast<uint16_t>(circ.getNqubits()), 6, false, true);
+  EXPECT_TRUE(result.sat);
+  EXPECT_EQ(result.stages.size(), 5);
+  std::size_t numGates = 0;
+  for (const auto& stage : result.stages) {
+    numGates += stage.gates.size();
+    if (!stage.rydberg) {
+      EXPECT_TRUE(stage.gates.empty());
+    }
+  }
+  EXPECT_EQ(numGates, pairs.size());
+  // with at most four stages, there is no solution
+  const auto resultUnsat = solver.solveOptimal(
+      pairs, static_cast<uint16_t>(circ.getNqubits()), 4, false, true);
+  EXPECT_FALSE(resultUnsat.sat);
+}
+
+TEST(Solver, OptimalMinimalTransfers) {
+  const auto& circ =
+      qasm3::Importer::importf(TEST_CIRCUITS_PATH "/steane.qasm");
+  // create solver
+  na::NASolver solver(3, 7, 2, 3, 2, 2, 2, 2, 2, 4);
+  // get operations for solver
+  const auto& pairs = na::NASolver::getOpsForSolver(circ, qc::Z, 1, true);
+  // solve
+  const auto result = solver.solveOptimal(
+      pairs, static_cast<uint16_t>(circ.getNqubits()), 5, false, true);
+  EXPECT_TRUE(result.sat);
+  EXPECT_EQ(result.stages.size(), 4);
+  const auto numTransfers = static_cast<uint16_t>(
+      std::count_if(result.stages.cbegin(), result.stages.cend(),
+                    [](const auto& stage) { return !stage.rydberg; }));
+  // one less transfer stage is not possible with four stages
+  if (numTransfers > 0) {
+    EXPECT_FALSE(solver
+                     .solve(pairs, static_cast<uint16_t>(circ.getNqubits()), 4,
+                            numTransfers - 1, false, true)
+                     .sat);
+  }
+}
+
+TEST(Solver, ParallelSteaneBottomStorage) {
+  const auto& circ =
+      qasm3::Importer::importf(TEST_CIRCUITS_PATH "/steane.qasm");
+  // create solver
+  na::NASolver solver(3, 7, 2, 3, 2, 2, 2, 2, 0, 4);
+  // get operations for solver
+  const auto& pairs = na::NASolver::getOpsForSolver(circ, qc::Z, 1, true);
+  const auto countTransfers = [](const na::NASolver::Result& result) {
+    return std::count_if(result.stages.cbegin(), result.stages.cend(),
+                         [](const auto& stage) { return !stage.rydberg; });
+  };
+  // solve
+  const auto result =
+      solver.solveParallel(pairs, static_cast<uint16_t>(circ.getNqubits()), 6,
+                           false, true, false, 4);
+  EXPECT_TRUE(result.sat);
+  EXPECT_EQ(result.stages.size(), 5);
+  // the optimum must be the same as the one of the incremental search
+  const auto resultOptimal = solver.solveOptimal(
+      pairs, static_cast<uint16_t>(circ.getNqubits()), 6, false, true);
+  EXPECT_EQ(countTransfers(result), countTransfers(resultOptimal));
+  // with at most four stages, there is no solution
+  const auto resultUnsat =
+      solver.solveParallel(pairs, static_cast<uint16_t>(circ.getNqubits()), 4,
+                           false, true, false, 2);
+  EXPECT_FALSE(resultUnsat.sat);
+}
+
+/// An instance of the solver: the circuit, the y-coordinates delimiting the
+/// entangling zone, the number of stages, whether the order is minded, and
+/// whether the instance is satisfiable
+using SolverInstance = std::tuple<std::string, uint16_t, uint16_t, uint16_t,
+                                  bool, bool>;
+class SolverSymmetryBreakingTest
+    : public ::testing::TestWithParam<SolverInstance> {};
+TEST_P(SolverSymmetryBreakingTest, SameResult) {
+  const auto& [circuit, minEntanglingY, maxEntanglingY, numStages,
+               mindOpsOrder, sat] = GetParam();
+  const auto& circ = qasm3::Importer::importf(TEST_CIRCUITS_PATH "/" + circuit +
+                                              ".qasm");
+  const auto& pairs = na::NASolver::getOpsForSolver(circ, qc::Z, 1, true);
+  // solve the instance without and with symmetry breaking, the times are
+  // recorded to compare the encodings
+  for (const bool breakSymmetries : {false, true}) {
+    na::NASolver solver(3, 7, 2, 3, 2, 2, 2, 2, minEntanglingY,
+                        maxEntanglingY);
+    const auto start = std::chrono::steady_clock::now();
+    const auto result = solver.solve(
+        pairs, static_cast<uint16_t>(circ.getNqubits()), numStages,
+        std::nullopt, mindOpsOrder, true, breakSymmetries);
+    const auto time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+    RecordProperty(breakSymmetries ? "time_symmetry_breaking_ms" : "time_ms",
+                   std::to_string(time));
+    EXPECT_EQ(result.sat, sat);
+    if (sat) {
+      EXPECT_EQ(result.stages.size(), numStages);
+    }
+  }
+}
+INSTANTIATE_TEST_SUITE_P(
+    SolverSymmetryBreakingTests, SolverSymmetryBreakingTest,
+    ::testing::Values(SolverInstance{"steane", 0, 4, 4, false, false},
+                      SolverInstance{"steane", 0, 4, 5, false, true},
+                      SolverInstance{"steane", 2, 4, 3, false, false},
+                      SolverInstance{"shor", 2, 4, 4, false, false},
+                      SolverInstance{"steane", 0, 4, 4, true, false},
+                      SolverInstance{"shor", 2, 4, 5, true, false}));
+
+TEST(Solver, SymmetryBreakingOrdersInterchangeableQubits) {
+  // create solver
+  na::NASolver solver(3, 7, 2, 3, 2, 2, 2, 2, 2, 4);
+  // the qubits 1, 2, and 3 are interchangeable, and so are 4 and 5
+  const std::vector<std::pair<qc::Qubit, qc::Qubit>> pairs{
+      {0, 1}, {0, 2}, {0, 3}, {4, 5}};
+  const auto result = solver.solveOptimal(pairs, 6, 6, false, true, true);
+  ASSERT_TRUE(result.sat);
+  const auto& qubits = result.stages.front().qubits;
+  const auto location = [&qubits](const size_t q) {
+    return std::tuple{qubits[q].x, qubits[q].y, qubits[q].h, qubits[q].v};
+  };
+  EXPECT_LT(location(1), location(2));
+  EXPECT_LT(location(2), location(3));
+  EXPECT_LT(location(4), location(5));
+  // the symmetry breaking does not change the optimal number of stages
+  EXPECT_EQ(result.stages.size(),
+            solver.solveOptimal(pairs, 6, 6, false, true, false).stages.size());
+}
+
 TEST(Solver, NoShieldingFixedOrder) {
   const auto& circ =
       qasm3::Importer::importf(TEST_CIRCUITS_PATH "/steane.qasm");
@@ -126,7 +273,10 @@ TEST(Solver, FixedTransfer) {
   // solve
   const auto result = solver.solve(
       pairs, static_cast<uint16_t>(circ.getNqubits()), 5, 2, false, true);
-  EXPECT_TRUE(result.sat);
+  ASSERT_TRUE(result.sat);
+  EXPECT_EQ(std::count_if(result.stages.cbegin(), result.stages.cend(),
+                          [](const auto& stage) { return !stage.rydberg; }),
+            2);
 }
 
 TEST(Solver, Unsat) {
@@ -160,6 +310,73 @@ TEST(Solver, Exceptions) {
   EXPECT_THROW(std::ignore =
                    solver2.solve({{0, 1}}, 1, 1, std::nullopt, false, true),
                std::invalid_argument);
+  // The maximum number of stages must be at least one.
+  EXPECT_THROW(std::ignore = solver2.solveOptimal({{0, 1}}, 2, 0, false, true),
+               std::invalid_argument);
+  EXPECT_THROW(std::ignore = solver2.solveParallel({{0, 1}}, 2, 0, false, true),
+               std::invalid_argument);
+}
+
+namespace {
+/// Adds the pigeonhole formula with @p n holes, which takes Z3 very long to
+/// refute for n >= 12, to @p solver.
+auto addPigeonhole(z3::context& ctx, z3::solver& solver, const int n) -> void {
+  std::vector<z3::expr_vector> inHole;
+  for (int i = 0; i <= n; ++i) {
+    auto& holes = inHole.emplace_back(ctx);
+    for (int j = 0; j < n; ++j) {
+      holes.push_back(ctx.bool_const(
+          ("p" + std::to_string(i) + "_" + std::to_string(j)).c_str()));
+    }
+    solver.add(z3::mk_or(holes));
+  }
+  for (int j = 0; j < n; ++j) {
+    for (int i = 0; i <= n; ++i) {
+      for (int k = i + 1; k <= n; ++k) {
+        solver.add(!inHole[i][j] || !inHole[k][j]);
+      }
+    }
+  }
+}
+} // namespace
+
+TEST(Solver, InterrupterStopsCheckCancelledBeforeStart) {
+  z3::context ctx;
+  z3::solver solver(ctx);
+  addPigeonhole(ctx, solver, 12);
+  na::ContextInterrupter interrupter(1);
+  ASSERT_TRUE(interrupter.registerContext(0, ctx));
+  // the first interrupt arrives before the check starts and is cleared by Z3
+  interrupter.cancel(0);
+  EXPECT_TRUE(interrupter.isCancelled(0));
+  const auto start = std::chrono::steady_clock::now();
+  const auto result = solver.check();
+  const auto duration = std::chrono::steady_clock::now() - start;
+  interrupter.unregisterContext(0);
+  EXPECT_EQ(result, z3::unknown);
+  EXPECT_LT(duration, std::chrono::seconds(5));
+  // a cancelled job cannot register its context again
+  EXPECT_FALSE(interrupter.registerContext(0, ctx));
+}
+
+TEST(Solver, InterrupterStopsRunningCheck) {
+  z3::context ctx;
+  z3::solver solver(ctx);
+  addPigeonhole(ctx, solver, 12);
+  na::ContextInterrupter interrupter(2);
+  ASSERT_TRUE(interrupter.registerContext(1, ctx));
+  std::thread canceller([&interrupter] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    interrupter.cancel(1);
+  });
+  const auto start = std::chrono::steady_clock::now();
+  const auto result = solver.check();
+  const auto duration = std::chrono::steady_clock::now() - start;
+  canceller.join();
+  interrupter.unregisterContext(1);
+  EXPECT_EQ(result, z3::unknown);
+  EXPECT_LT(duration, std::chrono::seconds(5));
+  EXPECT_FALSE(interrupter.isCancelled(0));
 }
 
 TEST(Solver, JSONRoundTrip) {
@@ -177,6 +394,75 @@ TEST(Solver, JSONRoundTrip) {
   EXPECT_EQ(resultRT, result);
 }
 
+TEST(Solver, BinaryRoundTrip) {
+  const auto& circ =
+      qasm3::Importer::importf(TEST_CIRCUITS_PATH "/steane.qasm");
+  // create solver
+  na::NASolver solver(3, 7, 2, 3, 2, 2, 2, 2, 2, 4);
+  // get operations for solver
+  const auto& pairs = na::NASolver::getOpsForSolver(circ, qc::Z, 1, true);
+  // solve
+  const auto result =
+      solver.solve(pairs, static_cast<uint16_t>(circ.getNqubits()), 4,
+                   std::nullopt, false, true);
+  ASSERT_TRUE(result.sat);
+  // every gate is extracted exactly once and in the stage it is executed in
+  std::size_t numGates = 0;
+  for (std::size_t t = 0; t < result.stages.size(); ++t) {
+    for (const auto& gate : result.stages[t].gates) {
+      EXPECT_EQ(gate.stage, t);
+      ++numGates;
+    }
+  }
+  EXPECT_EQ(numGates, pairs.size());
+  const auto binary = result.binary();
+  EXPECT_LT(binary.size(), result.json().dump().size());
+  const auto resultRT = na::NASolver::Result::fromBinary(binary);
+  EXPECT_EQ(resultRT, result);
+  EXPECT_EQ(resultRT.minEntanglingY, result.minEntanglingY);
+  EXPECT_EQ(resultRT.maxEntanglingY, result.maxEntanglingY);
+  EXPECT_EQ(resultRT.maxHOffset, result.maxHOffset);
+  EXPECT_EQ(resultRT.maxVOffset, result.maxVOffset);
+  for (std::size_t t = 0; t < result.stages.size(); ++t) {
+    for (std::size_t i = 0; i < result.stages[t].gates.size(); ++i) {
+      EXPECT_EQ(resultRT.stages[t].gates[i].stage,
+                result.stages[t].gates[i].stage);
+    }
+  }
+  EXPECT_THROW(std::ignore = na::NASolver::Result::fromBinary(""),
+               std::invalid_argument);
+  EXPECT_THROW(std::ignore = na::NASolver::Result::fromBinary(
+                   binary.substr(0, binary.size() - 1)),
+               std::invalid_argument);
+  EXPECT_THROW(std::ignore = na::NASolver::Result::fromBinary(binary + "x"),
+               std::invalid_argument);
+  auto otherVersion = binary;
+  otherVersion[4] = 0;
+  EXPECT_THROW(std::ignore = na::NASolver::Result::fromBinary(otherVersion),
+               std::invalid_argument);
+}
+
+TEST(Solver, BinaryOverlongInteger) {
+  const auto binary = na::NASolver::Result{}.binary();
+  // the encoding of minEntanglingY, i.e., zero, starts at offset 6
+  ASSERT_EQ(binary[6], '\0');
+  const auto withMinEntanglingY = [&binary](const std::string& encoding) {
+    return binary.substr(0, 6) + encoding + binary.substr(7);
+  };
+  // zero encoded with the maximum of ten bytes is accepted
+  EXPECT_EQ(na::NASolver::Result::fromBinary(
+                withMinEntanglingY(std::string(9, '\x80') + '\0')),
+            na::NASolver::Result{});
+  // the tenth byte holds bits beyond the 64th one that would be lost
+  EXPECT_THROW(std::ignore = na::NASolver::Result::fromBinary(
+                   withMinEntanglingY(std::string(9, '\x80') + '\x02')),
+               std::invalid_argument);
+  // the encoding continues beyond the tenth byte
+  EXPECT_THROW(std::ignore = na::NASolver::Result::fromBinary(
+                   withMinEntanglingY(std::string(10, '\x80') + '\0')),
+               std::invalid_argument);
+}
+
 TEST(Solver, GetOpsForSolver) {
   const auto& circ = qasm3::Importer::imports(R"(
 OPENQASM 2.0;
@@ -8,11 +8,15 @@
  * Licensed under the MIT License
  */
 
+#include "na/zoned/Profiling.hpp"
 #include "na/zoned/layout_synthesizer/placer/AStarPlacer.hpp"
+#include "na/zoned/layout_synthesizer/placer/AStarSearch.hpp"
 
+#include <chrono>
 #include <cstddef>
 #include <gmock/gmock-function-mocker.h>
 #include <gmock/gmock-matchers.h>
+#include <gmock/gmock-more-matchers.h>
 #include <gtest/gtest.h>
 #include <src/gtest-internal-inl.h>
 #include <string>
@@ -219,6 +223,61 @@ TEST_F(AStarPlacerPlaceTest, TwoTwoQubitLayerReuse) {
   EXPECT_EQ(std::get<1>(placement[2][1]), std::get<1>(placement[3][1]));
   EXPECT_EQ(std::get<2>(placement[2][1]), std::get<2>(placement[3][1]));
 }
+TEST_F(AStarPlacerPlaceTest, NodeFootprint) {
+  // places a sequence of full entanglement layers and reports the memory per
+  // search node and the search throughput
+  constexpr qc::Qubit nQubits = 32;
+  std::vector<std::vector<std::array<qc::Qubit, 2>>> layers;
+  for (qc::Qubit shift = 0; shift < 4; ++shift) {
+    auto& layer = layers.emplace_back();
+    for (qc::Qubit q = 0; q < nQubits; q += 2) {
+      layer.push_back({(q + shift) % nQubits, (q + shift + 1) % nQubits});
+    }
+  }
+  const std::vector<std::unordered_set<qc::Qubit>> reuseQubits(
+      layers.size() - 1);
+  const auto start = std::chrono::steady_clock::now();
+  const auto& placement = placer.place(nQubits, layers, reuseQubits);
+  const auto end = std::chrono::steady_clock::now();
+  EXPECT_THAT(placement, ::testing::SizeIs((2 * layers.size()) + 1));
+  EXPECT_THAT(placement, ::testing::Each(::testing::SizeIs(nQubits)));
+  const auto& statistics = placer.getStatistics();
+  ASSERT_GT(statistics.nNodes, 0);
+  const auto bytesPerNode = statistics.nodeMemory / statistics.nNodes;
+  EXPECT_LE(bytesPerNode, 32);
+  const auto seconds = std::chrono::duration<double>(end - start).count();
+  RecordProperty("bytesPerNode", std::to_string(bytesPerNode));
+  RecordProperty("nodesPerSecond",
+                 std::to_string(static_cast<double>(statistics.nNodes) /
+                                seconds));
+}
+TEST_F(AStarPlacerPlaceTest, ProfilingCounters) {
+  constexpr qc::Qubit nQubits = 8;
+  const std::vector<std::vector<std::array<qc::Qubit, 2>>> layers{
+      {{0, 1}, {2, 3}}, {{1, 2}, {4, 5}, {6, 7}}};
+  const std::vector<std::unordered_set<qc::Qubit>> reuseQubits(
+      layers.size() - 1);
+  std::ignore = placer.place(nQubits, layers, reuseQubits);
+  const auto& statistics = placer.getStatistics();
+  if constexpr (!PROFILING) {
+    EXPECT_THAT(statistics.layers, ::testing::IsEmpty());
+    return;
+  }
+  ASSERT_THAT(statistics.layers, ::testing::SizeIs(layers.size()));
+  size_t nGenerated = 0;
+  for (const auto& layer : statistics.layers) {
+    for (const auto& counters : {layer.gatePlacement, layer.atomPlacement}) {
+      EXPECT_GT(counters.nExpanded, 0);
+      EXPECT_GE(counters.nGenerated, counters.nExpanded);
+      EXPECT_GT(counters.openSetPeak, 0);
+      EXPECT_GT(counters.bytesAllocated, 0);
+      EXPECT_GE(counters.searchTime, 0);
+      nGenerated += counters.nGenerated;
+    }
+  }
+  // every node except the root of every search is generated by an expansion
+  EXPECT_EQ(nGenerated + (2 * layers.size()), statistics.nNodes);
+}
 TEST(AStarPlacerTest, NoSolution) {
   Architecture architecture(Architecture::fromJSONString(architectureJson));
   AStarPlacer::Config config = R"({
@@ -261,6 +320,70 @@ TEST(AStarPlacerTest, LimitSpace) {
                    std::vector<std::unordered_set<qc::Qubit>>{}),
                std::runtime_error);
 }
+class AStarPlacerFallbackTest : public ::testing::TestWithParam<std::string> {
+};
+TEST_P(AStarPlacerFallbackTest, LimitSpace) {
+  Architecture architecture(Architecture::fromJSONString(architectureJson));
+  auto config = R"({
+  "useWindow": true,
+  "windowMinWidth": 4,
+  "windowRatio": 1.5,
+  "windowShare": 0.6,
+  "deepeningFactor": 0.6,
+  "deepeningValue": 0.2,
+  "lookaheadFactor": 0.2,
+  "reuseLevel": 5.0,
+  "maxNodes": 100,
+  "beamWidth": 4
+})"_json;
+  config["fallback"] = GetParam();
+  AStarPlacer placer(architecture, config);
+  constexpr size_t nQubits = 4;
+  const auto& placement = placer.place(
+      nQubits,
+      std::vector<std::vector<std::array<qc::Qubit, 2>>>{{{0U, 1U}, {2U, 3U}}},
+      std::vector<std::unordered_set<qc::Qubit>>{});
+  ASSERT_EQ(placement.size(), 3);
+  // the two gates are placed at neighboring sites in the entanglement zone
+  for (const auto& [first, second] : {std::pair{0U, 1U}, std::pair{2U, 3U}}) {
+    const auto& [slm1, r1, c1] = placement[1][first];
+    const auto& [slm2, r2, c2] = placement[1][second];
+    EXPECT_TRUE(slm1.get().isEntanglement());
+    EXPECT_TRUE(slm2.get().isEntanglement());
+    EXPECT_EQ(r1, r2);
+    EXPECT_EQ(c1, c2);
+  }
+  EXPECT_THAT(placer.getStatistics().degradedLayers, ::testing::ElementsAre(0));
+}
+INSTANTIATE_TEST_SUITE_P(AStarPlacerFallbackTest, AStarPlacerFallbackTest,
+                         ::testing::Values("beamSearch", "weightedAStar"));
+TEST(AStarPlacerTest, Portfolio) {
+  Architecture architecture(Architecture::fromJSONString(architectureJson));
+  auto config = nlohmann::json::parse(configJson);
+  config["portfolioSize"] = 4;
+  AStarPlacer placer(architecture, config);
+  constexpr size_t nQubits = 16;
+  const std::vector<std::vector<std::array<qc::Qubit, 2>>> layers{
+      {{0U, 1U}, {2U, 3U}, {4U, 5U}, {6U, 7U}, {8U, 9U}, {10U, 11U}},
+      {{1U, 2U}, {3U, 12U}, {13U, 14U}, {5U, 15U}}};
+  const auto& placement = placer.place(
+      nQubits, layers, std::vector<std::unordered_set<qc::Qubit>>(1));
+  ASSERT_THAT(placement, ::testing::SizeIs((2 * layers.size()) + 1));
+  EXPECT_THAT(placement, ::testing::Each(::testing::SizeIs(nQubits)));
+  // every gate is placed at a pair of neighboring entanglement sites
+  for (size_t layer = 0; layer < layers.size(); ++layer) {
+    for (const auto& [first, second] : layers[layer]) {
+      const auto& [slm1, r1, c1] = placement[(2 * layer) + 1][first];
+      const auto& [slm2, r2, c2] = placement[(2 * layer) + 1][second];
+      EXPECT_TRUE(slm1.get().isEntanglement());
+      EXPECT_TRUE(slm2.get().isEntanglement());
+      EXPECT_NE(&slm1.get(), &slm2.get());
+      EXPECT_EQ(r1, r2);
+      EXPECT_EQ(c1, c2);
+    }
+  }
+  EXPECT_GT(placer.getStatistics().nNodes, 0);
+}
 TEST(AStarPlacerTest, WindowExpansion) {
   Architecture architecture(Architecture::fromJSONString(architectureJson));
   AStarPlacer placer(architecture, R"({
@@ -315,10 +438,43 @@ TEST(AStarPlacerTest, InitialPlacementForTwoSLMs) {
                   ::testing::Field(&SLM::id, ::testing::Eq(1)),
                   ::testing::Lt(18), ::testing::Lt(20)))));
 }
+/**
+ * A policy for the A* search on a 4x4 grid, see the test below. For testing
+ * purposes, the nodes have no structure and are identified by their index.
+ */
+struct GridSearchPolicy {
+  struct Node {};
+  std::vector<Node> nodes = std::vector<Node>(16);
+  std::unordered_map<size_t, std::vector<size_t>> neighbors{
+      {0, {1, 4}},   {1, {2, 5}},   {2, {3, 6}},   {3, {7}},
+      {4, {5, 8}},   {5, {6, 9}},   {6, {7, 10}},  {7, {11}},
+      {8, {9, 12}},  {9, {10, 13}}, {10, {11, 14}}, {11, {15}},
+      {12, {13}},    {13, {14}},    {14, {15}},    {15, {}}};
+  [[nodiscard]] auto index(const Node& node) const -> size_t {
+    return static_cast<size_t>(std::distance(nodes.data(), &node));
+  }
+  template <class Emit>
+  auto expand(const Node& node, Emit&& emit) const -> void {
+    for (const auto i : neighbors.at(index(node))) {
+      emit(nodes[i]);
+    }
+  }
+  [[nodiscard]] auto isGoal(const Node& node) const -> bool {
+    return index(node) == 14;
+  }
+  [[nodiscard]] static auto getCost(const Node& /* unused */) -> double {
+    return 1.0;
+  }
+  [[nodiscard]] auto getHeuristic(const Node& node) const -> double {
+    const auto i = static_cast<long>(index(node));
+    const long x = i % 4;
+    const long y = i / 4;
+    return std::hypot(x, y);
+  }
+};
 TEST(AStarPlacerTest, AStarSearch) {
-  // for testing purposes, we do not use the structure of nodes and just use
-  // their respective address to identify a location in a 4x4 grid that looks
-  // like the following, where the cost of each edge is 1:
+  // the nodes form a 4x4 grid that looks like the following, where the cost
+  // of each edge is 1:
   // ┌Start┐        ┌─────┐        ┌─────┐        ┌─────┐
   // │  0  ├─────→  │  1  ├─────→  │  2  ├─────→  │  3  │
   // └─────┘        └──┬──┘        └──┬──┘        └──┬──┘
@@ -337,51 +493,11 @@ TEST(AStarPlacerTest, AStarSearch) {
   // ┌─────┐        ┌─────┐        ┌Goal=┐        ┌─────┐
   // │  12 ├─────→  │  13 ├─────→  │  14 ├─────→  │  15 │
   // └─────┘        └─────┘        └=====┘        └─────┘
-  const std::vector<AStarPlacer::AtomNode> nodes(16);
-  std::unordered_map<
-      const AStarPlacer::AtomNode*,
-      std::vector<std::reference_wrapper<const AStarPlacer::AtomNode>>>
-      neighbors{{nodes.data(), {std::cref(nodes[1]), std::cref(nodes[4])}},
-                {&nodes[1], {std::cref(nodes[2]), std::cref(nodes[5])}},
-                {&nodes[2], {std::cref(nodes[3]), std::cref(nodes[6])}},
-                {&nodes[3], {std::cref(nodes[7])}},
-                {&nodes[4], {std::cref(nodes[5]), std::cref(nodes[8])}},
-                {&nodes[5], {std::cref(nodes[6]), std::cref(nodes[9])}},
-                {&nodes[6], {std::cref(nodes[7]), std::cref(nodes[10])}},
-                {&nodes[7], {std::cref(nodes[11])}},
-                {&nodes[8], {std::cref(nodes[9]), std::cref(nodes[12])}},
-                {&nodes[9], {std::cref(nodes[10]), std::cref(nodes[13])}},
-                {&nodes[10], {std::cref(nodes[11]), std::cref(nodes[14])}},
-                {&nodes[11], {std::cref(nodes[15])}},
-                {&nodes[12], {std::cref(nodes[13])}},
-                {&nodes[13], {std::cref(nodes[14])}},
-                {&nodes[14], {std::cref(nodes[15])}},
-                {&nodes[15], {}}};
-  const auto path = (AStarPlacer::aStarTreeSearch<AStarPlacer::AtomNode>(
-      /* start: */
-      nodes[0],
-      /* getNeighbors: */
-      [&neighbors](const AStarPlacer::AtomNode& node)
-          -> std::vector<std::reference_wrapper<const AStarPlacer::AtomNode>> {
-        return neighbors.at(&node);
-      },
-      /* isGoal: */
-      [&nodes](const AStarPlacer::AtomNode& node) -> bool {
-        return &node == &nodes[14];
-      },
-      /* getCost: */
-      [](const AStarPlacer::AtomNode& /* unused */) -> double { return 1.0; },
-      /* getHeuristic: */
-      [&nodes](const AStarPlacer::AtomNode& node) -> double {
-        const auto* head = nodes.data();
-        const auto i = std::distance(head, &node);
-        const long x = i % 4;
-        const long y = i / 4;
-        return std::hypot(x, y);
-      },
-      1'000'000));
+  GridSearchPolicy policy;
+  const auto& nodes = policy.nodes;
+  const auto path = aStarTreeSearch(policy, nodes[0], 1'000'000);
   // convert to const Node* for easier comparison
-  std::vector<const AStarPlacer::AtomNode*> pathNodes;
+  std::vector<const GridSearchPolicy::Node*> pathNodes;
   for (const auto& node : path) {
     pathNodes.emplace_back(&node.get());
   }
@@ -389,4 +505,14 @@ TEST(AStarPlacerTest, AStarSearch) {
               ::testing::ElementsAre(&nodes[0], ::testing::_, ::testing::_,
                                      ::testing::_, ::testing::_, &nodes[14]));
 }
+TEST(AStarPlacerTest, BeamSearchDeadEnd) {
+  // from node 3 of the grid above, the only path leads to node 15 that has no
+  // neighbors and is not the goal
+  GridSearchPolicy policy;
+  const auto& nodes = policy.nodes;
+  EXPECT_THROW(std::ignore = beamTreeSearch(policy, nodes[3], 4, 1'000'000),
+               BeamExhausted);
+  const auto path = beamTreeSearch(policy, nodes[10], 4, 1'000'000);
+  EXPECT_EQ(&path.back().get(), &nodes[14]);
+}
 } // namespace na::zoned
@@ -11,8 +11,13 @@
 #include "na/zoned/Architecture.hpp"
 
 #include <cstddef>
+#include <filesystem>
 #include <gtest/gtest.h>
+#include <limits>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
 
 namespace na::zoned {
 constexpr std::string_view architectureJson = R"({
@@ -115,6 +120,114 @@ TEST_F(TwoZoneArchitectureTest, NearestEntanglementSite) {
     }
   }
 }
+TEST_F(TwoZoneArchitectureTest, NearestSiteIds) {
+  const auto& storageSLM = *arch.storageZones.front();
+  const auto& entanglementSLM = arch.entanglementZones.front()->front();
+  EXPECT_EQ(arch.getSite(arch.nearestStorageSiteId(
+                arch.getSiteId(entanglementSLM, 1, 2))),
+            arch.nearestStorageSite(entanglementSLM, 1, 2));
+  EXPECT_EQ(arch.nearestEntanglementSiteId(arch.getSiteId(storageSLM, 3, 4),
+                                           arch.getSiteId(storageSLM, 5, 6)),
+            arch.nearestEntanglementSiteId(arch.getSiteId(storageSLM, 5, 6),
+                                           arch.getSiteId(storageSLM, 3, 4)));
+  EXPECT_EQ(arch.distance(arch.getSiteId(storageSLM, 0, 0),
+                          arch.getSiteId(entanglementSLM, 0, 0)),
+            arch.distance(storageSLM, 0, 0, entanglementSLM, 0, 0));
+}
+TEST_F(TwoZoneArchitectureTest, LookupTables) {
+  std::stringstream ss;
+  arch.exportLookupTables(ss);
+  auto other = Architecture::fromJSONString(architectureJson);
+  ASSERT_TRUE(other.importLookupTables(ss));
+  // the SLMs of both architectures differ, hence, compare the site ids
+  for (const auto& slm : *arch.entanglementZones.front()) {
+    for (std::size_t r = 0; r < slm.nRows; ++r) {
+      for (std::size_t c = 0; c < slm.nCols; ++c) {
+        const auto site = arch.getSiteId(slm, r, c);
+        EXPECT_EQ(other.nearestStorageSiteId(site),
+                  arch.nearestStorageSiteId(site));
+      }
+    }
+  }
+}
+TEST_F(TwoZoneArchitectureTest, LookupTablesMismatch) {
+  std::stringstream ss;
+  arch.exportLookupTables(ss);
+  auto spec = nlohmann::json::parse(architectureJson);
+  spec["storage_zones"][0]["slms"][0]["r"] = 10;
+  auto other = Architecture::fromJSON(spec);
+  EXPECT_FALSE(other.importLookupTables(ss));
+  std::stringstream empty;
+  EXPECT_FALSE(other.importLookupTables(empty));
+}
+TEST_F(TwoZoneArchitectureTest, LookupTablesCorrupted) {
+  std::stringstream ss;
+  arch.exportLookupTables(ss);
+  // replace the last nearest storage site id by an id out of range
+  auto tables = ss.str();
+  const auto site = std::numeric_limits<SiteId>::max();
+  tables.replace(tables.size() - sizeof(SiteId), sizeof(SiteId),
+                 reinterpret_cast<const char*>(&site), sizeof(SiteId));
+  std::stringstream corrupted(tables);
+  auto other = Architecture::fromJSONString(architectureJson);
+  const auto entanglementSite =
+      arch.getSiteId(arch.entanglementZones.front()->front(), 0, 0);
+  EXPECT_THROW(std::ignore = other.importLookupTables(corrupted),
+               std::invalid_argument);
+  // the current lookup tables are left unchanged
+  EXPECT_EQ(other.nearestStorageSiteId(entanglementSite),
+            arch.nearestStorageSiteId(entanglementSite));
+}
+TEST_F(TwoZoneArchitectureTest, LookupTablesFile) {
+  const std::filesystem::path path = arch.name + ".lut";
+  std::filesystem::remove(path);
+  const auto spec = nlohmann::json::parse(architectureJson);
+  const auto created = Architecture::fromJSON(spec, path);
+  ASSERT_TRUE(std::filesystem::exists(path));
+  const auto loaded = Architecture::fromJSON(spec, path);
+  const auto site =
+      arch.getSiteId(arch.entanglementZones.front()->front(), 0, 0);
+  EXPECT_EQ(created.nearestStorageSiteId(site),
+            arch.nearestStorageSiteId(site));
+  EXPECT_EQ(loaded.nearestStorageSiteId(site), arch.nearestStorageSiteId(site));
+  std::filesystem::remove(path);
+}
+class ArchitectureScalingTest : public ::testing::TestWithParam<std::size_t> {
+};
+TEST_P(ArchitectureScalingTest, LargeStorageZone) {
+  // the nearest entanglement sites of pairs of storage sites are not
+  // precomputed, hence, loading large storage zones is cheap
+  const auto n = GetParam();
+  auto spec = nlohmann::json::parse(architectureJson);
+  spec["storage_zones"][0]["slms"][0]["r"] = n;
+  spec["storage_zones"][0]["slms"][0]["c"] = n;
+  spec["storage_zones"][0]["dimension"] = {3 * n, 3 * n};
+  for (auto& slm : spec["entanglement_zones"][0]["slms"]) {
+    slm["location"][1] = (3 * n) + 10;
+  }
+  spec["entanglement_zones"][0]["offset"][1] = (3 * n) + 10;
+  spec["rydberg_range"] = {{{0, 3 * n}, {65, (3 * n) + 50}}};
+  const auto arch = Architecture::fromJSON(spec);
+  EXPECT_EQ(arch.getNumberOfSites(), (n * n) + (2 * 4 * 4));
+  const auto& storageSLM = *arch.storageZones.front();
+  const auto& [nearestSLM, nearestRow, nearestCol] =
+      arch.nearestEntanglementSite(storageSLM, n - 1, 0, storageSLM, n - 1, 1);
+  EXPECT_TRUE(nearestSLM.get().isEntanglement());
+  const auto minDistance =
+      arch.distance(storageSLM, n - 1, 0, nearestSLM, nearestRow, nearestCol) +
+      arch.distance(storageSLM, n - 1, 1, nearestSLM, nearestRow, nearestCol);
+  for (const auto& slm : *arch.entanglementZones.front()) {
+    for (std::size_t r = 0; r < slm.nRows; ++r) {
+      for (std::size_t c = 0; c < slm.nCols; ++c) {
+        EXPECT_GE(arch.distance(storageSLM, n - 1, 0, slm, r, c) +
+                      arch.distance(storageSLM, n - 1, 1, slm, r, c),
+                  minDistance);
+      }
+    }
+  }
+}
+INSTANTIATE_TEST_SUITE_P(ArchitectureScalingTests, ArchitectureScalingTest,
+                         ::testing::Values(20, 100, 400));
 TEST_F(TwoZoneArchitectureTest, ExportNoThrow) {
   ASSERT_NO_THROW(arch.exportNAVizMachine(arch.name + ".namachine"));
 }
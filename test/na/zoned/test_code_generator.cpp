@@ -13,13 +13,18 @@
 #include "ir/operations/StandardOperation.hpp"
 #include "ir/operations/SymbolicOperation.hpp"
 #include "na/zoned/code_generator/CodeGenerator.hpp"
+#include "na/zoned/code_generator/CodeWriter.hpp"
 
+#include <bit>
 #include <cstddef>
+#include <cstdint>
 #include <gmock/gmock-matchers.h>
 #include <gmock/gmock-more-matchers.h>
 #include <gtest/gtest.h>
 #include <map>
 #include <optional>
+#include <sstream>
+#include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -604,4 +609,88 @@ TEST_F(CodeGeneratorGenerateTest, Offset) {
       "    atom3\n"
       "]\n");
 }
+TEST_F(CodeGeneratorGenerateTest, StreamText) {
+  const auto& storage = *architecture.storageZones.front();
+  const auto& entanglementLeft =
+      architecture.entanglementZones.front()->front();
+  const auto& entanglementRight =
+      architecture.entanglementZones.front()->back();
+  const auto rz = qc::StandardOperation(0, qc::RZ, {0.1});
+  const auto h = qc::StandardOperation(1, qc::H);
+  const std::vector<SingleQubitGateLayer> singleQubitGateLayers{{rz}, {h}};
+  const std::vector<Placement> placement{
+      {{storage, 18, 0}, {storage, 18, 1}, {storage, 19, 0}, {storage, 19, 1}},
+      {{entanglementLeft, 0, 0},
+       {entanglementRight, 0, 0},
+       {entanglementLeft, 1, 0},
+       {entanglementRight, 1, 0}},
+      {{storage, 18, 0}, {storage, 18, 1}, {storage, 19, 0}, {storage, 19, 1}}};
+  const std::vector<Routing> routing{{{0U, 1U, 2U, 3U}}, {{0U, 1U, 2U, 3U}}};
+  std::ostringstream os;
+  TextCodeWriter writer(os);
+  codeGenerator.generate(singleQubitGateLayers, placement, routing, writer);
+  EXPECT_EQ(os.str(),
+            codeGenerator.generate(singleQubitGateLayers, placement, routing)
+                .toString());
+}
+TEST_F(CodeGeneratorGenerateTest, StreamCallback) {
+  const auto& slm = *architecture.storageZones.front();
+  const auto rz = qc::StandardOperation(0, qc::RZ, {0.1});
+  const auto ry = qc::StandardOperation(0, qc::RY, {0.1});
+  std::vector<std::string> chunks;
+  TextCodeWriter writer(
+      [&chunks](const std::string& chunk) { chunks.emplace_back(chunk); });
+  codeGenerator.generate(
+      std::vector<SingleQubitGateLayer>{{rz, ry}},
+      std::vector<Placement>{{{slm, 0, 0}}}, std::vector<Routing>{}, writer);
+  EXPECT_THAT(chunks, ::testing::ElementsAre("atom (0.000, 0.000) atom0\n",
+                                             "@+ rz 0.10000 atom0\n",
+                                             "@+ ry 0.10000 global\n"));
+}
+TEST_F(CodeGeneratorGenerateTest, StreamBinary) {
+  const auto& slm = *architecture.storageZones.front();
+  const auto ry = qc::StandardOperation(0, qc::RY, {0.1});
+  std::ostringstream os(std::ios::out | std::ios::binary);
+  BinaryCodeWriter writer(os);
+  codeGenerator.generate(std::vector<SingleQubitGateLayer>{{ry}},
+                         std::vector<Placement>{{{slm, 0, 0}}},
+                         std::vector<Routing>{}, writer);
+  std::string expected = "NAQC";
+  expected.push_back(static_cast<char>(BinaryCodeWriter::VERSION));
+  const auto appendU32 = [&expected](const uint32_t value) {
+    for (size_t i = 0; i < 4; ++i) {
+      expected.push_back(static_cast<char>((value >> (8 * i)) & 0xFFU));
+    }
+  };
+  const auto appendF64 = [&expected](const double value) {
+    const auto bits = std::bit_cast<uint64_t>(value);
+    for (size_t i = 0; i < 8; ++i) {
+      expected.push_back(static_cast<char>((bits >> (8 * i)) & 0xFFU));
+    }
+  };
+  const auto appendString = [&expected, &appendU32](const std::string& value) {
+    appendU32(static_cast<uint32_t>(value.size()));
+    expected += value;
+  };
+  // zones
+  appendU32(2);
+  appendString("zone_cz0");
+  for (const auto value : {5.0, 70.0, 55.0, 110.0}) {
+    appendF64(value);
+  }
+  appendString("global");
+  for (const auto value : {0.0, 0.0, 60.0, 60.0}) {
+    appendF64(value);
+  }
+  // atoms
+  appendU32(1);
+  appendString("atom0");
+  appendF64(0.0);
+  appendF64(0.0);
+  // global ry in the global zone
+  expected.push_back(static_cast<char>(BinaryCodeWriter::Opcode::GlobalRY));
+  appendU32(1);
+  appendF64(0.1);
+  EXPECT_EQ(os.str(), expected);
+}
 } // namespace na::zoned
@@ -11,11 +11,14 @@
 #include "circuit_optimizer/CircuitOptimizer.hpp"
 #include "ir/QuantumComputation.hpp"
 #include "na/zoned/Compiler.hpp"
+#include "na/zoned/scheduler/ListScheduler.hpp"
 #include "qasm3/Importer.hpp"
 
 #include <cstddef>
 #include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
 #include <utility>
+#include <vector>
 
 namespace na::zoned {
 
@@ -126,9 +129,22 @@ constexpr std::string_view routingAwareConfiguration = R"({
         const auto& filename = path.substr(path.find_last_of("/") + 1);        \
         return filename.substr(0, filename.find_last_of("."));                 \
       })
+/// A compiler that uses the ListScheduler instead of the ASAPScheduler
+class ListSchedulingCompiler final
+    : public Compiler<ListSchedulingCompiler, ListScheduler,
+                      VertexMatchingReuseAnalyzer, RoutingAwareSynthesizer,
+                      CodeGenerator> {
+public:
+  ListSchedulingCompiler(const Architecture& architecture,
+                         const Config& config)
+      : Compiler(architecture, config) {}
+  ListSchedulingCompiler(const Architecture& architecture)
+      : Compiler(architecture) {}
+};
 /*============================== INSTANTIATIONS ==============================*/
 COMPILER_TEST(RoutingAgnosticCompiler, routingAgnosticConfiguration);
 COMPILER_TEST(RoutingAwareCompiler, routingAwareConfiguration);
+COMPILER_TEST(ListSchedulingCompiler, routingAwareConfiguration);
 
 // Tests that the bug described in issue
 // https://github.com/munich-quantum-toolkit/qmap/issues/727 is fixed.
@@ -201,4 +217,70 @@ TEST(RoutingAwareCompilerTest, Issue727) {
   const auto& code = compiler.compile(circ);
   EXPECT_TRUE(code.validate().first);
 }
+
+TEST(RoutingAwareCompilerTest, Pipelining) {
+  qc::QuantumComputation circ(8);
+  for (size_t i = 0; i < 4; ++i) {
+    for (qc::Qubit q = 0; q < 8; ++q) {
+      circ.h(q);
+    }
+    for (qc::Qubit q = i % 2; q + 1 < 8; q += 2) {
+      circ.cz(q, q + 1);
+    }
+  }
+  const auto arch = Architecture::fromJSONString(architectureSpecification);
+  auto config = nlohmann::json::parse(routingAwareConfiguration)
+                    .get<RoutingAwareCompiler::Config>();
+  RoutingAwareCompiler sequentialCompiler(arch, config);
+  config.pipelining = true;
+  config.pipelineQueueCapacity = 1;
+  RoutingAwareCompiler pipelinedCompiler(arch, config);
+  const auto& sequentialCode = sequentialCompiler.compile(circ);
+  const auto& pipelinedCode = pipelinedCompiler.compile(circ);
+  EXPECT_TRUE(pipelinedCode.validate().first);
+  EXPECT_EQ(pipelinedCode.toString(), sequentialCode.toString());
+}
+
+TEST(RoutingAwareCompilerTest, CompileBatch) {
+  std::vector<qc::QuantumComputation> circuits;
+  for (size_t n = 2; n <= 8; ++n) {
+    auto& circ = circuits.emplace_back(n);
+    for (size_t i = 0; i < n; ++i) {
+      for (qc::Qubit q = 0; q < n; ++q) {
+        circ.h(q);
+      }
+      for (qc::Qubit q = i % 2; q + 1 < n; q += 2) {
+        circ.cz(q, q + 1);
+      }
+    }
+  }
+  const auto arch = Architecture::fromJSONString(architectureSpecification);
+  const auto config = nlohmann::json::parse(routingAwareConfiguration)
+                          .get<RoutingAwareCompiler::Config>();
+  const RoutingAwareCompiler compiler(arch, config);
+  const auto& results = compiler.compileBatch(circuits, 3);
+  ASSERT_EQ(results.size(), circuits.size());
+  RoutingAwareCompiler sequentialCompiler(arch, config);
+  for (size_t i = 0; i < circuits.size(); ++i) {
+    EXPECT_TRUE(results[i].code.validate().first);
+    EXPECT_EQ(results[i].code.toString(),
+              sequentialCompiler.compile(circuits[i]).toString());
+    EXPECT_GE(results[i].statistics.totalTime, 0);
+  }
+}
+
+TEST(RoutingAwareCompilerTest, CompileBatchEmpty) {
+  const auto arch = Architecture::fromJSONString(architectureSpecification);
+  const RoutingAwareCompiler compiler(arch);
+  EXPECT_TRUE(compiler.compileBatch({}).empty());
+}
+
+TEST(RoutingAwareCompilerTest, LogLevelIsNotGlobal) {
+  const auto globalLevel = spdlog::get_level();
+  const auto arch = Architecture::fromJSONString(architectureSpecification);
+  RoutingAwareCompiler::Config config;
+  config.logLevel = spdlog::level::off;
+  [[maybe_unused]] const RoutingAwareCompiler compiler(arch, config);
+  EXPECT_EQ(spdlog::get_level(), globalLevel);
+}
 } // namespace na::zoned
@@ -8,14 +8,19 @@
  * Licensed under the MIT License
  */
 
+#include "na/zoned/PlacementSequence.hpp"
 #include "na/zoned/layout_synthesizer/router/IndependentSetRouter.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <gmock/gmock-matchers.h>
 #include <gmock/gmock-more-matchers.h>
 #include <gtest/gtest.h>
 #include <map>
+#include <numeric>
 #include <optional>
+#include <random>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -183,4 +188,74 @@ TEST_F(IndependentSetRouterRouteTest, Array) {
       ::testing::ElementsAre(::testing::UnorderedElementsAre(
           ::testing::UnorderedElementsAre(0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U))));
 }
+TEST_F(IndependentSetRouterRouteTest, PlacementSequence) {
+  const auto& storage = *architecture.storageZones.front();
+  const auto& entanglementLeft =
+      architecture.entanglementZones.front()->front();
+  const auto& entanglementRight =
+      architecture.entanglementZones.front()->back();
+  const std::vector<Placement> placement{
+      {{storage, 18, 0}, {storage, 18, 1}, {storage, 19, 0}, {storage, 19, 1}},
+      {{entanglementLeft, 1, 0},
+       {entanglementRight, 1, 0},
+       {entanglementLeft, 0, 0},
+       {entanglementRight, 0, 0}},
+      {{entanglementLeft, 1, 0},
+       {entanglementRight, 1, 0},
+       {storage, 19, 0},
+       {storage, 19, 1}},
+      {{storage, 18, 0}, {storage, 18, 1}, {storage, 19, 0}, {storage, 19, 1}}};
+  std::vector<int64_t> routingTimes;
+  EXPECT_EQ(router.route(PlacementSequence(architecture, placement, 2),
+                         &routingTimes),
+            router.route(placement));
+  // one time is recorded for every transition between two placements
+  EXPECT_THAT(routingTimes, ::testing::SizeIs(placement.size() - 1));
+}
+TEST(IndependentSetRouterTest, ConflictGraph) {
+  const auto architecture = Architecture::fromJSONString(architectureJson);
+  const IndependentSetRouter router(architecture, {});
+  const auto& storage = *architecture.storageZones.front();
+  const auto& entanglement = architecture.entanglementZones.front()->front();
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<size_t> storageIndex(0, 19);
+  std::uniform_int_distribution<size_t> entanglementIndex(0, 3);
+  // few distinct rows and columns lead to many equal coordinates
+  constexpr qc::Qubit nAtoms = 150;
+  Placement start;
+  Placement target;
+  for (qc::Qubit atom = 0; atom < nAtoms; ++atom) {
+    start.emplace_back(storage, storageIndex(gen) % 5, storageIndex(gen));
+    if (atom % 3 == 0) {
+      target.emplace_back(entanglement, entanglementIndex(gen),
+                          entanglementIndex(gen));
+    } else {
+      target.emplace_back(storage, storageIndex(gen), storageIndex(gen) % 5);
+    }
+  }
+  std::vector<qc::Qubit> atoms(nAtoms);
+  std::iota(atoms.begin(), atoms.end(), 0);
+  std::shuffle(atoms.begin(), atoms.end(), gen);
+  const auto& graph = router.createConflictGraph(atoms, start, target);
+  ASSERT_THAT(graph, ::testing::SizeIs(nAtoms));
+  for (size_t i = 0; i < nAtoms; ++i) {
+    for (size_t j = 0; j < nAtoms; ++j) {
+      const auto compatible = IndependentSetRouter::isCompatibleMovement(
+          router.getMovementVector(start[atoms[i]], target[atoms[i]]),
+          router.getMovementVector(start[atoms[j]], target[atoms[j]]));
+      EXPECT_EQ((graph[i][j / 64] >> (j % 64) & 1) == 0, compatible)
+          << "atoms " << atoms[i] << " and " << atoms[j];
+    }
+  }
+  // every group must be free of conflicts
+  for (const auto& group : router.route(start, target)) {
+    for (const auto atom : group) {
+      for (const auto other : group) {
+        EXPECT_TRUE(IndependentSetRouter::isCompatibleMovement(
+            router.getMovementVector(start[atom], target[atom]),
+            router.getMovementVector(start[other], target[other])));
+      }
+    }
+  }
+}
 } // namespace na::zoned
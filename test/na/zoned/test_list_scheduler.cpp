@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2023 - 2025 Chair for Design Automation, TUM
+ * Copyright (c) 2025 Munich Quantum Software Company GmbH
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/StandardOperation.hpp"
+#include "na/zoned/scheduler/ASAPScheduler.hpp"
+#include "na/zoned/scheduler/ListScheduler.hpp"
+#include "qasm3/Importer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest.h>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace testing {
+// NOLINTNEXTLINE(modernize-use-trailing-return-type)
+MATCHER_P(RefEq, value, "") { return arg.get() == value; }
+} // namespace testing
+namespace na::zoned {
+constexpr std::string_view architectureJson = R"({
+  "name": "list_scheduler_architecture",
+  "storage_zones": [{
+    "zone_id": 0,
+    "slms": [{"id": 0, "site_separation": [3, 3], "r": 20, "c": 20, "location": [0, 0]}],
+    "offset": [0, 0],
+    "dimension": [60, 60]
+  }],
+  "entanglement_zones": [{
+    "zone_id": 0,
+    "slms": [
+      {"id": 1, "site_separation": [12, 10], "r": 4, "c": 4, "location": [5, 70]},
+      {"id": 2, "site_separation": [12, 10], "r": 4, "c": 4, "location": [7, 70]}
+    ],
+    "offset": [5, 70],
+    "dimension": [50, 40]
+  }],
+  "aods":[{"id": 0, "site_separation": 2, "r": 20, "c": 20}],
+  "rydberg_range": [[[5, 70], [55, 110]]]
+})";
+class ListSchedulerScheduleTest : public ::testing::Test {
+protected:
+  Architecture architecture;
+  ListScheduler::Config config;
+  ListScheduler scheduler;
+  ListSchedulerScheduleTest()
+      : architecture(Architecture::fromJSONString(architectureJson)),
+        scheduler(architecture, config) {}
+};
+TEST_F(ListSchedulerScheduleTest, NoGate) {
+  qc::QuantumComputation qc;
+  const auto& [singleQubitGateLayers, twoQubitGateLayers] =
+      scheduler.schedule(qc);
+  EXPECT_THAT(singleQubitGateLayers, ::testing::IsEmpty());
+  EXPECT_THAT(twoQubitGateLayers, ::testing::IsEmpty());
+}
+TEST_F(ListSchedulerScheduleTest, SingleQubitGate) {
+  //    ┌───────┐
+  // q: ┤ Rz(π) ├
+  //    └───────┘
+  qc::QuantumComputation qc(1);
+  qc.rz(qc::PI, 0);
+  const auto& [singleQubitGateLayers, twoQubitGateLayers] =
+      scheduler.schedule(qc);
+  EXPECT_THAT(singleQubitGateLayers,
+              ::testing::ElementsAre(::testing::ElementsAre(::testing::RefEq(
+                  static_cast<qc::StandardOperation&>(*qc.at(0))))));
+  EXPECT_THAT(twoQubitGateLayers, ::testing::IsEmpty());
+}
+TEST_F(ListSchedulerScheduleTest, TwoQubitGate) {
+  // q_0: ─■─
+  //       │
+  // q_1: ─■─
+  qc::QuantumComputation qc(2);
+  qc.cz(0, 1);
+  const auto& [singleQubitGateLayers, twoQubitGateLayers] =
+      scheduler.schedule(qc);
+  EXPECT_THAT(
+      singleQubitGateLayers,
+      ::testing::ElementsAre(::testing::IsEmpty(), ::testing::IsEmpty()));
+  EXPECT_THAT(twoQubitGateLayers,
+              ::testing::UnorderedElementsAre(::testing::ElementsAre(
+                  ::testing::UnorderedElementsAre(0U, 1U))));
+}
+TEST_F(ListSchedulerScheduleTest, CommutingSequence) {
+  //            INPUT ORDER                    SCHEDULED ORDER
+  // q_0: ─■───────  >>>  ─■────
+  //       │         >>>   │
+  // q_1: ─■──■────  >>>  ─■──■─
+  //          │      >>>      │
+  // q_2: ────■──■─  >>>  ─■──■─
+  //             │   >>>   │
+  // q_3: ───────■─  >>>  ─■────
+  qc::QuantumComputation qc(4);
+  qc.cz(0, 1);
+  qc.cz(1, 2);
+  qc.cz(2, 3);
+  const auto& [singleQubitGateLayers, twoQubitGateLayers] =
+      scheduler.schedule(qc);
+  EXPECT_THAT(singleQubitGateLayers, ::testing::SizeIs(3));
+  EXPECT_THAT(singleQubitGateLayers, ::testing::Each(::testing::IsEmpty()));
+  EXPECT_THAT(
+      twoQubitGateLayers,
+      ::testing::ElementsAre(::testing::UnorderedElementsAre(
+                                 ::testing::UnorderedElementsAre(0U, 1U),
+                                 ::testing::UnorderedElementsAre(2U, 3U)),
+                             ::testing::UnorderedElementsAre(
+                                 ::testing::UnorderedElementsAre(1U, 2U))));
+}
+TEST_F(ListSchedulerScheduleTest, DiagonalGate) {
+  // the diagonal gate commutes with both CZ gates and is executed first
+  // q_0: ─────────■──────────
+  //               │
+  // q_1: ─────────■─[Rz(π)]─■─
+  //                         │
+  // q_2: ───────────────────■─
+  qc::QuantumComputation qc(3);
+  qc.cz(0, 1);
+  qc.rz(qc::PI, 1);
+  qc.cz(1, 2);
+  const auto& [singleQubitGateLayers, twoQubitGateLayers] =
+      scheduler.schedule(qc);
+  EXPECT_THAT(singleQubitGateLayers,
+              ::testing::ElementsAre(
+                  ::testing::ElementsAre(::testing::RefEq(
+                      static_cast<qc::StandardOperation&>(*qc.at(1)))),
+                  ::testing::IsEmpty(), ::testing::IsEmpty()));
+  EXPECT_THAT(twoQubitGateLayers, ::testing::SizeIs(2));
+}
+TEST_F(ListSchedulerScheduleTest, NonDiagonalGate) {
+  // the Hadamard gate does not commute with the CZ gates and keeps their order
+  // q_0: ───────■───────────
+  //             │
+  // q_1: ───────■──[H]──■───
+  //                     │
+  // q_2: ───────────────■───
+  qc::QuantumComputation qc(3);
+  qc.cz(1, 2);
+  qc.h(1);
+  qc.cz(0, 1);
+  const auto& [singleQubitGateLayers, twoQubitGateLayers] =
+      scheduler.schedule(qc);
+  EXPECT_THAT(singleQubitGateLayers,
+              ::testing::ElementsAre(
+                  ::testing::IsEmpty(),
+                  ::testing::ElementsAre(::testing::RefEq(
+                      static_cast<qc::StandardOperation&>(*qc.at(1)))),
+                  ::testing::IsEmpty()));
+  EXPECT_THAT(
+      twoQubitGateLayers,
+      ::testing::ElementsAre(::testing::UnorderedElementsAre(
+                                 ::testing::UnorderedElementsAre(1U, 2U)),
+                             ::testing::UnorderedElementsAre(
+                                 ::testing::UnorderedElementsAre(0U, 1U))));
+}
+TEST_F(ListSchedulerScheduleTest, CriticalPath) {
+  // q_0 is involved in three CZ gates, hence, its gates are scheduled first
+  // q_0: ─■──■──■────
+  //       │  │  │
+  // q_1: ─┼──┼──■──■─
+  //       │  │     │
+  // q_2: ─┼──■─────■─
+  //       │
+  // q_3: ─■──────────
+  qc::QuantumComputation qc(4);
+  qc.cz(1, 2);
+  qc.cz(0, 3);
+  qc.cz(0, 2);
+  qc.cz(0, 1);
+  const auto& [singleQubitGateLayers, twoQubitGateLayers] =
+      scheduler.schedule(qc);
+  EXPECT_THAT(twoQubitGateLayers, ::testing::SizeIs(3));
+  for (const auto& layer : twoQubitGateLayers) {
+    EXPECT_THAT(layer, ::testing::Contains(::testing::Contains(0U)));
+  }
+}
+TEST_F(ListSchedulerScheduleTest, Capacity) {
+  // the entanglement zone offers 16 sites, hence, 20 parallel CZ gates are
+  // split into two layers
+  qc::QuantumComputation qc(40);
+  for (qc::Qubit q = 0; q < 40; q += 2) {
+    qc.cz(q, q + 1);
+  }
+  const auto& [singleQubitGateLayers, twoQubitGateLayers] =
+      scheduler.schedule(qc);
+  EXPECT_THAT(twoQubitGateLayers,
+              ::testing::ElementsAre(::testing::SizeIs(16),
+                                     ::testing::SizeIs(4)));
+}
+TEST_F(ListSchedulerScheduleTest, Barrier) {
+  // q_0: ─■─────────░───
+  //       │┌───────┐░
+  // q_1: ─■┤ Rz(π) ├░───
+  //        └───────┘░
+  // q_2: ───────────░─■─
+  //                 ░ │
+  // q_3: ───────────░─■─
+  qc::QuantumComputation qc(4);
+  qc.cz(0, 1);
+  qc.rz(qc::PI, 1);
+  qc.barrier();
+  qc.cz(2, 3);
+  const auto& [singleQubitGateLayers, twoQubitGateLayers] =
+      scheduler.schedule(qc);
+  EXPECT_THAT(singleQubitGateLayers,
+              ::testing::ElementsAre(
+                  ::testing::ElementsAre(::testing::RefEq(
+                      static_cast<qc::StandardOperation&>(*qc.at(1)))),
+                  ::testing::IsEmpty(), ::testing::IsEmpty()));
+  EXPECT_THAT(
+      twoQubitGateLayers,
+      ::testing::ElementsAre(::testing::UnorderedElementsAre(
+                                 ::testing::UnorderedElementsAre(0U, 1U)),
+                             ::testing::UnorderedElementsAre(
+                                 ::testing::UnorderedElementsAre(2U, 3U))));
+}
+TEST_F(ListSchedulerScheduleTest, NonGlobalBarrier) {
+  // q_0: ─░─
+  //
+  // q_1: ───
+  qc::QuantumComputation qc(2);
+  qc.emplace_back<qc::StandardOperation>(0, qc::Barrier);
+  EXPECT_THROW(std::ignore = scheduler.schedule(qc), std::invalid_argument);
+}
+TEST_F(ListSchedulerScheduleTest, UnsupportedCXGate) {
+  qc::QuantumComputation qc(2);
+  qc.cx(0, 1);
+  EXPECT_THROW(std::ignore = scheduler.schedule(qc), std::invalid_argument);
+}
+namespace {
+/// @returns true if a single-qubit gate of this type commutes with CZ gates
+auto isDiagonal(const qc::OpType type) -> bool {
+  return type == qc::I || type == qc::Z || type == qc::S || type == qc::Sdg ||
+         type == qc::T || type == qc::Tdg || type == qc::P || type == qc::RZ;
+}
+/**
+ * Checks that the schedule contains every operation of the circuit exactly
+ * once, respects the dependencies between the operations, and never exceeds
+ * the capacity of the entanglement zones.
+ * @details The CZ gates acting on a qubit are divided into blocks by the
+ * non-diagonal single-qubit gates, global operations, and barriers. Within a
+ * block, CZ gates and diagonal single-qubit gates may be reordered freely.
+ */
+auto expectValidSchedule(
+    const qc::QuantumComputation& qc, const Architecture& architecture,
+    const std::vector<SingleQubitGateLayer>& singleQubitGateLayers,
+    const std::vector<TwoQubitGateLayer>& twoQubitGateLayers) -> void {
+  const auto nQubits = qc.getNqubits();
+  size_t capacity = 0;
+  for (const auto& zone : architecture.entanglementZones) {
+    capacity += zone->front().nRows * zone->front().nCols;
+  }
+  // the position of an operation in the schedule, where the single-qubit gate
+  // layer i precedes the two-qubit gate layer i
+  using Time = std::pair<size_t, size_t>;
+  std::unordered_map<const qc::Operation*, Time> singleQubitGateTimes;
+  for (size_t i = 0; i < singleQubitGateLayers.size(); ++i) {
+    for (size_t j = 0; j < singleQubitGateLayers[i].size(); ++j) {
+      EXPECT_TRUE(singleQubitGateTimes
+                      .emplace(&singleQubitGateLayers[i][j].get(),
+                               Time{2 * i, j})
+                      .second);
+    }
+  }
+  // the times of the CZ gates acting on every pair of qubits in increasing
+  // order
+  std::map<QubitPair, std::vector<Time>> twoQubitGateTimes;
+  for (size_t i = 0; i < twoQubitGateLayers.size(); ++i) {
+    EXPECT_LE(twoQubitGateLayers[i].size(), capacity);
+    std::vector<bool> used(nQubits, false);
+    for (const auto& [q1, q2] : twoQubitGateLayers[i]) {
+      EXPECT_FALSE(used[q1]);
+      EXPECT_FALSE(used[q2]);
+      used[q1] = true;
+      used[q2] = true;
+      twoQubitGateTimes[{std::min(q1, q2), std::max(q1, q2)}].emplace_back(
+          2 * i + 1, 0);
+    }
+  }
+  // for every qubit, the time of the operation that started the current block
+  // and the times of the operations in the current block
+  std::vector<std::optional<Time>> blockStart(nQubits);
+  std::vector<std::vector<Time>> block(nQubits);
+  std::optional<Time> latest;
+  const auto addToBlock = [&](const qc::Qubit q, const Time& time) {
+    EXPECT_TRUE(!blockStart[q].has_value() || *blockStart[q] < time);
+    block[q].emplace_back(time);
+  };
+  const auto startBlock = [&](const qc::Qubit q, const Time& time) {
+    EXPECT_TRUE(!blockStart[q].has_value() || *blockStart[q] < time);
+    for (const auto& t : block[q]) {
+      EXPECT_LT(t, time);
+    }
+    blockStart[q] = time;
+    block[q].clear();
+  };
+  size_t nSingleQubitGates = 0;
+  std::map<QubitPair, size_t> nTwoQubitGates;
+  for (const auto& op : qc) {
+    if (op->getType() == qc::Barrier) {
+      // all operations after the barrier succeed all operations before it
+      for (qc::Qubit q = 0; q < nQubits; ++q) {
+        blockStart[q] = latest;
+        block[q].clear();
+      }
+      continue;
+    }
+    Time time;
+    if (op->getNcontrols() == 0) {
+      const auto it = singleQubitGateTimes.find(op.get());
+      ASSERT_NE(it, singleQubitGateTimes.end());
+      ++nSingleQubitGates;
+      time = it->second;
+      if (op->isGlobal(nQubits) && nQubits > 1) {
+        for (qc::Qubit q = 0; q < nQubits; ++q) {
+          startBlock(q, time);
+        }
+      } else if (const auto q = op->getTargets().front();
+                 isDiagonal(op->getType())) {
+        addToBlock(q, time);
+      } else {
+        startBlock(q, time);
+      }
+    } else {
+      const auto q1 = op->getTargets().front();
+      const auto q2 = op->getControls().cbegin()->qubit;
+      const QubitPair qubits{std::min(q1, q2), std::max(q1, q2)};
+      // CZ gates acting on the same pair of qubits are interchangeable
+      const auto& times = twoQubitGateTimes[qubits];
+      auto& n = nTwoQubitGates[qubits];
+      ASSERT_LT(n, times.size());
+      time = times[n++];
+      addToBlock(q1, time);
+      addToBlock(q2, time);
+    }
+    latest = std::max(latest.value_or(time), time);
+  }
+  EXPECT_EQ(nSingleQubitGates, singleQubitGateTimes.size());
+  for (const auto& [qubits, times] : twoQubitGateTimes) {
+    EXPECT_EQ(nTwoQubitGates[qubits], times.size());
+  }
+}
+} // namespace
+/// Compares the number of layers and the scheduling time with the ASAPScheduler
+class ListSchedulerBenchmark : public ::testing::TestWithParam<std::string> {
+protected:
+  Architecture architecture;
+  ASAPScheduler asapScheduler;
+  ListScheduler listScheduler;
+  ListSchedulerBenchmark()
+      : architecture(Architecture::fromJSONString(architectureJson)),
+        asapScheduler(architecture, {}), listScheduler(architecture, {}) {}
+};
+TEST_P(ListSchedulerBenchmark, CompareWithASAP) {
+  const auto qc = qasm3::Importer::importf(GetParam());
+  const auto asapStart = std::chrono::system_clock::now();
+  const auto& [asapSingleQubitGateLayers, asapTwoQubitGateLayers] =
+      asapScheduler.schedule(qc);
+  const auto listStart = std::chrono::system_clock::now();
+  const auto& [singleQubitGateLayers, twoQubitGateLayers] =
+      listScheduler.schedule(qc);
+  const auto listEnd = std::chrono::system_clock::now();
+  const auto asapTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                            listStart - asapStart)
+                            .count();
+  const auto listTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                            listEnd - listStart)
+                            .count();
+  RecordProperty("asapLayers", std::to_string(asapTwoQubitGateLayers.size()));
+  RecordProperty("listLayers", std::to_string(twoQubitGateLayers.size()));
+  RecordProperty("asapTime", std::to_string(asapTime));
+  RecordProperty("listTime", std::to_string(listTime));
+  // the list scheduler is a heuristic, hence, it is not guaranteed to require
+  // fewer layers than the ASAP scheduler
+  EXPECT_EQ(singleQubitGateLayers.size(), twoQubitGateLayers.size() + 1);
+  expectValidSchedule(qc, architecture, singleQubitGateLayers,
+                      twoQubitGateLayers);
+  // every qubit is involved in at most one CZ gate per layer, hence, the CZ
+  // gates of the busiest qubit are a lower bound for the number of layers
+  std::vector<size_t> nGatesOfQubit(qc.getNqubits(), 0);
+  for (const auto& op : qc) {
+    if (op->getNcontrols() == 1) {
+      ++nGatesOfQubit[op->getTargets().front()];
+      ++nGatesOfQubit[op->getControls().cbegin()->qubit];
+    }
+  }
+  EXPECT_GE(twoQubitGateLayers.size(),
+            *std::max_element(nGatesOfQubit.begin(), nGatesOfQubit.end()));
+}
+INSTANTIATE_TEST_SUITE_P(
+    ListSchedulerBenchmarkWithCircuits, ListSchedulerBenchmark,
+    ::testing::Values(TEST_CIRCUITS),
+    [](const ::testing::TestParamInfo<std::string>& pinfo) {
+      const auto& path = pinfo.param;
+      const auto& filename = path.substr(path.find_last_of('/') + 1);
+      return filename.substr(0, filename.find_last_of('.'));
+    });
+} // namespace na::zoned
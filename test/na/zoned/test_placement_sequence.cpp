@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2023 - 2025 Chair for Design Automation, TUM
+ * Copyright (c) 2025 Munich Quantum Software Company GmbH
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "na/zoned/Architecture.hpp"
+#include "na/zoned/PlacementSequence.hpp"
+#include "na/zoned/Types.hpp"
+
+#include <cstddef>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest.h>
+#include <string_view>
+#include <vector>
+
+namespace na::zoned {
+constexpr std::string_view architectureJson = R"({
+  "name": "placement_sequence_architecture",
+  "storage_zones": [{
+    "zone_id": 0,
+    "slms": [{"id": 0, "site_separation": [3, 3], "r": 20, "c": 20, "location": [0, 0]}],
+    "offset": [0, 0],
+    "dimension": [60, 60]
+  }],
+  "entanglement_zones": [{
+    "zone_id": 0,
+    "slms": [
+      {"id": 1, "site_separation": [12, 10], "r": 4, "c": 4, "location": [5, 70]},
+      {"id": 2, "site_separation": [12, 10], "r": 4, "c": 4, "location": [7, 70]}
+    ],
+    "offset": [5, 70],
+    "dimension": [50, 40]
+  }],
+  "aods":[{"id": 0, "site_separation": 2, "r": 20, "c": 20}],
+  "rydberg_range": [[[5, 70], [55, 110]]]
+})";
+class PlacementSequenceTest : public ::testing::Test {
+protected:
+  Architecture architecture;
+  std::vector<Placement> placements;
+  PlacementSequenceTest()
+      : architecture(Architecture::fromJSONString(architectureJson)) {
+    const auto& storage = *architecture.storageZones.front();
+    const auto& entanglementLeft =
+        architecture.entanglementZones.front()->front();
+    const auto& entanglementRight =
+        architecture.entanglementZones.front()->back();
+    placements = {
+        {{storage, 19, 0}, {storage, 19, 1}, {storage, 19, 2}},
+        {{entanglementLeft, 0, 0}, {entanglementRight, 0, 0}, {storage, 19, 2}},
+        {{storage, 19, 0}, {storage, 19, 1}, {storage, 19, 2}},
+        {{storage, 19, 0}, {entanglementLeft, 1, 1}, {entanglementRight, 1, 1}},
+        {{storage, 19, 0}, {storage, 18, 1}, {storage, 19, 2}}};
+  }
+};
+TEST_F(PlacementSequenceTest, SiteIds) {
+  EXPECT_EQ(architecture.getNumberOfSites(), (20 * 20) + (2 * 4 * 4));
+  for (SiteId id = 0; id < architecture.getNumberOfSites(); ++id) {
+    EXPECT_EQ(architecture.getSiteId(architecture.getSite(id)), id);
+  }
+  // storage sites are numbered before entanglement sites
+  const auto& storage = *architecture.storageZones.front();
+  EXPECT_EQ(architecture.getSiteId(storage, 0, 0), 0);
+  EXPECT_EQ(architecture.getSiteId(storage, 1, 0), 20);
+}
+TEST_F(PlacementSequenceTest, Empty) {
+  const PlacementSequence sequence(architecture);
+  EXPECT_TRUE(sequence.empty());
+  EXPECT_THAT(sequence.toVector(), ::testing::IsEmpty());
+}
+TEST_F(PlacementSequenceTest, RoundTrip) {
+  const PlacementSequence sequence(architecture, placements);
+  EXPECT_EQ(sequence.size(), placements.size());
+  EXPECT_EQ(sequence.getNumberOfAtoms(), 3);
+  EXPECT_EQ(sequence.toVector(), placements);
+  EXPECT_EQ(sequence.back(), placements.back());
+}
+TEST_F(PlacementSequenceTest, Moves) {
+  const PlacementSequence sequence(architecture, placements);
+  // std::span lacks const_iterator before C++23, hence, copy the moves
+  const auto getMoves = [&sequence](const size_t i) {
+    const auto moves = sequence.getMoves(i);
+    return std::vector(moves.begin(), moves.end());
+  };
+  EXPECT_THAT(getMoves(0), ::testing::IsEmpty());
+  const auto& entanglementLeft =
+      architecture.entanglementZones.front()->front();
+  const auto& entanglementRight =
+      architecture.entanglementZones.front()->back();
+  EXPECT_THAT(getMoves(1),
+              ::testing::ElementsAre(
+                  PlacementSequence::Move{
+                      0, architecture.getSiteId(entanglementLeft, 0, 0)},
+                  PlacementSequence::Move{
+                      1, architecture.getSiteId(entanglementRight, 0, 0)}));
+  const auto& storage = *architecture.storageZones.front();
+  EXPECT_THAT(
+      getMoves(4),
+      ::testing::ElementsAre(
+          PlacementSequence::Move{1, architecture.getSiteId(storage, 18, 1)},
+          PlacementSequence::Move{2, architecture.getSiteId(storage, 19, 2)}));
+}
+TEST_F(PlacementSequenceTest, RandomAccess) {
+  // a small checkpoint interval such that some placements are reconstructed
+  // from a checkpoint and others are stored in full
+  const PlacementSequence sequence(architecture, placements, 2);
+  for (size_t i = placements.size(); i > 0; --i) {
+    EXPECT_EQ(sequence.getPlacement(i - 1), placements[i - 1]);
+  }
+}
+TEST_F(PlacementSequenceTest, ApplyMoves) {
+  const PlacementSequence sequence(architecture, placements);
+  auto placement = sequence.front();
+  for (size_t i = 1; i < sequence.size(); ++i) {
+    sequence.applyMoves(i, placement);
+    EXPECT_EQ(placement, placements[i]);
+  }
+}
+} // namespace na::zoned
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2023 - 2025 Chair for Design Automation, TUM
+ * Copyright (c) 2025 Munich Quantum Software Company GmbH
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "na/zoned/Architecture.hpp"
+#include "na/zoned/SiteIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <gmock/gmock-matchers.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest.h>
+#include <random>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace na::zoned {
+constexpr std::string_view architectureJson = R"({
+  "name": "site_index_architecture",
+  "storage_zones": [{
+    "zone_id": 0,
+    "slms": [
+      {"id": 0, "site_separation": [3, 3], "r": 20, "c": 20, "location": [0, 0]},
+      {"id": 3, "site_separation": [4, 2], "r": 5, "c": 10, "location": [70, 10]}
+    ],
+    "offset": [0, 0],
+    "dimension": [120, 60]
+  }],
+  "entanglement_zones": [{
+    "zone_id": 0,
+    "slms": [
+      {"id": 1, "site_separation": [12, 10], "r": 4, "c": 4, "location": [5, 70]},
+      {"id": 2, "site_separation": [12, 10], "r": 4, "c": 4, "location": [7, 70]}
+    ],
+    "offset": [5, 70],
+    "dimension": [50, 40]
+  }],
+  "aods":[{"id": 0, "site_separation": 2, "r": 20, "c": 20}],
+  "rydberg_range": [[[5, 70], [55, 110]]]
+})";
+class SiteIndexTest : public ::testing::Test {
+protected:
+  Architecture architecture;
+  SiteIndex index;
+  SiteIndexTest()
+      : architecture(Architecture::fromJSONString(architectureJson)),
+        index(architecture, 0, architecture.getNumberOfStorageSites()) {}
+
+  /// @returns the sites of the index sorted by their distance to (x, y)
+  [[nodiscard]] auto sortedByDistance(const std::size_t x,
+                                      const std::size_t y) const
+      -> std::vector<std::pair<double, SiteId>> {
+    std::vector<std::pair<double, SiteId>> sites;
+    for (SiteId site = 0; site < architecture.getNumberOfSites(); ++site) {
+      if (index.contains(site)) {
+        const auto& [siteX, siteY] = architecture.getSiteLocation(site);
+        sites.emplace_back(
+            std::hypot(static_cast<double>(siteX) - static_cast<double>(x),
+                       static_cast<double>(siteY) - static_cast<double>(y)),
+            site);
+      }
+    }
+    std::sort(sites.begin(), sites.end());
+    return sites;
+  }
+};
+TEST_F(SiteIndexTest, Empty) {
+  EXPECT_TRUE(index.empty());
+  EXPECT_THAT(index.nearest(0, 0, 5), ::testing::IsEmpty());
+  EXPECT_THAT(index.withinRadius(0, 0, 100), ::testing::IsEmpty());
+}
+TEST_F(SiteIndexTest, InsertErase) {
+  EXPECT_TRUE(index.insert(3));
+  EXPECT_FALSE(index.insert(3));
+  EXPECT_TRUE(index.insert(4));
+  EXPECT_EQ(index.size(), 2);
+  EXPECT_TRUE(index.contains(3));
+  EXPECT_TRUE(index.erase(3));
+  EXPECT_FALSE(index.erase(3));
+  EXPECT_FALSE(index.contains(3));
+  EXPECT_TRUE(index.contains(4));
+  EXPECT_EQ(index.size(), 1);
+  // entanglement sites are not covered by the index
+  EXPECT_FALSE(index.covers(architecture.getNumberOfStorageSites()));
+  EXPECT_FALSE(index.contains(architecture.getNumberOfStorageSites()));
+  index.fill();
+  EXPECT_EQ(index.size(), architecture.getNumberOfStorageSites());
+}
+TEST_F(SiteIndexTest, Nearest) {
+  index.fill();
+  const auto& slm = *architecture.storageZones.front();
+  // the nearest site of a site is the site itself
+  EXPECT_THAT(index.nearest(3, 3, 1),
+              ::testing::ElementsAre(architecture.getSiteId(slm, 1, 1)));
+  // ties are broken by the site id
+  EXPECT_THAT(index.nearest(3, 3, 5),
+              ::testing::ElementsAre(architecture.getSiteId(slm, 1, 1),
+                                     architecture.getSiteId(slm, 0, 1),
+                                     architecture.getSiteId(slm, 1, 0),
+                                     architecture.getSiteId(slm, 1, 2),
+                                     architecture.getSiteId(slm, 2, 1)));
+  // a query outside of the zone
+  EXPECT_THAT(index.nearest(1000, 0, 1),
+              ::testing::ElementsAre(architecture.getSiteId(
+                  *architecture.storageZones.back(), 0, 9)));
+}
+TEST_F(SiteIndexTest, NearestRandom) {
+  index.fill();
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<SiteId> site(
+      0, architecture.getNumberOfStorageSites() - 1);
+  std::uniform_int_distribution<std::size_t> coordinate(0, 150);
+  for (std::size_t i = 0; i < 200; ++i) {
+    // remove some sites to resemble occupied sites
+    index.erase(site(gen));
+    const auto x = coordinate(gen);
+    const auto y = coordinate(gen);
+    const auto k = 1 + (i % 40);
+    const auto& expected = sortedByDistance(x, y);
+    const auto& result = index.nearest(x, y, k);
+    ASSERT_EQ(result.size(), std::min(k, expected.size()));
+    for (std::size_t j = 0; j < result.size(); ++j) {
+      EXPECT_EQ(result[j], expected[j].second);
+    }
+  }
+}
+TEST_F(SiteIndexTest, WithinRadius) {
+  index.fill();
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<SiteId> site(
+      0, architecture.getNumberOfStorageSites() - 1);
+  std::uniform_int_distribution<std::size_t> coordinate(0, 150);
+  std::uniform_real_distribution<double> radius(0.0, 30.0);
+  for (std::size_t i = 0; i < 200; ++i) {
+    index.erase(site(gen));
+    const auto x = coordinate(gen);
+    const auto y = coordinate(gen);
+    const auto r = radius(gen);
+    std::vector<SiteId> expected;
+    for (const auto& [d, s] : sortedByDistance(x, y)) {
+      if (d <= r) {
+        expected.emplace_back(s);
+      }
+    }
+    EXPECT_EQ(index.withinRadius(x, y, r), expected);
+  }
+}
+TEST_F(SiteIndexTest, LargeZone) {
+  // the number of visited sites does not depend on the size of the zone,
+  // hence, this query is fast also for a large zone
+  auto spec = nlohmann::json::parse(architectureJson);
+  spec["storage_zones"][0]["slms"][0]["r"] = 500;
+  spec["storage_zones"][0]["slms"][0]["c"] = 500;
+  spec["storage_zones"][0]["dimension"] = {1500, 1500};
+  for (auto& slm : spec["entanglement_zones"][0]["slms"]) {
+    slm["location"][1] = 1510;
+  }
+  spec["entanglement_zones"][0]["offset"][1] = 1510;
+  spec["rydberg_range"] = {{{5, 1510}, {55, 1550}}};
+  const auto arch = Architecture::fromJSON(spec);
+  SiteIndex largeIndex(arch, 0, arch.getNumberOfStorageSites());
+  largeIndex.fill();
+  const auto& slm = *arch.storageZones.front();
+  largeIndex.erase(arch.getSiteId(slm, 250, 250));
+  const auto& result = largeIndex.nearest(750, 750, 4);
+  EXPECT_THAT(result, ::testing::UnorderedElementsAre(
+                          arch.getSiteId(slm, 249, 250),
+                          arch.getSiteId(slm, 251, 250),
+                          arch.getSiteId(slm, 250, 249),
+                          arch.getSiteId(slm, 250, 251)));
+}
+} // namespace na::zoned
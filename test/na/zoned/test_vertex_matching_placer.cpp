@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 #include <map>
 #include <optional>
+#include <random>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -214,6 +215,34 @@ TEST_F(VertexMatchingPlacerPlaceTest, TwoTwoQubitLayerReuse) {
   EXPECT_EQ(std::get<1>(placement[2][1]), std::get<1>(placement[3][1]));
   EXPECT_EQ(std::get<2>(placement[2][1]), std::get<2>(placement[3][1]));
 }
+TEST_F(VertexMatchingPlacerPlaceTest, DenseMatching) {
+  config["denseMatching"] = true;
+  VertexMatchingPlacer densePlacer(architecture, config);
+  constexpr size_t nQubits = 8;
+  const std::vector<std::vector<std::array<qc::Qubit, 2>>> layers{
+      {{0U, 1U}, {2U, 3U}, {4U, 5U}, {6U, 7U}},
+      {{1U, 2U}, {3U, 4U}, {5U, 6U}, {7U, 0U}}};
+  const std::vector<std::unordered_set<qc::Qubit>> reuseQubits{{}};
+  const auto& placement = placer.place(nQubits, layers, reuseQubits);
+  const auto& densePlacement = densePlacer.place(nQubits, layers, reuseQubits);
+  ASSERT_THAT(densePlacement, ::testing::SizeIs(placement.size()));
+  // both matchings have minimum weight, hence, the occupied sites coincide
+  // unless there are ties
+  for (size_t i = 0; i < placement.size(); ++i) {
+    std::unordered_set<std::pair<size_t, size_t>> locations;
+    std::unordered_set<std::pair<size_t, size_t>> denseLocations;
+    for (qc::Qubit q = 0; q < nQubits; ++q) {
+      const auto& [slm, r, c] = placement[i][q];
+      const auto& [denseSLM, denseR, denseC] = densePlacement[i][q];
+      EXPECT_EQ(slm.get().isStorage(), denseSLM.get().isStorage());
+      locations.emplace(architecture.exactSLMLocation(slm, r, c));
+      denseLocations.emplace(
+          architecture.exactSLMLocation(denseSLM, denseR, denseC));
+    }
+    EXPECT_THAT(locations, ::testing::SizeIs(nQubits));
+    EXPECT_THAT(denseLocations, ::testing::SizeIs(nQubits));
+  }
+}
 TEST(VertexMatchingPlacerTest, MinimumWeightFullBipartiteMatching1) {
   // We consider the following bipartite graph, where the nodes in the upper row
   // are the sources, and the nodes in the lower row are the sinks.
@@ -298,4 +327,130 @@ TEST(VertexMatchingPlacerTest, MinimumWeightFullBipartiteMatchingExceptions) {
                        {{0, std::nullopt}, {0}}),
                std::invalid_argument);
 }
+TEST(VertexMatchingPlacerTest, SparseMatching) {
+  // the same graphs as in the tests of the dense matching above
+  std::vector prices(5, 0.0);
+  EXPECT_THAT(VertexMatchingPlacer::sparseMinimumWeightFullBipartiteMatching(
+                  {{{0, 2}, {1, 1}, {2, 3}}, {{1, 2}, {2, 4}, {3, 4}},
+                   {{3, 2}, {4, 3}}},
+                  5, prices),
+              ::testing::ElementsAre(0, 1, 3));
+  std::fill(prices.begin(), prices.end(), 0.0);
+  EXPECT_THAT(VertexMatchingPlacer::sparseMinimumWeightFullBipartiteMatching(
+                  {{{0, 3}, {1, 3}, {2, 1}}, {{1, 2}, {2, 1}, {3, 1}},
+                   {{3, 1}, {4, 3}}},
+                  5, prices),
+              ::testing::ElementsAre(2, 1, 3));
+  prices.clear();
+  EXPECT_THAT(VertexMatchingPlacer::sparseMinimumWeightFullBipartiteMatching(
+                  {}, 0, prices),
+              ::testing::IsEmpty());
+  // without rows, the prices of the columns remain unchanged
+  prices = {1.0, 2.0};
+  EXPECT_THAT(VertexMatchingPlacer::sparseMinimumWeightFullBipartiteMatching(
+                  {}, 2, prices),
+              ::testing::IsEmpty());
+  EXPECT_THAT(prices, ::testing::ElementsAre(1.0, 2.0));
+}
+namespace {
+/// @returns the weight of @p matching in @p costMatrix
+auto matchingWeight(const std::vector<std::vector<std::optional<double>>>& m,
+                    const std::vector<size_t>& matching) -> double {
+  double weight = 0;
+  for (size_t row = 0; row < matching.size(); ++row) {
+    weight += m[row][matching[row]].value();
+  }
+  return weight;
+}
+/// @returns a random sparse instance that admits a full matching
+auto randomInstance(std::mt19937& gen, const size_t nRows, const size_t nCols)
+    -> std::vector<std::vector<std::optional<double>>> {
+  std::uniform_real_distribution cost(0.0, 10.0);
+  std::bernoulli_distribution edge(0.3);
+  std::vector matrix(nRows,
+                     std::vector<std::optional<double>>(nCols, std::nullopt));
+  for (size_t row = 0; row < nRows; ++row) {
+    // the diagonal guarantees the existence of a full matching
+    matrix[row][row] = cost(gen);
+    for (size_t col = 0; col < nCols; ++col) {
+      if (edge(gen)) {
+        matrix[row][col] = cost(gen);
+      }
+    }
+  }
+  return matrix;
+}
+auto toSparse(const std::vector<std::vector<std::optional<double>>>& matrix)
+    -> std::vector<std::vector<std::pair<size_t, double>>> {
+  std::vector<std::vector<std::pair<size_t, double>>> sparse(matrix.size());
+  for (size_t row = 0; row < matrix.size(); ++row) {
+    for (size_t col = 0; col < matrix[row].size(); ++col) {
+      if (matrix[row][col]) {
+        sparse[row].emplace_back(col, *matrix[row][col]);
+      }
+    }
+  }
+  return sparse;
+}
+} // namespace
+TEST(VertexMatchingPlacerTest, SparseMatchingRandom) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution price(-5.0, 5.0);
+  for (size_t i = 0; i < 50; ++i) {
+    const size_t nRows = 1 + (i % 12);
+    const size_t nCols = nRows + (i % 5);
+    const auto& matrix = randomInstance(gen, nRows, nCols);
+    const auto& dense =
+        VertexMatchingPlacer::minimumWeightFullBipartiteMatching(matrix);
+    std::vector prices(nCols, 0.0);
+    const auto& sparse =
+        VertexMatchingPlacer::sparseMinimumWeightFullBipartiteMatching(
+            toSparse(matrix), nCols, prices);
+    EXPECT_THAT(std::unordered_set(sparse.cbegin(), sparse.cend()),
+                ::testing::SizeIs(nRows));
+    EXPECT_NEAR(matchingWeight(matrix, sparse), matchingWeight(matrix, dense),
+                1e-9);
+    // arbitrary initial prices must not change the weight of the matching
+    for (auto& p : prices) {
+      p = price(gen);
+    }
+    const auto& shifted =
+        VertexMatchingPlacer::sparseMinimumWeightFullBipartiteMatching(
+            toSparse(matrix), nCols, prices);
+    EXPECT_NEAR(matchingWeight(matrix, shifted), matchingWeight(matrix, dense),
+                1e-9);
+  }
+}
+TEST(VertexMatchingPlacerTest, SparseMatchingWarmStart) {
+  std::mt19937 gen(7);
+  const auto& matrix = randomInstance(gen, 20, 25);
+  const auto& sparse = toSparse(matrix);
+  std::vector prices(25, 0.0);
+  const auto& cold =
+      VertexMatchingPlacer::sparseMinimumWeightFullBipartiteMatching(
+          sparse, 25, prices);
+  // with the final prices of the same instance, every row finds its partner
+  // at reduced cost zero
+  const auto& warm =
+      VertexMatchingPlacer::sparseMinimumWeightFullBipartiteMatching(
+          sparse, 25, prices);
+  EXPECT_NEAR(matchingWeight(matrix, warm), matchingWeight(matrix, cold),
+              1e-9);
+}
+TEST(VertexMatchingPlacerTest, SparseMatchingExceptions) {
+  const auto match =
+      [](const std::vector<std::vector<std::pair<size_t, double>>>& matrix,
+         const size_t nCols) {
+        std::vector prices(nCols, 0.0);
+        std::ignore =
+            VertexMatchingPlacer::sparseMinimumWeightFullBipartiteMatching(
+                matrix, nCols, prices);
+      };
+  // more rows than columns
+  EXPECT_THROW(match({{{0, 0}}, {{0, 0}}}, 1), std::invalid_argument);
+  // empty row
+  EXPECT_THROW(match({{{0, 0}}, {}}, 2), std::invalid_argument);
+  // no full matching
+  EXPECT_THROW(match({{{0, 0}}, {{0, 1}}}, 2), std::invalid_argument);
+}
 } // namespace na::zoned
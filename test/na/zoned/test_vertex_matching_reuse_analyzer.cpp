@@ -15,7 +15,9 @@
 #include <gmock/gmock-matchers.h>
 #include <gmock/gmock-more-matchers.h>
 #include <gtest/gtest.h>
+#include <functional>
 #include <optional>
+#include <random>
 #include <utility>
 #include <vector>
 
@@ -128,4 +130,58 @@ TEST(VertexMatchingReuseAnalyzerMaximumBipartiteMatchingInvertedTest, Direct) {
                   inverseSparseMatrix),
               ::testing::ElementsAre(0, 2, 1, 3));
 }
+TEST(VertexMatchingReuseAnalyzerMaximumBipartiteMatchingRandomTest, Random) {
+  std::mt19937 gen(42);
+  for (std::size_t i = 0; i < 100; ++i) {
+    std::uniform_int_distribution<std::size_t> size(1, 30);
+    const auto nSources = size(gen);
+    const auto nSinks = size(gen);
+    std::bernoulli_distribution edge(
+        std::uniform_real_distribution(0.02, 0.3)(gen));
+    std::vector<std::vector<std::size_t>> sparseMatrix(nSources);
+    for (auto& row : sparseMatrix) {
+      for (std::size_t sink = 0; sink < nSinks; ++sink) {
+        if (edge(gen)) {
+          row.emplace_back(sink);
+        }
+      }
+    }
+    // compute the size of a maximum matching with simple augmenting paths
+    std::vector<std::optional<std::size_t>> expectedInvMatching(nSinks);
+    std::size_t expectedSize = 0;
+    for (std::size_t source = 0; source < nSources; ++source) {
+      std::vector visited(nSinks, false);
+      const std::function<bool(std::size_t)> augment = [&](std::size_t s) {
+        for (const auto sink : sparseMatrix[s]) {
+          if (!visited[sink]) {
+            visited[sink] = true;
+            if (!expectedInvMatching[sink] ||
+                augment(*expectedInvMatching[sink])) {
+              expectedInvMatching[sink] = s;
+              return true;
+            }
+          }
+        }
+        return false;
+      };
+      if (augment(source)) {
+        ++expectedSize;
+      }
+    }
+    const auto& matching =
+        VertexMatchingReuseAnalyzer::maximumBipartiteMatching(sparseMatrix);
+    ASSERT_EQ(matching.size(), nSources);
+    std::vector used(nSinks, false);
+    std::size_t matchingSize = 0;
+    for (std::size_t source = 0; source < nSources; ++source) {
+      if (const auto& sink = matching[source]; sink) {
+        EXPECT_THAT(sparseMatrix[source], ::testing::Contains(*sink));
+        EXPECT_FALSE(used[*sink]);
+        used[*sink] = true;
+        ++matchingSize;
+      }
+    }
+    EXPECT_EQ(matchingSize, expectedSize);
+  }
+}
 } // namespace na::zoned
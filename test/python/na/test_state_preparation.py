@@ -63,3 +63,44 @@ def test_na_state_prep_unsat(solver: NAStatePreparationSolver, circuit_filename:
     result = solver.solve(ops, n_qubits, 4, None, False, True)
     assert result is not None
     assert result.json()["sat"] is False
+
+
+def test_na_state_prep_optimal(solver: NAStatePreparationSolver) -> None:
+    """Test that the optimal search finds the minimal number of stages."""
+    qc = load(circ_dir / "steane.qasm")
+    ops = get_ops_for_solver(qc, "z", 1)
+    result = solver.solve_optimal(ops, 7, 5)
+    assert result.json()["sat"] is True
+    assert len(result.json()["stages"]) == 4
+    result = solver.solve_optimal(ops, 7, 3)
+    assert result.json()["sat"] is False
+
+
+def test_na_state_prep_parallel(solver: NAStatePreparationSolver) -> None:
+    """Test that the parallel search finds the same number of stages as the incremental one."""
+    qc = load(circ_dir / "steane.qasm")
+    ops = get_ops_for_solver(qc, "z", 1)
+    result = solver.solve_parallel(ops, 7, 5, num_threads=2)
+    assert result.json()["sat"] is True
+    assert len(result.json()["stages"]) == 4
+
+
+def test_na_state_prep_break_symmetries(solver: NAStatePreparationSolver) -> None:
+    """Test that breaking symmetries does not change the minimal number of stages."""
+    qc = load(circ_dir / "steane.qasm")
+    ops = get_ops_for_solver(qc, "z", 1)
+    result = solver.solve_optimal(ops, 7, 5, break_symmetries=True)
+    assert result.json()["sat"] is True
+    assert len(result.json()["stages"]) == 4
+
+
+def test_na_state_prep_binary_round_trip(solver: NAStatePreparationSolver) -> None:
+    """Test that a result can be restored from its binary representation."""
+    qc = load(circ_dir / "steane.qasm")
+    ops = get_ops_for_solver(qc, "z", 1)
+    result = solver.solve(ops, 7, 4, None, False, True)
+    data = result.binary()
+    assert isinstance(data, bytes)
+    assert type(result).from_binary(data).json() == result.json()
+    with pytest.raises(ValueError, match="binary representation"):
+        type(result).from_binary(b"")
@@ -68,3 +68,13 @@ def test_na_routing_aware_compiler(compiler: RoutingAwareCompiler, circuit_filen
     stats = compiler.stats()
     assert "totalTime" in stats
     assert stats["totalTime"] > 0
+
+
+def test_routing_aware_compiler_invalid_fallback() -> None:
+    """Test that an unknown fallback of the routing-aware compiler is rejected."""
+    architecture = ZonedNeutralAtomArchitecture.from_json_string(architecture_specification)
+    with pytest.raises(ValueError, match="beam_search"):
+        RoutingAwareCompiler(architecture, fallback="beamSearch")
+    # the snake_case names are accepted
+    RoutingAwareCompiler(architecture, fallback="beam_search")
+    RoutingAwareCompiler(architecture, fallback="weighted_a_star")